@@ -0,0 +1,89 @@
+/**
+ * ================================================================================
+ * @file include_engine/atlas.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the work with the texture
+ * atlases. Many small images are packed by the skyline packer into a few large pages,
+ * so the pixels of the sprites drawn together lie close in memory. Every packed image
+ * is described by a region of its page, which is drawn directly by the blit functions.
+ * The packed atlas could be serialized (built offline) and loaded without the packing.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_ATLAS_H_
+#define JEMA_ENGINE_ATLAS_H_
+
+#include "include_engine/utils.h"
+
+typedef struct Image_ Image;
+typedef struct ImageRegion_ ImageRegion;
+typedef struct MemObject_ MemObject;
+
+#define ATLAS_MAGIC 0x534c544a  /* Serialized atlas signature ("JTLS"). */
+#define ATLAS_VERSION 1  /* Version of the serialized atlas format. */
+
+/**
+ * @brief Structure for the Atlas object.
+ */
+struct Atlas_
+{
+    Image **pages;  /**< Pages with the packed images (PF_BGRA, compiled sprites). */
+    u32 pages_num;  /**< Amount of the pages. */
+    ImageRegion *regions;  /**< Regions of the packed images (in the order of the input). */
+    u32 *region_pages;  /**< Index of the page of every region. */
+    u32 regions_num;  /**< Amount of the regions. */
+};
+typedef struct Atlas_ Atlas;
+
+/**
+ * @brief Object constructor.
+ * @return Atlas* Pointer to the Atlas structure.
+ */
+Atlas*
+Atlas_Constructor(void);
+
+/**
+ * @brief Object destructor. The pages belong to the atlas and are destroyed too.
+ * @param atlas Pointer to the Atlas structure.
+ * @return Atlas* Pointer to the Atlas structure.
+ */
+Atlas*
+Atlas_Destructor(Atlas *atlas);
+
+/**
+ * @brief Packing of the images into the pages of the atlas. The images are placed
+ * from the tallest one by the skyline bottom-left rule, a new page is started when the
+ * image does not fit into any of the previous ones. Pages are trimmed to the packed
+ * area. The images are not needed after the packing.
+ * @param atlas Pointer to the empty Atlas structure.
+ * @param images Array of pointers to the images (any pixel format).
+ * @param images_num Amount of the images.
+ * @param page_width Maximal width of a page in pixels.
+ * @param page_height Maximal height of a page in pixels.
+ * @param padding Transparent pixels between the images (against the filter bleeding).
+ */
+void
+Atlas_InitByImages(Atlas *atlas, Image *const *images, u32 images_num, u32 page_width,
+    u32 page_height, u32 padding);
+
+/**
+ * @brief Serialization of the atlas pages and regions into the memory object (which
+ * could be written to disc).
+ * @param atlas Pointer to the Atlas structure.
+ * @param mem_object Pointer to the empty memory object.
+ */
+void
+Atlas_Serialize(const Atlas *atlas, MemObject *mem_object);
+
+/**
+ * @brief Initialization of the atlas by the serialized data. The pages are restored
+ * and compiled into the sprites, nothing is packed again.
+ * @param atlas Pointer to the empty Atlas structure.
+ * @param mem_object Pointer to the memory object with the serialized atlas.
+ */
+void
+Atlas_InitByMemObject(Atlas *atlas, MemObject *mem_object);
+
+#endif  /* JEMA_ENGINE_ATLAS_H_ */
@@ -0,0 +1,135 @@
+/**
+ * ================================================================================
+ * @file include_engine/atomic.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Set of the atomic operations on 32 bit integers shared between threads.
+ * All the operations are full memory barriers.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_ATOMIC_H_
+#define JEMA_ENGINE_ATOMIC_H_
+
+#include "include_engine/utils.h"
+
+/* 32 bit integer to be accessed only by the atomic operations. */
+#ifdef _WIN32
+typedef volatile LONG atomic_s32;
+#else
+typedef volatile s32 atomic_s32;
+#endif
+
+/**
+ * @brief Atomic increment.
+ * @param value Pointer to the atomic value.
+ * @return s32 Incremented value.
+ */
+static inline s32
+Atomic_Increment(atomic_s32 *value)
+{
+#ifdef _WIN32
+    return (s32)InterlockedIncrement(value);
+#else
+    return __atomic_add_fetch(value, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief Atomic decrement.
+ * @param value Pointer to the atomic value.
+ * @return s32 Decremented value.
+ */
+static inline s32
+Atomic_Decrement(atomic_s32 *value)
+{
+#ifdef _WIN32
+    return (s32)InterlockedDecrement(value);
+#else
+    return __atomic_sub_fetch(value, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief Atomic addition.
+ * @param value Pointer to the atomic value.
+ * @param addend Value to add.
+ * @return s32 Value before the addition.
+ */
+static inline s32
+Atomic_Add(atomic_s32 *value, s32 addend)
+{
+#ifdef _WIN32
+    return (s32)InterlockedExchangeAdd(value, (LONG)addend);
+#else
+    return __atomic_fetch_add(value, addend, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief Atomic exchange.
+ * @param value Pointer to the atomic value.
+ * @param new_value Value to store.
+ * @return s32 Value before the exchange.
+ */
+static inline s32
+Atomic_Exchange(atomic_s32 *value, s32 new_value)
+{
+#ifdef _WIN32
+    return (s32)InterlockedExchange(value, (LONG)new_value);
+#else
+    return __atomic_exchange_n(value, new_value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief Atomic compare and exchange.
+ * @param value Pointer to the atomic value.
+ * @param new_value Value to store if the current value is equal to expected.
+ * @param expected Expected current value.
+ * @return s32 Value before the operation (equal to expected on success).
+ */
+static inline s32
+Atomic_CompareExchange(atomic_s32 *value, s32 new_value, s32 expected)
+{
+#ifdef _WIN32
+    return (s32)InterlockedCompareExchange(value, (LONG)new_value, (LONG)expected);
+#else
+    __atomic_compare_exchange_n(value, &expected, new_value, false, __ATOMIC_SEQ_CST,
+        __ATOMIC_SEQ_CST);
+    return expected;
+#endif
+}
+
+/**
+ * @brief Atomic load.
+ * @param value Pointer to the atomic value.
+ * @return s32 Current value.
+ */
+static inline s32
+Atomic_Load(atomic_s32 *value)
+{
+#ifdef _WIN32
+    return (s32)InterlockedCompareExchange(value, 0, 0);
+#else
+    return __atomic_load_n(value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief Atomic store.
+ * @param value Pointer to the atomic value.
+ * @param new_value Value to store.
+ */
+static inline void
+Atomic_Store(atomic_s32 *value, s32 new_value)
+{
+#ifdef _WIN32
+    InterlockedExchange(value, (LONG)new_value);
+#else
+    __atomic_store_n(value, new_value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+#endif  /* JEMA_ENGINE_ATOMIC_H_ */
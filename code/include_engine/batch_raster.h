@@ -0,0 +1,153 @@
+/**
+ * ================================================================================
+ * @file include_engine/batch_raster.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for the drawing of the large batches of filled
+ * rectangles, circles and points (particles, scatter plots). The instances are clipped and
+ * binned into the bands of rows once, keeping their order inside of a band, then the
+ * bands are drawn one by one: every band is small enough to stay in the cache while
+ * all its instances are written, and a drawing restricted to a few rows (a tile) only
+ * visits the instances of its bands.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_BATCH_RASTER_H_
+#define JEMA_ENGINE_BATCH_RASTER_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+#define BATCH_RASTER_BAND_ROWS 16  /* Amount of the rows in a single band. */
+
+/**
+ * @brief Getting the amount of the bands covering the rows of the clip rectangle.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @return u32 Amount of the bands (bands begin at the row 0).
+ */
+u32
+BatchRaster_GetBandsNum(const RenderRect *clip);
+
+/**
+ * @brief Counting the parts of the rectangles inside of every band (the first pass of
+ * the binning). A rectangle crossing several bands is split into a part per band.
+ * @param rects Array of the rectangles.
+ * @param rects_num Amount of the rectangles.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param band_offsets Array of BatchRaster_GetBandsNum + 1 elements for the counts.
+ * @return u32 Total amount of the parts of the rectangles.
+ */
+u32
+BatchRaster_CountRects(const RenderRectInstance *rects, u32 rects_num,
+    const RenderRect *clip, u32 *band_offsets);
+
+/**
+ * @brief Binning of the rectangles (the second pass). Parts are clipped, their colors
+ * are premultiplied if blended.
+ * @param rects Array of the rectangles.
+ * @param rects_num Amount of the rectangles.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param blend Blend mode of the rectangles.
+ * @param band_offsets Array with the counts of BatchRaster_CountRects, becomes the
+ * array of the offsets of the bands in the parts array.
+ * @param parts Array for the parts of the rectangles (the total amount of the parts).
+ */
+void
+BatchRaster_BinRects(const RenderRectInstance *rects, u32 rects_num,
+    const RenderRect *clip, BlendMode blend, u32 *band_offsets, RenderRectInstance *parts);
+
+/**
+ * @brief Counting the circles crossing every band (the first pass of the binning).
+ * Only the rows with the pixel centers inside of a circle are taken into account.
+ * @param circles Array of the circles.
+ * @param circles_num Amount of the circles.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param band_offsets Array of BatchRaster_GetBandsNum + 1 elements for the counts.
+ * @return u32 Total amount of the copies of the circles in the bands.
+ */
+u32
+BatchRaster_CountCircles(const RenderCircle *circles, u32 circles_num,
+    const RenderRect *clip, u32 *band_offsets);
+
+/**
+ * @brief Binning of the circles (the second pass). A circle crossing several bands is
+ * copied into every band, circles without pixels inside of the clip are dropped.
+ * @param circles Array of the circles.
+ * @param circles_num Amount of the circles.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param band_offsets Array with the counts of BatchRaster_CountCircles, becomes the
+ * array of the offsets of the bands in the binned array.
+ * @param binned Array for the copies of the circles (the total amount of the copies).
+ */
+void
+BatchRaster_BinCircles(const RenderCircle *circles, u32 circles_num,
+    const RenderRect *clip, u32 *band_offsets, RenderCircle *binned);
+
+/**
+ * @brief Binning of the points given as the array of structures or as the separate
+ * arrays of the coordinates and colors. Points outside of the clip rectangle are
+ * dropped.
+ * @param points Array of the points (NULL - the separate arrays are used).
+ * @param xs Array of the X coordinates of the points.
+ * @param ys Array of the Y coordinates of the points.
+ * @param colors Array of the 32 bit colors (ARGB) of the points.
+ * @param points_num Amount of the points.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param band_offsets Array of BatchRaster_GetBandsNum + 1 elements for the offsets
+ * of the bands in the binned array.
+ * @param binned Array for the binned points (points_num elements).
+ * @return u32 Amount of the binned points.
+ */
+u32
+BatchRaster_BinPoints(const RenderPoint *points, const u32 *xs, const u32 *ys,
+    const u32 *colors, u32 points_num, const RenderRect *clip, u32 *band_offsets,
+    RenderPoint *binned);
+
+/**
+ * @brief Filling the binned rectangles of the bands crossed by the clip rectangle.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param parts Array of the binned parts of the rectangles.
+ * @param band_offsets Array of the offsets of the bands (bands_num + 1 elements).
+ * @param bands_num Amount of the bands.
+ * @param blend Blend mode.
+ */
+void
+BatchRaster_FillRects(void *memory, u32 pitch, const RenderRect *clip,
+    const RenderRectInstance *parts, const u32 *band_offsets, u32 bands_num,
+    BlendMode blend);
+
+/**
+ * @brief Filling the binned circles of the bands crossed by the clip rectangle. Every
+ * copy only fills the spans of the rows of its band.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param circles Array of the binned circles.
+ * @param band_offsets Array of the offsets of the bands (bands_num + 1 elements).
+ * @param bands_num Amount of the bands.
+ * @param blend Blend mode.
+ */
+void
+BatchRaster_FillCircles(void *memory, u32 pitch, const RenderRect *clip,
+    const RenderCircle *circles, const u32 *band_offsets, u32 bands_num,
+    BlendMode blend);
+
+/**
+ * @brief Setting the colors of the binned points of the bands crossed by the clip
+ * rectangle (the colors are written without blending).
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param points Array of the binned points.
+ * @param band_offsets Array of the offsets of the bands (bands_num + 1 elements).
+ * @param bands_num Amount of the bands.
+ */
+void
+BatchRaster_PlotPoints(void *memory, u32 pitch, const RenderRect *clip,
+    const RenderPoint *points, const u32 *band_offsets, u32 bands_num);
+
+#endif  /* JEMA_ENGINE_BATCH_RASTER_H_ */
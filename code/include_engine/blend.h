@@ -0,0 +1,71 @@
+/**
+ * ================================================================================
+ * @file include_engine/blend.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for blending rows of 32 bit pixels (ARGB). Sources
+ * are colors with the premultiplied alpha, all the math is done in 8 bit fixed point.
+ * Kernels use the instruction set selected for the span fill.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_BLEND_H_
+#define JEMA_ENGINE_BLEND_H_
+
+#include "include_engine/utils.h"
+
+/**
+ * @brief Enumerator for the blend modes of the source pixels with the render buffer.
+ */
+enum BlendMode_
+{
+    BM_NONE,  /**< Source replaces the destination (no blending). */
+    BM_ALPHA,  /**< Source over the destination: d = s + d * (1 - sa). */
+    BM_ADD,  /**< Additive blending with saturation: d = s + d. */
+    BM_MULTIPLY,  /**< Multiplicative blending: d = d * (s + 1 - sa). */
+    BM_MODES_NUM  /**< Total amount of the blend modes. */
+};
+typedef enum BlendMode_ BlendMode;
+
+/**
+ * @brief Conversion of a color to the premultiplied alpha form.
+ * @param color 32 bit color (ARGB) with the straight alpha.
+ * @return u32 32 bit color (ARGB) with the premultiplied alpha.
+ */
+u32
+Blend_Premultiply(u32 color);
+
+/**
+ * @brief Blending a row of the source pixels with the destination row.
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel (premultiplied alpha).
+ * @param count Amount of pixels in the row.
+ * @param mode Blend mode (BM_NONE copies the source).
+ */
+void
+Blend_Row(u32 *dst, const u32 *src, u32 count, BlendMode mode);
+
+/**
+ * @brief Blending a single color with the destination row.
+ * @param dst Pointer to the first destination pixel.
+ * @param count Amount of pixels in the row.
+ * @param color 32 bit color (ARGB) with the premultiplied alpha.
+ * @param mode Blend mode (BM_NONE fills the row with the color).
+ */
+void
+Blend_RowColor(u32 *dst, u32 count, u32 color, BlendMode mode);
+
+/**
+ * @brief Blending a single color modulated by the alpha channel of the source pixels
+ * with the destination row (drawing of the translucent masks).
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel (only the alpha channel is used).
+ * @param count Amount of pixels in the row.
+ * @param color 32 bit color (ARGB) with the premultiplied alpha.
+ * @param mode Blend mode (BM_NONE is treated as BM_ALPHA).
+ */
+void
+Blend_RowTinted(u32 *dst, const u32 *src, u32 count, u32 color, BlendMode mode);
+
+#endif  /* JEMA_ENGINE_BLEND_H_ */
@@ -17,6 +17,7 @@
 typedef struct Color_ Color;
 typedef struct Font_ Font;
 typedef struct Render_ Render;
+typedef struct RenderFrameStats_ RenderFrameStats;
 
 /**
  * @brief Structure for a single message in the debug console.
@@ -42,11 +43,10 @@ struct DConsole_
     Color *bkg_color;  /**< Pointer to the background color of the debug console. */
     Color *brd_color;  /**< Pointer to the console boarders color. */
     u32 margin_width;  /**< Top, left, bottom and right margins width. */
-    /* TODO: Later on game_bkg_color should be deleted (use render layers). */
-    Color *game_bkg_color;  /**< Pointer to the game background color. */
     u32 message_index;  /**< Pointer to the current available message line in the console. */
     Message *messages;  /**< Pointer to the debug console message array. */
     Font *font;  /**< Pointer to the font. */
+    b32 is_visible;  /**< Flag of the console shown in the game window. */
 };
 typedef struct DConsole_ DConsole;
 
@@ -76,12 +76,11 @@ DConsole_Destructor(DConsole *dconsole);
  * @param bkg_color Pointer to the background color of the debug console.
  * @param brd_color Pointer to the console boarders color.
  * @param margin_width Top, left, bottom and right margins width.
- * @param game_bkg_color Pointer to the game background color.
  * @param font Pointer to the font.
  */
 void 
 DConsole_Init(DConsole *dconsole, u32 x, u32 y, u32 width, Color *bkg_color, 
-    Color *brd_color, u32 margin_width, Color *game_bkg_color, Font *font);
+    Color *brd_color, u32 margin_width, Font *font);
 
 /**
  * @brief Adding a single message line to the debug console.
@@ -92,6 +91,18 @@ DConsole_Init(DConsole *dconsole, u32 x, u32 y, u32 width, Color *bkg_color,
 void 
 DConsole_AddMessage(DConsole *dconsole, char *msg_str, Color *color);
 
+/**
+ * @brief Adding the render statistics of a frame to the debug console: the line of the
+ * totals and the lines of the most expensive (by time) command types.
+ * @param dconsole Pointer to the DConsole structure.
+ * @param stats Pointer to the statistics of the frame (Render_GetStats).
+ * @param types_num Maximum amount of the lines of the command types.
+ * @param color Pointer to the color of the messages (ARGB).
+ */
+void
+DConsole_AddRenderStats(DConsole *dconsole, const RenderFrameStats *stats, u32 types_num,
+    Color *color);
+
 /**
  * @brief Clear all messages in the debug console.
  * @param dconsole Pointer to the DConsole structure.
@@ -108,7 +119,9 @@ void
 DConsole_ClearConsole(DConsole *dconsole, Render *render);
 
 /**
- * @brief Hide debug console from the game window.
+ * @brief Hide debug console from the game window. The debug layer is hidden, so the
+ * game beneath the console is uncovered without redrawing. The render statistics are
+ * not counted anymore.
  * @param dconsole Pointer to the DConsole structure.
  * @param render Pointer to the Render structure.
  */
@@ -116,7 +129,9 @@ void
 DConsole_Hide(DConsole *dconsole, Render *render);
 
 /**
- * @brief Render the debug console with all messages in the game window. 
+ * @brief Render the debug console with all messages in the game window (into the
+ * debug layer, which is shown). The render statistics are counted while the console
+ * is shown (they are slow, see Render_EnableStats).
  * @param dconsole Pointer to the DConsole structure.
  * @param font_symbols Pointer to the font symbols.
  * @param render Pointer to the Render_Buffer structure.
@@ -0,0 +1,71 @@
+/**
+ * ================================================================================
+ * @file include_engine/dirty_rects.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the tracking of the
+ * changed (dirty) regions of the render buffer. Rectangles touched by the drawing
+ * are coalesced into a small set, so only these regions need to be presented.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_DIRTY_RECTS_H_
+#define JEMA_ENGINE_DIRTY_RECTS_H_
+
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+#define DIRTY_RECTS_MAX 16  /* Maximum amount of the separate dirty rectangles. */
+#define DIRTY_RECTS_SLACK 1024  /* Area (pixels) allowed to be wasted by a merge. */
+
+/**
+ * @brief Structure for the DirtyRects object.
+ */
+struct DirtyRects_
+{
+    RenderRect rects[DIRTY_RECTS_MAX];  /**< Dirty rectangles (do not overlap much). */
+    u32 rects_num;  /**< Amount of the dirty rectangles. */
+};
+typedef struct DirtyRects_ DirtyRects;
+
+/**
+ * @brief Object constructor.
+ * @return DirtyRects* Pointer to the DirtyRects structure.
+ */
+DirtyRects*
+DirtyRects_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param dirty_rects Pointer to the DirtyRects structure.
+ * @return DirtyRects* Pointer to the DirtyRects structure.
+ */
+DirtyRects*
+DirtyRects_Destructor(DirtyRects *dirty_rects);
+
+/**
+ * @brief Removing all the dirty rectangles.
+ * @param dirty_rects Pointer to the DirtyRects structure.
+ */
+void
+DirtyRects_Clear(DirtyRects *dirty_rects);
+
+/**
+ * @brief Adding a touched rectangle. The rectangle is merged with the existing ones
+ * when the merge wastes little area, or when there is no room for a new rectangle.
+ * @param dirty_rects Pointer to the DirtyRects structure.
+ * @param rect Pointer to the touched rectangle.
+ */
+void
+DirtyRects_Add(DirtyRects *dirty_rects, const RenderRect *rect);
+
+/**
+ * @brief Getting the total area of the dirty rectangles.
+ * @param dirty_rects Pointer to the DirtyRects structure.
+ * @return u64 Area in pixels.
+ */
+u64
+DirtyRects_GetArea(DirtyRects *dirty_rects);
+
+#endif  /* JEMA_ENGINE_DIRTY_RECTS_H_ */
@@ -0,0 +1,39 @@
+/**
+ * ================================================================================
+ * @file include_engine/ellipse_raster.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for the rasterization of the filled ellipses and
+ * rings (circles are the ellipses with equal radii). Pixels are sampled at their
+ * centers, every row of the shape is filled by a single span (two spans for a ring)
+ * with the span fill or blend kernels, so no pixel is written twice.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_ELLIPSE_RASTER_H_
+#define JEMA_ENGINE_ELLIPSE_RASTER_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Filling an axis-aligned ellipse or an elliptic ring. The ring is the ellipse
+ * without the inner ellipse with both radii reduced by the thickness.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param x0 X coordinate of the center.
+ * @param y0 Y coordinate of the center.
+ * @param radius_x Horizontal radius.
+ * @param radius_y Vertical radius.
+ * @param thickness Thickness of the ring (0 - filled ellipse).
+ * @param color 32 bit color (ARGB) of the ellipse.
+ * @param blend Blend mode.
+ */
+void
+EllipseRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, f32 x0, f32 y0,
+    f32 radius_x, f32 radius_y, f32 thickness, u32 color, BlendMode blend);
+
+#endif  /* JEMA_ENGINE_ELLIPSE_RASTER_H_ */
@@ -39,6 +39,7 @@ struct Font_
     s32 sym_width;  /**< Symbol width in pixels (6).  */
     s32 sym_height;  /**< Symbol height in pixels (7). */
     SymbolData *symbols_data;  /**< Pointer to the font symbols data. */
+    u32 id;  /**< Unique identifier of the font (key of the cached glyphs). */
 };
 typedef struct Font_ Font;
 
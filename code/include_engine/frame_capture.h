@@ -0,0 +1,132 @@
+/**
+ * ================================================================================
+ * @file include_engine/frame_capture.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the capture of the
+ * presented frames. The frames are copied into a pool of preallocated frames by the
+ * drawing thread, a background writer thread encodes them into a png sequence or
+ * streams them as a raw video (Y4M or RGBA) into a file or a pipe. The pool is a
+ * single producer, single consumer ring: the drawing thread never waits, a frame not
+ * fitting into the full pool is dropped.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_FRAME_CAPTURE_H_
+#define JEMA_ENGINE_FRAME_CAPTURE_H_
+
+#include <stdio.h>
+
+#include "include_engine/atomic.h"
+#include "include_engine/utils.h"
+
+#define FRAME_CAPTURE_PATH_MAX 260  /* Maximum length of the output path. */
+
+/**
+ * @brief Enumeration of the capture output formats.
+ */
+enum FrameCaptureFormat_
+{
+    FCF_PNG,  /**< Png file per frame, the path is a pattern with the frame number (%u). */
+    FCF_Y4M,  /**< YUV4MPEG2 stream (4:4:4, BT.601 limited range). */
+    FCF_RGBA,  /**< Raw stream of 8 bit RGBA pixels, top row first. */
+    FCF_FORMATS_NUM  /**< Total amount of the formats. */
+};
+typedef enum FrameCaptureFormat_ FrameCaptureFormat;
+
+typedef struct FrameCaptureThread_ FrameCaptureThread;
+
+/**
+ * @brief Structure for the FrameCapture object.
+ */
+struct FrameCapture_
+{
+    FrameCaptureFormat format;  /**< Format of the output. */
+    char path[FRAME_CAPTURE_PATH_MAX];  /**< Output path (pattern, file, "-" or "|cmd"). */
+    FILE *file;  /**< Stream of the raw video (NULL - png sequence). */
+    b32 is_pipe;  /**< Flag showing that the stream is a pipe to the command. */
+    u32 width;  /**< Width of the captured frames. */
+    u32 height;  /**< Height of the captured frames. */
+    u32 frames_num;  /**< Amount of the frames in the pool. */
+    u32 *frames;  /**< Memory of the pool frames (ARGB, BL origin, rows without gaps). */
+    u8 *converted;  /**< Row (RGBA) or planes (Y4M) converted by the writer thread. */
+    atomic_s32 write_count;  /**< Amount of the frames put into the pool. */
+    atomic_s32 read_count;  /**< Amount of the frames taken from the pool. */
+    atomic_s32 frames_encoded;  /**< Amount of the frames written to the output. */
+    atomic_s32 frames_dropped;  /**< Amount of the frames not fitting into the pool. */
+    atomic_s32 frames_failed;  /**< Amount of the frames not written (output errors). */
+    atomic_s32 is_running;  /**< Flag showing that the writer thread should run. */
+    void *signal;  /**< Semaphore released for every pooled frame and for the stop. */
+    FrameCaptureThread *thread;  /**< Pointer to the writer thread data. */
+};
+typedef struct FrameCapture_ FrameCapture;
+
+/**
+ * @brief Structure for the statistics of the frame capture.
+ */
+struct FrameCaptureStats_
+{
+    u32 frames_captured;  /**< Amount of the frames copied into the pool. */
+    u32 frames_encoded;  /**< Amount of the frames written to the output. */
+    u32 frames_dropped;  /**< Amount of the frames not fitting into the pool. */
+    u32 frames_failed;  /**< Amount of the frames not written (output errors). */
+    u32 frames_pending;  /**< Amount of the frames waiting in the pool. */
+};
+typedef struct FrameCaptureStats_ FrameCaptureStats;
+
+/**
+ * @brief Object constructor.
+ * @return FrameCapture* Pointer to the FrameCapture structure.
+ */
+FrameCapture*
+FrameCapture_Constructor(void);
+
+/**
+ * @brief Object destructor. The frames left in the pool are written, then the writer
+ * thread is joined and the output is closed.
+ * @param capture Pointer to the FrameCapture structure.
+ * @return FrameCapture* Pointer to the FrameCapture structure.
+ */
+FrameCapture*
+FrameCapture_Destructor(FrameCapture *capture);
+
+/**
+ * @brief Object initialization. Allocating the pool, opening the stream (the header
+ * of Y4M is written) and starting the writer thread.
+ * @param capture Pointer to the FrameCapture structure.
+ * @param format Format of the output.
+ * @param path Path pattern of the png files ("capture/frame_%05u.png"), path of the
+ * stream file, "-" for the standard output or "|command" for a pipe to the command.
+ * @param width Width of the captured frames.
+ * @param height Height of the captured frames.
+ * @param fps Frame rate written to the Y4M header.
+ * @param frames_num Amount of the frames in the pool (the allowed writer lag).
+ */
+void
+FrameCapture_Init(FrameCapture *capture, FrameCaptureFormat format, const char *path,
+    u32 width, u32 height, u32 fps, u32 frames_num);
+
+/**
+ * @brief Copying the frame into the pool (drawing thread). Never waits: the frame is
+ * dropped if the pool is full or the frame size differs from the capture size.
+ * @param capture Pointer to the FrameCapture structure.
+ * @param pixels Pointer to the BL pixel of the 32 bit ARGB pixels.
+ * @param width Width of the frame.
+ * @param height Height of the frame.
+ * @param pitch Distance between the rows in bytes.
+ * @return b32 True if the frame was captured, false if it was dropped.
+ */
+b32
+FrameCapture_Submit(FrameCapture *capture, const u32 *pixels, u32 width, u32 height,
+    u32 pitch);
+
+/**
+ * @brief Getting the capture statistics (could be called from any thread).
+ * @param capture Pointer to the FrameCapture structure.
+ * @param stats Pointer to the statistics structure to fill.
+ */
+void
+FrameCapture_GetStats(FrameCapture *capture, FrameCaptureStats *stats);
+
+#endif  /* JEMA_ENGINE_FRAME_CAPTURE_H_ */
@@ -0,0 +1,145 @@
+/**
+ * ================================================================================
+ * @file include_engine/glyph_cache.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the caching of the
+ * rasterized text. Every glyph of a font is converted once per symbol pixel size into
+ * a few rectangles (horizontal spans of the symbol rows, merged with the equal spans of
+ * the neighbouring rows). Layouts of the whole strings are cached as well (as the spans
+ * of every pixel row of the string), so the text which does not change between frames
+ * is drawn row by row without looking at the glyphs at all.
+ * Entries are keyed by the font identifier, the glyphs do not depend on the color.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_GLYPH_CACHE_H_
+#define JEMA_ENGINE_GLYPH_CACHE_H_
+
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+typedef struct Font_ Font;
+
+#define GLYPH_CACHE_SYMBOLS_NUM 256  /* Amount of the symbols in a font (Win1251). */
+#define GLYPH_CACHE_ELLIPSIS 133  /* Symbol printed when the string is too wide. */
+#define GLYPH_CACHE_RUNS_CAPACITY 64  /* Initial capacity of the text runs hash table. */
+#define GLYPH_CACHE_SHORT_SPAN 8  /* Spans filled without the span fill kernel call. */
+
+/**
+ * @brief Structure for a single rasterized glyph.
+ */
+struct Glyph_
+{
+    u32 rects_offset;  /**< Index of the first rectangle in the rects array of the set. */
+    u32 rects_num;  /**< Amount of the rectangles of the glyph. */
+    s32 advance;  /**< Distance to the next symbol of the string in pixels. */
+};
+typedef struct Glyph_ Glyph;
+
+/**
+ * @brief Structure for the glyphs of a font rasterized with a single pixel size.
+ */
+struct GlyphSet_
+{
+    u32 font_id;  /**< Identifier of the font. */
+    u32 size;  /**< Size of a single symbol pixel. */
+    Glyph glyphs[GLYPH_CACHE_SYMBOLS_NUM];  /**< Glyphs of all the symbols. */
+    RenderRect *rects;  /**< Rectangles of all the glyphs (relative to the BL corner). */
+    u32 rects_num;  /**< Total amount of the rectangles. */
+    u64 frame;  /**< Last frame the set was used in. */
+};
+typedef struct GlyphSet_ GlyphSet;
+
+/**
+ * @brief Structure for a horizontal span of the lit pixels [x0, x1) of a string row.
+ */
+struct TextSpan_
+{
+    s32 x0;  /**< X coordinate of the first pixel (relative to the string). */
+    s32 x1;  /**< X coordinate of the pixel after the last one (relative to the string). */
+};
+typedef struct TextSpan_ TextSpan;
+
+/**
+ * @brief Structure for the cached layout of a string.
+ */
+struct TextRun_
+{
+    u64 hash;  /**< Hash of the string and of the layout parameters. */
+    char *str;  /**< Copy of the string. */
+    u32 font_id;  /**< Identifier of the font. */
+    u32 size;  /**< Size of a single symbol pixel. */
+    s32 max_width;  /**< Maximum width of the string in pixels (0 - unlimited). */
+    RenderRect bounds;  /**< Bounding rectangle of the string (relative to its BL corner). */
+    TextSpan *spans;  /**< Spans of all the rows (row after row, sorted by x). */
+    u32 spans_num;  /**< Total amount of the spans. */
+    u32 *row_spans;  /**< Index of the first span of every row from bounds.y0 (+1 item). */
+    u64 frame;  /**< Last frame the run was used in. */
+};
+typedef struct TextRun_ TextRun;
+
+/**
+ * @brief Structure for the GlyphCache object.
+ */
+struct GlyphCache_
+{
+    GlyphSet **sets;  /**< Array of the glyph sets. */
+    u32 sets_num;  /**< Amount of the glyph sets. */
+    TextRun **runs;  /**< Hash table of the text runs (open addressing, NULL - empty). */
+    u32 runs_num;  /**< Amount of the text runs. */
+    u32 runs_capacity;  /**< Capacity of the hash table (power of two). */
+    u64 frame;  /**< Number of the current frame. */
+};
+typedef struct GlyphCache_ GlyphCache;
+
+/**
+ * @brief Object constructor.
+ * @return GlyphCache* Pointer to the GlyphCache structure.
+ */
+GlyphCache*
+GlyphCache_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param glyph_cache Pointer to the GlyphCache structure.
+ * @return GlyphCache* Pointer to the GlyphCache structure.
+ */
+GlyphCache*
+GlyphCache_Destructor(GlyphCache *glyph_cache);
+
+/**
+ * @brief Getting the glyphs of the font rasterized with the pixel size (rasterizing
+ * them if necessary).
+ * @param glyph_cache Pointer to the GlyphCache structure.
+ * @param font Pointer to the font.
+ * @param size Size of a single symbol pixel.
+ * @return const GlyphSet* Pointer to the glyph set.
+ */
+const GlyphSet*
+GlyphCache_GetSet(GlyphCache *glyph_cache, const Font *font, u32 size);
+
+/**
+ * @brief Getting the layout of the string (building it if necessary). The run stays
+ * valid at least until the end of the current frame.
+ * @param glyph_cache Pointer to the GlyphCache structure.
+ * @param font Pointer to the font.
+ * @param str Null terminated string.
+ * @param size Size of a single symbol pixel.
+ * @param max_width Maximum width of the string in pixels (0 - unlimited).
+ * @return const TextRun* Pointer to the text run.
+ */
+const TextRun*
+GlyphCache_GetRun(GlyphCache *glyph_cache, const Font *font, const char *str, u32 size,
+    s32 max_width);
+
+/**
+ * @brief Finishing the frame. Glyph sets and text runs not used during the frame are
+ * freed (so the entries of the freed fonts are dropped as well).
+ * @param glyph_cache Pointer to the GlyphCache structure.
+ */
+void
+GlyphCache_NextFrame(GlyphCache *glyph_cache);
+
+#endif  /* JEMA_ENGINE_GLYPH_CACHE_H_ */
@@ -49,3 +49,37 @@ HelperFcn_MemAllocate(size_t memory_size);
 void
 HelperFcn_MemFree(void *object);
 
+
+/**
+ * @brief Wrapper for the standard realloc function with additional examination of the
+ * memory allocation success.
+ * @param object Pointer to the object allocated in memory (could be NULL).
+ * @param memory_size New size of the memory block.
+ * @return void* Pointer to the reallocated memory block.
+ */
+void*
+HelperFcn_MemReallocate(void *object, size_t memory_size);
+
+/**
+ * @brief Allocation of a large zero filled memory block by whole pages (the bitmaps of
+ * the render buffers). VirtualAlloc is used on Windows, calloc on other platforms.
+ * @param memory_size Size of the memory block.
+ * @return void* Pointer to the allocated memory block.
+ */
+void*
+HelperFcn_PageAllocate(size_t memory_size);
+
+/**
+ * @brief Freeing of the memory block allocated by HelperFcn_PageAllocate.
+ * @param object Pointer to the memory block (could be NULL).
+ */
+void
+HelperFcn_PageFree(void *object);
+
+/**
+ * @brief Getting the time of the monotonic clock (profiling of the code). The
+ * performance counter is used on Windows, CLOCK_MONOTONIC on other platforms.
+ * @return u64 Time in nanoseconds from an arbitrary moment.
+ */
+u64
+HelperFcn_GetTimeNs(void);
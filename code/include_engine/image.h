@@ -11,22 +11,42 @@
 #ifndef JEMA_ENGINE_IMAGE_H_
 #define JEMA_ENGINE_IMAGE_H_
 
+#include "include_engine/pixel_format.h"
+#include "include_engine/texture.h"
 #include "include_engine/utils.h"
 
 typedef struct MemObject_ MemObject;
+typedef struct Sprite_ Sprite;
 
 /**
  * @brief Structure for the uncompressed image holding in memory.
  */
 struct Image_ 
 {
-    u32 *data;  /**< Pointer to the uncompressed image data (set of bytes). */
+    void *data;  /**< Pointer to the uncompressed image data (rows without gaps). */
     u32 width;  /**< Width of the uncompresed image in pixels. */
     u32 height;  /**< Height of the uncompressed image in pixels. */
     u32 channels;  /**< Number of channels of the uncompressed image (4 - RGBA) */
+    PixelFormat format;  /**< Pixel format of the data (PF_RGBA - not converted). */
+    Sprite *sprite;  /**< Compiled opaque spans of the image (NULL - not compiled). */
+    Texture *texture;  /**< Texture for the transformed drawing (NULL - not compiled). */
 };
 typedef struct Image_ Image;
 
+/**
+ * @brief Structure for a rectangular region of an image (for example, an image packed
+ * into an atlas page). Regions are drawn directly by the blit functions.
+ */
+struct ImageRegion_
+{
+    const Image *image;  /**< Pointer to the image holding the region. */
+    u32 x;  /**< X coordinate of the BL corner of the region in the image. */
+    u32 y;  /**< Y coordinate of the BL corner of the region in the image. */
+    u32 width;  /**< Width of the region in pixels. */
+    u32 height;  /**< Height of the region in pixels. */
+};
+typedef struct ImageRegion_ ImageRegion;
+
 /**
  * @brief Object constructor.
  * @return Image* Pointer to the Image structure.
@@ -50,6 +70,32 @@ Image_Destructor(Image *image);
 void
 Image_InitByMemObject(Image *image, MemObject *mem_object);
 
+/**
+ * @brief Conversion of the image data to another pixel format. Compiled sprite and
+ * texture are compiled again (alpha only formats keep the alpha of the pixels only).
+ * @param image Pointer to the Image structure.
+ * @param format Desired pixel format.
+ */
+void
+Image_Convert(Image *image, PixelFormat format);
+
+/**
+ * @brief Compilation of the image data into the sprite used for the drawing. Necessary
+ * for the images filled not by the loading functions (or changed after the loading).
+ * @param image Pointer to the Image structure.
+ */
+void
+Image_CompileSprite(Image *image);
+
+/**
+ * @brief Compilation of the image data into the texture used for the rotated, scaled
+ * and texture mapped drawing. Compiled on demand, as it doubles the image memory.
+ * @param image Pointer to the Image structure.
+ * @param layout Memory layout of the texels (TL_TILED suits the rotated drawing).
+ */
+void
+Image_CompileTexture(Image *image, TextureLayout layout);
+
 /**
  * @brief Loading the desired image to the application. This is a frontend 
  * function wrapping the set of more specific functions.
@@ -0,0 +1,91 @@
+/**
+ * ================================================================================
+ * @file include_engine/job_pool.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the work with the pool
+ * of worker threads. The pool executes batches of independent jobs in parallel.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_JOB_POOL_H_
+#define JEMA_ENGINE_JOB_POOL_H_
+
+#include "include_engine/atomic.h"
+#include "include_engine/utils.h"
+
+/* Declare pointer to the job procedure. Worker index is in range [0, workers_num). */
+typedef void job_proc_t(void *data, u32 job_index, u32 worker_index);
+
+typedef struct JobPoolThread_ JobPoolThread;
+
+/**
+ * @brief Structure for the JobPool object.
+ */
+struct JobPool_
+{
+    u32 threads_num;  /**< Amount of the worker threads (the caller is not counted). */
+    JobPoolThread *threads;  /**< Pointer to the array of worker threads data. */
+    void *start_signal;  /**< Semaphore released once per worker for every batch. */
+    void *done_signal;  /**< Semaphore released when the last worker finished a batch. */
+    job_proc_t *job_proc;  /**< Procedure of the current batch. */
+    void *job_data;  /**< Data of the current batch. */
+    u32 jobs_num;  /**< Amount of jobs in the current batch. */
+    atomic_s32 next_job;  /**< Index of the next job to be taken. */
+    atomic_s32 active_workers;  /**< Amount of workers still busy with the batch. */
+    atomic_s32 is_running;  /**< Flag showing that the worker threads should run. */
+};
+typedef struct JobPool_ JobPool;
+
+/**
+ * @brief Object constructor.
+ * @return JobPool* Pointer to the JobPool structure.
+ */
+JobPool*
+JobPool_Constructor(void);
+
+/**
+ * @brief Object destructor. Stops and joins all the worker threads.
+ * @param job_pool Pointer to the JobPool structure.
+ * @return JobPool* Pointer to the JobPool structure.
+ */
+JobPool*
+JobPool_Destructor(JobPool *job_pool);
+
+/**
+ * @brief Object initialization. Starting the worker threads.
+ * @param job_pool Pointer to the JobPool structure.
+ * @param threads_num Amount of the worker threads. Zero - one thread per extra CPU core.
+ */
+void
+JobPool_Init(JobPool *job_pool, u32 threads_num);
+
+/**
+ * @brief Getting the amount of workers taking part in the batch (including the caller).
+ * @param job_pool Pointer to the JobPool structure.
+ * @return u32 Amount of the workers.
+ */
+u32
+JobPool_GetWorkersNum(JobPool *job_pool);
+
+/**
+ * @brief Executing a batch of jobs. Every job is executed exactly once by one of the
+ * workers, the calling thread takes part in the execution. Function returns when all
+ * the jobs are done.
+ * @param job_pool Pointer to the JobPool structure.
+ * @param job_proc Procedure to be called for every job.
+ * @param job_data Data passed to the every job procedure call.
+ * @param jobs_num Amount of jobs in the batch.
+ */
+void
+JobPool_Run(JobPool *job_pool, job_proc_t *job_proc, void *job_data, u32 jobs_num);
+
+/**
+ * @brief Getting the amount of logical CPU cores.
+ * @return u32 Amount of the CPU cores.
+ */
+u32
+JobPool_GetCpuCoresNum(void);
+
+#endif  /* JEMA_ENGINE_JOB_POOL_H_ */
@@ -0,0 +1,60 @@
+/**
+ * ================================================================================
+ * @file include_engine/line_raster.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for the rasterization of the anti-aliased lines by
+ * the Wu algorithm. Pixels are sampled at their centers, the line is traversed along
+ * its major axis in 16.16 fixed point and every step covers two pixels of the minor
+ * axis with the complementary coverage. Pixel addresses are stepped incrementally.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_LINE_RASTER_H_
+#define JEMA_ENGINE_LINE_RASTER_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#define LINE_RASTER_FRACTION_BITS 16  /* Fractional bits of the fixed point stepping. */
+#define LINE_RASTER_GUARD_BAND 32768.0f  /* Lines beyond are clipped geometrically. */
+
+/**
+ * @brief Drawing an anti-aliased line one pixel wide. The color is blended with the
+ * coverage of every pixel. Lines reaching out of the guard band are clipped by it
+ * first, other ones are only scissored (so the pixels do not depend on the clip).
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param x0 X coordinate of the beginning point.
+ * @param y0 Y coordinate of the beginning point.
+ * @param x1 X coordinate of the ending point.
+ * @param y1 Y coordinate of the ending point.
+ * @param color 32 bit color (ARGB) of the line.
+ * @param blend Blend mode (BM_NONE is treated as BM_ALPHA).
+ */
+void
+LineRaster_DrawAA(void *memory, u32 pitch, const RenderRect *clip, f32 x0, f32 y0,
+    f32 x1, f32 y1, u32 color, BlendMode blend);
+
+/**
+ * @brief Drawing an anti-aliased polyline one pixel wide through the array of points.
+ * The coverage of the segments is gathered first (the larger one is kept where the
+ * segments meet or cross), then every covered pixel is blended once, so the joints are
+ * not darker than the lines. A single segment gives the pixels of LineRaster_DrawAA.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param points Array of the points.
+ * @param points_num Amount of the points.
+ * @param color 32 bit color (ARGB) of the polyline.
+ * @param blend Blend mode (BM_NONE is treated as BM_ALPHA).
+ */
+void
+LineRaster_DrawPolylineAA(void *memory, u32 pitch, const RenderRect *clip,
+    const Vec2 *points, u32 points_num, u32 color, BlendMode blend);
+
+#endif  /* JEMA_ENGINE_LINE_RASTER_H_ */
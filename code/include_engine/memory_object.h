@@ -48,6 +48,15 @@ MemObject_Destructor(MemObject *mem_object);
 void
 MemObject_InitByFile(MemObject *mem_object, const char *file_path);
 
+/**
+ * @brief Initialization of the memory object by the allocated memory of the specified 
+ * size (zero filled).
+ * @param mem_object Pointer to the MemObject structure.
+ * @param size Size of the memory object in bytes.
+ */
+void
+MemObject_InitBySize(MemObject *mem_object, u64 size);
+
 /**
  * @brief Writing the entire data of the memory object to disc.
  * @param mem_object Pointer to the MemObject structure.
@@ -0,0 +1,78 @@
+/**
+ * ================================================================================
+ * @file include_engine/pixel_format.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of the pixel formats of the images and of the functions for the
+ * conversion of pixel rows between them. Images are converted once (at the loading or
+ * the compilation), so no pixel is swizzled while drawing. Kernels use the instruction
+ * set selected for the span fill.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_PIXEL_FORMAT_H_
+#define JEMA_ENGINE_PIXEL_FORMAT_H_
+
+#include "include_engine/utils.h"
+
+/**
+ * @brief Enumerator for the pixel formats. The alpha channel of the 32 bit formats is
+ * always the most significant byte.
+ */
+enum PixelFormat_
+{
+    PF_RGBA,  /**< Bytes R, G, B, A (order of the decoded png files). */
+    PF_BGRA,  /**< Bytes B, G, R, A (32 bit ARGB color of the render buffer). */
+    PF_BGRA_PREMULTIPLIED,  /**< PF_BGRA with the color multiplied by the alpha. */
+    PF_A8,  /**< 8 bit alpha only (masks). */
+    PF_A1,  /**< 1 bit alpha only, the lowest bit first, rows padded to whole bytes. */
+    PF_FORMATS_NUM  /**< Total amount of the formats. */
+};
+typedef enum PixelFormat_ PixelFormat;
+
+/**
+ * @brief Structure for the description of a pixel format.
+ */
+struct PixelFormatInfo_
+{
+    u32 bits_per_pixel;  /**< Size of a single pixel in bits. */
+    b32 has_color;  /**< Flag of the color channels (otherwise alpha only). */
+    b32 is_premultiplied;  /**< Flag of the color multiplied by the alpha. */
+    const char *name;  /**< Human readable name of the format. */
+};
+typedef struct PixelFormatInfo_ PixelFormatInfo;
+
+/**
+ * @brief Getting the description of the pixel format.
+ * @param format Pixel format.
+ * @return const PixelFormatInfo* Pointer to the description.
+ */
+const PixelFormatInfo*
+PixelFormat_GetInfo(PixelFormat format);
+
+/**
+ * @brief Getting the size of a row of pixels.
+ * @param format Pixel format.
+ * @param width Amount of pixels in the row.
+ * @return u32 Size of the row in bytes.
+ */
+u32
+PixelFormat_GetPitch(PixelFormat format, u32 width);
+
+/**
+ * @brief Conversion of a row of pixels to another format. Alpha only formats become
+ * black pixels with the color, colors become alpha only by their alpha channel (1 bit
+ * alpha is set from the alpha 128 and above). The destination could be the source if
+ * the formats have the same pixel size.
+ * @param dst Pointer to the destination row.
+ * @param dst_format Pixel format of the destination row.
+ * @param src Pointer to the source row.
+ * @param src_format Pixel format of the source row.
+ * @param count Amount of pixels in the row.
+ */
+void
+PixelFormat_ConvertRow(void *dst, PixelFormat dst_format, const void *src,
+    PixelFormat src_format, u32 count);
+
+#endif  /* JEMA_ENGINE_PIXEL_FORMAT_H_ */
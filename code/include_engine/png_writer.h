@@ -0,0 +1,34 @@
+/**
+ * ================================================================================
+ * @file include_engine/png_writer.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of the functions for the encoding of the frames into the png
+ * files (golden images of the benchmarks, captured frames). The data is compressed
+ * by the LZ77 matching with the fixed Huffman codes, which suits the flat areas of
+ * the rendered frames and keeps the encoder small and fast.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_PNG_WRITER_H_
+#define JEMA_ENGINE_PNG_WRITER_H_
+
+#include "include_engine/utils.h"
+
+typedef struct MemObject_ MemObject;
+
+/**
+ * @brief Encoding of the pixels into the png file data (8 bit RGBA). The rows are
+ * stored from the top one, so the file looks like the frame on the screen.
+ * @param mem_object Pointer to the empty memory object for the file data.
+ * @param pixels Pointer to the BL pixel of the 32 bit ARGB pixels (render buffer order).
+ * @param width Width of the image in pixels.
+ * @param height Height of the image in pixels.
+ * @param pitch Distance between the rows in bytes.
+ */
+void
+PngWriter_Encode(MemObject *mem_object, const u32 *pixels, u32 width, u32 height,
+    u32 pitch);
+
+#endif  /* JEMA_ENGINE_PNG_WRITER_H_ */
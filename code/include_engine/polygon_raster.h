@@ -0,0 +1,75 @@
+/**
+ * ================================================================================
+ * @file include_engine/polygon_raster.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for the rasterization of the filled polygons (convex,
+ * concave or self-intersecting) by the scanlines with the active edge table. Pixels are
+ * sampled at their centers, the inside of the polygon is found by the fill rule and
+ * every covered run of a row is filled by a single span, so the cost follows the
+ * covered pixels and not the amount of the vertices.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_POLYGON_RASTER_H_
+#define JEMA_ENGINE_POLYGON_RASTER_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#define POLYGON_RASTER_STACK_EDGES 64  /* Edges of the polygon kept without allocation. */
+
+typedef struct RenderRect_ RenderRect;
+
+/**
+ * @brief Enumerator for the rules deciding which parts of the polygon are inside.
+ */
+enum PolygonFillRule_
+{
+    PFR_EVEN_ODD,  /**< Inside if a ray from the point crosses the edges odd times. */
+    PFR_NON_ZERO,  /**< Inside if the edges wind around the point at least once. */
+    PFR_RULES_NUM  /**< Total amount of the rules. */
+};
+typedef enum PolygonFillRule_ PolygonFillRule;
+
+/**
+ * @brief Filling a polygon. The polygon is closed by the edge from the last vertex to
+ * the first one, a pixel is covered if its center is inside by the fill rule (centers
+ * lying on the left and bottom edges are inside, so polygons sharing an edge neither
+ * overlap nor leave gaps). Only the rows of the clip rectangle are traversed.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param vertices Array of the vertices of the polygon.
+ * @param vertices_num Amount of the vertices (less than three - nothing is drawn).
+ * @param rule Fill rule of the polygon.
+ * @param color 32 bit color (ARGB) of the polygon.
+ * @param blend Blend mode.
+ */
+void
+PolygonRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, const Vec2 *vertices,
+    u32 vertices_num, PolygonFillRule rule, u32 color, BlendMode blend);
+
+/**
+ * @brief Filling the shape made of several contours with the same amount of vertices by
+ * a single pass, so the pixels covered by several contours are written once. Every
+ * contour is closed by itself, the inside is found by the fill rule from the windings
+ * of all the contours (contours oriented alike are united by PFR_NON_ZERO).
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param vertices Array of the vertices of the contours one after another.
+ * @param contours_num Amount of the contours.
+ * @param contour_size Amount of the vertices of every contour.
+ * @param rule Fill rule of the shape.
+ * @param color 32 bit color (ARGB) of the shape.
+ * @param blend Blend mode.
+ */
+void
+PolygonRaster_FillContours(void *memory, u32 pitch, const RenderRect *clip,
+    const Vec2 *vertices, u32 contours_num, u32 contour_size, PolygonFillRule rule,
+    u32 color, BlendMode blend);
+
+#endif  /* JEMA_ENGINE_POLYGON_RASTER_H_ */
@@ -11,46 +11,106 @@
 #ifndef JEMA_ENGINE_RENDER_H_
 #define JEMA_ENGINE_RENDER_H_
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
+#include "include_engine/atomic.h"
+#include "include_engine/blend.h"
+#include "include_engine/frame_capture.h"
+#include "include_engine/polygon_raster.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/render_target.h"
+#include "include_engine/swap_chain.h"
+#include "include_engine/texture.h"
+#include "include_engine/upscaler.h"
 #include "include_engine/utils.h"
 
 typedef struct Color_ Color;
+typedef struct DirtyRects_ DirtyRects;
+typedef struct Font_ Font;
 typedef struct Game_ Game;
+typedef struct GlyphCache_ GlyphCache;
 typedef struct Image_ Image;
+typedef struct ImageRegion_ ImageRegion;
+typedef struct RenderCmd_ RenderCmd;
+typedef struct RenderCmdBuffer_ RenderCmdBuffer;
+typedef struct RenderLayers_ RenderLayers;
+typedef struct RenderOcclusion_ RenderOcclusion;
+typedef struct RenderTiler_ RenderTiler;
 typedef struct Vec2_ Vec2;
 
 /**
- * @brief Structure for the render buffer.
+ * @brief Structure for a rectangle of pixels [x0, x1) x [y0, y1).
  */
-struct RenderBuffer_
+struct RenderRect_
 {
-    u32 width;  /**< Allocated buffer width. */
-    u32 height;  /**< Allocated buffer height. */
-    void *bitmap_memory;  /**< Pointer to the allocated bitmap memory. */
+    s32 x0;  /**< X coordinate of the BL corner (included). */
+    s32 y0;  /**< Y coordinate of the BL corner (included). */
+    s32 x1;  /**< X coordinate of the UR corner (excluded). */
+    s32 y1;  /**< Y coordinate of the UR corner (excluded). */
 };
-typedef struct RenderBuffer_ RenderBuffer;
+typedef struct RenderRect_ RenderRect;
+
+/**
+ * @brief Enumerator for the render layers (from the bottom to the top).
+ */
+enum RenderLayerId_
+{
+    RL_BACKGROUND,  /**< Static background (opaque, copied without blending). */
+    RL_WORLD,  /**< Game world. */
+    RL_UI,  /**< User interface. */
+    RL_DEBUG,  /**< Debug overlays (debug console). */
+    RL_LAYERS_NUM  /**< Total amount of the layers. */
+};
+typedef enum RenderLayerId_ RenderLayerId;
+
+/**
+ * @brief Structure for a filled circle of the batched drawing.
+ */
+struct RenderCircle_
+{
+    f32 x0;  /**< X coordinate of the circle center. */
+    f32 y0;  /**< Y coordinate of the circle center. */
+    f32 radius;  /**< Radius of the circle. */
+    u32 color;  /**< 32 bit color (ARGB) of the circle. */
+};
+typedef struct RenderCircle_ RenderCircle;
 
 /**
- * @brief Enumerator indicating side flat triangles.
+ * @brief Structure for a filled rectangle of the batched drawing.
  */
-enum FlatSideFlag_
+struct RenderRectInstance_
 {
-    SF_BOTTOM_FLAT,  /**< Flag for the bottom flat triangles. */
-    SF_TOP_FLAT  /**< Flag for the top flat triangles. */
+    u32 x0;  /**< X coordinate of the BL corner. */
+    u32 y0;  /**< Y coordinate of the BL corner. */
+    u32 width;  /**< Width of the rectangle. */
+    u32 height;  /**< Height of the rectangle. */
+    u32 color;  /**< 32 bit color (ARGB) of the rectangle. */
 };
-typedef enum FlatSideFlag_ FlatSideFlag;
+typedef struct RenderRectInstance_ RenderRectInstance;
 
 /**
- * @brief Structure holding data necessary for drawing a filled triangles.
+ * @brief Structure for a pixel of the batched drawing.
  */
-struct TriangleData_
+struct RenderPoint_
 {
-    u32 LSX_array[WINDOW_WIDTH];  /**< Left Side X array. */
-    u32 RSX_array[WINDOW_WIDTH];  /**< Rigth Side X array. */
-    u32 LSX_i;  /**< Left Side X array index. */
-    u32 RSX_i;  /**< Right Side X array index. */
+    u32 x;  /**< X coordinate of the pixel. */
+    u32 y;  /**< Y coordinate of the pixel. */
+    u32 color;  /**< 32 bit color (ARGB) of the pixel. */
 };
-typedef struct TriangleData_ TriangleData;
+typedef struct RenderPoint_ RenderPoint;
+
+/**
+ * @brief Structure for the render buffer.
+ */
+struct RenderBuffer_
+{
+    u32 width;  /**< Allocated buffer width. */
+    u32 height;  /**< Allocated buffer height. */
+    u32 pitch;  /**< Distance between the rows in bytes. */
+    void *bitmap_memory;  /**< Pointer to the allocated bitmap memory. */
+};
+typedef struct RenderBuffer_ RenderBuffer;
 
 /**
  * @brief Structure for the Render properties.
@@ -60,10 +120,42 @@ struct Render_
     u32 width;  /**< Current width of the graphic window.  */
     u32 height;  /**< Current height of the graphic window. */
     RenderBuffer *buffer;  /**< Pointer to the render buffer. */
-    HWND window;  /**< Handle to the window. */
+#ifdef _WIN32
+    HWND window;  /**< Handle to the window (NULL - headless render). */
     HDC hdc;  /**< Handle to the drawing context. */ 
     BITMAPINFO bitmap_info;  /**< Windows specific bitmapinfo structure. */
-    TriangleData *triangle_data; /**< Pointer to the triangle fill data. */
+#endif
+    RenderRect clip;  /**< Clip rectangle. Pixels outside of it are never written. */
+    RenderTiler *tiler;  /**< Pointer to the tiler (NULL - immediate rendering). */
+    RenderCmdBuffer *cmd_buffer;  /**< Command buffer being recorded (NULL - drawing). */
+    DirtyRects *dirty_rects;  /**< Regions of the buffer changed since the last present. */
+    atomic_s32 is_invalidated;  /**< Flag requesting the present of the whole buffer. */
+    BlendMode blend_mode;  /**< Blend mode of the following drawing calls. */
+    GlyphCache *glyph_cache;  /**< Cache of the rasterized glyphs and strings. */
+    SwapChain *swap_chain;  /**< Swap chain of the buffers (NULL - single buffer). */
+    void *swap_memory[SWAP_CHAIN_BUFFERS_MAX];  /**< Bitmap memory of the chain buffers. */
+    DirtyRects *swap_drawn[SWAP_CHAIN_BUFFERS_MAX];  /**< Regions drawn in the buffer frame. */
+    DirtyRects *swap_stale[SWAP_CHAIN_BUFFERS_MAX];  /**< Regions behind the newest frame. */
+    u32 presented_frame;  /**< Number of the frame presented last (present thread). */
+    Upscaler *upscaler;  /**< Upscaler of the internal resolution (NULL - window size). */
+    RenderLayers *layers;  /**< Layers of the buffer (NULL - drawing into the frame). */
+    RenderLayerId layer;  /**< Layer the commands are executed into. */
+    RenderLayerId cmd_layer;  /**< Layer of the following drawing calls (submitted). */
+    void *frame_memory;  /**< Memory of the frame the layers are composited into. */
+    DirtyRects *frame_dirty_rects;  /**< Regions of the frame changed by the composition. */
+    FrameCapture *capture;  /**< Capture of the presented frames (NULL - not captured). */
+    RenderTarget *target;  /**< Target of the drawing (NULL - the frame or its layer). */
+    RenderBuffer saved_buffer;  /**< Buffer of the frame saved while drawing into target. */
+    RenderRect saved_clip;  /**< Clip rectangle of the frame saved for the target. */
+    DirtyRects *saved_dirty_rects;  /**< Dirty regions of the frame saved for the target. */
+    DirtyRects *target_dirty_rects;  /**< Regions drawn into the target (not presented). */
+    void *batch_memory;  /**< Memory of the batches binned by the submit. */
+    size_t batch_capacity;  /**< Capacity of the batch memory in bytes. */
+    RenderStats *stats;  /**< Statistics of the drawing (NULL - not counted). */
+    RenderStatsExchange *stats_exchange;  /**< Statistics of the frames for the reader. */
+    u32 stats_slot;  /**< Slot of the statistics counters (0 - the render thread). */
+    RenderOcclusion *occlusion;  /**< Covered pixels of the front to back drawing. */
+    b32 is_front_to_back;  /**< Flag of the front to back drawing with the occlusion. */
 };
 typedef struct Render_ Render;
 
@@ -87,23 +179,361 @@ Render_Destructor(Render *render);
  * @param render Poiner to the Render structure.
  * @param window Handle to the game window.
  */
+#ifdef _WIN32
 void
 Render_Init(Render *render, HWND window);
+#endif
 
 /**
- * @brief Processing the resizing of the game window.
+ * @brief Initialization of the render without a window (headless). The frames are
+ * drawn into the plain memory of the render buffer and the present only clears the
+ * changed regions, so the rasterizer runs on any platform (benchmarks, tests).
+ * @param render Poiner to the Render structure.
+ * @param width Width of the frame in pixels.
+ * @param height Height of the frame in pixels.
+ */
+void
+Render_InitHeadless(Render *render, u32 width, u32 height);
+
+/**
+ * @brief Processing the resizing of the game window (nothing for the headless render).
  * @param render Poiner to the Render structure.
  */
 void 
 Render_ResizeWindow(Render *render);
 
 /**
- * @brief Updating the window by stretching DI bits 
+ * @brief Setting the internal resolution of the render buffer, decoupled from the size
+ * of the window. At the present the buffer is scaled to the window by the upscaler
+ * (multithreaded, SIMD) and the output is blitted 1:1. The present thread should not be
+ * running, the content of the buffer is lost.
+ * @param render Pointer to the render structure.
+ * @param width Width of the buffer (0 - the buffer follows the window size).
+ * @param height Height of the buffer (0 - the buffer follows the window size).
+ * @param filter Filter of the upscaler.
+ */
+void
+Render_SetInternalResolution(Render *render, u32 width, u32 height, UpscaleFilter filter);
+
+/**
+ * @brief Mapping a point of the window client area to the pixel of the render buffer
+ * shown there (according to the last presented frame).
+ * @param render Pointer to the render structure.
+ * @param x X coordinate of the window point (from the left).
+ * @param y Y coordinate of the window point (from the bottom).
+ * @param buffer_x X coordinate of the buffer pixel.
+ * @param buffer_y Y coordinate of the buffer pixel.
+ */
+void
+Render_MapWindowPoint(Render *render, s32 x, s32 y, s32 *buffer_x, s32 *buffer_y);
+
+/**
+ * @brief Updating the window by stretching DI bits. Only the dirty regions are
+ * presented, unless the window was invalidated. With the swap chain the frame is only
+ * handed over to the present thread and the drawing continues in the next buffer.
  * @param render Poiner to the Render structure.
  */
 void 
 Render_UpdateWindow(Render *render);
 
+/**
+ * @brief Switching the render to the swap chain of the buffers. Every frame is drawn
+ * into its own buffer, while the previous one is presented by Render_PresentFrame from
+ * another thread. New buffers get the content of the current one.
+ * @param render Pointer to the render structure.
+ * @param buffers_num Amount of the buffers (2 - double, 3 - triple buffering).
+ */
+void
+Render_EnableSwapChain(Render *render, u32 buffers_num);
+
+/**
+ * @brief Switching the render back to the single buffer. The present thread should not
+ * be running.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_DisableSwapChain(Render *render);
+
+/**
+ * @brief Presenting the newest frame of the swap chain (present thread). The window is
+ * updated only when there is a new frame or when the window was invalidated.
+ * @param render Pointer to the render structure.
+ * @return b32 True if a new frame was presented.
+ */
+b32
+Render_PresentFrame(Render *render);
+
+/**
+ * @brief Getting the frame statistics of the swap chain (zeros without it). Could be
+ * called from any thread.
+ * @param render Pointer to the render structure.
+ * @param stats Pointer to the statistics structure to fill.
+ */
+void
+Render_GetSwapChainStats(Render *render, SwapChainStats *stats);
+
+/**
+ * @brief Starting the capture of the frames presented by Render_UpdateWindow. Every
+ * frame is copied into the pool and written by the background thread, the frames not
+ * fitting into the full pool (or of a changed buffer size) are dropped.
+ * @param render Pointer to the render structure.
+ * @param format Format of the output.
+ * @param path Path pattern of the png files, path of the stream file, "-" for the
+ * standard output or "|command" for a pipe to the command.
+ * @param fps Frame rate written to the Y4M header.
+ * @param frames_num Amount of the frames in the pool.
+ */
+void
+Render_StartCapture(Render *render, FrameCaptureFormat format, const char *path, u32 fps,
+    u32 frames_num);
+
+/**
+ * @brief Stopping the capture. Waits for the pooled frames to be written.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_StopCapture(Render *render);
+
+/**
+ * @brief Getting the capture statistics (zeros without the capture). Could be called
+ * from any thread.
+ * @param render Pointer to the render structure.
+ * @param stats Pointer to the statistics structure to fill.
+ */
+void
+Render_GetCaptureStats(Render *render, FrameCaptureStats *stats);
+
+/**
+ * @brief Starting the counting of the render statistics (the counters are zeroed). Every
+ * command is drawn twice more to find the written pixels, so the statistics are for the
+ * debugging only: without RENDER_STATS defined at the compilation nothing is counted.
+ * The frames are finished by Render_UpdateWindow. The start is a command, it is recorded
+ * along with the drawing and applied at its execution.
+ * @param render Pointer to the render structure.
+ * @param is_heatmap Flag of the counting of the writes of every pixel (overdraw).
+ */
+void
+Render_EnableStats(Render *render, b32 is_heatmap);
+
+/**
+ * @brief Stopping the counting of the render statistics (recorded as the start).
+ * @param render Pointer to the render structure.
+ */
+void
+Render_DisableStats(Render *render);
+
+/**
+ * @brief Getting the statistics of the last finished frame (zeros without them). Could
+ * be called by a single thread other than the one executing the drawing.
+ * @param render Pointer to the render structure.
+ * @param stats Pointer to the statistics structure to fill.
+ */
+void
+Render_GetStats(Render *render, RenderFrameStats *stats);
+
+/**
+ * @brief Drawing the heatmap of the writes of the last finished frame over the clip
+ * rectangle (does nothing without the heatmap). The drawing is recorded as the other
+ * commands, the heatmap is not counted itself.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_DrawStatsHeatmap(Render *render);
+
+/**
+ * @brief Requesting the present of the whole buffer on the next window update (for
+ * example when the window was resized or uncovered). Could be called from any thread.
+ * @param render Poiner to the Render structure.
+ */
+void
+Render_InvalidateWindow(Render *render);
+
+/**
+ * @brief Getting the regions of the buffer changed since the last present.
+ * @param render Poiner to the Render structure.
+ * @param rects_num Amount of the returned rectangles.
+ * @return const RenderRect* Array of the dirty rectangles.
+ */
+const RenderRect*
+Render_GetDirtyRects(Render *render, u32 *rects_num);
+
+/**
+ * @brief Forgetting the dirty regions (done by the window update after the present).
+ * @param render Poiner to the Render structure.
+ */
+void
+Render_ClearDirtyRects(Render *render);
+
+/**
+ * @brief Switching the render into the tiled mode. Drawing calls are recorded and
+ * rasterized in parallel by a pool of worker threads at the flush. The result is
+ * identical to the immediate rendering.
+ * @param render Pointer to the render structure.
+ * @param tile_size Width and height of a single tile in pixels (for example 64).
+ * @param threads_num Amount of the rendering threads. Zero - one thread per CPU core.
+ */
+void
+Render_EnableTiling(Render *render, u32 tile_size, u32 threads_num);
+
+/**
+ * @brief Switching the render back into the immediate mode. All the recorded drawing
+ * calls are flushed.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_DisableTiling(Render *render);
+
+/**
+ * @brief Rasterizing all the drawing calls recorded in the tiled mode into the render
+ * buffer. Does nothing in the immediate mode.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_Flush(Render *render);
+
+/**
+ * @brief Switching the render to the drawing into the layers. The content of the frame
+ * becomes the background layer, all the other layers are transparent. The layers are
+ * composited into the frame at the window update (only the changed regions).
+ * @param render Pointer to the render structure.
+ */
+void
+Render_EnableLayers(Render *render);
+
+/**
+ * @brief Switching the render back to the drawing into the frame. Pending changes of
+ * the layers are composited first.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_DisableLayers(Render *render);
+
+/**
+ * @brief Selecting the layer of the following drawing calls (does nothing without the
+ * layers). The change is a command, it is recorded along with the drawing and applied
+ * at its execution (the tiled drawing is flushed into the previous layer then).
+ * @param render Pointer to the render structure.
+ * @param layer Identifier of the layer.
+ */
+void
+Render_SetLayer(Render *render, RenderLayerId layer);
+
+/**
+ * @brief Getting the layer of the following drawing calls.
+ * @param render Pointer to the render structure.
+ * @return RenderLayerId Identifier of the layer.
+ */
+RenderLayerId
+Render_GetLayer(Render *render);
+
+/**
+ * @brief Showing or hiding a layer without redrawing it or the layers beneath (does
+ * nothing without the layers). The change is recorded as the layer selection.
+ * @param render Pointer to the render structure.
+ * @param layer Identifier of the layer.
+ * @param is_visible Flag of the visible layer.
+ */
+void
+Render_SetLayerVisible(Render *render, RenderLayerId layer, b32 is_visible);
+
+/**
+ * @brief Making the current layer transparent (does nothing without the layers).
+ * @param render Pointer to the render structure.
+ */
+void
+Render_ClearLayer(Render *render);
+
+/**
+ * @brief Redirecting all the drawing into the render target. The frame (or the layer)
+ * is not changed until the target is reset, the frame operations (window update, swap
+ * chain, layers, resolution) are not allowed meanwhile. The sprite and the texture of
+ * the image target are compiled again when the target is reset or replaced.
+ * @param render Pointer to the render structure.
+ * @param target Pointer to the render target (NULL - drawing into the frame again).
+ */
+void
+Render_SetTarget(Render *render, RenderTarget *target);
+
+/**
+ * @brief Getting the current render target.
+ * @param render Pointer to the render structure.
+ * @return RenderTarget* Pointer to the render target (NULL - drawing into the frame).
+ */
+RenderTarget*
+Render_GetTarget(Render *render);
+
+/**
+ * @brief Starting to record all the drawing calls into the command buffer instead of
+ * drawing them. Nothing is written to the render buffer until the command buffer is
+ * executed, so the recording could be done by another thread than the rasterization.
+ * @param render Pointer to the render structure.
+ * @param cmd_buffer Pointer to the command buffer to append the commands to.
+ */
+void
+Render_BeginRecording(Render *render, RenderCmdBuffer *cmd_buffer);
+
+/**
+ * @brief Finishing the recording of the drawing calls.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_EndRecording(Render *render);
+
+/**
+ * @brief Beginning of the front to back drawing with the occlusion. The following calls
+ * should be made from the front to the back: pixels covered by the opaque rectangles and
+ * the opaque spans of the images are not written again, so every pixel of the opaque
+ * content is written once. Translucent drawing is deferred and done from the back to
+ * the front by the end of the occlusion, hidden by the opaque content in front of it.
+ * @param render Pointer to the render structure.
+ */
+void
+Render_BeginOcclusion(Render *render);
+
+/**
+ * @brief Finishing the front to back drawing: the deferred drawing is done. Should be
+ * called before the frame is presented (the target and the layer are not changed till
+ * then).
+ * @param render Pointer to the render structure.
+ */
+void
+Render_EndOcclusion(Render *render);
+
+/**
+ * @brief Setting the blend mode of the following drawing calls. The mode is applied to
+ * the rectangles, triangles, images and strings, other primitives are always opaque.
+ * Translucent pixels of the images are blended in any mode (BM_NONE acts as BM_ALPHA).
+ * @param render Pointer to the render structure.
+ * @param blend_mode Blend mode (BM_NONE - colors replace the render buffer pixels).
+ */
+void
+Render_SetBlendMode(Render *render, BlendMode blend_mode);
+
+/**
+ * @brief Getting the blend mode of the following drawing calls.
+ * @param render Pointer to the render structure.
+ * @return BlendMode Current blend mode.
+ */
+BlendMode
+Render_GetBlendMode(Render *render);
+
+/**
+ * @brief Drawing the command regardless of the recording: immediately or through the
+ * tiler. Commands lying outside of the clip rectangle are rejected.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the render command.
+ */
+void
+Render_SubmitCmd(Render *render, const RenderCmd *cmd);
+
+/**
+ * @brief Executing a single render command immediately (respecting the clip rectangle).
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the render command.
+ */
+void
+Render_ExecuteCmd(Render *render, const RenderCmd *cmd);
+
 /**
  * @brief Clearing the full screen with a background color.
  * @param render Pointer to the render structure.
@@ -144,6 +574,51 @@ Render_GetPixelColor(Render *render, u32 x, u32 y, Color *color);
 void 
 Render_DrawLine(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, const Color *color);
 
+/**
+ * @brief Drawing an anti-aliased line one pixel wide (Wu algorithm). The color is
+ * blended by the coverage of the pixels with the current blend mode (no blending is
+ * treated as the alpha one).
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the beginning point of the line.
+ * @param y0 Y coordinate of the beginning point of the line.
+ * @param x1 X coordinate of the ending point of the line.
+ * @param y1 Y coordinate of the ending point of the line.
+ * @param color Pointer to the color structure.
+ */
+void
+Render_DrawLineAA(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, const Color *color);
+
+/**
+ * @brief Drawing a thick line as a quad (two filled triangles) with the butt ends.
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the beginning point of the line.
+ * @param y0 Y coordinate of the beginning point of the line.
+ * @param x1 X coordinate of the ending point of the line.
+ * @param y1 Y coordinate of the ending point of the line.
+ * @param width Width of the line in pixels.
+ * @param color Pointer to the color structure.
+ */
+void
+Render_DrawThickLine(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, f32 width,
+    const Color *color);
+
+/**
+ * @brief Drawing a polyline through the array of points by a single command (graphs,
+ * wireframes). Lines up to one pixel wide are drawn as the pixelized or anti-aliased
+ * lines, thicker ones as the quads with the bevel joins filled together, so the joints
+ * are written (and blended) once. The whole polyline is marked dirty by a single
+ * rectangle, the array is copied when the command is recorded.
+ * @param render Pointer to the render structure.
+ * @param points Pointer to the array of the points.
+ * @param points_num Amount of the points.
+ * @param width Width of the line in pixels.
+ * @param is_anti_aliased Flag of the anti-aliased lines (one pixel wide only).
+ * @param color Pointer to the color structure.
+ */
+void
+Render_DrawPolyline(Render *render, const Vec2 *points, u32 points_num, f32 width,
+    b32 is_anti_aliased, const Color *color);
+
 /**
  * @brief Drawing a pixelized horizontal line from one point to another.
  * @param render Pointer to the render structure.
@@ -206,6 +681,20 @@ Render_DrawRectWithBrd(Render *render, u32 x0, u32 y0, u32 width, u32 height, u3
 void 
 Render_DrawFillTriangle(Render *render, Vec2 v1, Vec2 v2, Vec2 v3, const Color *color);
 
+/**
+ * @brief Drawing a filled polygon of any shape (convex, concave or self-intersecting)
+ * without the triangulation. Every row of the polygon is filled by the spans of the
+ * inside pixels. The vertices are copied when the command is recorded.
+ * @param render Pointer to the render structure.
+ * @param vertices Pointer to the array of the vertices (closed from the last to the first).
+ * @param vertices_num Amount of the vertices.
+ * @param rule Fill rule of the self-intersecting and nested parts.
+ * @param color Pointer to the color structure.
+ */
+void
+Render_DrawPolygon(Render *render, const Vec2 *vertices, u32 vertices_num,
+    PolygonFillRule rule, const Color *color);
+
 /**
  * @brief Drawing a rectangle rotated by specified angle degrees. 
  * @param render Pointer to the render structure.
@@ -221,7 +710,8 @@ Render_DrawRotatedRect(Render *render, f32 x0, f32 y0, f32 width, f32 height, f3
     const Color *color);
 
 /**
- * @brief Drawing a circle using Brezenhame algorithm.
+ * @brief Drawing a circle using Brezenhame algorithm. The filled circle is drawn by a
+ * single span per row and covers its outline.
  * @param render Pointer to the render structure.
  * @param x0 X coordinate of the circle center.
  * @param y0 Y coordinate of the circle center.
@@ -233,6 +723,85 @@ void
 Render_DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled, 
     const Color *color);
 
+/**
+ * @brief Drawing a filled axis-aligned ellipse. Pixels with the centers inside of the
+ * ellipse are covered (the pixel (x, y) has its center at (x + 0.5, y + 0.5)).
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the ellipse center.
+ * @param y0 Y coordinate of the ellipse center.
+ * @param radius_x Horizontal radius of the ellipse.
+ * @param radius_y Vertical radius of the ellipse.
+ * @param color Pointer to the color structure (ellipse color).
+ */
+void
+Render_DrawEllipse(Render *render, f32 x0, f32 y0, f32 radius_x, f32 radius_y,
+    const Color *color);
+
+/**
+ * @brief Drawing a filled ring (circle with a hole). Pixels with the centers between
+ * the outer and the inner circles are covered.
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the ring center.
+ * @param y0 Y coordinate of the ring center.
+ * @param radius Outer radius of the ring.
+ * @param thickness Thickness of the ring (the inner radius is radius - thickness).
+ * @param color Pointer to the color structure (ring color).
+ */
+void
+Render_DrawRing(Render *render, f32 x0, f32 y0, f32 radius, f32 thickness,
+    const Color *color);
+
+/**
+ * @brief Drawing a batch of filled circles (particles, bullets) by a single command.
+ * The result is the same as drawing the circles one by one as the ellipses with equal
+ * radii, but the circles are binned into the bands of rows once and filled band after
+ * band, and the whole batch is marked dirty by a single rectangle. The array is copied
+ * when the command is recorded.
+ * @param render Pointer to the render structure.
+ * @param circles Pointer to the array of the circles.
+ * @param circles_num Amount of the circles.
+ */
+void
+Render_DrawCircles(Render *render, const RenderCircle *circles, u32 circles_num);
+
+/**
+ * @brief Drawing a batch of filled rectangles (tiles, bars, particles) by a single
+ * command. The result is the same as drawing the rectangles one by one, but the
+ * rectangles are binned into the bands of rows once and drawn band after band, and the
+ * whole batch is marked dirty by a single rectangle. The array is copied when the
+ * command is recorded.
+ * @param render Pointer to the render structure.
+ * @param rects Pointer to the array of the rectangles.
+ * @param rects_num Amount of the rectangles.
+ */
+void
+Render_DrawRects(Render *render, const RenderRectInstance *rects, u32 rects_num);
+
+/**
+ * @brief Setting colors of a batch of pixels (scatter plots, particle overlays) by a
+ * single command, the same as Render_SetPixelColor for every point. The points are
+ * binned into the bands of rows once, the whole batch is marked dirty by a single
+ * rectangle. The array is copied when the command is recorded.
+ * @param render Pointer to the render structure.
+ * @param points Pointer to the array of the points.
+ * @param points_num Amount of the points.
+ */
+void
+Render_DrawPoints(Render *render, const RenderPoint *points, u32 points_num);
+
+/**
+ * @brief Setting colors of a batch of pixels given by the separate arrays of the
+ * coordinates and colors (structure of arrays). Same as Render_DrawPoints otherwise.
+ * @param render Pointer to the render structure.
+ * @param xs Pointer to the array of the X coordinates.
+ * @param ys Pointer to the array of the Y coordinates.
+ * @param colors Pointer to the array of the 32 bit colors (ARGB).
+ * @param points_num Amount of the points.
+ */
+void
+Render_DrawPointArrays(Render *render, const u32 *xs, const u32 *ys, const u32 *colors,
+    u32 points_num);
+
 /**
  * @brief Drawing the loaded png image.
  * @param render Pointer to the render structure.
@@ -257,4 +826,109 @@ void
 Render_DrawBitmapByMask(Render *render, u32 x, u32 y, const Image *mask, const Color *color, 
     u32 scale);
 
+/**
+ * @brief Drawing a region of the image (for example, an image packed into an atlas).
+ * @param render Pointer to the render structure.
+ * @param x X coordinate of the bottom-left corner of the region (BL).
+ * @param y Y coordinate of the bottom-left corner of the region (BL).
+ * @param region Pointer to the region of the image to be drawn.
+ * @param scale Scale of the region.
+ */
+void
+Render_DrawBitmapRegion(Render *render, u32 x, u32 y, const ImageRegion *region, u32 scale);
+
+/**
+ * @brief Drawing a region of the image mask using one specified color.
+ * @param render Pointer to the render structure.
+ * @param x X coordinate of the bottom-left corner of the region (BL).
+ * @param y Y coordinate of the bottom-left corner of the region (BL).
+ * @param mask Pointer to the region of the image (mask) to be drawn with a color.
+ * @param color Pointer to the color structure.
+ * @param scale Scale of the region.
+ */
+void
+Render_DrawBitmapRegionByMask(Render *render, u32 x, u32 y, const ImageRegion *mask,
+    const Color *color, u32 scale);
+
+/**
+ * @brief Drawing a triangle mapped with the image texture (affine mapping). The image
+ * has to be compiled into the texture (Image_CompileTexture). The texels are blended
+ * as the image pixels are (BM_NONE is treated as BM_ALPHA).
+ * @param render Pointer to the render structure.
+ * @param image Pointer to the image to be drawn.
+ * @param v1 First vertex of the triangle.
+ * @param v2 Second vertex of the triangle.
+ * @param v3 Third vertex of the triangle.
+ * @param uv1 Texture coordinates of the first vertex (in texels, origin in the BL).
+ * @param uv2 Texture coordinates of the second vertex.
+ * @param uv3 Texture coordinates of the third vertex.
+ * @param filter Filter of the texture sampling.
+ */
+void
+Render_DrawTexturedTriangle(Render *render, const Image *image, Vec2 v1, Vec2 v2, Vec2 v3,
+    Vec2 uv1, Vec2 uv2, Vec2 uv3, TextureFilter filter);
+
+/**
+ * @brief Drawing the image rotated and scaled around its center (rotozoom). The image
+ * has to be compiled into the texture (Image_CompileTexture), so no rotated frames of
+ * the sprite have to be prepared.
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the image center.
+ * @param y0 Y coordinate of the image center.
+ * @param image Pointer to the image to be drawn.
+ * @param angle Angle (in degrees) of the counter-clockwise rotation.
+ * @param scale Scale of the image (any positive value).
+ * @param filter Filter of the texture sampling.
+ */
+void
+Render_DrawRotatedBitmap(Render *render, f32 x0, f32 y0, const Image *image, f32 angle,
+    f32 scale, TextureFilter filter);
+
+/**
+ * @brief Drawing the image scaled by any positive factors (zoomed views). The image has
+ * to be compiled into the texture (Image_CompileTexture). The pixels with the centers
+ * inside of the scaled image are drawn, the texels are blended as the image pixels are.
+ * Integer scales with the nearest filter give the same pixels as Render_DrawBitmap.
+ * @param render Pointer to the render structure.
+ * @param x X coordinate of the bottom-left corner of the scaled image (BL).
+ * @param y Y coordinate of the bottom-left corner of the scaled image (BL).
+ * @param image Pointer to the image to be drawn.
+ * @param scale_x Horizontal scale of the image.
+ * @param scale_y Vertical scale of the image.
+ * @param filter Filter of the texture sampling.
+ */
+void
+Render_DrawScaledBitmap(Render *render, f32 x, f32 y, const Image *image, f32 scale_x,
+    f32 scale_y, TextureFilter filter);
+
+/**
+ * @brief Drawing a region of the image scaled by any positive factors. The bilinear
+ * filter does not sample the texels outside of the region (atlases).
+ * @param render Pointer to the render structure.
+ * @param x X coordinate of the bottom-left corner of the scaled region (BL).
+ * @param y Y coordinate of the bottom-left corner of the scaled region (BL).
+ * @param region Pointer to the region of the image to be drawn.
+ * @param scale_x Horizontal scale of the region.
+ * @param scale_y Vertical scale of the region.
+ * @param filter Filter of the texture sampling.
+ */
+void
+Render_DrawScaledBitmapRegion(Render *render, f32 x, f32 y, const ImageRegion *region,
+    f32 scale_x, f32 scale_y, TextureFilter filter);
+
+/**
+ * @brief Drawing a string with the specified font.
+ * @param render Pointer to the render structure.
+ * @param font Pointer to the font.
+ * @param str Null terminated string to be drawn.
+ * @param str_max_width Maximum width of the string in pixels (0 - unlimited).
+ * @param x X coordinate of the BL corner of the first symbol.
+ * @param y Y coordinate of the BL corner of the first symbol.
+ * @param size Size of a single symbol pixel.
+ * @param color Pointer to the color structure.
+ */
+void
+Render_DrawString(Render *render, const Font *font, const char *str, s32 str_max_width,
+    u32 x, u32 y, u32 size, const Color *color);
+
 #endif  /* JEMA_ENGINE_RENDER_H_ */
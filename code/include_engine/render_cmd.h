@@ -0,0 +1,242 @@
+/**
+ * ================================================================================
+ * @file include_engine/render_cmd.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of the render commands. Every drawing call of the Render is
+ * described by a single command, so it could be executed immediately as well as
+ * recorded and executed later.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_RENDER_CMD_H_
+#define JEMA_ENGINE_RENDER_CMD_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/polygon_raster.h"
+#include "include_engine/texture.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+typedef struct Font_ Font;
+typedef struct Image_ Image;
+typedef struct RenderCircle_ RenderCircle;
+typedef struct RenderPoint_ RenderPoint;
+typedef struct RenderRectInstance_ RenderRectInstance;
+typedef struct TextRun_ TextRun;
+
+/**
+ * @brief Enumerator for the types of the render commands.
+ */
+enum RenderCmdType_
+{
+    RCT_CLEAR,  /**< Clearing the full screen. */
+    RCT_PIXEL,  /**< Setting color of a single pixel. */
+    RCT_LINE,  /**< Drawing a pixelized line. */
+    RCT_RECT,  /**< Drawing a filled rectangle. */
+    RCT_TRIANGLE,  /**< Drawing a filled triangle. */
+    RCT_CIRCLE,  /**< Drawing a circle. */
+    RCT_BITMAP,  /**< Drawing an image. */
+    RCT_BITMAP_MASK,  /**< Drawing an image mask with a single color. */
+    RCT_TEXT,  /**< Drawing a string with the font. */
+    RCT_ELLIPSE,  /**< Drawing a filled ellipse or a ring. */
+    RCT_LINE_AA,  /**< Drawing an anti-aliased line. */
+    RCT_TEXTURE,  /**< Drawing a texture mapped triangle or parallelogram. */
+    RCT_POLYGON,  /**< Drawing a filled polygon. */
+    RCT_RECTS,  /**< Drawing a batch of filled rectangles. */
+    RCT_POINTS,  /**< Setting colors of a batch of pixels. */
+    RCT_BITMAP_SCALED,  /**< Drawing an image scaled by any positive factors. */
+    RCT_CIRCLES,  /**< Drawing a batch of filled circles. */
+    RCT_POLYLINE,  /**< Drawing a polyline through an array of points. */
+    RCT_LAYER,  /**< Changing the state of the render layers. */
+    RCT_STATS,  /**< Changing the render statistics or drawing their heatmap. */
+    RCT_TYPES_NUM  /**< Amount of the command types. */
+};
+typedef enum RenderCmdType_ RenderCmdType;
+
+/**
+ * @brief Enumerator for the actions of the RCT_LAYER command.
+ */
+enum RenderLayerAction_
+{
+    RLA_SELECT,  /**< Selecting the layer of the following commands. */
+    RLA_SET_VISIBLE,  /**< Showing or hiding the layer. */
+    RLA_CLEAR,  /**< Making the layer transparent. */
+    RLA_ACTIONS_NUM  /**< Amount of the layer actions. */
+};
+typedef enum RenderLayerAction_ RenderLayerAction;
+
+/**
+ * @brief Enumerator for the actions of the RCT_STATS command.
+ */
+enum RenderStatsAction_
+{
+    RSA_ENABLE,  /**< Starting the counting of the statistics. */
+    RSA_DISABLE,  /**< Stopping the counting of the statistics. */
+    RSA_DRAW_HEATMAP,  /**< Drawing the heatmap of the last finished frame. */
+    RSA_ACTIONS_NUM  /**< Amount of the statistics actions. */
+};
+typedef enum RenderStatsAction_ RenderStatsAction;
+
+/**
+ * @brief Structure for a single render command.
+ */
+struct RenderCmd_
+{
+    RenderCmdType type;  /**< Type of the command. */
+    BlendMode blend;  /**< Blend mode (filled shapes, AA lines, images and strings). */
+    u32 color;  /**< 32 bit color (ARGB) of the command. */
+    union
+    {
+        struct
+        {
+            u32 x;  /**< X coordinate of the pixel. */
+            u32 y;  /**< Y coordinate of the pixel. */
+        } pixel;  /**< Data of the RCT_PIXEL command. */
+
+        struct
+        {
+            f32 x0;  /**< X coordinate of the beginning point. */
+            f32 y0;  /**< Y coordinate of the beginning point. */
+            f32 x1;  /**< X coordinate of the ending point. */
+            f32 y1;  /**< Y coordinate of the ending point. */
+        } line;  /**< Data of the RCT_LINE and RCT_LINE_AA commands. */
+
+        struct
+        {
+            u32 x0;  /**< X coordinate of the BL corner. */
+            u32 y0;  /**< Y coordinate of the BL corner. */
+            u32 width;  /**< Width of the rectangle. */
+            u32 height;  /**< Height of the rectangle. */
+        } rect;  /**< Data of the RCT_RECT command. */
+
+        struct
+        {
+            Vec2 v1;  /**< First vertex of the triangle. */
+            Vec2 v2;  /**< Second vertex of the triangle. */
+            Vec2 v3;  /**< Third vertex of the triangle. */
+        } triangle;  /**< Data of the RCT_TRIANGLE command. */
+
+        struct
+        {
+            const Vec2 *vertices;  /**< Vertices (copied when the command is recorded). */
+            u32 vertices_num;  /**< Amount of the vertices. */
+            PolygonFillRule rule;  /**< Fill rule of the polygon. */
+        } polygon;  /**< Data of the RCT_POLYGON command. */
+
+        struct
+        {
+            const Vec2 *points;  /**< Points (copied when the command is recorded). */
+            u32 points_num;  /**< Amount of the points. */
+            f32 width;  /**< Width of the line in pixels. */
+            b32 is_anti_aliased;  /**< Flag of the anti-aliased lines (one pixel wide). */
+        } polyline;  /**< Data of the RCT_POLYLINE command. */
+
+        struct
+        {
+            const RenderRectInstance *rects;  /**< Rectangles (band parts if binned). */
+            u32 rects_num;  /**< Amount of the rectangles. */
+            const u32 *band_offsets;  /**< Offsets of the bands (NULL - not binned). */
+            u32 bands_num;  /**< Amount of the bands. */
+        } rects;  /**< Data of the RCT_RECTS command (copied when recorded). */
+
+        struct
+        {
+            const RenderPoint *points;  /**< Points (NULL - the separate arrays). */
+            const u32 *xs;  /**< X coordinates of the separate arrays. */
+            const u32 *ys;  /**< Y coordinates of the separate arrays. */
+            const u32 *colors;  /**< Colors (ARGB) of the separate arrays. */
+            u32 points_num;  /**< Amount of the points. */
+            const u32 *band_offsets;  /**< Offsets of the bands (NULL - not binned). */
+            u32 bands_num;  /**< Amount of the bands. */
+        } points;  /**< Data of the RCT_POINTS command (copied when recorded). */
+
+        struct
+        {
+            const RenderCircle *circles;  /**< Circles (band copies if binned). */
+            u32 circles_num;  /**< Amount of the circles. */
+            const u32 *band_offsets;  /**< Offsets of the bands (NULL - not binned). */
+            u32 bands_num;  /**< Amount of the bands. */
+        } circles;  /**< Data of the RCT_CIRCLES command (copied when recorded). */
+
+        struct
+        {
+            f32 x0;  /**< X coordinate of the circle center. */
+            f32 y0;  /**< Y coordinate of the circle center. */
+            f32 radius;  /**< Radius of the circle. */
+            b32 is_filled;  /**< Flag indicating the fill of the circle. */
+        } circle;  /**< Data of the RCT_CIRCLE command. */
+
+        struct
+        {
+            f32 x0;  /**< X coordinate of the ellipse center. */
+            f32 y0;  /**< Y coordinate of the ellipse center. */
+            f32 radius_x;  /**< Horizontal radius of the ellipse. */
+            f32 radius_y;  /**< Vertical radius of the ellipse. */
+            f32 thickness;  /**< Thickness of the ring (0 - filled ellipse). */
+        } ellipse;  /**< Data of the RCT_ELLIPSE command. */
+
+        struct
+        {
+            u32 x;  /**< X coordinate of the BL corner of the image. */
+            u32 y;  /**< Y coordinate of the BL corner of the image. */
+            u32 scale;  /**< Scale of the image. */
+            u32 src_x;  /**< X coordinate of the BL corner of the drawn image region. */
+            u32 src_y;  /**< Y coordinate of the BL corner of the drawn image region. */
+            u32 width;  /**< Width of the drawn image region. */
+            u32 height;  /**< Height of the drawn image region. */
+            const Image *image;  /**< Pointer to the image (must live until execution). */
+        } bitmap;  /**< Data of the RCT_BITMAP and RCT_BITMAP_MASK commands. */
+
+        struct
+        {
+            Vec2 vertices[3];  /**< Vertices (quad: a corner and its neighbours). */
+            Vec2 uvs[3];  /**< Texture coordinates of the vertices (in texels). */
+            b32 is_quad;  /**< Flag of the parallelogram (otherwise a triangle). */
+            TextureFilter filter;  /**< Filter of the texture sampling. */
+            const Image *image;  /**< Pointer to the image (must live until execution). */
+        } texture;  /**< Data of the RCT_TEXTURE command. */
+
+        struct
+        {
+            f32 x;  /**< X coordinate of the BL corner of the scaled image. */
+            f32 y;  /**< Y coordinate of the BL corner of the scaled image. */
+            f32 scale_x;  /**< Horizontal scale of the image. */
+            f32 scale_y;  /**< Vertical scale of the image. */
+            u32 src_x;  /**< X coordinate of the BL corner of the drawn image region. */
+            u32 src_y;  /**< Y coordinate of the BL corner of the drawn image region. */
+            u32 width;  /**< Width of the drawn image region. */
+            u32 height;  /**< Height of the drawn image region. */
+            TextureFilter filter;  /**< Filter of the texture sampling. */
+            const Image *image;  /**< Pointer to the image (must live until execution). */
+        } scaled;  /**< Data of the RCT_BITMAP_SCALED command. */
+
+        struct
+        {
+            u32 x;  /**< X coordinate of the BL corner of the first symbol. */
+            u32 y;  /**< Y coordinate of the BL corner of the first symbol. */
+            u32 size;  /**< Size of a single symbol pixel. */
+            s32 max_width;  /**< Maximum width of the string in pixels (0 - unlimited). */
+            const Font *font;  /**< Pointer to the font (must live until execution). */
+            const char *str;  /**< Null terminated string (must live until execution). */
+            const TextRun *run;  /**< Cached layout of the string (set by the submit). */
+        } text;  /**< Data of the RCT_TEXT command. */
+
+        struct
+        {
+            u32 layer;  /**< Identifier of the layer (RenderLayerId). */
+            u32 action;  /**< Action with the layer (RenderLayerAction). */
+            b32 is_visible;  /**< Flag of the visible layer (RLA_SET_VISIBLE). */
+        } layer;  /**< Data of the RCT_LAYER command. */
+
+        struct
+        {
+            u32 action;  /**< Action with the statistics (RenderStatsAction). */
+            b32 is_heatmap;  /**< Flag of the counting of the heatmap (RSA_ENABLE). */
+        } stats;  /**< Data of the RCT_STATS command. */
+    };
+};
+typedef struct RenderCmd_ RenderCmd;
+
+#endif  /* JEMA_ENGINE_RENDER_CMD_H_ */
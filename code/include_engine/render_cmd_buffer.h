@@ -0,0 +1,239 @@
+/**
+ * ================================================================================
+ * @file include_engine/render_cmd_buffer.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the work with the
+ * recorded render command buffer. The buffer is a compact description of a single
+ * frame: commands are packed one after another into an arena which is reused from
+ * frame to frame. The buffer could be serialized together with all the images and
+ * fonts it refers to and replayed later.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_RENDER_CMD_BUFFER_H_
+#define JEMA_ENGINE_RENDER_CMD_BUFFER_H_
+
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+typedef struct Font_ Font;
+typedef struct Image_ Image;
+typedef struct MemObject_ MemObject;
+typedef struct Render_ Render;
+typedef struct RenderCmd_ RenderCmd;
+
+#define RENDER_CMD_BUFFER_MAGIC 0x4243524a  /* Serialized buffer signature ("JRCB"). */
+#define RENDER_CMD_BUFFER_VERSION 12  /* Version of the serialized buffer format. */
+
+/**
+ * @brief Structure for the header of a packed command. The header is followed by the
+ * data of the command: the corresponding member of the RenderCmd for the geometry
+ * commands, RenderCmdBitmapData for the images, RenderCmdScaledData for the scaled
+ * images, RenderCmdTextureData for the texture mapped shapes, RenderCmdPolygonData for
+ * the polygons, RenderCmdPolylineData for the polylines, RenderCmdBatchData for the
+ * batches and RenderCmdTextData for the strings.
+ */
+struct RenderCmdHeader_
+{
+    u8 type;  /**< Type of the command (RenderCmdType). */
+    u8 blend;  /**< Blend mode of the command (BlendMode). */
+    u16 reserved;  /**< Not used (zero). */
+    u32 size;  /**< Size of the packed command in bytes (header included, 4 aligned). */
+    u32 color;  /**< 32 bit color (ARGB) of the command. */
+};
+typedef struct RenderCmdHeader_ RenderCmdHeader;
+
+/**
+ * @brief Structure for the packed data of the RCT_BITMAP and RCT_BITMAP_MASK commands.
+ */
+struct RenderCmdBitmapData_
+{
+    u32 x;  /**< X coordinate of the BL corner of the image. */
+    u32 y;  /**< Y coordinate of the BL corner of the image. */
+    u32 scale;  /**< Scale of the image. */
+    u32 src_x;  /**< X coordinate of the BL corner of the drawn image region. */
+    u32 src_y;  /**< Y coordinate of the BL corner of the drawn image region. */
+    u32 width;  /**< Width of the drawn image region. */
+    u32 height;  /**< Height of the drawn image region. */
+    u32 image_index;  /**< Index of the image in the images table of the buffer. */
+};
+typedef struct RenderCmdBitmapData_ RenderCmdBitmapData;
+
+/**
+ * @brief Structure for the packed data of the RCT_BITMAP_SCALED command.
+ */
+struct RenderCmdScaledData_
+{
+    f32 x;  /**< X coordinate of the BL corner of the scaled image. */
+    f32 y;  /**< Y coordinate of the BL corner of the scaled image. */
+    f32 scale_x;  /**< Horizontal scale of the image. */
+    f32 scale_y;  /**< Vertical scale of the image. */
+    u32 src_x;  /**< X coordinate of the BL corner of the drawn image region. */
+    u32 src_y;  /**< Y coordinate of the BL corner of the drawn image region. */
+    u32 width;  /**< Width of the drawn image region. */
+    u32 height;  /**< Height of the drawn image region. */
+    u32 filter;  /**< Filter of the texture sampling (TextureFilter). */
+    u32 image_index;  /**< Index of the image in the images table of the buffer. */
+};
+typedef struct RenderCmdScaledData_ RenderCmdScaledData;
+
+/**
+ * @brief Structure for the packed data of the RCT_TEXTURE command.
+ */
+struct RenderCmdTextureData_
+{
+    Vec2 vertices[3];  /**< Vertices (quad: a corner and its neighbours). */
+    Vec2 uvs[3];  /**< Texture coordinates of the vertices (in texels). */
+    u32 is_quad;  /**< Flag of the parallelogram (otherwise a triangle). */
+    u32 filter;  /**< Filter of the texture sampling (TextureFilter). */
+    u32 image_index;  /**< Index of the image in the images table of the buffer. */
+};
+typedef struct RenderCmdTextureData_ RenderCmdTextureData;
+
+/**
+ * @brief Structure for the packed data of the RCT_POLYGON command. The vertices follow
+ * the structure.
+ */
+struct RenderCmdPolygonData_
+{
+    u32 rule;  /**< Fill rule of the polygon (PolygonFillRule). */
+    u32 vertices_num;  /**< Amount of the vertices. */
+};
+typedef struct RenderCmdPolygonData_ RenderCmdPolygonData;
+
+/**
+ * @brief Structure for the packed data of the RCT_POLYLINE command. The points follow
+ * the structure.
+ */
+struct RenderCmdPolylineData_
+{
+    f32 width;  /**< Width of the line in pixels. */
+    u32 is_anti_aliased;  /**< Flag of the anti-aliased lines. */
+    u32 points_num;  /**< Amount of the points. */
+};
+typedef struct RenderCmdPolylineData_ RenderCmdPolylineData;
+
+/**
+ * @brief Structure for the packed data of the RCT_RECTS, RCT_POINTS and RCT_CIRCLES
+ * commands. The instances (RenderRectInstance, RenderPoint or RenderCircle) follow the
+ * structure, large batches are split into several commands.
+ */
+struct RenderCmdBatchData_
+{
+    u32 instances_num;  /**< Amount of the instances. */
+};
+typedef struct RenderCmdBatchData_ RenderCmdBatchData;
+
+/**
+ * @brief Structure for the packed data of the RCT_TEXT command. The null terminated
+ * string follows the structure.
+ */
+struct RenderCmdTextData_
+{
+    u32 x;  /**< X coordinate of the BL corner of the first symbol. */
+    u32 y;  /**< Y coordinate of the BL corner of the first symbol. */
+    u32 size;  /**< Size of a single symbol pixel. */
+    s32 max_width;  /**< Maximum width of the string in pixels (0 - unlimited). */
+    u32 font_index;  /**< Index of the font in the fonts table of the buffer. */
+    u32 length;  /**< Length of the string without the terminating null. */
+};
+typedef struct RenderCmdTextData_ RenderCmdTextData;
+
+/**
+ * @brief Structure for the RenderCmdBuffer object.
+ */
+struct RenderCmdBuffer_
+{
+    u8 *data;  /**< Arena with the packed commands. */
+    u32 size;  /**< Used size of the arena in bytes. */
+    u32 capacity;  /**< Capacity of the arena in bytes. */
+    u32 cmds_num;  /**< Amount of the recorded commands. */
+    const Image **images;  /**< Table of the images referred by the commands. */
+    u32 images_num;  /**< Amount of the images in the table. */
+    u32 images_capacity;  /**< Capacity of the images table. */
+    const Font **fonts;  /**< Table of the fonts referred by the commands. */
+    u32 fonts_num;  /**< Amount of the fonts in the table. */
+    u32 fonts_capacity;  /**< Capacity of the fonts table. */
+    b32 is_owner;  /**< Flag indicating that the images and fonts belong to the buffer. */
+};
+typedef struct RenderCmdBuffer_ RenderCmdBuffer;
+
+/**
+ * @brief Object constructor.
+ * @return RenderCmdBuffer* Pointer to the RenderCmdBuffer structure.
+ */
+RenderCmdBuffer*
+RenderCmdBuffer_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @return RenderCmdBuffer* Pointer to the RenderCmdBuffer structure.
+ */
+RenderCmdBuffer*
+RenderCmdBuffer_Destructor(RenderCmdBuffer *cmd_buffer);
+
+/**
+ * @brief Object initialization. Allocation of the arena.
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param capacity Initial capacity of the arena in bytes (grows when necessary).
+ */
+void
+RenderCmdBuffer_Init(RenderCmdBuffer *cmd_buffer, u32 capacity);
+
+/**
+ * @brief Removing all the commands while keeping the allocated memory for the next frame.
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ */
+void
+RenderCmdBuffer_Reset(RenderCmdBuffer *cmd_buffer);
+
+/**
+ * @brief Packing the command at the end of the buffer. Images and fonts are referred by
+ * pointers, so they should live until the buffer is executed or serialized.
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param cmd Pointer to the command.
+ */
+void
+RenderCmdBuffer_PushCmd(RenderCmdBuffer *cmd_buffer, const RenderCmd *cmd);
+
+/**
+ * @brief Drawing all the recorded commands in order.
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param render Pointer to the render (should not record into the same buffer).
+ */
+void
+RenderCmdBuffer_Execute(RenderCmdBuffer *cmd_buffer, Render *render);
+
+/**
+ * @brief Unpacking of a single recorded command. Arrays and strings of the command point
+ * into the buffer, so they are valid until the buffer is reset.
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param offset Offset of the command in the arena in bytes.
+ * @param cmd Pointer to the unpacked command.
+ * @return u32 Offset of the next command.
+ */
+u32
+RenderCmdBuffer_ReadCmd(const RenderCmdBuffer *cmd_buffer, u32 offset, RenderCmd *cmd);
+
+/**
+ * @brief Serialization of the buffer with all the referred images and fonts into the
+ * memory object (which could be written to disc).
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param mem_object Pointer to the empty memory object.
+ */
+void
+RenderCmdBuffer_Serialize(RenderCmdBuffer *cmd_buffer, MemObject *mem_object);
+
+/**
+ * @brief Initialization of the buffer by the serialized data. The images and fonts are
+ * restored and belong to the buffer.
+ * @param cmd_buffer Pointer to the empty RenderCmdBuffer structure.
+ * @param mem_object Pointer to the memory object with the serialized buffer.
+ */
+void
+RenderCmdBuffer_InitByMemObject(RenderCmdBuffer *cmd_buffer, MemObject *mem_object);
+
+#endif  /* JEMA_ENGINE_RENDER_CMD_BUFFER_H_ */
@@ -0,0 +1,101 @@
+/**
+ * ================================================================================
+ * @file include_engine/render_layers.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the drawing into separate
+ * layers of the render buffer size. Every layer has its own bitmap memory (colors with
+ * the premultiplied alpha, zero - transparent) and its own dirty regions. The visible
+ * layers are composited into the frame from the bottom to the top, only within the
+ * regions changed since the previous composition, so the layers which are not drawn
+ * into cost nothing.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_RENDER_LAYERS_H_
+#define JEMA_ENGINE_RENDER_LAYERS_H_
+
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+typedef struct DirtyRects_ DirtyRects;
+
+/**
+ * @brief Structure for a single render layer.
+ */
+struct RenderLayer_
+{
+    void *memory;  /**< Bitmap memory of the layer. */
+    DirtyRects *dirty_rects;  /**< Regions changed since the last composition. */
+    RenderRect bounds;  /**< Bounds of the pixels drawn since the last clear. */
+    b32 is_visible;  /**< Flag of the layer taking part in the composition. */
+};
+typedef struct RenderLayer_ RenderLayer;
+
+/**
+ * @brief Structure for the RenderLayers object.
+ */
+struct RenderLayers_
+{
+    RenderLayer layers[RL_LAYERS_NUM];  /**< Layers from the bottom to the top. */
+    u32 width;  /**< Width of the layers. */
+    u32 height;  /**< Height of the layers. */
+};
+typedef struct RenderLayers_ RenderLayers;
+
+/**
+ * @brief Object constructor.
+ * @return RenderLayers* Pointer to the RenderLayers structure.
+ */
+RenderLayers*
+RenderLayers_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param layers Pointer to the RenderLayers structure.
+ * @return RenderLayers* Pointer to the RenderLayers structure.
+ */
+RenderLayers*
+RenderLayers_Destructor(RenderLayers *layers);
+
+/**
+ * @brief Object initialization. All the layers are visible and transparent.
+ * @param layers Pointer to the RenderLayers structure.
+ * @param width Width of the layers.
+ * @param height Height of the layers.
+ */
+void
+RenderLayers_Init(RenderLayers *layers, u32 width, u32 height);
+
+/**
+ * @brief Showing or hiding the layer. The pixels of the layer are composited (or
+ * uncovered) at the next composition.
+ * @param layers Pointer to the RenderLayers structure.
+ * @param id Identifier of the layer.
+ * @param is_visible Flag of the visible layer.
+ */
+void
+RenderLayers_SetVisible(RenderLayers *layers, RenderLayerId id, b32 is_visible);
+
+/**
+ * @brief Making all the pixels of the layer transparent. Only the bounds of the drawn
+ * pixels (composited or not yet) are cleared.
+ * @param layers Pointer to the RenderLayers structure.
+ * @param id Identifier of the layer.
+ */
+void
+RenderLayers_Clear(RenderLayers *layers, RenderLayerId id);
+
+/**
+ * @brief Compositing the visible layers into the frame within the dirty regions of
+ * all the layers. The composited regions are added to the dirty regions of the frame,
+ * the dirty regions of the layers are cleared.
+ * @param layers Pointer to the RenderLayers structure.
+ * @param frame Pointer to the bitmap memory of the frame (size of the layers).
+ * @param frame_dirty_rects Dirty regions of the frame.
+ */
+void
+RenderLayers_Composite(RenderLayers *layers, void *frame, DirtyRects *frame_dirty_rects);
+
+#endif  /* JEMA_ENGINE_RENDER_LAYERS_H_ */
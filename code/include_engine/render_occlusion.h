@@ -0,0 +1,157 @@
+/**
+ * ================================================================================
+ * @file include_engine/render_occlusion.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions for the occlusion of the drawing submitted
+ * from the front to the back. Every row of the buffer keeps the sorted spans of the
+ * pixels already covered by the opaque content (s-buffer), so only the uncovered parts
+ * of the following commands are drawn. Commands which are not opaque are kept with their
+ * uncovered parts and drawn from the back to the front at the end.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_RENDER_OCCLUSION_H_
+#define JEMA_ENGINE_RENDER_OCCLUSION_H_
+
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+typedef struct RenderCmd_ RenderCmd;
+typedef struct RenderCmdBuffer_ RenderCmdBuffer;
+
+/**
+ * @brief Structure for a covered span of a row [x0, x1).
+ */
+struct RenderOcclusionSpan_
+{
+    s32 x0;  /**< X coordinate of the first covered pixel. */
+    s32 x1;  /**< X coordinate after the last covered pixel. */
+};
+typedef struct RenderOcclusionSpan_ RenderOcclusionSpan;
+
+/**
+ * @brief Structure for the covered spans of a row.
+ */
+struct RenderOcclusionRow_
+{
+    RenderOcclusionSpan *spans;  /**< Sorted spans (neither overlap nor touch). */
+    u32 spans_num;  /**< Amount of the spans. */
+    u32 capacity;  /**< Capacity of the spans array. */
+};
+typedef struct RenderOcclusionRow_ RenderOcclusionRow;
+
+/**
+ * @brief Structure for a command deferred till the end of the front to back drawing.
+ */
+struct RenderOcclusionCmd_
+{
+    u32 offset;  /**< Offset of the command in the command buffer. */
+    u32 first_rect;  /**< Index of the first uncovered rectangle of the command. */
+    u32 rects_num;  /**< Amount of the uncovered rectangles. */
+};
+typedef struct RenderOcclusionCmd_ RenderOcclusionCmd;
+
+/**
+ * @brief Structure for the RenderOcclusion object.
+ */
+struct RenderOcclusion_
+{
+    RenderOcclusionRow *rows;  /**< Covered spans of every row of the buffer. */
+    u32 rows_num;  /**< Amount of the rows (height of the buffer). */
+    RenderRect *rects;  /**< Uncovered rectangles of the last command bounds. */
+    u32 rects_num;  /**< Amount of the uncovered rectangles. */
+    u32 rects_capacity;  /**< Capacity of the uncovered rectangles array. */
+    RenderCmdBuffer *cmd_buffer;  /**< Copies of the deferred commands. */
+    RenderOcclusionCmd *cmds;  /**< Deferred commands (in the submit order). */
+    u32 cmds_num;  /**< Amount of the deferred commands. */
+    u32 cmds_capacity;  /**< Capacity of the deferred commands array. */
+    RenderRect *cmds_rects;  /**< Uncovered rectangles of all the deferred commands. */
+    u32 cmds_rects_num;  /**< Amount of the rectangles of the deferred commands. */
+    u32 cmds_rects_capacity;  /**< Capacity of the deferred rectangles array. */
+};
+typedef struct RenderOcclusion_ RenderOcclusion;
+
+/**
+ * @brief Object constructor.
+ * @return RenderOcclusion* Pointer to the RenderOcclusion structure.
+ */
+RenderOcclusion*
+RenderOcclusion_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @return RenderOcclusion* Pointer to the RenderOcclusion structure.
+ */
+RenderOcclusion*
+RenderOcclusion_Destructor(RenderOcclusion *occlusion);
+
+/**
+ * @brief Beginning of the front to back drawing: nothing is covered, no commands are
+ * deferred. The memory of the previous drawing is reused.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @param height Height of the buffer being drawn into.
+ */
+void
+RenderOcclusion_Begin(RenderOcclusion *occlusion, u32 height);
+
+/**
+ * @brief Getting the parts of the bounds which are not covered yet. Rows with the same
+ * uncovered spans are joined into the rectangles, so a few rectangles are returned for
+ * the rectangular coverage.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @param bounds Pointer to the bounds of the command (inside of the buffer).
+ * @param rects_num Pointer to the amount of the rectangles.
+ * @return const RenderRect* Uncovered rectangles (valid until the next call).
+ */
+const RenderRect*
+RenderOcclusion_GetUncoveredRects(RenderOcclusion *occlusion, const RenderRect *bounds,
+    u32 *rects_num);
+
+/**
+ * @brief Covering a span of a row. The span is merged with the covered spans it
+ * overlaps or touches.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @param y Y coordinate of the row.
+ * @param x0 X coordinate of the first pixel.
+ * @param x1 X coordinate after the last pixel.
+ */
+void
+RenderOcclusion_CoverSpan(RenderOcclusion *occlusion, s32 y, s32 x0, s32 x1);
+
+/**
+ * @brief Covering a rectangle.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @param rect Pointer to the rectangle (inside of the buffer).
+ */
+void
+RenderOcclusion_CoverRect(RenderOcclusion *occlusion, const RenderRect *rect);
+
+/**
+ * @brief Deferring a command which could not be drawn before the content behind it. The
+ * command is copied along with its arrays, so it could be submitted with the transient
+ * ones.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @param cmd Pointer to the command (batches should not be binned).
+ * @param rects Uncovered rectangles the command is drawn in.
+ * @param rects_num Amount of the rectangles.
+ */
+void
+RenderOcclusion_DeferCmd(RenderOcclusion *occlusion, const RenderCmd *cmd,
+    const RenderRect *rects, u32 rects_num);
+
+/**
+ * @brief Getting a deferred command.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @param index Index of the command (in the submit order).
+ * @param cmd Pointer to the command (its arrays point into the occlusion).
+ * @param rects_num Pointer to the amount of the rectangles the command is drawn in.
+ * @return const RenderRect* Rectangles the command is drawn in.
+ */
+const RenderRect*
+RenderOcclusion_GetDeferredCmd(RenderOcclusion *occlusion, u32 index, RenderCmd *cmd,
+    u32 *rects_num);
+
+#endif  /* JEMA_ENGINE_RENDER_OCCLUSION_H_ */
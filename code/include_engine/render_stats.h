@@ -0,0 +1,256 @@
+/**
+ * ================================================================================
+ * @file include_engine/render_stats.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions for the statistics of the render: the
+ * counters of every command type (calls, pixels written and rejected, time of the
+ * rasterization) and the heatmap of the writes of every pixel of the frame. The
+ * counting is compiled into the render only with RENDER_STATS defined (the debug
+ * builds), the span and pixel kernels report the pixels they store into the buffer of
+ * the command executed by the thread, so every command is still executed once. The
+ * statistics of the finished frames are handed over to the reader thread by the
+ * exchange of three buffers.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_RENDER_STATS_H_
+#define JEMA_ENGINE_RENDER_STATS_H_
+
+#include "include_engine/atomic.h"
+#include "include_engine/render_cmd.h"
+#include "include_engine/utils.h"
+
+typedef struct RenderRect_ RenderRect;
+
+#define RENDER_STATS_HEAT_COLORS 8  /* Amount of the heatmap colors (last - 7+ writes). */
+#define RENDER_STATS_FRESH 0x100  /* Slot flag of the published frame not read yet. */
+
+/* Counting of the pixels stored by the kernels, compiled out without RENDER_STATS. */
+#ifdef RENDER_STATS
+#define RENDER_STATS_COUNT_ROW(dst, count) RenderStats_CountWrites((dst), 0, (count), 1)
+#define RENDER_STATS_COUNT_RECT(dst, pitch, width, height) \
+    RenderStats_CountWrites((dst), (pitch), (width), (height))
+#else
+#define RENDER_STATS_COUNT_ROW(dst, count) ((void)0)
+#define RENDER_STATS_COUNT_RECT(dst, pitch, width, height) ((void)0)
+#endif
+
+/**
+ * @brief Structure for the counters of a command type.
+ */
+struct RenderStatsCounters_
+{
+    u64 calls;  /**< Amount of the submitted commands. */
+    u64 culled;  /**< Amount of the commands rejected entirely by the clip rectangle. */
+    u64 pixels_written;  /**< Amount of the pixels stored by the commands. */
+    u64 pixels_overdrawn;  /**< Written pixels already written in the frame (heatmap). */
+    u64 pixels_rejected;  /**< Pixels of the command bounds outside of the clip. */
+    u64 time_ns;  /**< Time of the rasterization with the counting (all the threads). */
+};
+typedef struct RenderStatsCounters_ RenderStatsCounters;
+
+/**
+ * @brief Structure for the statistics of a whole frame.
+ */
+struct RenderFrameStats_
+{
+    u64 frame;  /**< Number of the frame (from the enabling of the statistics). */
+    RenderStatsCounters types[RCT_TYPES_NUM];  /**< Counters of every command type. */
+    RenderStatsCounters total;  /**< Sum of the counters of all the types. */
+    u32 pixels_touched;  /**< Pixels of the frame written at least once (heatmap). */
+    u32 max_writes;  /**< Maximum amount of the writes of a pixel (heatmap). */
+};
+typedef struct RenderFrameStats_ RenderFrameStats;
+
+/**
+ * @brief Structure for the RenderStats object.
+ */
+struct RenderStats_
+{
+    RenderStatsCounters *slots;  /**< Counters of the render thread and the tiler workers. */
+    u32 slots_num;  /**< Amount of the slots (RCT_TYPES_NUM counters each). */
+    b32 is_heatmap;  /**< Flag of the counting of the writes of every pixel. */
+    u32 width;  /**< Width of the heatmap (frame). */
+    u32 height;  /**< Height of the heatmap (frame). */
+    u32 *heat;  /**< Writes of every pixel of the current frame. */
+    u32 *last_heat;  /**< Writes of every pixel of the last finished frame. */
+    RenderFrameStats last;  /**< Statistics of the last finished frame. */
+};
+typedef struct RenderStats_ RenderStats;
+
+/**
+ * @brief Structure for the RenderStatsExchange object. The render thread writes the
+ * back buffer and publishes it into the shared slot, the reader takes the fresh one
+ * from the slot in exchange for its front buffer (as the buffers of the swap chain).
+ */
+struct RenderStatsExchange_
+{
+    RenderFrameStats frames[3];  /**< Buffers of the frame statistics. */
+    s32 back;  /**< Index of the buffer owned by the render thread. */
+    s32 front;  /**< Index of the buffer owned by the reader. */
+    atomic_s32 slot;  /**< Index of the shared buffer with the fresh flag. */
+};
+typedef struct RenderStatsExchange_ RenderStatsExchange;
+
+/**
+ * @brief Object constructor.
+ * @return RenderStats* Pointer to the RenderStats structure.
+ */
+RenderStats*
+RenderStats_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param stats Pointer to the RenderStats structure.
+ * @return RenderStats* Pointer to the RenderStats structure.
+ */
+RenderStats*
+RenderStats_Destructor(RenderStats *stats);
+
+/**
+ * @brief Object initialization. All the counters are zeroed.
+ * @param stats Pointer to the RenderStats structure.
+ * @param width Width of the frame.
+ * @param height Height of the frame.
+ * @param is_heatmap Flag of the counting of the writes of every pixel.
+ */
+void
+RenderStats_Init(RenderStats *stats, u32 width, u32 height, b32 is_heatmap);
+
+/**
+ * @brief Reserving the counters for the render thread (slot 0) and the tiler workers.
+ * Should not be called while the commands are executed.
+ * @param stats Pointer to the RenderStats structure.
+ * @param slots_num Amount of the slots.
+ */
+void
+RenderStats_ReserveSlots(RenderStats *stats, u32 slots_num);
+
+/**
+ * @brief Getting the counters of the command type of a slot.
+ * @param stats Pointer to the RenderStats structure.
+ * @param slot Index of the slot.
+ * @param type Type of the command.
+ * @return RenderStatsCounters* Pointer to the counters.
+ */
+RenderStatsCounters*
+RenderStats_GetCounters(RenderStats *stats, u32 slot, RenderCmdType type);
+
+/**
+ * @brief Beginning of the execution of a command by the calling thread: the writes
+ * counted till the end of it are added to the counters (the tiler workers execute their
+ * commands at once, every one into its own tile).
+ * @param stats Pointer to the RenderStats structure.
+ * @param counters Pointer to the counters of the command.
+ * @param memory Pointer to the pixel (0, 0) of the buffer being drawn into.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param height Height of the buffer.
+ * @param is_frame Flag of the drawing into the frame (not into a render target).
+ */
+void
+RenderStats_BeginCmd(RenderStats *stats, RenderStatsCounters *counters, void *memory,
+    u32 pitch, u32 height, b32 is_frame);
+
+/**
+ * @brief End of the execution of the command by the calling thread.
+ */
+void
+RenderStats_EndCmd(void);
+
+/**
+ * @brief Counting the pixels of a block stored by a kernel (RENDER_STATS_COUNT_ROW and
+ * RENDER_STATS_COUNT_RECT). Only the writes into the buffer of the command executed by
+ * the calling thread are counted, the heatmap is updated for the frame. Every store is
+ * a write, even the one keeping the value (a fully transparent blend).
+ * @param dst Pointer to the first pixel of the block.
+ * @param pitch Distance between two rows of the block in bytes (unused for a row).
+ * @param width Width of the block in pixels.
+ * @param height Height of the block in pixels.
+ */
+void
+RenderStats_CountWrites(const void *dst, u32 pitch, u32 width, u32 height);
+
+/**
+ * @brief Finishing the frame: the counters of all the slots and the heatmap become the
+ * statistics of the last frame and are zeroed for the next one.
+ * @param stats Pointer to the RenderStats structure.
+ * @param width Width of the frame (the heatmap is reallocated if it is changed).
+ * @param height Height of the frame.
+ */
+void
+RenderStats_NextFrame(RenderStats *stats, u32 width, u32 height);
+
+/**
+ * @brief Drawing the heatmap of the last frame: black - no writes, then blue, cyan,
+ * green, yellow, orange, red and white for 7 and more writes.
+ * @param stats Pointer to the RenderStats structure.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer of the frame size.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ */
+void
+RenderStats_DrawHeatmap(const RenderStats *stats, void *memory, u32 pitch,
+    const RenderRect *clip);
+
+/**
+ * @brief Object constructor.
+ * @return RenderStatsExchange* Pointer to the RenderStatsExchange structure.
+ */
+RenderStatsExchange*
+RenderStatsExchange_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param exchange Pointer to the RenderStatsExchange structure.
+ * @return RenderStatsExchange* Pointer to the RenderStatsExchange structure.
+ */
+RenderStatsExchange*
+RenderStatsExchange_Destructor(RenderStatsExchange *exchange);
+
+/**
+ * @brief Object initialization. All the buffers are zeroed, none of them is fresh.
+ * @param exchange Pointer to the RenderStatsExchange structure.
+ */
+void
+RenderStatsExchange_Init(RenderStatsExchange *exchange);
+
+/**
+ * @brief Publishing the statistics of a frame (the render thread only). A fresh frame
+ * not read yet is replaced.
+ * @param exchange Pointer to the RenderStatsExchange structure.
+ * @param stats Pointer to the statistics of the frame.
+ */
+void
+RenderStatsExchange_Publish(RenderStatsExchange *exchange, const RenderFrameStats *stats);
+
+/**
+ * @brief Reading the statistics of the last published frame (a single reader thread).
+ * @param exchange Pointer to the RenderStatsExchange structure.
+ * @param stats Pointer to the statistics structure to fill.
+ */
+void
+RenderStatsExchange_Read(RenderStatsExchange *exchange, RenderFrameStats *stats);
+
+/**
+ * @brief Getting the name of the command type (for the printing).
+ * @param type Type of the command.
+ * @return const char* Name of the type.
+ */
+const char*
+RenderStats_GetTypeName(RenderCmdType type);
+
+/**
+ * @brief Formatting the counters as a single line: name, calls, written, overdrawn and
+ * rejected pixels, time in microseconds.
+ * @param counters Pointer to the counters.
+ * @param name Name of the counters.
+ * @param str Buffer for the line.
+ * @param size Size of the buffer (the line is truncated).
+ */
+void
+RenderStats_Format(const RenderStatsCounters *counters, const char *name, char *str,
+    u32 size);
+
+#endif  /* JEMA_ENGINE_RENDER_STATS_H_ */
@@ -0,0 +1,112 @@
+/**
+ * ================================================================================
+ * @file include_engine/render_target.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the work with the render
+ * targets. A target is a rectangle of 32 bit premultiplied ARGB pixels with an explicit
+ * distance between the rows: an own buffer (rows aligned to 64 bytes), an image, a
+ * foreign memory or a sub-view of another target. All the render primitives could draw
+ * into a target (see Render_SetTarget).
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_RENDER_TARGET_H_
+#define JEMA_ENGINE_RENDER_TARGET_H_
+
+#include "include_engine/utils.h"
+
+#define RENDER_TARGET_ALIGNMENT 64  /* Alignment of the rows of the own buffer in bytes. */
+
+typedef struct Image_ Image;
+
+/**
+ * @brief Structure for the RenderTarget object.
+ */
+struct RenderTarget_
+{
+    u32 width;  /**< Width of the target in pixels. */
+    u32 height;  /**< Height of the target in pixels. */
+    u32 pitch;  /**< Distance between the rows in bytes. */
+    void *memory;  /**< Pointer to the BL pixel of the target. */
+    void *allocation;  /**< Own memory of the target (NULL - the memory is not owned). */
+    Image *image;  /**< Image the target draws into (NULL - not an image). */
+};
+typedef struct RenderTarget_ RenderTarget;
+
+/**
+ * @brief Object constructor.
+ * @return RenderTarget* Pointer to the RenderTarget structure.
+ */
+RenderTarget*
+RenderTarget_Constructor(void);
+
+/**
+ * @brief Object destructor. Only the own memory is freed, the sub-views of the target
+ * should not be used after it.
+ * @param target Pointer to the RenderTarget structure.
+ * @return RenderTarget* Pointer to the RenderTarget structure.
+ */
+RenderTarget*
+RenderTarget_Destructor(RenderTarget *target);
+
+/**
+ * @brief Object initialization by the own zero filled buffer. The pitch is rounded up
+ * to RENDER_TARGET_ALIGNMENT and the memory is aligned to it, so every row starts at
+ * the aligned address.
+ * @param target Pointer to the RenderTarget structure.
+ * @param width Width of the target in pixels.
+ * @param height Height of the target in pixels.
+ */
+void
+RenderTarget_Init(RenderTarget *target, u32 width, u32 height);
+
+/**
+ * @brief Object initialization by the foreign memory (it should live longer than the
+ * target).
+ * @param target Pointer to the RenderTarget structure.
+ * @param memory Pointer to the BL pixel of the 32 bit premultiplied ARGB pixels.
+ * @param width Width of the target in pixels.
+ * @param height Height of the target in pixels.
+ * @param pitch Distance between the rows in bytes (at least width * 4).
+ */
+void
+RenderTarget_InitByMemory(RenderTarget *target, void *memory, u32 width, u32 height,
+    u32 pitch);
+
+/**
+ * @brief Object initialization by the image. The image is converted to
+ * PF_BGRA_PREMULTIPLIED (the format of the drawing), its sprite and texture are
+ * compiled again when the drawing into the target is over.
+ * @param target Pointer to the RenderTarget structure.
+ * @param image Pointer to the image (should not be drawn into itself).
+ */
+void
+RenderTarget_InitByImage(RenderTarget *target, Image *image);
+
+/**
+ * @brief Object initialization by the rectangle of another target (the rectangle is
+ * clipped by the parent). The view shares the memory of the parent.
+ * @param target Pointer to the RenderTarget structure.
+ * @param parent Pointer to the parent target.
+ * @param x X coordinate of the BL corner of the rectangle in the parent.
+ * @param y Y coordinate of the BL corner of the rectangle in the parent.
+ * @param width Width of the rectangle.
+ * @param height Height of the rectangle.
+ */
+void
+RenderTarget_InitSubView(RenderTarget *target, const RenderTarget *parent, u32 x, u32 y,
+    u32 width, u32 height);
+
+/**
+ * @brief Getting the address of the pixel of the target.
+ * @param target Pointer to the RenderTarget structure.
+ * @param x X coordinate of the pixel.
+ * @param y Y coordinate of the pixel.
+ * @return u32* Pointer to the pixel.
+ */
+u32*
+RenderTarget_GetPixelAddress(const RenderTarget *target, u32 x, u32 y);
+
+#endif  /* JEMA_ENGINE_RENDER_TARGET_H_ */
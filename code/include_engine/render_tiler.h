@@ -0,0 +1,92 @@
+/**
+ * ================================================================================
+ * @file include_engine/render_tiler.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the tile-binned
+ * multithreaded rendering. Recorded commands are binned into screen tiles and the
+ * tiles are rasterized in parallel, every tile is owned by a single worker.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_RENDER_TILER_H_
+#define JEMA_ENGINE_RENDER_TILER_H_
+
+#include "include_engine/utils.h"
+
+typedef struct JobPool_ JobPool;
+typedef struct Render_ Render;
+typedef struct RenderCmd_ RenderCmd;
+typedef struct RenderRect_ RenderRect;
+
+/**
+ * @brief Structure for the RenderTiler object.
+ */
+struct RenderTiler_
+{
+    u32 tile_size;  /**< Width and height of a single tile in pixels. */
+    u32 tiles_x;  /**< Amount of tiles along the Ox axis. */
+    u32 tiles_y;  /**< Amount of tiles along the Oy axis. */
+    RenderCmd *cmds;  /**< Array of the recorded commands. */
+    RenderRect *cmds_bounds;  /**< Array of the screen bounds of the recorded commands. */
+    u32 cmds_num;  /**< Amount of the recorded commands. */
+    u32 cmds_capacity;  /**< Capacity of the commands arrays. */
+    u8 *arrays;  /**< Copies of the arrays referred by the recorded commands. */
+    size_t arrays_size;  /**< Used size of the arrays memory in bytes. */
+    size_t arrays_capacity;  /**< Capacity of the arrays memory in bytes. */
+    u32 *bin_offsets;  /**< Offsets of the tile bins in the bin_cmds array. */
+    u32 bins_capacity;  /**< Capacity of the bin_offsets array. */
+    u32 *bin_cmds;  /**< Command indices of all the bins (bin after bin). */
+    u32 bin_cmds_capacity;  /**< Capacity of the bin_cmds array. */
+    JobPool *job_pool;  /**< Pointer to the pool of the worker threads. */
+    Render *workers;  /**< Array of the per worker render contexts. */
+    u32 workers_num;  /**< Amount of the worker render contexts. */
+    Render *render;  /**< Pointer to the render being flushed. */
+};
+typedef struct RenderTiler_ RenderTiler;
+
+/**
+ * @brief Object constructor.
+ * @return RenderTiler* Pointer to the RenderTiler structure.
+ */
+RenderTiler*
+RenderTiler_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param tiler Pointer to the RenderTiler structure.
+ * @return RenderTiler* Pointer to the RenderTiler structure.
+ */
+RenderTiler*
+RenderTiler_Destructor(RenderTiler *tiler);
+
+/**
+ * @brief Object initialization. Starting the worker threads.
+ * @param tiler Pointer to the RenderTiler structure.
+ * @param tile_size Width and height of a single tile in pixels.
+ * @param threads_num Amount of the worker threads. Zero - one thread per CPU core.
+ */
+void
+RenderTiler_Init(RenderTiler *tiler, u32 tile_size, u32 threads_num);
+
+/**
+ * @brief Recording a command for the current frame. The arrays of the polygons and
+ * batches are copied, so they are not required to live until the flush.
+ * @param tiler Pointer to the RenderTiler structure.
+ * @param cmd Pointer to the command.
+ * @param bounds Pointer to the screen bounds of the command (clipped, not empty).
+ */
+void
+RenderTiler_PushCmd(RenderTiler *tiler, const RenderCmd *cmd, const RenderRect *bounds);
+
+/**
+ * @brief Binning and rasterizing all the recorded commands into the render buffer.
+ * The output is identical to the immediate execution of the commands.
+ * @param tiler Pointer to the RenderTiler structure.
+ * @param render Pointer to the Render structure.
+ */
+void
+RenderTiler_Flush(RenderTiler *tiler, Render *render);
+
+#endif  /* JEMA_ENGINE_RENDER_TILER_H_ */
@@ -0,0 +1,67 @@
+/**
+ * ================================================================================
+ * @file include_engine/scale_raster.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for the blitting of the image regions scaled by any
+ * positive (non-integer) factors. Source texels of every column and every row of the
+ * destination are found once per blit and kept in the tables, so the rows are copied by
+ * the table lookups only. Rows mapped to the same source row are copied from the previous
+ * destination row.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_SCALE_RASTER_H_
+#define JEMA_ENGINE_SCALE_RASTER_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/texture.h"
+#include "include_engine/utils.h"
+
+#define SCALE_RASTER_STACK_WORDS 4096  /* Words of the tables kept without allocation. */
+
+/**
+ * @brief Getting the pixels covered by the scaled region: the pixels with the centers
+ * inside of the rectangle [x, x + width * scale_x) x [y, y + height * scale_y). Far away
+ * pixels are clamped to the guard band of the triangle raster.
+ * @param x X coordinate of the BL corner of the scaled region.
+ * @param y Y coordinate of the BL corner of the scaled region.
+ * @param width Width of the region in texels.
+ * @param height Height of the region in texels.
+ * @param scale_x Horizontal scale of the region.
+ * @param scale_y Vertical scale of the region.
+ * @param rect Pointer to the rectangle of the covered pixels.
+ * @return b32 False if no pixel is covered or the parameters are not valid.
+ */
+b32
+ScaleRaster_GetRect(f32 x, f32 y, u32 width, u32 height, f32 scale_x, f32 scale_y,
+    RenderRect *rect);
+
+/**
+ * @brief Blitting a region of the texture scaled by the factors. The nearest filter takes
+ * the texel under the pixel center, the bilinear one interpolates between the texel
+ * centers (clamped to the edges of the region, so the neighbour regions of an atlas are
+ * never sampled). The pixels do not depend on the clip rectangle (tiles).
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param texture Pointer to the texture.
+ * @param x X coordinate of the BL corner of the scaled region.
+ * @param y Y coordinate of the BL corner of the scaled region.
+ * @param src_x X coordinate of the BL corner of the region of the texture.
+ * @param src_y Y coordinate of the BL corner of the region of the texture.
+ * @param width Width of the region in texels.
+ * @param height Height of the region in texels.
+ * @param scale_x Horizontal scale of the region.
+ * @param scale_y Vertical scale of the region.
+ * @param filter Filter of the texture sampling.
+ * @param blend Blend mode (BM_NONE is treated as BM_ALPHA, as for the images).
+ */
+void
+ScaleRaster_Blit(void *memory, u32 pitch, const RenderRect *clip, const Texture *texture,
+    f32 x, f32 y, u32 src_x, u32 src_y, u32 width, u32 height, f32 scale_x, f32 scale_y,
+    TextureFilter filter, BlendMode blend);
+
+#endif  /* JEMA_ENGINE_SCALE_RASTER_H_ */
@@ -0,0 +1,91 @@
+/**
+ * ================================================================================
+ * @file include_engine/span_fill.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for filling horizontal spans of 32 bit pixels.
+ * Kernels are selected at runtime according to the instruction set of the CPU.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_SPAN_FILL_H_
+#define JEMA_ENGINE_SPAN_FILL_H_
+
+#include "include_engine/utils.h"
+
+/**
+ * @brief Enumerator for the instruction sets of the span fill kernels.
+ */
+enum SpanFillIsa_
+{
+    SFI_SCALAR,  /**< Plain C kernels (fallback). */
+    SFI_SSE2,  /**< Kernels with 128 bit SSE2 stores. */
+    SFI_AVX2,  /**< Kernels with 256 bit AVX2 stores. */
+    SFI_ISA_NUM  /**< Total amount of the instruction sets. */
+};
+typedef enum SpanFillIsa_ SpanFillIsa;
+
+/**
+ * @brief Detection of the CPU features and selection of the fastest kernels.
+ * Before the call the scalar kernels are used.
+ */
+void
+SpanFill_Init(void);
+
+/**
+ * @brief Getting the instruction set of the currently selected kernels.
+ * @return SpanFillIsa Current instruction set.
+ */
+SpanFillIsa
+SpanFill_GetIsa(void);
+
+/**
+ * @brief Forcing the kernels of the specified instruction set (benchmarks).
+ * @param isa Desired instruction set.
+ * @return b32 False if the instruction set is not supported by the CPU.
+ */
+b32
+SpanFill_SetIsa(SpanFillIsa isa);
+
+/**
+ * @brief Getting the human readable name of the instruction set.
+ * @param isa Instruction set.
+ * @return const char* Name of the instruction set.
+ */
+const char*
+SpanFill_GetIsaName(SpanFillIsa isa);
+
+/**
+ * @brief Filling a single span of pixels with a value.
+ * @param dst Pointer to the first pixel of the span.
+ * @param count Amount of pixels in the span.
+ * @param value 32 bit value (color) to fill with.
+ */
+void
+SpanFill_Row(u32 *dst, u32 count, u32 value);
+
+/**
+ * @brief Filling a rectangular block of pixels with a value.
+ * @param dst Pointer to the first pixel of the block.
+ * @param pitch Distance between two rows of the block in bytes.
+ * @param width Width of the block in pixels.
+ * @param height Height of the block in pixels.
+ * @param value 32 bit value (color) to fill with.
+ */
+void
+SpanFill_Rect(void *dst, u32 pitch, u32 width, u32 height, u32 value);
+
+/**
+ * @brief Filling a large block of pixels (full screen clear). Non-temporal stores
+ * are used for the blocks which don't fit into the CPU cache.
+ * @param dst Pointer to the first pixel of the block.
+ * @param pitch Distance between two rows of the block in bytes.
+ * @param width Width of the block in pixels.
+ * @param height Height of the block in pixels.
+ * @param value 32 bit value (color) to fill with.
+ */
+void
+SpanFill_Clear(void *dst, u32 pitch, u32 width, u32 height, u32 value);
+
+#endif  /* JEMA_ENGINE_SPAN_FILL_H_ */
@@ -0,0 +1,74 @@
+/**
+ * ================================================================================
+ * @file include_engine/sprite.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the work with the compiled
+ * sprites. Every row of an image is stored as a list of the opaque and translucent
+ * spans with the pixels already converted to the render buffer format (premultiplied
+ * alpha), so the transparent pixels are skipped, the opaque ones are copied by whole
+ * spans and only the translucent ones are blended.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_SPRITE_H_
+#define JEMA_ENGINE_SPRITE_H_
+
+#include "include_engine/utils.h"
+
+typedef struct Image_ Image;
+
+/**
+ * @brief Structure for a span of the visible pixels in a row of the sprite.
+ */
+struct SpriteSpan_
+{
+    u32 x;  /**< X coordinate of the first pixel of the span in the row. */
+    u32 length;  /**< Amount of pixels in the span. */
+    u32 offset;  /**< Index of the first pixel of the span in the pixels array. */
+    b32 is_opaque;  /**< Flag of the fully opaque pixels (otherwise translucent). */
+};
+typedef struct SpriteSpan_ SpriteSpan;
+
+/**
+ * @brief Structure for the Sprite object.
+ */
+struct Sprite_
+{
+    u32 width;  /**< Width of the sprite in pixels. */
+    u32 height;  /**< Height of the sprite in pixels. */
+    SpriteSpan *spans;  /**< Visible spans of all the rows (row after row). */
+    u32 spans_num;  /**< Total amount of the visible spans. */
+    u32 *row_spans;  /**< Index of the first span of every row (height + 1 items). */
+    u32 *pixels;  /**< Pixels (ARGB, premultiplied alpha) of all the spans. */
+    u32 pixels_num;  /**< Total amount of the visible pixels. */
+};
+typedef struct Sprite_ Sprite;
+
+/**
+ * @brief Object constructor.
+ * @return Sprite* Pointer to the Sprite structure.
+ */
+Sprite*
+Sprite_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param sprite Pointer to the Sprite structure.
+ * @return Sprite* Pointer to the Sprite structure.
+ */
+Sprite*
+Sprite_Destructor(Sprite *sprite);
+
+/**
+ * @brief Compilation of the sprite from the image. Pixels with the zero alpha channel
+ * are skipped, the spans are split where the pixels change from the fully opaque
+ * ones to the translucent ones.
+ * @param sprite Pointer to the Sprite structure.
+ * @param image Pointer to the image.
+ */
+void
+Sprite_InitByImage(Sprite *sprite, const Image *image);
+
+#endif  /* JEMA_ENGINE_SPRITE_H_ */
@@ -0,0 +1,126 @@
+/**
+ * ================================================================================
+ * @file include_engine/swap_chain.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the handoff of the frame
+ * buffers between a producer (drawing) thread and a consumer (presenting) thread. The
+ * chain only manages the buffer indices, so it does not depend on the buffers memory.
+ * The producer owns the back buffer, the consumer owns the front buffer, the remaining
+ * buffer (if any) sits in the shared slot. Buffers change hands by an atomic exchange
+ * of the slot, no locks are taken.
+ * Double buffering: the producer waits for the consumer to take every frame (no
+ * frames are dropped). Triple buffering: the producer never waits, a frame not taken
+ * before the next one is published is dropped.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_SWAP_CHAIN_H_
+#define JEMA_ENGINE_SWAP_CHAIN_H_
+
+#include "include_engine/atomic.h"
+#include "include_engine/utils.h"
+
+#define SWAP_CHAIN_BUFFERS_MAX 3  /* Maximum amount of the buffers in the chain. */
+#define SWAP_CHAIN_NONE -1  /* Index meaning the absence of the buffer. */
+#define SWAP_CHAIN_FRESH 0x100  /* Slot flag of the published frame not taken yet. */
+
+/**
+ * @brief Structure for the SwapChain object.
+ */
+struct SwapChain_
+{
+    u32 buffers_num;  /**< Amount of the buffers in the chain (2 or 3). */
+    s32 back;  /**< Index of the buffer owned by the producer (SWAP_CHAIN_NONE - none). */
+    s32 front;  /**< Index of the buffer owned by the consumer. */
+    atomic_s32 slot;  /**< Index of the shared buffer with the fresh flag (or NONE). */
+    u32 frames[SWAP_CHAIN_BUFFERS_MAX];  /**< Number of the frame stored in every buffer. */
+    atomic_s32 frames_published;  /**< Amount of the frames published by the producer. */
+    atomic_s32 frames_presented;  /**< Amount of the frames taken by the consumer. */
+    atomic_s32 frames_dropped;  /**< Amount of the frames replaced before being taken. */
+    atomic_s32 frames_repeated;  /**< Amount of the consumer ticks without a new frame. */
+};
+typedef struct SwapChain_ SwapChain;
+
+/**
+ * @brief Structure for the statistics of the swap chain.
+ */
+struct SwapChainStats_
+{
+    u32 frames_published;  /**< Amount of the frames published by the producer. */
+    u32 frames_presented;  /**< Amount of the frames taken by the consumer. */
+    u32 frames_dropped;  /**< Amount of the frames replaced before being taken. */
+    u32 frames_repeated;  /**< Amount of the consumer ticks without a new frame. */
+};
+typedef struct SwapChainStats_ SwapChainStats;
+
+/**
+ * @brief Object constructor.
+ * @return SwapChain* Pointer to the SwapChain structure.
+ */
+SwapChain*
+SwapChain_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param swap_chain Pointer to the SwapChain structure.
+ * @return SwapChain* Pointer to the SwapChain structure.
+ */
+SwapChain*
+SwapChain_Destructor(SwapChain *swap_chain);
+
+/**
+ * @brief Object initialization. The producer starts with the buffer 1, the consumer
+ * starts with the buffer 0 (frame 0, which is the initial content of all the buffers).
+ * @param swap_chain Pointer to the SwapChain structure.
+ * @param buffers_num Amount of the buffers (2 - double, 3 - triple buffering).
+ */
+void
+SwapChain_Init(SwapChain *swap_chain, u32 buffers_num);
+
+/**
+ * @brief Publishing the back buffer as the newest frame (producer side). The producer
+ * gets the buffer from the shared slot in exchange, if there is one.
+ * @param swap_chain Pointer to the SwapChain structure.
+ * @return s32 Index of the published buffer.
+ */
+s32
+SwapChain_Publish(SwapChain *swap_chain);
+
+/**
+ * @brief Getting the back buffer to draw the next frame into (producer side). Does not
+ * wait: with the double buffering there is no back buffer until the consumer takes the
+ * published frame.
+ * @param swap_chain Pointer to the SwapChain structure.
+ * @return s32 Index of the back buffer or SWAP_CHAIN_NONE.
+ */
+s32
+SwapChain_AcquireBack(SwapChain *swap_chain);
+
+/**
+ * @brief Getting the back buffer, yielding the thread until it is available.
+ * @param swap_chain Pointer to the SwapChain structure.
+ * @return s32 Index of the back buffer.
+ */
+s32
+SwapChain_WaitBack(SwapChain *swap_chain);
+
+/**
+ * @brief Taking the newest published frame as the front buffer (consumer side). The
+ * previous front buffer is given back through the shared slot.
+ * @param swap_chain Pointer to the SwapChain structure.
+ * @return b32 True if a new frame was taken, false if the front buffer is repeated.
+ */
+b32
+SwapChain_AcquireFront(SwapChain *swap_chain);
+
+/**
+ * @brief Getting the frame statistics (could be called from any thread).
+ * @param swap_chain Pointer to the SwapChain structure.
+ * @param stats Pointer to the statistics structure to fill.
+ */
+void
+SwapChain_GetStats(SwapChain *swap_chain, SwapChainStats *stats);
+
+#endif  /* JEMA_ENGINE_SWAP_CHAIN_H_ */
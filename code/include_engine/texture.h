@@ -0,0 +1,87 @@
+/**
+ * ================================================================================
+ * @file include_engine/texture.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the work with the
+ * textures. The texture is a copy of the image pixels converted to the render buffer
+ * format (premultiplied alpha) for the sampling by the transformed drawing. The texels
+ * are addressed through the column and row offset tables, so the memory layout (linear
+ * rows or the tiles in Morton order) is hidden from the samplers.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_TEXTURE_H_
+#define JEMA_ENGINE_TEXTURE_H_
+
+#include "include_engine/utils.h"
+
+typedef struct Image_ Image;
+
+#define TEXTURE_TILE_SIZE 8  /* Size of the square tiles of the tiled layout. */
+
+/**
+ * @brief Enumerator for the memory layouts of the texels.
+ */
+enum TextureLayout_
+{
+    TL_LINEAR,  /**< Rows of texels one after another (as in the image). */
+    TL_TILED,  /**< Square tiles row by row, texels of a tile in Morton (Z) order. */
+    TL_LAYOUTS_NUM  /**< Total amount of the layouts. */
+};
+typedef enum TextureLayout_ TextureLayout;
+
+/**
+ * @brief Enumerator for the filters of the texture sampling.
+ */
+enum TextureFilter_
+{
+    TF_NEAREST,  /**< Texel with the center nearest to the sample point. */
+    TF_BILINEAR,  /**< Interpolation between four texels around the sample point. */
+    TF_FILTERS_NUM  /**< Total amount of the filters. */
+};
+typedef enum TextureFilter_ TextureFilter;
+
+/**
+ * @brief Structure for the Texture object.
+ */
+struct Texture_
+{
+    u32 width;  /**< Width of the texture in texels. */
+    u32 height;  /**< Height of the texture in texels. */
+    TextureLayout layout;  /**< Memory layout of the texels. */
+    b32 is_opaque;  /**< Flag of all the texels being fully opaque. */
+    u32 *texels;  /**< Texels (ARGB, premultiplied alpha) in the layout order. */
+    u32 *column_offsets;  /**< Offset of every column (width items). */
+    u32 *row_offsets;  /**< Offset of every row (height items). */
+};
+typedef struct Texture_ Texture;
+
+/**
+ * @brief Object constructor.
+ * @return Texture* Pointer to the Texture structure.
+ */
+Texture*
+Texture_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param texture Pointer to the Texture structure.
+ * @return Texture* Pointer to the Texture structure.
+ */
+Texture*
+Texture_Destructor(Texture *texture);
+
+/**
+ * @brief Initialization of the texture by the image pixels. The texel (x, y) is found
+ * at texels[column_offsets[x] + row_offsets[y]] for any layout.
+ * @param texture Pointer to the Texture structure.
+ * @param image Pointer to the image.
+ * @param layout Memory layout of the texels. The tiled one keeps the neighbouring rows
+ * close in memory, so rotated sampling touches fewer cache lines.
+ */
+void
+Texture_InitByImage(Texture *texture, const Image *image, TextureLayout layout);
+
+#endif  /* JEMA_ENGINE_TEXTURE_H_ */
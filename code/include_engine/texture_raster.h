@@ -0,0 +1,47 @@
+/**
+ * ================================================================================
+ * @file include_engine/texture_raster.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for the rasterization of the affine texture mapped
+ * triangles and quads. The covered pixels are found exactly as for the filled triangles
+ * (same fixed point grid and fill rule), every row is a single span with the texture
+ * coordinates stepped in fixed point from pixel to pixel.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_TEXTURE_RASTER_H_
+#define JEMA_ENGINE_TEXTURE_RASTER_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/texture.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#define TEXTURE_RASTER_UV_BITS 24  /* Fractional bits of the texture coordinates. */
+#define TEXTURE_RASTER_VERTICES_MAX 4  /* Maximal amount of the polygon vertices. */
+
+/**
+ * @brief Filling a convex polygon (triangle or quad) with the texture. The texture
+ * coordinates are an affine function of the screen position defined by the first three
+ * vertices, the texels outside of the texture are clamped to its edges. The texture
+ * coordinates of every pixel are found in integers from the pixel position, so the
+ * pixels do not depend on the clip rectangle (tiles).
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param texture Pointer to the texture.
+ * @param vertices Vertices of the polygon (in order, any winding).
+ * @param uvs Texture coordinates of the vertices (in texels, origin in the BL corner).
+ * @param vertices_num Amount of the vertices (3 or 4).
+ * @param filter Filter of the texture sampling.
+ * @param blend Blend mode (BM_NONE is treated as BM_ALPHA, as for the images).
+ */
+void
+TextureRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, const Texture *texture,
+    const Vec2 *vertices, const Vec2 *uvs, u32 vertices_num, TextureFilter filter,
+    BlendMode blend);
+
+#endif  /* JEMA_ENGINE_TEXTURE_RASTER_H_ */
@@ -0,0 +1,44 @@
+/**
+ * ================================================================================
+ * @file include_engine/triangle_raster.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of functions for the rasterization of the filled triangles by
+ * the edge functions (half-space rasterizer). Vertices are snapped to the fixed point
+ * grid, pixels are sampled at their centers and the top-left fill rule is applied, so
+ * triangles sharing an edge neither overlap nor leave gaps.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_TRIANGLE_RASTER_H_
+#define JEMA_ENGINE_TRIANGLE_RASTER_H_
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#define TRIANGLE_RASTER_SUBPIXEL_BITS 4  /* Fractional bits of the vertex coordinates. */
+#define TRIANGLE_RASTER_BLOCK_SIZE 8  /* Size of the square blocks of the traversal. */
+#define TRIANGLE_RASTER_GUARD_BAND 32768.0f  /* Vertices beyond are clipped geometrically. */
+
+/**
+ * @brief Filling a triangle. The blocks of pixels are tested against the triangle as a
+ * whole: the outside blocks are skipped, the inside blocks are filled by spans and
+ * only the blocks crossed by the edges are tested pixel by pixel. Triangles reaching
+ * out of the guard band are clipped by it first, other ones are only scissored.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param v1 First vertex of the triangle.
+ * @param v2 Second vertex of the triangle.
+ * @param v3 Third vertex of the triangle.
+ * @param color 32 bit color (ARGB) of the triangle.
+ * @param blend Blend mode.
+ */
+void
+TriangleRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, Vec2 v1, Vec2 v2,
+    Vec2 v3, u32 color, BlendMode blend);
+
+#endif  /* JEMA_ENGINE_TRIANGLE_RASTER_H_ */
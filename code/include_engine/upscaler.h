@@ -0,0 +1,125 @@
+/**
+ * ================================================================================
+ * @file include_engine/upscaler.h
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Declaration of objects and functions necessary for the scaling of the render
+ * buffer of the internal resolution to the output (window) resolution. The output is
+ * ready to be presented 1:1. Rows of the output are split into bands scaled in parallel
+ * by a pool of worker threads, the row kernels use the instruction set selected for the
+ * span fill. Both buffers are bottom-up rows of 32 bit pixels (ARGB) without padding.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#ifndef JEMA_ENGINE_UPSCALER_H_
+#define JEMA_ENGINE_UPSCALER_H_
+
+#include "include_engine/utils.h"
+
+typedef struct JobPool_ JobPool;
+
+#define UPSCALER_BAND_ROWS 16  /* Amount of the output rows scaled by a single job. */
+#define UPSCALER_WEIGHT_ONE 128  /* Bilinear weight of the second pixel equal to one. */
+
+/**
+ * @brief Enumerator for the upscale filters.
+ */
+enum UpscaleFilter_
+{
+    UF_NEAREST_INTEGER,  /**< Largest integer scale fitting the output, black borders. */
+    UF_NEAREST,  /**< Nearest pixel, the image is stretched to the whole output. */
+    UF_BILINEAR,  /**< Bilinear filter, the image is stretched to the whole output. */
+    UF_FILTERS_NUM  /**< Total amount of the filters. */
+};
+typedef enum UpscaleFilter_ UpscaleFilter;
+
+/**
+ * @brief Structure for the Upscaler object.
+ */
+struct Upscaler_
+{
+    UpscaleFilter filter;  /**< Filter of the scaling. */
+    UpscaleFilter used_filter;  /**< Filter actually used (after the fallbacks). */
+    u32 src_width;  /**< Width of the source buffer. */
+    u32 src_height;  /**< Height of the source buffer. */
+    u32 dst_width;  /**< Width of the output buffer. */
+    u32 dst_height;  /**< Height of the output buffer. */
+    u32 image_x;  /**< X coordinate of the BL corner of the scaled image in the output. */
+    u32 image_y;  /**< Y coordinate of the BL corner of the scaled image in the output. */
+    u32 image_width;  /**< Width of the scaled image (the rest of the output is black). */
+    u32 image_height;  /**< Height of the scaled image. */
+    u32 factor;  /**< Integer scale factor (UF_NEAREST_INTEGER only). */
+    u32 *output;  /**< Memory of the output buffer. */
+    u32 *cols;  /**< Source column of every image column. */
+    u16 *cols_weight;  /**< Bilinear weight of the next source column. */
+    u32 *rows;  /**< Source row of every image row. */
+    u16 *rows_weight;  /**< Bilinear weight of the next source row. */
+    JobPool *job_pool;  /**< Pool of the worker threads. */
+    u32 *scratch;  /**< Temporary rows of the workers (4 image rows per worker). */
+    const u32 *src;  /**< Source buffer of the current scaling. */
+};
+typedef struct Upscaler_ Upscaler;
+
+/**
+ * @brief Object constructor.
+ * @return Upscaler* Pointer to the Upscaler structure.
+ */
+Upscaler*
+Upscaler_Constructor(void);
+
+/**
+ * @brief Object destructor.
+ * @param upscaler Pointer to the Upscaler structure.
+ * @return Upscaler* Pointer to the Upscaler structure.
+ */
+Upscaler*
+Upscaler_Destructor(Upscaler *upscaler);
+
+/**
+ * @brief Object initialization. Starting the worker threads.
+ * @param upscaler Pointer to the Upscaler structure.
+ * @param threads_num Amount of the worker threads. Zero - one thread per extra CPU core.
+ */
+void
+Upscaler_Init(Upscaler *upscaler, u32 threads_num);
+
+/**
+ * @brief Setting the sizes of the buffers and the filter. The tables are rebuilt only
+ * if something was changed. Integer filter of the output smaller than the source and
+ * bilinear filter of the source narrower or lower than two pixels fall back to the
+ * nearest one.
+ * @param upscaler Pointer to the Upscaler structure.
+ * @param src_width Width of the source buffer.
+ * @param src_height Height of the source buffer.
+ * @param dst_width Width of the output buffer.
+ * @param dst_height Height of the output buffer.
+ * @param filter Filter of the scaling.
+ */
+void
+Upscaler_Configure(Upscaler *upscaler, u32 src_width, u32 src_height, u32 dst_width,
+    u32 dst_height, UpscaleFilter filter);
+
+/**
+ * @brief Scaling the source buffer to the output buffer. Without the initialization
+ * (no worker threads) all the rows are scaled by the calling thread.
+ * @param upscaler Pointer to the Upscaler structure.
+ * @param src Pointer to the source buffer memory.
+ * @return const u32* Pointer to the output buffer memory.
+ */
+const u32*
+Upscaler_Run(Upscaler *upscaler, const void *src);
+
+/**
+ * @brief Mapping a point of the output to the pixel of the source shown there (points
+ * outside of the scaled image are mapped to the nearest edge pixel).
+ * @param upscaler Pointer to the Upscaler structure.
+ * @param x X coordinate of the output point (from the left).
+ * @param y Y coordinate of the output point (from the bottom).
+ * @param src_x X coordinate of the source pixel.
+ * @param src_y Y coordinate of the source pixel.
+ */
+void
+Upscaler_MapPoint(Upscaler *upscaler, s32 x, s32 y, s32 *src_x, s32 *src_y);
+
+#endif  /* JEMA_ENGINE_UPSCALER_H_ */
@@ -13,8 +13,11 @@
 #define JEMA_ENGINE_UTILS_H_
 
 #include <float.h>
+#include <stddef.h>
 #include <stdint.h>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 /* Window constants */
 #define WINDOW_WIDTH 1280  /* Width of the whole windows window. */
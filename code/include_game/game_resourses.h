@@ -52,6 +52,7 @@ enum GameResourseColor_
     GC_DCONSOLE_BKG,  /**< Debug console background color (0x00ffffff). */
     GC_DCONSOLE_BRD,  /**< Debug console border color (0x00b4b4b4). */
     GC_BKG_COLOR,  /**< Game background color. */
+    GC_TRANSPARENT,  /**< Transparent color erasing the pixels of a layer (0x00000000). */
     GC_COLORS_NUM  /**< Total number of the colors used in the game. */
 };
 typedef enum GameResourseColor_ GameResourseColor;
@@ -13,9 +13,11 @@
 #define JEMA_GAME_WORKER_H_
 
 #include <windows.h>
+#include "include_engine/atomic.h"
 #include "include_engine/utils.h"
 
 typedef struct Game_ Game;
+typedef struct RenderCmdBuffer_ RenderCmdBuffer;
 typedef struct Win32Platform_ Win32Platform;
 
 /**
@@ -25,6 +27,11 @@ struct GameWorker_
 {
     Game *game;  /**< Pointer to the Game structure. */
     Win32Platform *win32_platform;  /**< Pointer to the Win32Platform structure. */
+    RenderCmdBuffer *cmd_buffers[2];  /**< Command buffers of two consecutive frames. */
+    RenderCmdBuffer *frame_cmd_buffer;  /**< Frame to rasterize (NULL - stop rendering). */
+    HANDLE frame_ready;  /**< Semaphore signaled when a frame is recorded. */
+    HANDLE frame_done;  /**< Semaphore signaled when a frame is rasterized. */
+    atomic_s32 is_presenting;  /**< Flag to keep the present thread running. */
 };
 typedef struct GameWorker_ GameWorker;
 
@@ -51,7 +58,10 @@ void
 GameWorker_Init(GameWorker *game_worker, Game *game, Win32Platform *win32_platform);
 
 /**
- * @brief Game worker procedure to be executed in the separate thread. 
+ * @brief Game worker procedure to be executed in the separate thread. The simulation
+ * only records the render commands of a frame, while the frame is rasterized by the
+ * render thread started by the worker. So the simulation of the next frame overlaps
+ * the rasterization of the previous one.
  */
 DWORD WINAPI 
 GameWorker_ThreadProc(void *game_worker);
@@ -0,0 +1,259 @@
+/**
+ * ================================================================================
+ * @file src_bench/capture_bench.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Headless benchmark of the frame capture. The frames of a headless render are
+ * captured into every output format, paced as a game would present them or as fast as
+ * possible. The time taken from the drawing thread by the capture is reported with
+ * the frame counters, the written outputs are verified (and removed). Run from the
+ * build or misc directory.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "include_engine/color.h"
+#include "include_engine/frame_capture.h"
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+#define BENCH_FRAMES_NUM 120  /* Amount of the frames presented in every case. */
+#define BENCH_WIDTH 640  /* Width of the render buffer. */
+#define BENCH_HEIGHT 360  /* Height of the render buffer. */
+
+/**
+ * @brief Structure describing one benchmark case.
+ */
+struct BenchCase_
+{
+    const char *name;  /**< Name of the case. */
+    FrameCaptureFormat format;  /**< Format of the output. */
+    const char *path;  /**< Output path. */
+    const char *file_path;  /**< Path of the written stream to verify (NULL - none). */
+    u32 frames_num;  /**< Amount of the frames in the pool. */
+    u32 frame_us;  /**< Period of the frames (0 - as fast as possible). */
+};
+typedef struct BenchCase_ BenchCase;
+
+/**
+ * @brief Getting the current value of the monotonic clock.
+ * @return u64 Time in nanoseconds.
+ */
+static u64
+GetTimeNs(void);
+
+/**
+ * @brief Sleeping for at least the specified time.
+ * @param us Time in microseconds.
+ */
+static void
+SleepFor(u32 us);
+
+/**
+ * @brief Verification of the written output and its removal. The frames of the RGBA
+ * stream should have increasing numbers (stored in the clear color).
+ * @param bench_case Pointer to the benchmark case.
+ * @param frames_encoded Amount of the frames written by the capture.
+ * @return b32 Result of the verification.
+ */
+static b32
+VerifyOutput(const BenchCase *bench_case, u32 frames_encoded);
+
+/**
+ * @brief Running a single benchmark case.
+ * @param bench_case Pointer to the benchmark case.
+ * @return b32 Result of the verification.
+ */
+static b32
+RunCase(const BenchCase *bench_case);
+
+int
+main(void)
+{
+    static const BenchCase cases[] =
+    {
+        {"png, 60 fps, pool 8", FCF_PNG, "../build/capture_%05u.png", NULL, 8, 16667},
+        {"png, unpaced, pool 4", FCF_PNG, "../build/capture_%05u.png", NULL, 4, 0},
+        {"y4m, 60 fps, pool 8", FCF_Y4M, "../build/capture.y4m", "../build/capture.y4m",
+            8, 16667},
+        {"y4m, unpaced, pool 4", FCF_Y4M, "../build/capture.y4m", "../build/capture.y4m",
+            4, 0},
+        {"rgba, unpaced, pool 4", FCF_RGBA, "../build/capture.rgba", "../build/capture.rgba",
+            4, 0},
+#ifndef _WIN32
+        {"rgba pipe, unpaced, pool 4", FCF_RGBA, "|cat > ../build/capture.rgba",
+            "../build/capture.rgba", 4, 0}
+#endif
+    };
+    u32 cases_num = sizeof(cases) / sizeof(cases[0]);
+
+    FILE *file = fopen("../build/capture.probe", "wb");
+    if (file == NULL)
+    {
+        printf("Directory ../build is not found (run from the build or misc directory)!\n");
+        return 1;
+    }
+    fclose(file);
+    remove("../build/capture.probe");
+
+    b32 is_ok = true;
+    for (u32 i = 0; i < cases_num; ++i)
+    {
+        is_ok = RunCase(&cases[i]) && is_ok;
+    }
+    return is_ok ? 0 : 1;
+}
+
+static u64
+GetTimeNs(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (u64)((f64)counter.QuadPart * 1.0e9 / (f64)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+static void
+SleepFor(u32 us)
+{
+#ifdef _WIN32
+    Sleep((us + 999) / 1000);
+#else
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static b32
+VerifyOutput(const BenchCase *bench_case, u32 frames_encoded)
+{
+    u64 frame_size = (u64)BENCH_WIDTH * BENCH_HEIGHT;
+    b32 is_ok = true;
+
+    if (bench_case->format == FCF_PNG)
+    {
+        /* Every frame is a file, the frames are numbered without gaps. */
+        char file_path[256];
+        for (u32 i = 0; i < frames_encoded; ++i)
+        {
+            snprintf(file_path, sizeof(file_path), bench_case->path, i);
+            FILE *file = fopen(file_path, "rb");
+            if (file == NULL)
+            {
+                is_ok = false;
+                continue;
+            }
+            fclose(file);
+            remove(file_path);
+        }
+        return is_ok;
+    }
+
+    FILE *file = fopen(bench_case->file_path, "rb");
+    if (file == NULL) return false;
+    fseek(file, 0, SEEK_END);
+    u64 file_size = (u64)ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (bench_case->format == FCF_Y4M)
+    {
+        char header[128];
+        if (fgets(header, sizeof(header), file) == NULL) header[0] = '\0';
+        u64 expected = strlen(header) + (6 + 3 * frame_size) * frames_encoded;
+        is_ok = (strncmp(header, "YUV4MPEG2 ", 10) == 0) && (file_size == expected);
+    }
+    else
+    {
+        /* The first pixel (top row) of the frame holds the frame number. */
+        is_ok = (file_size == 4 * frame_size * frames_encoded);
+        u8 *frame = (u8 *)malloc((size_t)(4 * frame_size));
+        s64 previous = -1;
+        for (u32 i = 0; is_ok && (i < frames_encoded); ++i)
+        {
+            if (fread(frame, 1, (size_t)(4 * frame_size), file) != 4 * frame_size) break;
+            s64 number = ((s64)frame[0] << 16) | ((s64)frame[1] << 8) | frame[2];
+            is_ok = (number > previous) && (frame[3] == 0xff);
+            previous = number;
+        }
+        free(frame);
+    }
+    fclose(file);
+    remove(bench_case->file_path);
+    return is_ok;
+}
+
+static b32
+RunCase(const BenchCase *bench_case)
+{
+    Render *render = Render_Constructor();
+    Render_InitHeadless(render, BENCH_WIDTH, BENCH_HEIGHT);
+    Render_StartCapture(render, bench_case->format, bench_case->path, 60,
+        bench_case->frames_num);
+
+    /* The frame number is the clear color, a moving rectangle is drawn over it. */
+    u64 update_ns = 0;
+    u64 update_max_ns = 0;
+    for (u32 i = 0; i < BENCH_FRAMES_NUM; ++i)
+    {
+        u64 frame_begin = GetTimeNs();
+        Color color;
+        color.color = 0xff000000 | i;
+        Render_ClearScreen(render, &color);
+        color.color = 0xffffc040;
+        Render_DrawRect(render, (i * 4) % (BENCH_WIDTH - 64), 100, 64, 64, &color);
+
+        u64 begin = GetTimeNs();
+        Render_UpdateWindow(render);
+        u64 elapsed = GetTimeNs() - begin;
+        update_ns += elapsed;
+        if (elapsed > update_max_ns) update_max_ns = elapsed;
+
+        u64 frame_ns = GetTimeNs() - frame_begin;
+        if ((u64)bench_case->frame_us * 1000 > frame_ns)
+            SleepFor((u32)(((u64)bench_case->frame_us * 1000 - frame_ns) / 1000));
+    }
+
+    /* The pooled frames are written in the background after the last present. */
+    FrameCaptureStats stats;
+    Render_GetCaptureStats(render, &stats);
+    u32 frames_pending = stats.frames_pending;
+    u64 begin = GetTimeNs();
+    while (stats.frames_pending > 0)
+    {
+        SleepFor(100);
+        Render_GetCaptureStats(render, &stats);
+    }
+    u64 drain_ns = GetTimeNs() - begin;
+    Render_GetCaptureStats(render, &stats);
+    Render_StopCapture(render);
+    render = Render_Destructor(render);
+
+    b32 is_ok = (stats.frames_captured + stats.frames_dropped == BENCH_FRAMES_NUM) &&
+        (stats.frames_failed == 0) && (stats.frames_captured == stats.frames_encoded);
+    is_ok = VerifyOutput(bench_case, stats.frames_encoded) && is_ok;
+
+    printf("%-28s update %7.1f us (max %7.1f us), captured %3u, dropped %3u, "
+        "pending %u (drained in %.1f ms), verification: %s\n", bench_case->name,
+        (f64)update_ns / BENCH_FRAMES_NUM / 1.0e3, (f64)update_max_ns / 1.0e3,
+        stats.frames_captured, stats.frames_dropped, frames_pending,
+        (f64)drain_ns / 1.0e6, is_ok ? "ok" : "FAILED");
+    return is_ok;
+}
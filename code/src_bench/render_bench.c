@@ -0,0 +1,1414 @@
+/**
+ * ================================================================================
+ * @file src_bench/render_bench.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Headless benchmark of the render primitives. Every primitive is drawn into a
+ * small scene which is compared with the golden image (data/golden) for every supported
+ * instruction set and with the scene drawn into the sub-views of the render targets
+ * (an image and an own buffer with the aligned rows), then the primitive is drawn at
+ * several sizes into a large frame and the throughput is reported. Run from the build or misc directory, "--update" writes
+ * the golden images, "--verify" skips the timing. Built with RENDER_STATS, the render
+ * statistics and the heatmap are checked and the overdraw of every primitive is shown.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "include_engine/color.h"
+#include "include_engine/engine_constants.h"
+#include "include_engine/font.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/image.h"
+#include "include_engine/memory_object.h"
+#include "include_engine/png_writer.h"
+#include "include_engine/pixel_format.h"
+#include "include_engine/render.h"
+#include "include_engine/render_target.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#define BENCH_MIN_TIME_NS 100000000ull  /* Minimum time of every measurement. */
+#define BENCH_GOLDEN_DIR "../data/golden/"  /* Directory of the golden images. */
+#define BENCH_FONT_PATH "../data/font_Win1251.png"  /* Font of the text primitives. */
+#define BENCH_SCENE_WIDTH 160  /* Width of the scene compared with the golden image. */
+#define BENCH_SCENE_HEIGHT 120  /* Height of the scene compared with the golden image. */
+#define BENCH_FRAME_WIDTH 1024  /* Width of the frame of the throughput measurement. */
+#define BENCH_FRAME_HEIGHT 768  /* Height of the frame of the throughput measurement. */
+#define BENCH_SIZES_NUM 4  /* Amount of the primitive sizes. */
+#define BENCH_VIEW_X 19  /* X coordinate of the sub-view with the scene in the target. */
+#define BENCH_VIEW_Y 7  /* Y coordinate of the sub-view with the scene in the target. */
+#define BENCH_BATCH_SIZE 50000  /* Amount of the instances of the batch comparison. */
+#define BENCH_PANELS_NUM 200  /* Amount of the stacked panels of the occlusion comparison. */
+#define BENCH_SCALED_STEP 46  /* Distance between the images of the scaled comparison. */
+
+static const u32 bench_sizes[BENCH_SIZES_NUM] = {4, 16, 64, 256};
+
+/**
+ * @brief Structure for the resources shared by the primitives.
+ */
+struct BenchContext_
+{
+    Image *images[BENCH_SIZES_NUM];  /**< Images of every size (sprites and textures). */
+    Font *font;  /**< Font of the text primitives. */
+};
+typedef struct BenchContext_ BenchContext;
+
+/**
+ * @brief Pointer to the function drawing a primitive centered at the point.
+ */
+typedef void (*BenchDrawFcn)(Render *render, const BenchContext *context, f32 x, f32 y,
+    u32 size_index);
+
+/**
+ * @brief Structure describing one primitive of the benchmark.
+ */
+struct BenchPrimitive_
+{
+    const char *name;  /**< Name of the primitive (and of its golden image). */
+    BenchDrawFcn draw;  /**< Function drawing the primitive. */
+};
+typedef struct BenchPrimitive_ BenchPrimitive;
+
+/**
+ * @brief Getting the current value of the monotonic clock.
+ * @return u64 Time in nanoseconds.
+ */
+static u64
+GetTimeNs(void);
+
+/**
+ * @brief Creation of the image with the opaque center, translucent ring and
+ * transparent corners (all the sprite span kinds).
+ * @param size Width and height of the image.
+ * @return Image* Pointer to the image with the compiled sprite and texture.
+ */
+static Image*
+CreateImage(u32 size);
+
+/**
+ * @brief Drawing the golden scene of the primitive: a few instances of different sizes,
+ * partially clipped by the frame edges.
+ * @param render Pointer to the render of the scene size.
+ * @param context Pointer to the shared resources.
+ * @param primitive Pointer to the primitive.
+ */
+static void
+DrawScene(Render *render, const BenchContext *context, const BenchPrimitive *primitive);
+
+/**
+ * @brief Comparison of the scene with the golden image (or writing the golden image).
+ * Mismatched scene is written to the current directory for the inspection.
+ * @param render Pointer to the render with the drawn scene.
+ * @param primitive Pointer to the primitive.
+ * @param is_update Flag of writing the golden image.
+ * @return b32 Result of the comparison.
+ */
+static b32
+CheckGolden(Render *render, const BenchPrimitive *primitive, b32 is_update);
+
+/**
+ * @brief Comparison of the scene drawn into the sub-view of the target with the scene
+ * drawn into the frame. The target pixels around the view should stay zero.
+ * @param render Pointer to the render with the drawn scene.
+ * @param context Pointer to the shared resources.
+ * @param primitive Pointer to the primitive.
+ * @param target Pointer to the zero filled target (larger than the scene).
+ * @return b32 Result of the comparison.
+ */
+static b32
+CheckTarget(Render *render, const BenchContext *context, const BenchPrimitive *primitive,
+    RenderTarget *target);
+
+/**
+ * @brief Comparison of the batched drawing of the rectangles and points (arrays of
+ * structures and structure of arrays) with the drawing of them one by one. The frames
+ * should be identical, the times are printed if measured.
+ * @param render Pointer to the render of the frame size.
+ * @param is_timed Flag of the time measurement.
+ * @return b32 Result of the comparison.
+ */
+static b32
+CheckBatches(Render *render, b32 is_timed);
+
+/**
+ * @brief Checking the front to back drawing with the occlusion: a stack of the opaque
+ * panels with the translucent highlights, icons and labels should give the same frame
+ * as the back to front drawing, immediately and by the tiler. The time is printed if
+ * timed.
+ * @param render Pointer to the render of the frame size.
+ * @param context Pointer to the shared resources.
+ * @param is_timed Flag of the measurement of the time.
+ * @return b32 Result of the check.
+ */
+static b32
+CheckOcclusion(Render *render, const BenchContext *context, b32 is_timed);
+
+/**
+ * @brief Checking the images scaled by the sampling tables: the integer scale should give
+ * the same frame as the sprites, the fractional one should give the same frame
+ * immediately and by the tiler. The time is printed if timed.
+ * @param render Pointer to the render of the frame size.
+ * @param context Pointer to the shared resources.
+ * @param is_timed Flag of the measurement of the time.
+ * @return b32 Result of the check.
+ */
+static b32
+CheckScaled(Render *render, const BenchContext *context, b32 is_timed);
+
+/**
+ * @brief Drawing a panel of the occlusion comparison.
+ * @param render Pointer to the render of the frame size.
+ * @param context Pointer to the shared resources.
+ * @param index Index of the panel (its position and size are derived from it).
+ * @param is_front_to_back Flag of the drawing of the panel parts from the front.
+ */
+static void
+DrawPanel(Render *render, const BenchContext *context, u32 index, b32 is_front_to_back);
+
+#ifdef RENDER_STATS
+/**
+ * @brief Checking the render statistics: the counters and the heatmap of a few known
+ * rectangles, then the statistics of every primitive drawn immediately and by the tiler
+ * should be the same (except for the time). The statistics are printed if timed.
+ * @param render Pointer to the render of the scene size.
+ * @param context Pointer to the shared resources.
+ * @param primitives Array of the primitives.
+ * @param primitives_num Amount of the primitives.
+ * @param is_timed Flag of the printing of the statistics.
+ * @return b32 Result of the check.
+ */
+static b32
+CheckStats(Render *render, const BenchContext *context, const BenchPrimitive *primitives,
+    u32 primitives_num, b32 is_timed);
+
+/**
+ * @brief Drawing a large and a clipped instance of the primitive without the background
+ * as a single frame and getting its statistics.
+ * @param render Pointer to the render of the scene size.
+ * @param context Pointer to the shared resources.
+ * @param primitive Pointer to the primitive.
+ * @param stats Pointer to the statistics of the frame.
+ */
+static void
+GetPrimitiveStats(Render *render, const BenchContext *context,
+    const BenchPrimitive *primitive, RenderFrameStats *stats);
+#endif
+
+/**
+ * @brief Measuring the time of drawing the primitive of a size.
+ * @param render Pointer to the render of the frame size.
+ * @param context Pointer to the shared resources.
+ * @param primitive Pointer to the primitive.
+ * @param size_index Index of the size.
+ * @param pixels Pointer to the amount of pixels changed by a single call.
+ * @return f64 Time of a single call in nanoseconds.
+ */
+static f64
+MeasurePrimitive(Render *render, const BenchContext *context,
+    const BenchPrimitive *primitive, u32 size_index, u64 *pixels);
+
+/* Drawing functions of the primitives. */
+static void DrawClear(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawPixel(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawLineAA(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawThickLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawPolyline(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawPolylineAA(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawHorLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawVerLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRect(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRectAlpha(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRectWithBrd(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawTriangle(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRotatedRect(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawPolygon(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawPolygonStar(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawCircle(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawCircleOutline(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawEllipse(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRing(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawCircles(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRects(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawPoints(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawBitmap(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawBitmapScaled(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawBitmapMask(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawScaledNearest(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawScaledBilinear(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRotatedNearest(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawRotatedBilinear(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawTexturedTriangle(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+static void DrawText(Render *r, const BenchContext *c, f32 x, f32 y, u32 s);
+
+int
+main(int argc, char **argv)
+{
+    static const BenchPrimitive primitives[] =
+    {
+        {"clear", DrawClear},
+        {"pixel", DrawPixel},
+        {"line", DrawLine},
+        {"line_aa", DrawLineAA},
+        {"thick_line", DrawThickLine},
+        {"polyline", DrawPolyline},
+        {"polyline_aa", DrawPolylineAA},
+        {"hor_line", DrawHorLine},
+        {"ver_line", DrawVerLine},
+        {"rect", DrawRect},
+        {"rect_alpha", DrawRectAlpha},
+        {"rect_with_brd", DrawRectWithBrd},
+        {"triangle", DrawTriangle},
+        {"rotated_rect", DrawRotatedRect},
+        {"polygon", DrawPolygon},
+        {"polygon_star", DrawPolygonStar},
+        {"circle", DrawCircle},
+        {"circle_outline", DrawCircleOutline},
+        {"ellipse", DrawEllipse},
+        {"ring", DrawRing},
+        {"circles", DrawCircles},
+        {"rects", DrawRects},
+        {"points", DrawPoints},
+        {"bitmap", DrawBitmap},
+        {"bitmap_scaled", DrawBitmapScaled},
+        {"bitmap_mask", DrawBitmapMask},
+        {"scaled_nearest", DrawScaledNearest},
+        {"scaled_bilinear", DrawScaledBilinear},
+        {"rotated_nearest", DrawRotatedNearest},
+        {"rotated_bilinear", DrawRotatedBilinear},
+        {"textured_triangle", DrawTexturedTriangle},
+        {"text", DrawText}
+    };
+    u32 primitives_num = sizeof(primitives) / sizeof(primitives[0]);
+
+    b32 is_update = false;
+    b32 is_timed = true;
+    for (s32 i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--update") == 0) is_update = true;
+        else if (strcmp(argv[i], "--verify") == 0) is_timed = false;
+        else
+        {
+            printf("Usage: render_bench [--update] [--verify]\n");
+            return 1;
+        }
+    }
+
+    FILE *font_file = fopen(BENCH_FONT_PATH, "rb");
+    if (font_file == NULL)
+    {
+        printf("Font %s is not found (run from the build or misc directory)!\n",
+            BENCH_FONT_PATH);
+        return 1;
+    }
+    fclose(font_file);
+
+    BenchContext context;
+    for (u32 i = 0; i < BENCH_SIZES_NUM; ++i)
+    {
+        context.images[i] = CreateImage(bench_sizes[i]);
+    }
+    Image *font_image = Image_Constructor();
+    Image_LoadFromFile(font_image, BENCH_FONT_PATH);
+    context.font = Font_Constructor();
+    Font_Init(context.font, (s32)FONT_ROWS_NUM, (s32)FONT_COLS_NUM, (s32)FONT_SYM_WIDTH,
+        (s32)FONT_SYM_HEIGHT, font_image);
+
+    Render *scene = Render_Constructor();
+    Render_InitHeadless(scene, BENCH_SCENE_WIDTH, BENCH_SCENE_HEIGHT);
+    Render *frame = Render_Constructor();
+    Render_InitHeadless(frame, BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT);
+    SpanFillIsa best_isa = SpanFill_GetIsa();
+
+    /* Targets with the odd pitch (an image) and with the rows aligned by the target. */
+    u32 target_width = BENCH_SCENE_WIDTH + BENCH_VIEW_X + 8;
+    u32 target_height = BENCH_SCENE_HEIGHT + BENCH_VIEW_Y + 6;
+    Image *target_image = Image_Constructor();
+    target_image->width = target_width;
+    target_image->height = target_height;
+    target_image->channels = 4;
+    target_image->format = PF_BGRA_PREMULTIPLIED;
+    target_image->data = HelperFcn_MemAllocate(sizeof(u32) * target_width * target_height);
+    RenderTarget *targets[2];
+    targets[0] = RenderTarget_Constructor();
+    RenderTarget_InitByImage(targets[0], target_image);
+    targets[1] = RenderTarget_Constructor();
+    RenderTarget_Init(targets[1], target_width, target_height);
+
+    /* Golden images are written by the scalar kernels, all the kernels must match. */
+    b32 is_ok = true;
+    for (u32 isa = 0; isa < SFI_ISA_NUM; ++isa)
+    {
+        if (!SpanFill_SetIsa((SpanFillIsa)isa)) continue;
+        u32 failed = 0;
+        for (u32 i = 0; i < primitives_num; ++i)
+        {
+            DrawScene(scene, &context, &primitives[i]);
+            b32 is_matched = CheckGolden(scene, &primitives[i],
+                is_update && (isa == SFI_SCALAR));
+            for (u32 j = 0; j < 2; ++j)
+            {
+                is_matched = CheckTarget(scene, &context, &primitives[i], targets[j]) &&
+                    is_matched;
+            }
+            if (!is_matched) failed++;
+        }
+        printf("[%s] golden images and targets: %u of %u matched\n",
+            SpanFill_GetIsaName((SpanFillIsa)isa), primitives_num - failed, primitives_num);
+        is_ok = is_ok && (failed == 0);
+    }
+    SpanFill_SetIsa(best_isa);
+    is_ok = CheckBatches(frame, is_timed) && is_ok;
+    is_ok = CheckOcclusion(frame, &context, is_timed) && is_ok;
+    is_ok = CheckScaled(frame, &context, is_timed) && is_ok;
+#ifdef RENDER_STATS
+    is_ok = CheckStats(scene, &context, primitives, primitives_num, is_timed) && is_ok;
+#endif
+
+    if (is_timed)
+    {
+        printf("\n[%s] %ux%u frame, ns/call and Mpixels/s for the sizes:\n",
+            SpanFill_GetIsaName(best_isa), BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT);
+        printf("%-18s", "primitive");
+        for (u32 s = 0; s < BENCH_SIZES_NUM; ++s)
+        {
+            printf(" %20u", bench_sizes[s]);
+        }
+        printf("\n");
+        for (u32 i = 0; i < primitives_num; ++i)
+        {
+            printf("%-18s", primitives[i].name);
+            for (u32 s = 0; s < BENCH_SIZES_NUM; ++s)
+            {
+                u64 pixels = 0;
+                f64 ns = MeasurePrimitive(frame, &context, &primitives[i], s, &pixels);
+                printf(" %10.1f %9.1f", ns, (f64)pixels * 1.0e3 / ns);
+            }
+            printf("\n");
+        }
+    }
+
+    targets[1] = RenderTarget_Destructor(targets[1]);
+    targets[0] = RenderTarget_Destructor(targets[0]);
+    target_image = Image_Destructor(target_image);
+    frame = Render_Destructor(frame);
+    scene = Render_Destructor(scene);
+    context.font = Font_Destructor(context.font);
+    font_image = Image_Destructor(font_image);
+    for (u32 i = 0; i < BENCH_SIZES_NUM; ++i)
+    {
+        context.images[i] = Image_Destructor(context.images[i]);
+    }
+    return is_ok ? 0 : 1;
+}
+
+static u64
+GetTimeNs(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (u64)((f64)counter.QuadPart * 1.0e9 / (f64)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+static Image*
+CreateImage(u32 size)
+{
+    Image *image = Image_Constructor();
+    image->width = size;
+    image->height = size;
+    image->channels = 4;
+    image->format = PF_BGRA;
+    image->data = HelperFcn_MemAllocate(sizeof(u32) * size * size);
+
+    u32 *pixels = (u32 *)image->data;
+    f32 radius = 0.5f * (f32)size;
+    for (u32 y = 0; y < size; ++y)
+    {
+        for (u32 x = 0; x < size; ++x)
+        {
+            f32 dx = (f32)x + 0.5f - radius;
+            f32 dy = (f32)y + 0.5f - radius;
+            f32 distance = sqrtf(dx * dx + dy * dy) / radius;
+            u32 alpha = (distance < 0.75f) ? 255 : ((distance < 1.0f) ? 128 : 0);
+            u32 red = (x * 255) / size;
+            u32 green = (y * 255) / size;
+            u32 blue = ((x ^ y) & 8) ? 255 : 64;
+            pixels[x + y * size] = (alpha << 24) | (red << 16) | (green << 8) | blue;
+        }
+    }
+    Image_CompileSprite(image);
+    Image_CompileTexture(image, TL_TILED);
+    return image;
+}
+
+static void
+DrawScene(Render *render, const BenchContext *context, const BenchPrimitive *primitive)
+{
+    Color background;
+    background.color = 0xff203040;
+    Render_SetBlendMode(render, BM_NONE);
+    Render_ClearScreen(render, &background);
+
+    /* Instances of the three smaller sizes, the last ones cross the frame edges. */
+    static const f32 positions[6][2] =
+    {
+        {30.0f, 30.0f}, {80.0f, 60.0f}, {130.0f, 90.0f},
+        {120.0f, 25.0f}, {155.0f, 60.0f}, {70.0f, 117.0f}
+    };
+    for (u32 i = 0; i < 6; ++i)
+    {
+        primitive->draw(render, context, positions[i][0], positions[i][1], i % 3);
+    }
+    Render_SetBlendMode(render, BM_NONE);
+    Render_Flush(render);
+}
+
+static b32
+CheckGolden(Render *render, const BenchPrimitive *primitive, b32 is_update)
+{
+    RenderBuffer *buffer = render->buffer;
+    char file_path[256];
+    snprintf(file_path, sizeof(file_path), "%srender_%s.png", BENCH_GOLDEN_DIR,
+        primitive->name);
+
+    if (is_update)
+    {
+        MemObject *png = MemObject_Constructor();
+        PngWriter_Encode(png, (const u32 *)buffer->bitmap_memory, buffer->width,
+            buffer->height, buffer->width * sizeof(u32));
+        MemObject_WriteToDisc(png, file_path);
+        png = MemObject_Destructor(png);
+        return true;
+    }
+
+    FILE *file = fopen(file_path, "rb");
+    if (file == NULL)
+    {
+        printf("  %s: golden image %s is missing\n", primitive->name, file_path);
+        return false;
+    }
+    fclose(file);
+
+    /* Loaded image has the render buffer layout (BL origin, ARGB). */
+    Image *golden = Image_Constructor();
+    Image_LoadFromFile(golden, file_path);
+    u32 mismatched = 0;
+    if ((golden->width != buffer->width) || (golden->height != buffer->height))
+    {
+        mismatched = buffer->width * buffer->height;
+    }
+    else
+    {
+        const u32 *expected = (const u32 *)golden->data;
+        const u32 *actual = (const u32 *)buffer->bitmap_memory;
+        for (u32 i = 0; i < buffer->width * buffer->height; ++i)
+        {
+            if (expected[i] != actual[i]) mismatched++;
+        }
+    }
+    golden = Image_Destructor(golden);
+    if (mismatched == 0) return true;
+
+    snprintf(file_path, sizeof(file_path), "render_%s.actual.png", primitive->name);
+    MemObject *png = MemObject_Constructor();
+    PngWriter_Encode(png, (const u32 *)buffer->bitmap_memory, buffer->width,
+        buffer->height, buffer->width * sizeof(u32));
+    MemObject_WriteToDisc(png, file_path);
+    png = MemObject_Destructor(png);
+    printf("  %s: %u pixels differ (written to %s)\n", primitive->name, mismatched,
+        file_path);
+    return false;
+}
+
+static b32
+CheckTarget(Render *render, const BenchContext *context, const BenchPrimitive *primitive,
+    RenderTarget *target)
+{
+    RenderBuffer *buffer = render->buffer;
+    RenderTarget view;
+    memset(&view, 0, sizeof(view));
+    RenderTarget_InitSubView(&view, target, BENCH_VIEW_X, BENCH_VIEW_Y, buffer->width,
+        buffer->height);
+    Render_SetTarget(render, &view);
+    DrawScene(render, context, primitive);
+    Render_SetTarget(render, NULL);
+
+    /* Pixels of the view are compared with the frame and zeroed for the next check. */
+    u32 mismatched = 0;
+    for (u32 y = 0; y < target->height; ++y)
+    {
+        u32 *row = RenderTarget_GetPixelAddress(target, 0, y);
+        for (u32 x = 0; x < target->width; ++x)
+        {
+            u32 expected = 0;
+            if ((x >= BENCH_VIEW_X) && (x < BENCH_VIEW_X + buffer->width) &&
+                (y >= BENCH_VIEW_Y) && (y < BENCH_VIEW_Y + buffer->height))
+            {
+                expected = ((const u32 *)buffer->bitmap_memory)[(x - BENCH_VIEW_X) +
+                    (y - BENCH_VIEW_Y) * buffer->width];
+            }
+            if (row[x] != expected) mismatched++;
+            row[x] = 0;
+        }
+    }
+    if (mismatched == 0) return true;
+    printf("  %s: %u pixels of the %s target differ\n", primitive->name, mismatched,
+        target->image ? "image" : "aligned");
+    return false;
+}
+
+static b32
+CheckBatches(Render *render, b32 is_timed)
+{
+    RenderBuffer *buffer = render->buffer;
+    size_t frame_size = sizeof(u32) * buffer->width * buffer->height;
+    u32 repeats = is_timed ? 20 : 1;
+
+    /* Small rectangles and points all over the frame (some of them are clipped). */
+    RenderRectInstance *rects = (RenderRectInstance *)HelperFcn_MemAllocate(
+        BENCH_BATCH_SIZE * sizeof(RenderRectInstance));
+    RenderPoint *points = (RenderPoint *)HelperFcn_MemAllocate(
+        BENCH_BATCH_SIZE * sizeof(RenderPoint));
+    u32 *arrays = (u32 *)HelperFcn_MemAllocate(3 * BENCH_BATCH_SIZE * sizeof(u32));
+    u32 *xs = arrays;
+    u32 *ys = arrays + BENCH_BATCH_SIZE;
+    u32 *colors = arrays + 2 * BENCH_BATCH_SIZE;
+    u32 seed = 1;
+    for (u32 i = 0; i < BENCH_BATCH_SIZE; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        rects[i].x0 = (seed >> 8) % (buffer->width + 8) - 4;
+        rects[i].y0 = (seed >> 4) % (buffer->height + 8) - 4;
+        rects[i].width = 1 + (seed >> 24) % 8;
+        rects[i].height = 1 + (seed >> 28) % 8;
+        rects[i].color = 0xff000000 | (seed * 7);
+        seed = seed * 1664525 + 1013904223;
+        points[i].x = xs[i] = (seed >> 8) % (buffer->width + 8) - 4;
+        points[i].y = ys[i] = (seed >> 4) % (buffer->height + 8) - 4;
+        points[i].color = colors[i] = 0xff000000 | (seed * 13);
+    }
+
+    /* Case 0 draws one by one, its frame is the reference of the other cases. */
+    static const char *names[6] =
+    {
+        "single rects+points", "rects (AoS)", "points (AoS)", "points (SoA)",
+        "rects+points (AoS)", "rects+points (SoA)"
+    };
+    u32 *reference = (u32 *)HelperFcn_MemAllocate(frame_size);
+    f64 times[6];
+    b32 is_ok = true;
+    for (u32 c = 0; c < 6; ++c)
+    {
+        u64 begin = GetTimeNs();
+        for (u32 r = 0; r < repeats; ++r)
+        {
+            if (c == 0)
+            {
+                Color color;
+                for (u32 i = 0; i < BENCH_BATCH_SIZE; ++i)
+                {
+                    color.color = rects[i].color;
+                    Render_DrawRect(render, rects[i].x0, rects[i].y0, rects[i].width,
+                        rects[i].height, &color);
+                }
+                for (u32 i = 0; i < BENCH_BATCH_SIZE; ++i)
+                {
+                    color.color = points[i].color;
+                    Render_SetPixelColor(render, points[i].x, points[i].y, &color);
+                }
+            }
+            if ((c == 1) || (c >= 4)) Render_DrawRects(render, rects, BENCH_BATCH_SIZE);
+            if ((c == 2) || (c == 4)) Render_DrawPoints(render, points, BENCH_BATCH_SIZE);
+            if ((c == 3) || (c == 5)) Render_DrawPointArrays(render, xs, ys, colors, BENCH_BATCH_SIZE);
+            Render_Flush(render);
+            Render_ClearDirtyRects(render);
+        }
+        times[c] = (f64)(GetTimeNs() - begin) / repeats;
+
+        if (c == 0) memcpy(reference, buffer->bitmap_memory, frame_size);
+        if ((c >= 4) && (memcmp(reference, buffer->bitmap_memory, frame_size) != 0))
+        {
+            printf("  batches: the frame of %s differs from the single calls\n", names[c]);
+            is_ok = false;
+        }
+        memset(buffer->bitmap_memory, 0, frame_size);
+    }
+
+    if (is_timed)
+    {
+        printf("\nbatches of %u instances, us per batch (speedup over the single calls):\n",
+            BENCH_BATCH_SIZE);
+        for (u32 c = 0; c < 6; ++c)
+        {
+            printf("%-22s %10.1f", names[c], times[c] / 1.0e3);
+            if (c >= 4) printf(" (%.1fx)", times[0] / times[c]);
+            printf("\n");
+        }
+    }
+
+    HelperFcn_MemFree(reference);
+    HelperFcn_MemFree(arrays);
+    HelperFcn_MemFree(points);
+    HelperFcn_MemFree(rects);
+    return is_ok;
+}
+
+static b32
+CheckOcclusion(Render *render, const BenchContext *context, b32 is_timed)
+{
+    RenderBuffer *buffer = render->buffer;
+    size_t frame_size = sizeof(u32) * buffer->width * buffer->height;
+    u32 repeats = is_timed ? 20 : 1;
+
+    /* Case 0 draws from the back, its frame is the reference of the other cases. */
+    static const char *names[4] =
+    {
+        "back to front", "front to back (occlusion)", "back to front, tiled",
+        "front to back, tiled"
+    };
+    u32 *reference = (u32 *)HelperFcn_MemAllocate(frame_size);
+    f64 times[4];
+    b32 is_ok = true;
+    Color background;
+    background.color = 0xff202830;
+    for (u32 c = 0; c < 4; ++c)
+    {
+        b32 is_front_to_back = (c % 2 == 1);
+        if (c >= 2) Render_EnableTiling(render, 64, 4);
+        u64 begin = GetTimeNs();
+        for (u32 r = 0; r < repeats; ++r)
+        {
+            if (is_front_to_back)
+            {
+                Render_BeginOcclusion(render);
+                for (u32 i = BENCH_PANELS_NUM; i > 0; --i)
+                {
+                    DrawPanel(render, context, i - 1, true);
+                }
+                Render_SetBlendMode(render, BM_NONE);
+                Render_ClearScreen(render, &background);
+                Render_EndOcclusion(render);
+            }
+            else
+            {
+                Render_SetBlendMode(render, BM_NONE);
+                Render_ClearScreen(render, &background);
+                for (u32 i = 0; i < BENCH_PANELS_NUM; ++i)
+                {
+                    DrawPanel(render, context, i, false);
+                }
+            }
+            Render_Flush(render);
+            Render_ClearDirtyRects(render);
+        }
+        times[c] = (f64)(GetTimeNs() - begin) / repeats;
+        Render_DisableTiling(render);
+
+        if (c == 0) memcpy(reference, buffer->bitmap_memory, frame_size);
+        if ((c > 0) && (memcmp(reference, buffer->bitmap_memory, frame_size) != 0))
+        {
+            printf("  occlusion: the frame of %s differs from the back to front one\n",
+                names[c]);
+            is_ok = false;
+        }
+        memset(buffer->bitmap_memory, 0, frame_size);
+    }
+    Render_SetBlendMode(render, BM_NONE);
+
+    if (is_timed)
+    {
+        printf("\n%u stacked panels, us per frame (speedup over the back to front):\n",
+            BENCH_PANELS_NUM);
+        for (u32 c = 0; c < 4; ++c)
+        {
+            printf("%-26s %10.1f", names[c], times[c] / 1.0e3);
+            if (c % 2 == 1) printf(" (%.1fx)", times[c - 1] / times[c]);
+            printf("\n");
+        }
+    }
+
+    HelperFcn_MemFree(reference);
+    return is_ok;
+}
+
+static b32
+CheckScaled(Render *render, const BenchContext *context, b32 is_timed)
+{
+    RenderBuffer *buffer = render->buffer;
+    size_t frame_size = sizeof(u32) * buffer->width * buffer->height;
+    u32 repeats = is_timed ? 20 : 1;
+
+    /* Translucent small discs and opaque parts of the large disc over the frame. */
+    ImageRegion regions[2];
+    regions[0].image = context->images[1];
+    regions[0].x = 0;
+    regions[0].y = 0;
+    regions[0].width = 16;
+    regions[0].height = 16;
+    regions[1].image = context->images[3];
+    regions[1].x = 120;
+    regions[1].y = 120;
+    regions[1].width = 16;
+    regions[1].height = 16;
+    u32 columns_num = buffer->width / BENCH_SCALED_STEP + 2;
+    u32 rows_num = buffer->height / BENCH_SCALED_STEP + 2;
+
+    /* Frames of the cases 1 and 4 are compared with the frames of the cases 0 and 3. */
+    static const char *names[5] =
+    {
+        "sprites, scale 3", "nearest, scale 3", "nearest, scale 2.7",
+        "bilinear, scale 2.7", "bilinear, scale 2.7, tiled"
+    };
+    u32 *reference = (u32 *)HelperFcn_MemAllocate(frame_size);
+    f64 times[5];
+    b32 is_ok = true;
+    for (u32 c = 0; c < 5; ++c)
+    {
+        f32 scale = (c < 2) ? 3.0f : 2.7f;
+        TextureFilter filter = (c < 3) ? TF_NEAREST : TF_BILINEAR;
+        if (c == 4) Render_EnableTiling(render, 64, 4);
+        u64 begin = GetTimeNs();
+        for (u32 r = 0; r < repeats; ++r)
+        {
+            Render_SetBlendMode(render, BM_ALPHA);
+            for (u32 j = 0; j < rows_num; ++j)
+            {
+                for (u32 i = 0; i < columns_num; ++i)
+                {
+                    const ImageRegion *region = &regions[(i + j) % 2];
+                    s32 x = (s32)(i * BENCH_SCALED_STEP) - 7;
+                    s32 y = (s32)(j * BENCH_SCALED_STEP) - 5;
+                    if (c == 0)
+                        Render_DrawBitmapRegion(render, (u32)x, (u32)y, region, 3);
+                    else
+                        Render_DrawScaledBitmapRegion(render, (f32)x, (f32)y, region,
+                            scale, scale, filter);
+                }
+            }
+            Render_Flush(render);
+            Render_ClearDirtyRects(render);
+        }
+        times[c] = (f64)(GetTimeNs() - begin) / repeats;
+        Render_DisableTiling(render);
+
+        if ((c == 0) || (c == 3)) memcpy(reference, buffer->bitmap_memory, frame_size);
+        if (((c == 1) || (c == 4)) &&
+            (memcmp(reference, buffer->bitmap_memory, frame_size) != 0))
+        {
+            printf("  scaled: the frame of %s differs from the %s one\n", names[c],
+                names[c - 1]);
+            is_ok = false;
+        }
+        memset(buffer->bitmap_memory, 0, frame_size);
+    }
+    Render_SetBlendMode(render, BM_NONE);
+
+    if (is_timed)
+    {
+        printf("\n%u scaled images, us per frame:\n", columns_num * rows_num);
+        for (u32 c = 0; c < 5; ++c)
+        {
+            printf("%-26s %10.1f\n", names[c], times[c] / 1.0e3);
+        }
+    }
+
+    HelperFcn_MemFree(reference);
+    return is_ok;
+}
+
+static void
+DrawPanel(Render *render, const BenchContext *context, u32 index, b32 is_front_to_back)
+{
+    /* Panels of different sizes all over the frame (some of them are clipped). */
+    RenderBuffer *buffer = render->buffer;
+    u32 seed = index * 2654435761u + 1013904223;
+    u32 width = 120 + (seed >> 8) % 240;
+    u32 height = 90 + (seed >> 16) % 180;
+    u32 x = (seed >> 4) % (buffer->width + 64 - width / 2) - 32;
+    u32 y = ((seed * 7) >> 12) % (buffer->height + 64 - height / 2) - 32;
+
+    Color color, brd_color, highlight, label;
+    color.color = 0xff000000 | (seed & 0x7f7f7f);
+    brd_color.color = 0xffc0c0c0;
+    highlight.color = 0x60ffffff;
+    label.color = 0xffffffff;
+    const Image *icon = context->images[2];
+
+    /* Parts of the panel from the back: the frame, the highlight, the icon, the label. */
+    for (u32 i = 0; i < 4; ++i)
+    {
+        u32 part = is_front_to_back ? (3 - i) : i;
+        switch (part)
+        {
+        case 0:
+        {
+            Render_SetBlendMode(render, BM_NONE);
+            Render_DrawRectWithBrd(render, x, y, width, height, 2, &color, &brd_color);
+        } break;
+
+        case 1:
+        {
+            Render_SetBlendMode(render, BM_ALPHA);
+            Render_DrawRect(render, x + 2, y + height - 22, width - 4, 20, &highlight);
+        } break;
+
+        case 2:
+        {
+            Render_SetBlendMode(render, BM_ALPHA);
+            Render_DrawBitmap(render, x + 8, y + 8, (Image *)icon, 1);
+        } break;
+
+        default:
+        {
+            Render_SetBlendMode(render, BM_NONE);
+            Render_DrawString(render, context->font, "Panel", 0, x + 8,
+                y + height - 18, 2, &label);
+        }}
+    }
+}
+
+#ifdef RENDER_STATS
+static b32
+CheckStats(Render *render, const BenchContext *context, const BenchPrimitive *primitives,
+    u32 primitives_num, b32 is_timed)
+{
+    RenderBuffer *buffer = render->buffer;
+    size_t frame_size = sizeof(u32) * buffer->width * buffer->height;
+    b32 is_ok = true;
+
+    /* Rectangle drawn twice, clipped one and the one with the borders (no overdraw). */
+    Render_EnableStats(render, true);
+    Color color;
+    color.color = 0xff808080;
+    Render_DrawRect(render, 10, 10, 40, 20, &color);
+    Render_DrawRect(render, 10, 10, 40, 20, &color);
+    Render_DrawRect(render, (u32)-10, 50, 40, 20, &color);
+    Render_DrawRectWithBrd(render, 80, 40, 50, 30, 3, &color, &color);
+    Render_UpdateWindow(render);
+    RenderFrameStats stats;
+    Render_GetStats(render, &stats);
+    const RenderStatsCounters *rects = &stats.types[RCT_RECT];
+    if ((rects->calls != 8) || (rects->pixels_written != 800 + 800 + 600 + 1500) ||
+        (rects->pixels_overdrawn != 800) || (rects->pixels_rejected != 200) ||
+        (stats.pixels_touched != 800 + 600 + 1500) || (stats.max_writes != 2))
+    {
+        printf("  stats: rectangles are counted wrong (%llu calls, %llu written, %llu "
+            "overdrawn, %llu rejected)\n", (unsigned long long)rects->calls,
+            (unsigned long long)rects->pixels_written,
+            (unsigned long long)rects->pixels_overdrawn,
+            (unsigned long long)rects->pixels_rejected);
+        is_ok = false;
+    }
+
+    /* Heatmap: no writes, one write and two writes. */
+    Render_DrawStatsHeatmap(render);
+    const u32 *pixels = (const u32 *)buffer->bitmap_memory;
+    if ((pixels[5 + 5 * buffer->width] != 0xff000000) ||
+        (pixels[100 + 50 * buffer->width] != 0xff0000c0) ||
+        (pixels[20 + 20 * buffer->width] != 0xff00c0c0))
+    {
+        printf("  stats: heatmap colors are wrong\n");
+        is_ok = false;
+    }
+    memset(buffer->bitmap_memory, 0, frame_size);
+
+    /* Tiler workers count into their own slots, the sums should be the same. */
+    if (is_timed)
+    {
+        printf("\nrender statistics of a large and a clipped instance (no background):\n");
+        printf("%-18s %6s %8s %8s %8s %9s\n", "primitive", "calls", "written", "overdraw",
+            "rejected", "us");
+    }
+    for (u32 i = 0; i < primitives_num; ++i)
+    {
+        RenderFrameStats immediate, tiled;
+        GetPrimitiveStats(render, context, &primitives[i], &immediate);
+        Render_EnableTiling(render, 32, 4);
+        GetPrimitiveStats(render, context, &primitives[i], &tiled);
+        Render_DisableTiling(render);
+
+        const RenderStatsCounters *a = &immediate.total;
+        const RenderStatsCounters *b = &tiled.total;
+        if ((a->calls != b->calls) || (a->culled != b->culled) ||
+            (a->pixels_written != b->pixels_written) ||
+            (a->pixels_overdrawn != b->pixels_overdrawn) ||
+            (a->pixels_rejected != b->pixels_rejected) ||
+            (a->pixels_written != immediate.pixels_touched + a->pixels_overdrawn) ||
+            (immediate.max_writes != tiled.max_writes))
+        {
+            printf("  %s: statistics of the tiled drawing differ\n", primitives[i].name);
+            is_ok = false;
+        }
+        if (is_timed)
+        {
+            printf("%-18s %6llu %8llu %8llu %8llu %9.1f\n", primitives[i].name,
+                (unsigned long long)a->calls, (unsigned long long)a->pixels_written,
+                (unsigned long long)a->pixels_overdrawn,
+                (unsigned long long)a->pixels_rejected, (f64)a->time_ns / 1.0e3);
+        }
+    }
+    Render_DisableStats(render);
+    return is_ok;
+}
+
+static void
+GetPrimitiveStats(Render *render, const BenchContext *context,
+    const BenchPrimitive *primitive, RenderFrameStats *stats)
+{
+    RenderBuffer *buffer = render->buffer;
+    memset(buffer->bitmap_memory, 0, sizeof(u32) * buffer->width * buffer->height);
+    Render_UpdateWindow(render);
+    primitive->draw(render, context, 60.0f, 60.0f, 2);
+    primitive->draw(render, context, 155.0f, 60.0f, 1);
+    Render_SetBlendMode(render, BM_NONE);
+    Render_UpdateWindow(render);
+    Render_GetStats(render, stats);
+}
+#endif
+
+static f64
+MeasurePrimitive(Render *render, const BenchContext *context,
+    const BenchPrimitive *primitive, u32 size_index, u64 *pixels)
+{
+    RenderBuffer *buffer = render->buffer;
+    u32 buffer_size = buffer->width * buffer->height;
+    f32 x = 0.5f * (f32)buffer->width;
+    f32 y = 0.5f * (f32)buffer->height;
+
+    /* Pixels changed by a single call over the transparent black frame. */
+    memset(buffer->bitmap_memory, 0, sizeof(u32) * buffer_size);
+    primitive->draw(render, context, x, y, size_index);
+    Render_SetBlendMode(render, BM_NONE);
+    Render_Flush(render);
+    const u32 *memory = (const u32 *)buffer->bitmap_memory;
+    *pixels = 0;
+    for (u32 i = 0; i < buffer_size; ++i)
+    {
+        if (memory[i] != 0) (*pixels)++;
+    }
+
+    /* Repeat the drawing (moved by a few pixels) until the minimum time is reached. */
+    u64 calls = 0;
+    u64 begin = GetTimeNs();
+    u64 elapsed = 0;
+    while (elapsed < BENCH_MIN_TIME_NS)
+    {
+        for (u32 i = 0; i < 64; ++i)
+        {
+            primitive->draw(render, context, x + (f32)(i & 7), y + (f32)(i >> 3), size_index);
+        }
+        Render_Flush(render);
+        calls += 64;
+        elapsed = GetTimeNs() - begin;
+    }
+    Render_SetBlendMode(render, BM_NONE);
+    Render_ClearDirtyRects(render);
+    return (f64)elapsed / (f64)calls;
+}
+
+static void
+DrawClear(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c; (void)x; (void)y;
+    Color color;
+    color.color = 0xff000000 | (0x302010 * (s + 1));
+    Render_ClearScreen(r, &color);
+}
+
+static void
+DrawPixel(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c; (void)s;
+    Color color;
+    color.color = 0xffffff00;
+    Render_SetPixelColor(r, (u32)x, (u32)y, &color);
+}
+
+static void
+DrawLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Color color;
+    color.color = 0xffff8000;
+    Render_DrawLine(r, x - half, y - 0.6f * half, x + half, y + 0.6f * half, &color);
+}
+
+static void
+DrawLineAA(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Color color;
+    color.color = 0xffff8000;
+    Render_DrawLineAA(r, x - half, y - 0.6f * half, x + half, y + 0.6f * half, &color);
+}
+
+static void
+DrawThickLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Color color;
+    color.color = 0xff80ff00;
+    Render_DrawThickLine(r, x - half, y - 0.6f * half, x + half, y + 0.6f * half,
+        1.0f + half / 4.0f, &color);
+}
+
+static void
+DrawPolyline(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Vec2 points[5];
+    for (u32 i = 0; i < 5; ++i)
+    {
+        points[i].x = x - half + half * 0.5f * (f32)i;
+        points[i].y = y + ((i & 1) ? half : -half) * 0.5f;
+    }
+    Color color;
+    color.color = 0xff00c0ff;
+    Render_DrawPolyline(r, points, 5, 1.0f + half / 8.0f, false, &color);
+}
+
+static void
+DrawPolylineAA(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Vec2 points[5];
+    for (u32 i = 0; i < 5; ++i)
+    {
+        points[i].x = x - half + half * 0.5f * (f32)i;
+        points[i].y = y + ((i & 1) ? half : -half) * 0.5f;
+    }
+    Color color;
+    color.color = 0xff00c0ff;
+    Render_DrawPolyline(r, points, 5, 1.0f + half / 8.0f, true, &color);
+}
+
+static void
+DrawHorLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    u32 size = bench_sizes[s];
+    Color color;
+    color.color = 0xffffffff;
+    Render_DrawHorLine(r, (u32)(x - 0.5f * (f32)size), (u32)y, size, 1 + size / 16, &color);
+}
+
+static void
+DrawVerLine(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    u32 size = bench_sizes[s];
+    Color color;
+    color.color = 0xffffffff;
+    Render_DrawVerLine(r, (u32)x, (u32)(y - 0.5f * (f32)size), size, 1 + size / 16, &color);
+}
+
+static void
+DrawRect(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    u32 size = bench_sizes[s];
+    Color color;
+    color.color = 0xff4080ff;
+    Render_DrawRect(r, (u32)(x - 0.5f * (f32)size), (u32)(y - 0.5f * (f32)size), size, size,
+        &color);
+}
+
+static void
+DrawRectAlpha(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    u32 size = bench_sizes[s];
+    Color color;
+    color.color = 0x80ff4080;
+    Render_SetBlendMode(r, BM_ALPHA);
+    Render_DrawRect(r, (u32)(x - 0.5f * (f32)size), (u32)(y - 0.5f * (f32)size), size, size,
+        &color);
+}
+
+static void
+DrawRectWithBrd(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    u32 size = bench_sizes[s];
+    Color color, brd_color;
+    color.color = 0xff4080ff;
+    brd_color.color = 0xffffff80;
+    Render_DrawRectWithBrd(r, (u32)(x - 0.5f * (f32)size), (u32)(y - 0.5f * (f32)size),
+        size, size, 1 + size / 16, &color, &brd_color);
+}
+
+static void
+DrawTriangle(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Vec2 v1, v2, v3;
+    v1.x = x - half;
+    v1.y = y - half;
+    v2.x = x + half;
+    v2.y = y - 0.3f * half;
+    v3.x = x - 0.2f * half;
+    v3.y = y + half;
+    Color color;
+    color.color = 0xffc040ff;
+    Render_DrawFillTriangle(r, v1, v2, v3, &color);
+}
+
+static void
+DrawRotatedRect(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 size = (f32)bench_sizes[s];
+    Color color;
+    color.color = 0xff40ffc0;
+    Render_DrawRotatedRect(r, x, y, size, 0.6f * size, 30.0f, &color);
+}
+
+static void
+DrawPolygon(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+
+    /* Concave gear with the teeth of different depth. */
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Vec2 vertices[24];
+    for (u32 i = 0; i < 24; ++i)
+    {
+        f32 angle = 0.2618f * (f32)i;
+        f32 radius = (i % 2) ? half : half * ((i % 4) ? 0.6f : 0.35f);
+        vertices[i].x = x + radius * cosf(angle);
+        vertices[i].y = y + radius * sinf(angle);
+    }
+    Color color;
+    color.color = 0xff80ff40;
+    Render_DrawPolygon(r, vertices, 24, PFR_EVEN_ODD, &color);
+}
+
+static void
+DrawPolygonStar(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+
+    /* Self-intersecting pentagram, the center is inside by the non-zero rule only. */
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Vec2 vertices[5];
+    for (u32 i = 0; i < 5; ++i)
+    {
+        f32 angle = 1.5708f + 2.5133f * (f32)i;
+        vertices[i].x = x + half * cosf(angle);
+        vertices[i].y = y + half * sinf(angle);
+    }
+    Color color;
+    color.color = 0xc0ff8040;
+    Render_SetBlendMode(r, BM_ALPHA);
+    Render_DrawPolygon(r, vertices, 5, PFR_NON_ZERO, &color);
+}
+
+static void
+DrawCircle(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    Color color;
+    color.color = 0xffffc000;
+    Render_DrawCircle(r, x, y, 0.5f * (f32)bench_sizes[s], true, &color);
+}
+
+static void
+DrawCircleOutline(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    Color color;
+    color.color = 0xffffc000;
+    Render_DrawCircle(r, x, y, 0.5f * (f32)bench_sizes[s], false, &color);
+}
+
+static void
+DrawEllipse(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Color color;
+    color.color = 0xff00ff80;
+    Render_DrawEllipse(r, x, y, half, 0.6f * half, &color);
+}
+
+static void
+DrawRing(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    Color color;
+    color.color = 0xffff00ff;
+    Render_DrawRing(r, x, y, half, 1.0f + half / 4.0f, &color);
+}
+
+static void
+DrawCircles(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    RenderCircle circles[8];
+    for (u32 i = 0; i < 8; ++i)
+    {
+        circles[i].x0 = x + 0.75f * half * ((i & 1) ? 1.0f : -1.0f);
+        circles[i].y0 = y - half + 0.25f * half * (f32)i;
+        circles[i].radius = 0.25f * half;
+        circles[i].color = 0xff000000 | (0x1f3f5f * (i + 1));
+    }
+    Render_DrawCircles(r, circles, 8);
+}
+
+static void
+DrawRects(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+
+    /* Grid of the rectangles with the gaps between them. */
+    u32 size = bench_sizes[s];
+    u32 cell = size / 8 + 1;
+    RenderRectInstance rects[64];
+    for (u32 i = 0; i < 64; ++i)
+    {
+        rects[i].x0 = (u32)(x - 0.5f * (f32)size) + (i % 8) * cell;
+        rects[i].y0 = (u32)(y - 0.5f * (f32)size) + (i / 8) * cell;
+        rects[i].width = cell - cell / 4;
+        rects[i].height = cell - cell / 4;
+        rects[i].color = 0xff000000 | (0x0f1f2f * (i + 1));
+    }
+    Render_DrawRects(r, rects, 64);
+}
+
+static void
+DrawPoints(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    (void)c;
+
+    /* Points scattered over the square by a linear congruential generator. */
+    u32 size = bench_sizes[s];
+    RenderPoint points[256];
+    u32 seed = 7 + s;
+    for (u32 i = 0; i < 256; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        points[i].x = (u32)(x - 0.5f * (f32)size) + (seed >> 8) % size;
+        points[i].y = (u32)(y - 0.5f * (f32)size) + (seed >> 20) % size;
+        points[i].color = 0xff000000 | (seed & 0xffffff);
+    }
+    Render_DrawPoints(r, points, 256);
+}
+
+static void
+DrawBitmap(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    u32 size = bench_sizes[s];
+    Render_DrawBitmap(r, (u32)(x - 0.5f * (f32)size), (u32)(y - 0.5f * (f32)size),
+        c->images[s], 1);
+}
+
+static void
+DrawBitmapScaled(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    /* The image of the previous size is scaled to the size. */
+    u32 size = bench_sizes[s];
+    const Image *image = c->images[(s > 0) ? (s - 1) : 0];
+    u32 scale = size / image->width;
+    Render_DrawBitmap(r, (u32)(x - 0.5f * (f32)size), (u32)(y - 0.5f * (f32)size),
+        (Image *)image, scale);
+}
+
+static void
+DrawBitmapMask(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    u32 size = bench_sizes[s];
+    Color color;
+    color.color = 0xc0ff8040;
+    Render_SetBlendMode(r, BM_ALPHA);
+    Render_DrawBitmapByMask(r, (u32)(x - 0.5f * (f32)size), (u32)(y - 0.5f * (f32)size),
+        c->images[s], &color, 1);
+}
+
+static void
+DrawScaledNearest(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    /* Non-uniform fractional scale around the point. */
+    f32 size = (f32)bench_sizes[s];
+    Render_DrawScaledBitmap(r, x - 0.685f * size, y - 0.405f * size, c->images[s], 1.37f,
+        0.81f, TF_NEAREST);
+}
+
+static void
+DrawScaledBilinear(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    f32 size = (f32)bench_sizes[s];
+    Render_DrawScaledBitmap(r, x - 0.685f * size, y - 0.405f * size, c->images[s], 1.37f,
+        0.81f, TF_BILINEAR);
+}
+
+static void
+DrawRotatedNearest(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    Render_DrawRotatedBitmap(r, x, y, c->images[s], 30.0f, 1.0f, TF_NEAREST);
+}
+
+static void
+DrawRotatedBilinear(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    Render_DrawRotatedBitmap(r, x, y, c->images[s], 30.0f, 1.0f, TF_BILINEAR);
+}
+
+static void
+DrawTexturedTriangle(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    f32 half = 0.5f * (f32)bench_sizes[s];
+    f32 size = (f32)bench_sizes[s];
+    Vec2 v1, v2, v3, uv1, uv2, uv3;
+    v1.x = x - half;
+    v1.y = y - half;
+    v2.x = x + half;
+    v2.y = y - 0.3f * half;
+    v3.x = x - 0.2f * half;
+    v3.y = y + half;
+    uv1.x = 0.0f;
+    uv1.y = 0.0f;
+    uv2.x = size;
+    uv2.y = 0.0f;
+    uv3.x = 0.5f * size;
+    uv3.y = size;
+    Render_DrawTexturedTriangle(r, c->images[s], v1, v2, v3, uv1, uv2, uv3, TF_BILINEAR);
+}
+
+static void
+DrawText(Render *r, const BenchContext *c, f32 x, f32 y, u32 s)
+{
+    /* The string is about the size wide (6 symbols of FONT_SYM_WIDTH pixels). */
+    u32 size = bench_sizes[s];
+    u32 scale = (size >= 6 * FONT_SYM_WIDTH) ? (size / (6 * FONT_SYM_WIDTH)) : 1;
+    Color color;
+    color.color = 0xffffffff;
+    Render_DrawString(r, c->font, "Bench!", 0, (u32)(x - 0.5f * (f32)size),
+        (u32)(y - 0.5f * (f32)(scale * FONT_SYM_HEIGHT)), scale, &color);
+}
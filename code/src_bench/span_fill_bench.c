@@ -0,0 +1,210 @@
+/**
+ * ================================================================================
+ * @file src_bench/span_fill_bench.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Headless benchmark of the span fill kernels. Verifies every supported
+ * instruction set against the expected output and reports the throughput.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+
+#define BENCH_WIDTH WINDOW_WIDTH  /* Width of the benchmark frame. */
+#define BENCH_HEIGHT WINDOW_HEIGHT  /* Height of the benchmark frame. */
+#define BENCH_GUARD 64  /* Amount of guard pixels around the verified spans. */
+#define BENCH_MIN_TIME_NS 200000000ull  /* Minimum time of every measurement. */
+
+/**
+ * @brief Structure describing one benchmark case.
+ */
+struct BenchCase_
+{
+    const char *name;  /**< Name of the case. */
+    u32 x;  /**< X coordinate of the filled block. */
+    u32 y;  /**< Y coordinate of the filled block. */
+    u32 width;  /**< Width of the filled block. */
+    u32 height;  /**< Height of the filled block. */
+    b32 is_clear;  /**< Flag to use the full screen clear path. */
+};
+typedef struct BenchCase_ BenchCase;
+
+/**
+ * @brief Getting the current value of the monotonic clock.
+ * @return u64 Time in nanoseconds.
+ */
+static u64
+GetTimeNs(void);
+
+/**
+ * @brief Verification of the currently selected kernels for all the combinations
+ * of the span alignment and length.
+ * @return b32 Result of the verification.
+ */
+static b32
+VerifyKernels(void);
+
+/**
+ * @brief Running a single benchmark case with the currently selected kernels.
+ * @param frame Pointer to the frame memory.
+ * @param bench_case Pointer to the benchmark case.
+ */
+static void
+RunCase(u32 *frame, const BenchCase *bench_case);
+
+int
+main(void)
+{
+    static const BenchCase cases[] =
+    {
+        {"clear 1280x720", 0, 0, BENCH_WIDTH, BENCH_HEIGHT, true},
+        {"rect 1280x720", 0, 0, BENCH_WIDTH, BENCH_HEIGHT, false},
+        {"rect 100x100", 301, 300, 100, 100, false},
+        {"rect 7x7", 503, 200, 7, 7, false},
+        {"hor line 1280x1", 0, 360, BENCH_WIDTH, 1, false},
+        {"ver line 1x720", 641, 0, 1, BENCH_HEIGHT, false}
+    };
+    u32 cases_num = sizeof(cases) / sizeof(cases[0]);
+
+    u32 *frame = (u32 *)malloc(sizeof(u32) * BENCH_WIDTH * BENCH_HEIGHT);
+    if (frame == NULL)
+    {
+        printf("Frame allocation error!\n");
+        return 1;
+    }
+
+    b32 is_ok = true;
+    for (u32 isa = 0; isa < SFI_ISA_NUM; ++isa)
+    {
+        if (!SpanFill_SetIsa((SpanFillIsa)isa))
+        {
+            printf("[%s] not supported by the CPU\n", SpanFill_GetIsaName((SpanFillIsa)isa));
+            continue;
+        }
+
+        b32 is_verified = VerifyKernels();
+        printf("[%s] verification: %s\n", SpanFill_GetIsaName((SpanFillIsa)isa),
+            is_verified ? "ok" : "FAILED");
+        is_ok = is_ok && is_verified;
+
+        for (u32 i = 0; i < cases_num; ++i)
+        {
+            RunCase(frame, &cases[i]);
+        }
+    }
+
+    free(frame);
+    return is_ok ? 0 : 1;
+}
+
+static u64
+GetTimeNs(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (u64)((f64)counter.QuadPart * 1.0e9 / (f64)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+static b32
+VerifyKernels(void)
+{
+    u32 buffer[BENCH_GUARD * 2 + 160];
+    u32 guard = 0xdeadbeef;
+    u32 value = 0xff123456;
+
+    for (u32 offset = 0; offset < 8; ++offset)
+    {
+        for (u32 count = 0; count < 160 - 8; ++count)
+        {
+            for (u32 i = 0; i < sizeof(buffer) / sizeof(buffer[0]); ++i) buffer[i] = guard;
+
+            u32 *dst = buffer + BENCH_GUARD + offset;
+            SpanFill_Row(dst, count, value);
+
+            for (u32 i = 0; i < sizeof(buffer) / sizeof(buffer[0]); ++i)
+            {
+                b32 is_inside = (buffer + i >= dst) && (buffer + i < dst + count);
+                if (buffer[i] != (is_inside ? value : guard)) return false;
+            }
+        }
+    }
+
+    /* Non contiguous rows (pitch is larger than the width) and the clear path. */
+    u32 *frame = (u32 *)malloc(sizeof(u32) * BENCH_WIDTH * BENCH_HEIGHT);
+    if (frame == NULL) return false;
+    memset(frame, 0, sizeof(u32) * BENCH_WIDTH * BENCH_HEIGHT);
+
+    u32 pitch = BENCH_WIDTH * sizeof(u32);
+    SpanFill_Rect(frame + 3 + BENCH_WIDTH * 5, pitch, 37, 11, value);
+    b32 is_ok = true;
+    for (u32 y = 0; y < BENCH_HEIGHT && is_ok; ++y)
+    {
+        for (u32 x = 0; x < BENCH_WIDTH; ++x)
+        {
+            b32 is_inside = (x >= 3) && (x < 40) && (y >= 5) && (y < 16);
+            if (frame[x + BENCH_WIDTH * y] != (is_inside ? value : 0))
+            {
+                is_ok = false;
+                break;
+            }
+        }
+    }
+
+    SpanFill_Clear(frame, pitch, BENCH_WIDTH, BENCH_HEIGHT, guard);
+    for (u32 i = 0; (i < BENCH_WIDTH * BENCH_HEIGHT) && is_ok; ++i)
+    {
+        if (frame[i] != guard) is_ok = false;
+    }
+    free(frame);
+    return is_ok;
+}
+
+static void
+RunCase(u32 *frame, const BenchCase *bench_case)
+{
+    u32 pitch = BENCH_WIDTH * sizeof(u32);
+    u32 *dst = frame + bench_case->x + BENCH_WIDTH * bench_case->y;
+    u64 pixels = (u64)bench_case->width * bench_case->height;
+    u64 calls = 0;
+    u64 begin = GetTimeNs();
+    u64 elapsed = 0;
+
+    /* Repeat the batches of calls until the minimum measurement time is reached. */
+    while (elapsed < BENCH_MIN_TIME_NS)
+    {
+        for (u32 i = 0; i < 64; ++i)
+        {
+            u32 value = 0xff000000 | (u32)(calls + i);
+            if (bench_case->is_clear)
+                SpanFill_Clear(dst, pitch, bench_case->width, bench_case->height, value);
+            else
+                SpanFill_Rect(dst, pitch, bench_case->width, bench_case->height, value);
+        }
+        calls += 64;
+        elapsed = GetTimeNs() - begin;
+    }
+
+    f64 ns_per_call = (f64)elapsed / (f64)calls;
+    f64 mpixels_per_sec = (f64)(pixels * calls) / ((f64)elapsed * 1.0e-9) / 1.0e6;
+    printf("    %-18s %12.1f ns/call %12.1f Mpixels/s\n", bench_case->name, ns_per_call,
+        mpixels_per_sec);
+}
@@ -0,0 +1,272 @@
+/**
+ * ================================================================================
+ * @file src_bench/swap_chain_bench.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Headless benchmark of the swap chain handoff. A producer thread draws frames
+ * into the chain buffers and a fake consumer thread "presents" them periodically.
+ * Every frame is verified to be complete and newer than the previous one, and the
+ * frame counters of the chain are checked against the verified frames.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "include_engine/atomic.h"
+#include "include_engine/swap_chain.h"
+#include "include_engine/utils.h"
+
+#define BENCH_FRAMES_NUM 1000  /* Amount of the frames drawn by the producer. */
+#define BENCH_PIXELS_NUM 4096  /* Amount of the pixels in a fake buffer. */
+
+/**
+ * @brief Structure describing one benchmark case.
+ */
+struct BenchCase_
+{
+    const char *name;  /**< Name of the case. */
+    u32 buffers_num;  /**< Amount of the buffers in the chain. */
+    u32 draw_us;  /**< Time of drawing a single frame (busy). */
+    u32 present_us;  /**< Period of the consumer ticks (sleeping, as waiting for vblank). */
+};
+typedef struct BenchCase_ BenchCase;
+
+/**
+ * @brief Structure with data shared by the producer and the consumer threads.
+ */
+struct BenchData_
+{
+    const BenchCase *bench_case;  /**< Pointer to the benchmark case. */
+    SwapChain *swap_chain;  /**< Pointer to the swap chain. */
+    u32 *buffers[SWAP_CHAIN_BUFFERS_MAX];  /**< Memory of the fake buffers. */
+    atomic_s32 is_producing;  /**< Flag of the running producer. */
+    u64 handoff_ns;  /**< Total time spent by the producer in the handoff. */
+    u32 frames_verified;  /**< Amount of the new frames verified by the consumer. */
+    u32 errors_num;  /**< Amount of the torn or outdated frames seen by the consumer. */
+};
+typedef struct BenchData_ BenchData;
+
+/**
+ * @brief Getting the current value of the monotonic clock.
+ * @return u64 Time in nanoseconds.
+ */
+static u64
+GetTimeNs(void);
+
+/**
+ * @brief Busy waiting for the specified time (imitation of the work).
+ * @param us Time in microseconds.
+ */
+static void
+SpinFor(u32 us);
+
+/**
+ * @brief Sleeping for at least the specified time.
+ * @param us Time in microseconds.
+ */
+static void
+SleepFor(u32 us);
+
+/**
+ * @brief Producer procedure: drawing the frames and publishing them.
+ * @param data Pointer to the BenchData structure.
+ */
+static void
+ProduceFrames(BenchData *data);
+
+/**
+ * @brief Consumer procedure: taking the newest frames and verifying them.
+ * @param data Pointer to the BenchData structure.
+ */
+static void
+ConsumeFrames(BenchData *data);
+
+/**
+ * @brief Running a single benchmark case.
+ * @param bench_case Pointer to the benchmark case.
+ * @return b32 Result of the verification.
+ */
+static b32
+RunCase(const BenchCase *bench_case);
+
+#ifdef _WIN32
+static DWORD WINAPI
+ConsumerThreadProc(void *data)
+{
+    ConsumeFrames((BenchData *)data);
+    return 0;
+}
+#else
+static void*
+ConsumerThreadProc(void *data)
+{
+    ConsumeFrames((BenchData *)data);
+    return NULL;
+}
+#endif
+
+int
+main(void)
+{
+    static const BenchCase cases[] =
+    {
+        {"double, fast present", 2, 2000, 500},
+        {"double, slow present", 2, 500, 2000},
+        {"triple, fast present", 3, 2000, 500},
+        {"triple, slow present", 3, 500, 2000},
+        {"triple, no drawing", 3, 0, 100}
+    };
+    u32 cases_num = sizeof(cases) / sizeof(cases[0]);
+
+    b32 is_ok = true;
+    for (u32 i = 0; i < cases_num; ++i)
+    {
+        is_ok = RunCase(&cases[i]) && is_ok;
+    }
+    return is_ok ? 0 : 1;
+}
+
+static u64
+GetTimeNs(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (u64)((f64)counter.QuadPart * 1.0e9 / (f64)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+static void
+SpinFor(u32 us)
+{
+    u64 end = GetTimeNs() + (u64)us * 1000;
+    while (GetTimeNs() < end);
+}
+
+static void
+SleepFor(u32 us)
+{
+#ifdef _WIN32
+    Sleep((us + 999) / 1000);
+#else
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static void
+ProduceFrames(BenchData *data)
+{
+    SwapChain *swap_chain = data->swap_chain;
+    for (u32 frame = 1; frame <= BENCH_FRAMES_NUM; ++frame)
+    {
+        /* Draw the frame: every pixel gets the number of the frame. */
+        u32 *buffer = data->buffers[swap_chain->back];
+        for (u32 i = 0; i < BENCH_PIXELS_NUM; ++i) buffer[i] = frame;
+        SpinFor(data->bench_case->draw_us);
+
+        u64 begin = GetTimeNs();
+        SwapChain_Publish(swap_chain);
+        SwapChain_WaitBack(swap_chain);
+        data->handoff_ns += GetTimeNs() - begin;
+    }
+    Atomic_Store(&data->is_producing, false);
+}
+
+static void
+ConsumeFrames(BenchData *data)
+{
+    SwapChain *swap_chain = data->swap_chain;
+    u32 frame_last = 0;
+    b32 is_producing = true;
+    while (is_producing)
+    {
+        /* The last frame is taken after the producer has stopped. */
+        is_producing = Atomic_Load(&data->is_producing);
+        if (SwapChain_AcquireFront(swap_chain))
+        {
+            /* The frame should be newer than the previous one and should be complete. */
+            u32 frame = swap_chain->frames[swap_chain->front];
+            const u32 *buffer = data->buffers[swap_chain->front];
+            if (frame <= frame_last) data->errors_num++;
+            for (u32 i = 0; i < BENCH_PIXELS_NUM; ++i)
+            {
+                if (buffer[i] != frame)
+                {
+                    data->errors_num++;
+                    break;
+                }
+            }
+            frame_last = frame;
+            data->frames_verified++;
+        }
+        SleepFor(data->bench_case->present_us);
+    }
+}
+
+static b32
+RunCase(const BenchCase *bench_case)
+{
+    BenchData data;
+    memset(&data, 0, sizeof(data));
+    data.bench_case = bench_case;
+    data.swap_chain = SwapChain_Constructor();
+    SwapChain_Init(data.swap_chain, bench_case->buffers_num);
+    for (u32 i = 0; i < bench_case->buffers_num; ++i)
+    {
+        data.buffers[i] = (u32 *)calloc(BENCH_PIXELS_NUM, sizeof(u32));
+    }
+    Atomic_Store(&data.is_producing, true);
+
+    u64 begin = GetTimeNs();
+#ifdef _WIN32
+    HANDLE consumer = CreateThread(0, 0, ConsumerThreadProc, &data, 0, 0);
+    ProduceFrames(&data);
+    WaitForSingleObject(consumer, INFINITE);
+    CloseHandle(consumer);
+#else
+    pthread_t consumer;
+    pthread_create(&consumer, NULL, ConsumerThreadProc, &data);
+    ProduceFrames(&data);
+    pthread_join(consumer, NULL);
+#endif
+    u64 elapsed = GetTimeNs() - begin;
+
+    /* Every published frame is either taken or dropped, double buffering drops none. */
+    SwapChainStats stats;
+    SwapChain_GetStats(data.swap_chain, &stats);
+    b32 is_ok = (data.errors_num == 0) &&
+        (stats.frames_published == BENCH_FRAMES_NUM) &&
+        (stats.frames_presented == data.frames_verified) &&
+        (stats.frames_presented + stats.frames_dropped == stats.frames_published) &&
+        ((bench_case->buffers_num == 3) || (stats.frames_dropped == 0));
+
+    printf("%-22s %s: %6u presented %6u dropped %7u repeated, %7.1f ns/handoff, "
+        "%6.1f ms\n", bench_case->name, is_ok ? "ok" : "FAILED", stats.frames_presented,
+        stats.frames_dropped, stats.frames_repeated,
+        (f64)data.handoff_ns / (f64)BENCH_FRAMES_NUM, (f64)elapsed * 1.0e-6);
+
+    for (u32 i = 0; i < bench_case->buffers_num; ++i)
+    {
+        free(data.buffers[i]);
+    }
+    data.swap_chain = SwapChain_Destructor(data.swap_chain);
+    return is_ok;
+}
@@ -0,0 +1,230 @@
+/**
+ * ================================================================================
+ * @file src_bench/upscaler_bench.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Headless benchmark of the upscaler. Verifies every supported instruction set
+ * and the multithreaded scaling against the single threaded scalar output (and the
+ * nearest filters against the direct pixel mapping), then reports the throughput.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "include_engine/span_fill.h"
+#include "include_engine/upscaler.h"
+#include "include_engine/utils.h"
+
+#define BENCH_MIN_TIME_NS 200000000ull  /* Minimum time of every measurement. */
+
+/**
+ * @brief Structure describing one benchmark case.
+ */
+struct BenchCase_
+{
+    const char *name;  /**< Name of the case. */
+    u32 src_width;  /**< Width of the internal resolution. */
+    u32 src_height;  /**< Height of the internal resolution. */
+    u32 dst_width;  /**< Width of the output. */
+    u32 dst_height;  /**< Height of the output. */
+};
+typedef struct BenchCase_ BenchCase;
+
+/**
+ * @brief Getting the current value of the monotonic clock.
+ * @return u64 Time in nanoseconds.
+ */
+static u64
+GetTimeNs(void);
+
+/**
+ * @brief Verification of the currently selected kernels with all the filters.
+ * @param src Pointer to the source buffer (large enough for every case).
+ * @param bench_case Pointer to the benchmark case.
+ * @param reference Output of the scalar kernels of every filter (filled for SFI_SCALAR).
+ * @return b32 Result of the verification.
+ */
+static b32
+VerifyCase(const u32 *src, const BenchCase *bench_case, u32 **reference);
+
+/**
+ * @brief Measuring the time of the scaling with the currently selected kernels.
+ * @param upscaler Pointer to the configured upscaler.
+ * @param src Pointer to the source buffer.
+ * @return f64 Time of a single scaling in nanoseconds.
+ */
+static f64
+MeasureRun(Upscaler *upscaler, const u32 *src);
+
+int
+main(void)
+{
+    static const BenchCase cases[] =
+    {
+        {"640x360 -> 1920x1080", 640, 360, 1920, 1080},
+        {"640x360 -> 2560x1440", 640, 360, 2560, 1440},
+        {"640x360 -> 1366x768", 640, 360, 1366, 768},
+        {"1280x720 -> 1920x1080", 1280, 720, 1920, 1080},
+        {"1264x681 -> 1264x681", 1264, 681, 1264, 681},
+        {"7x5 -> 53x31", 7, 5, 53, 31}
+    };
+    static const char *filter_names[UF_FILTERS_NUM] = {"integer", "nearest", "bilinear"};
+    u32 cases_num = sizeof(cases) / sizeof(cases[0]);
+
+    /* Source with the pseudo random pixels (every channel is used). */
+    u32 src_size = 1280 * 720;
+    u32 *src = (u32 *)malloc(sizeof(u32) * src_size);
+    u32 *reference[UF_FILTERS_NUM];
+    if (src == NULL)
+    {
+        printf("Buffer allocation error!\n");
+        return 1;
+    }
+    u32 seed = 12345;
+    for (u32 i = 0; i < src_size; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        src[i] = seed;
+    }
+
+    b32 is_ok = true;
+    for (u32 i = 0; i < cases_num; ++i)
+    {
+        const BenchCase *bench_case = &cases[i];
+        u32 dst_size = bench_case->dst_width * bench_case->dst_height;
+        for (u32 filter = 0; filter < UF_FILTERS_NUM; ++filter)
+        {
+            reference[filter] = (u32 *)malloc(sizeof(u32) * dst_size);
+        }
+
+        printf("%s\n", bench_case->name);
+        for (u32 isa = 0; isa < SFI_ISA_NUM; ++isa)
+        {
+            if (!SpanFill_SetIsa((SpanFillIsa)isa)) continue;
+
+            b32 is_verified = VerifyCase(src, bench_case, reference);
+            printf("  [%s] verification: %s\n", SpanFill_GetIsaName((SpanFillIsa)isa),
+                is_verified ? "ok" : "FAILED");
+            is_ok = is_ok && is_verified;
+
+            /* Single thread (no pool) and all the CPU cores. */
+            Upscaler *single = Upscaler_Constructor();
+            Upscaler *multi = Upscaler_Constructor();
+            Upscaler_Init(multi, 0);
+            for (u32 filter = 0; filter < UF_FILTERS_NUM; ++filter)
+            {
+                Upscaler_Configure(single, bench_case->src_width, bench_case->src_height,
+                    bench_case->dst_width, bench_case->dst_height, (UpscaleFilter)filter);
+                Upscaler_Configure(multi, bench_case->src_width, bench_case->src_height,
+                    bench_case->dst_width, bench_case->dst_height, (UpscaleFilter)filter);
+                f64 single_ns = MeasureRun(single, src);
+                f64 multi_ns = MeasureRun(multi, src);
+                printf("    %-9s %9.3f ms/frame (1 thread) %9.3f ms/frame (all cores)\n",
+                    filter_names[filter], single_ns * 1.0e-6, multi_ns * 1.0e-6);
+            }
+            single = Upscaler_Destructor(single);
+            multi = Upscaler_Destructor(multi);
+        }
+
+        for (u32 filter = 0; filter < UF_FILTERS_NUM; ++filter)
+        {
+            free(reference[filter]);
+        }
+    }
+
+    free(src);
+    return is_ok ? 0 : 1;
+}
+
+static u64
+GetTimeNs(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (u64)((f64)counter.QuadPart * 1.0e9 / (f64)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
+
+static b32
+VerifyCase(const u32 *src, const BenchCase *bench_case, u32 **reference)
+{
+    u32 dst_width = bench_case->dst_width;
+    u32 dst_height = bench_case->dst_height;
+    u32 dst_size = dst_width * dst_height;
+    b32 is_scalar = (SpanFill_GetIsa() == SFI_SCALAR);
+    b32 is_ok = true;
+
+    Upscaler *single = Upscaler_Constructor();
+    Upscaler *multi = Upscaler_Constructor();
+    Upscaler_Init(multi, 3);
+    for (u32 filter = 0; filter < UF_FILTERS_NUM; ++filter)
+    {
+        Upscaler_Configure(single, bench_case->src_width, bench_case->src_height, dst_width,
+            dst_height, (UpscaleFilter)filter);
+        Upscaler_Configure(multi, bench_case->src_width, bench_case->src_height, dst_width,
+            dst_height, (UpscaleFilter)filter);
+        const u32 *output = Upscaler_Run(single, src);
+        if (is_scalar) memcpy(reference[filter], output, sizeof(u32) * dst_size);
+        if (memcmp(output, reference[filter], sizeof(u32) * dst_size) != 0) is_ok = false;
+        output = Upscaler_Run(multi, src);
+        if (memcmp(output, reference[filter], sizeof(u32) * dst_size) != 0) is_ok = false;
+        if (!is_scalar || (filter == UF_BILINEAR)) continue;
+
+        /* Nearest filters: every pixel of the image is the source pixel under its
+        center, the borders are black. */
+        for (u32 y = 0; y < dst_height; ++y)
+        {
+            for (u32 x = 0; x < dst_width; ++x)
+            {
+                u32 expected = 0;
+                s64 ix = (s64)x - single->image_x;
+                s64 iy = (s64)y - single->image_y;
+                if ((ix >= 0) && (iy >= 0) && (ix < single->image_width) &&
+                    (iy < single->image_height))
+                {
+                    u64 sx = ((2 * (u64)ix + 1) * bench_case->src_width) /
+                        (2 * (u64)single->image_width);
+                    u64 sy = ((2 * (u64)iy + 1) * bench_case->src_height) /
+                        (2 * (u64)single->image_height);
+                    expected = src[sx + sy * bench_case->src_width];
+                }
+                if (output[x + y * dst_width] != expected) is_ok = false;
+            }
+        }
+    }
+    single = Upscaler_Destructor(single);
+    multi = Upscaler_Destructor(multi);
+    return is_ok;
+}
+
+static f64
+MeasureRun(Upscaler *upscaler, const u32 *src)
+{
+    u64 runs = 0;
+    u64 begin = GetTimeNs();
+    u64 elapsed = 0;
+
+    /* Repeat the scaling until the minimum measurement time is reached. */
+    while (elapsed < BENCH_MIN_TIME_NS)
+    {
+        Upscaler_Run(upscaler, src);
+        runs++;
+        elapsed = GetTimeNs() - begin;
+    }
+    return (f64)elapsed / (f64)runs;
+}
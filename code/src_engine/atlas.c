@@ -0,0 +1,476 @@
+/**
+ * ================================================================================
+ * @file src_engine/atlas.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the work with the texture atlases.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/atlas.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/image.h"
+#include "include_engine/memory_object.h"
+#include "include_engine/pixel_format.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Structure for a segment of the skyline (the top edge of the packed area).
+ */
+struct SkylineNode_
+{
+    u32 x;  /**< X coordinate of the left end of the segment. */
+    u32 y;  /**< Height of the packed area under the segment. */
+    u32 width;  /**< Width of the segment. */
+};
+typedef struct SkylineNode_ SkylineNode;
+
+/**
+ * @brief Structure for the skyline of a page being packed.
+ */
+struct SkylinePage_
+{
+    SkylineNode *nodes;  /**< Segments of the skyline from left to right. */
+    u32 nodes_num;  /**< Amount of the segments. */
+    u32 used_width;  /**< Width of the area covered by the images. */
+    u32 used_height;  /**< Height of the area covered by the images. */
+};
+typedef struct SkylinePage_ SkylinePage;
+
+/**
+ * @brief Structure for an image waiting for the packing.
+ */
+struct PackItem_
+{
+    u32 index;  /**< Index of the image in the input array. */
+    u32 width;  /**< Width of the image with the padding. */
+    u32 height;  /**< Height of the image with the padding. */
+};
+typedef struct PackItem_ PackItem;
+
+/**
+ * @brief Comparison of the items for the packing order (the tallest and the widest
+ * items first, the input order for the equal ones).
+ * @param a Pointer to the first item.
+ * @param b Pointer to the second item.
+ * @return int Negative value if the first item goes first.
+ */
+static int
+ComparePackItems(const void *a, const void *b);
+
+/**
+ * @brief Finding the position of a rectangle on the skyline with the lowest top edge
+ * (the leftmost one of the equal).
+ * @param page Pointer to the skyline of the page.
+ * @param width Width of the rectangle.
+ * @param height Height of the rectangle.
+ * @param page_width Width of the page.
+ * @param page_height Height of the page.
+ * @param node_index Pointer to the index of the segment at the left end of the place.
+ * @param y Pointer to the Y coordinate of the place.
+ * @return b32 Flag of the found place.
+ */
+static b32
+FindSkylinePosition(const SkylinePage *page, u32 width, u32 height, u32 page_width,
+    u32 page_height, u32 *node_index, u32 *y);
+
+/**
+ * @brief Raising the skyline over the placed rectangle.
+ * @param page Pointer to the skyline of the page.
+ * @param node_index Index of the segment at the left end of the rectangle.
+ * @param y Y coordinate of the rectangle.
+ * @param width Width of the rectangle.
+ * @param height Height of the rectangle.
+ */
+static void
+AddSkylineNode(SkylinePage *page, u32 node_index, u32 y, u32 width, u32 height);
+
+/**
+ * @brief Copying the bytes to the cursor and moving the cursor forward.
+ * @param cursor Pointer to the write cursor.
+ * @param data Pointer to the bytes to copy.
+ * @param size Amount of bytes.
+ */
+static void
+WriteBytes(u8 **cursor, const void *data, size_t size);
+
+/**
+ * @brief Copying the bytes from the cursor and moving the cursor forward. The reading
+ * past the end of the serialized data is an error.
+ * @param cursor Pointer to the read cursor.
+ * @param end Pointer to the end of the serialized data.
+ * @param data Pointer to the destination.
+ * @param size Amount of bytes.
+ */
+static void
+ReadBytes(const u8 **cursor, const u8 *end, void *data, size_t size);
+
+Atlas*
+Atlas_Constructor(void)
+{
+    size_t size = sizeof(Atlas);
+    Atlas *atlas = (Atlas *)HelperFcn_MemAllocate(size);
+    return atlas;
+}
+
+Atlas*
+Atlas_Destructor(Atlas *atlas)
+{
+    for (u32 i = 0; i < atlas->pages_num; ++i)
+    {
+        Image_Destructor(atlas->pages[i]);
+    }
+    if (atlas->pages) HelperFcn_MemFree(atlas->pages);
+    if (atlas->regions) HelperFcn_MemFree(atlas->regions);
+    if (atlas->region_pages) HelperFcn_MemFree(atlas->region_pages);
+    HelperFcn_MemFree(atlas);
+    return NULL;
+}
+
+void
+Atlas_InitByImages(Atlas *atlas, Image *const *images, u32 images_num, u32 page_width,
+    u32 page_height, u32 padding)
+{
+    atlas->regions = (ImageRegion *)HelperFcn_MemAllocate((images_num ? images_num : 1) *
+        sizeof(ImageRegion));
+    atlas->region_pages = (u32 *)HelperFcn_MemAllocate((images_num ? images_num : 1) *
+        sizeof(u32));
+    atlas->regions_num = images_num;
+
+    /* The padding on the right and top sides of the last images may leave the page. */
+    u32 pack_width = page_width + padding;
+    u32 pack_height = page_height + padding;
+
+    PackItem *items = (PackItem *)HelperFcn_MemAllocate((images_num ? images_num : 1) *
+        sizeof(PackItem));
+    for (u32 i = 0; i < images_num; ++i)
+    {
+        const Image *image = images[i];
+        if ((image->width == 0) || (image->height == 0))
+        {
+            dbg_error("%s", "Empty image could not be packed into the atlas!");
+        }
+        if ((image->width > page_width) || (image->height > page_height))
+        {
+            dbg_error("%s", "Image is larger than the atlas page!");
+        }
+        items[i].index = i;
+        items[i].width = image->width + padding;
+        items[i].height = image->height + padding;
+    }
+    qsort(items, images_num, sizeof(PackItem), ComparePackItems);
+
+    /* Every item is placed into the first page it fits into. Every segment of the skyline
+    is at least a pixel wide, so the page width limits their amount. */
+    SkylinePage *skylines = (SkylinePage *)HelperFcn_MemAllocate((images_num ?
+        images_num : 1) * sizeof(SkylinePage));
+    u32 pages_num = 0;
+    for (u32 i = 0; i < images_num; ++i)
+    {
+        const PackItem *item = items + i;
+        u32 page_index = 0;
+        u32 node_index = 0;
+        u32 y = 0;
+        for (; page_index < pages_num; ++page_index)
+        {
+            if (FindSkylinePosition(skylines + page_index, item->width, item->height,
+                pack_width, pack_height, &node_index, &y))
+            {
+                break;
+            }
+        }
+        if (page_index == pages_num)
+        {
+            SkylinePage *skyline = skylines + pages_num++;
+            skyline->nodes = (SkylineNode *)HelperFcn_MemAllocate((pack_width + 1) *
+                sizeof(SkylineNode));
+            skyline->nodes[0].width = pack_width;
+            skyline->nodes_num = 1;
+            node_index = 0;
+            y = 0;
+        }
+
+        SkylinePage *skyline = skylines + page_index;
+        const Image *image = images[item->index];
+        ImageRegion *region = atlas->regions + item->index;
+        region->x = skyline->nodes[node_index].x;
+        region->y = y;
+        region->width = image->width;
+        region->height = image->height;
+        atlas->region_pages[item->index] = page_index;
+        if (region->x + region->width > skyline->used_width)
+            skyline->used_width = region->x + region->width;
+        if (region->y + region->height > skyline->used_height)
+            skyline->used_height = region->y + region->height;
+        AddSkylineNode(skyline, node_index, y, item->width, item->height);
+    }
+
+    /* Pages are filled with the transparent pixels and the converted images. */
+    atlas->pages = (Image **)HelperFcn_MemAllocate((pages_num ? pages_num : 1) *
+        sizeof(Image *));
+    atlas->pages_num = pages_num;
+    for (u32 i = 0; i < pages_num; ++i)
+    {
+        Image *page = Image_Constructor();
+        page->width = skylines[i].used_width;
+        page->height = skylines[i].used_height;
+        page->channels = 4;
+        page->format = PF_BGRA;
+        size_t size = (size_t)page->width * page->height * sizeof(u32);
+        page->data = HelperFcn_MemAllocate(size ? size : 1);
+        atlas->pages[i] = page;
+        HelperFcn_MemFree(skylines[i].nodes);
+    }
+    for (u32 i = 0; i < images_num; ++i)
+    {
+        const Image *image = images[i];
+        ImageRegion *region = atlas->regions + i;
+        Image *page = atlas->pages[atlas->region_pages[i]];
+        region->image = page;
+
+        u32 src_pitch = PixelFormat_GetPitch(image->format, image->width);
+        for (u32 row = 0; row < image->height; ++row)
+        {
+            u32 *dst = (u32 *)page->data + (size_t)(region->y + row) * page->width +
+                region->x;
+            PixelFormat_ConvertRow(dst, PF_BGRA, (const u8 *)image->data +
+                (size_t)src_pitch * row, image->format, image->width);
+        }
+    }
+    for (u32 i = 0; i < pages_num; ++i)
+    {
+        Image_CompileSprite(atlas->pages[i]);
+    }
+
+    HelperFcn_MemFree(skylines);
+    HelperFcn_MemFree(items);
+}
+
+void
+Atlas_Serialize(const Atlas *atlas, MemObject *mem_object)
+{
+    /* Header: magic, version, pages_num and regions_num. */
+    u32 header[4];
+    header[0] = ATLAS_MAGIC;
+    header[1] = ATLAS_VERSION;
+    header[2] = atlas->pages_num;
+    header[3] = atlas->regions_num;
+
+    /* Determine the size of the serialized data. */
+    u64 size = sizeof(header) + (u64)atlas->regions_num * 5 * sizeof(u32);
+    for (u32 i = 0; i < atlas->pages_num; ++i)
+    {
+        const Image *page = atlas->pages[i];
+        size += 3 * sizeof(u32) + (u64)PixelFormat_GetPitch(page->format, page->width) *
+            page->height;
+    }
+    MemObject_InitBySize(mem_object, size);
+
+    u8 *cursor = mem_object->data;
+    WriteBytes(&cursor, header, sizeof(header));
+
+    /* Pages: width, height, pixel format and the pixels. */
+    for (u32 i = 0; i < atlas->pages_num; ++i)
+    {
+        const Image *page = atlas->pages[i];
+        u32 page_header[3];
+        page_header[0] = page->width;
+        page_header[1] = page->height;
+        page_header[2] = page->format;
+        WriteBytes(&cursor, page_header, sizeof(page_header));
+        WriteBytes(&cursor, page->data,
+            (size_t)PixelFormat_GetPitch(page->format, page->width) * page->height);
+    }
+
+    /* Regions: page, x, y, width and height. */
+    for (u32 i = 0; i < atlas->regions_num; ++i)
+    {
+        const ImageRegion *region = atlas->regions + i;
+        u32 region_data[5];
+        region_data[0] = atlas->region_pages[i];
+        region_data[1] = region->x;
+        region_data[2] = region->y;
+        region_data[3] = region->width;
+        region_data[4] = region->height;
+        WriteBytes(&cursor, region_data, sizeof(region_data));
+    }
+}
+
+void
+Atlas_InitByMemObject(Atlas *atlas, MemObject *mem_object)
+{
+    const u8 *cursor = mem_object->data;
+    const u8 *end = mem_object->data + mem_object->size;
+
+    u32 header[4];
+    ReadBytes(&cursor, end, header, sizeof(header));
+    if ((header[0] != ATLAS_MAGIC) || (header[1] != ATLAS_VERSION))
+    {
+        dbg_error("%s", "Unsupported atlas format!");
+    }
+    u32 pages_num = header[2];
+    u32 regions_num = header[3];
+
+    /* Restore the pages. */
+    atlas->pages = (Image **)HelperFcn_MemAllocate((pages_num ? pages_num : 1) *
+        sizeof(Image *));
+    for (u32 i = 0; i < pages_num; ++i)
+    {
+        u32 page_header[3];
+        ReadBytes(&cursor, end, page_header, sizeof(page_header));
+        if (page_header[2] >= PF_FORMATS_NUM)
+        {
+            dbg_error("%s", "Unsupported pixel format of the atlas page!");
+        }
+        Image *page = Image_Constructor();
+        page->width = page_header[0];
+        page->height = page_header[1];
+        page->channels = 4;
+        page->format = (PixelFormat)page_header[2];
+        size_t size = (size_t)PixelFormat_GetPitch(page->format, page->width) *
+            page->height;
+        page->data = HelperFcn_MemAllocate(size ? size : 1);
+        ReadBytes(&cursor, end, page->data, size);
+        Image_CompileSprite(page);
+        atlas->pages[atlas->pages_num++] = page;
+    }
+
+    /* Restore the regions and check them, so the drawing is safe. */
+    atlas->regions = (ImageRegion *)HelperFcn_MemAllocate((regions_num ? regions_num : 1) *
+        sizeof(ImageRegion));
+    atlas->region_pages = (u32 *)HelperFcn_MemAllocate((regions_num ? regions_num : 1) *
+        sizeof(u32));
+    atlas->regions_num = regions_num;
+    for (u32 i = 0; i < regions_num; ++i)
+    {
+        u32 region_data[5];
+        ReadBytes(&cursor, end, region_data, sizeof(region_data));
+        dbg_check(region_data[0] < pages_num, "%s", "Broken atlas region!");
+        const Image *page = atlas->pages[region_data[0]];
+        dbg_check((region_data[1] <= page->width)
+            && (region_data[3] <= page->width - region_data[1])
+            && (region_data[2] <= page->height)
+            && (region_data[4] <= page->height - region_data[2]), "%s",
+            "Broken atlas region!");
+
+        ImageRegion *region = atlas->regions + i;
+        region->image = page;
+        region->x = region_data[1];
+        region->y = region_data[2];
+        region->width = region_data[3];
+        region->height = region_data[4];
+        atlas->region_pages[i] = region_data[0];
+    }
+}
+
+static int
+ComparePackItems(const void *a, const void *b)
+{
+    const PackItem *item_a = (const PackItem *)a;
+    const PackItem *item_b = (const PackItem *)b;
+    if (item_a->height != item_b->height) return (item_a->height > item_b->height) ? -1 : 1;
+    if (item_a->width != item_b->width) return (item_a->width > item_b->width) ? -1 : 1;
+    return (item_a->index < item_b->index) ? -1 : 1;
+}
+
+static b32
+FindSkylinePosition(const SkylinePage *page, u32 width, u32 height, u32 page_width,
+    u32 page_height, u32 *node_index, u32 *y)
+{
+    b32 is_found = false;
+    u32 best_top = 0;
+    for (u32 i = 0; i < page->nodes_num; ++i)
+    {
+        const SkylineNode *node = page->nodes + i;
+        if (node->x + width > page_width) break;
+
+        /* The rectangle lies on the highest of the segments under it. */
+        u32 top = 0;
+        u32 covered = 0;
+        for (u32 j = i; covered < width; ++j)
+        {
+            if (page->nodes[j].y > top) top = page->nodes[j].y;
+            covered += page->nodes[j].width;
+        }
+        if (top + height > page_height) continue;
+        if (!is_found || (top + height < best_top))
+        {
+            is_found = true;
+            best_top = top + height;
+            *node_index = i;
+            *y = top;
+        }
+    }
+    return is_found;
+}
+
+static void
+AddSkylineNode(SkylinePage *page, u32 node_index, u32 y, u32 width, u32 height)
+{
+    SkylineNode *nodes = page->nodes;
+    SkylineNode node;
+    node.x = nodes[node_index].x;
+    node.y = y + height;
+    node.width = width;
+    memmove(nodes + node_index + 1, nodes + node_index,
+        (page->nodes_num - node_index) * sizeof(SkylineNode));
+    nodes[node_index] = node;
+    page->nodes_num++;
+
+    /* Segments covered by the new one are shortened or removed. */
+    u32 i = node_index + 1;
+    while (i < page->nodes_num)
+    {
+        u32 right = nodes[i - 1].x + nodes[i - 1].width;
+        if (nodes[i].x >= right) break;
+        u32 shrink = right - nodes[i].x;
+        if (nodes[i].width > shrink)
+        {
+            nodes[i].x += shrink;
+            nodes[i].width -= shrink;
+            break;
+        }
+        memmove(nodes + i, nodes + i + 1, (page->nodes_num - i - 1) * sizeof(SkylineNode));
+        page->nodes_num--;
+    }
+
+    /* Neighbour segments of the same height are merged. */
+    for (u32 j = 0; j + 1 < page->nodes_num;)
+    {
+        if (nodes[j].y == nodes[j + 1].y)
+        {
+            nodes[j].width += nodes[j + 1].width;
+            memmove(nodes + j + 1, nodes + j + 2,
+                (page->nodes_num - j - 2) * sizeof(SkylineNode));
+            page->nodes_num--;
+        }
+        else
+        {
+            ++j;
+        }
+    }
+}
+
+static void
+WriteBytes(u8 **cursor, const void *data, size_t size)
+{
+    memcpy(*cursor, data, size);
+    *cursor += size;
+}
+
+static void
+ReadBytes(const u8 **cursor, const u8 *end, void *data, size_t size)
+{
+    if ((size_t)(end - *cursor) < size)
+    {
+        dbg_error("%s", "Unexpected end of the atlas data!");
+    }
+    memcpy(data, *cursor, size);
+    *cursor += size;
+}
@@ -0,0 +1,354 @@
+/**
+ * ================================================================================
+ * @file src_engine/batch_raster.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the drawing of the batches of filled rectangles,
+ * circles and points binned into the bands of rows.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/batch_raster.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/ellipse_raster.h"
+#include "include_engine/render.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Intersection of the rectangle with the clip rectangle. Coordinates are treated
+ * as signed ones, as in Render_DrawRect.
+ * @param rect Pointer to the rectangle.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param result Result of the intersection.
+ * @return b32 False if the intersection is empty.
+ */
+static b32
+ClipInstance(const RenderRectInstance *rect, const RenderRect *clip, RenderRect *result);
+
+/**
+ * @brief Getting the range of the bands with the pixels of the circle inside of the
+ * clip rectangle (the rows and columns of EllipseRaster_Fill).
+ * @param circle Pointer to the circle.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param band_first First band of the range.
+ * @param band_last Last band of the range (included).
+ * @return b32 False if the circle has no pixels inside of the clip rectangle.
+ */
+static b32
+GetCircleBands(const RenderCircle *circle, const RenderRect *clip, u32 *band_first,
+    u32 *band_last);
+
+/**
+ * @brief Getting the range of the bands crossed by the clip rectangle.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param bands_num Amount of the bands.
+ * @param band_begin First band of the range.
+ * @param band_end Band after the last band of the range.
+ */
+static void
+GetBandRange(const RenderRect *clip, u32 bands_num, u32 *band_begin, u32 *band_end);
+
+u32
+BatchRaster_GetBandsNum(const RenderRect *clip)
+{
+    if (clip->y1 <= 0) return 0;
+    return ((u32)clip->y1 + BATCH_RASTER_BAND_ROWS - 1) / BATCH_RASTER_BAND_ROWS;
+}
+
+u32
+BatchRaster_CountRects(const RenderRectInstance *rects, u32 rects_num,
+    const RenderRect *clip, u32 *band_offsets)
+{
+    /* Counts are stored with the shift by one, as the prefix sum of the binning needs. */
+    u32 bands_num = BatchRaster_GetBandsNum(clip);
+    memset(band_offsets, 0, (bands_num + 1) * sizeof(u32));
+
+    u32 parts_num = 0;
+    for (u32 i = 0; i < rects_num; ++i)
+    {
+        RenderRect rect;
+        if (!ClipInstance(&rects[i], clip, &rect)) continue;
+        u32 band_first = (u32)rect.y0 / BATCH_RASTER_BAND_ROWS;
+        u32 band_last = (u32)(rect.y1 - 1) / BATCH_RASTER_BAND_ROWS;
+        for (u32 band = band_first; band <= band_last; ++band)
+        {
+            band_offsets[band + 1]++;
+        }
+        parts_num += band_last - band_first + 1;
+    }
+    return parts_num;
+}
+
+void
+BatchRaster_BinRects(const RenderRectInstance *rects, u32 rects_num,
+    const RenderRect *clip, BlendMode blend, u32 *band_offsets, RenderRectInstance *parts)
+{
+    u32 bands_num = BatchRaster_GetBandsNum(clip);
+    for (u32 band = 1; band <= bands_num; ++band)
+    {
+        band_offsets[band] += band_offsets[band - 1];
+    }
+
+    /* Parts are written in the order of the rectangles, band_offsets[b] is the write
+    cursor of the band b, so it ends up at the beginning of the band b + 1. */
+    for (u32 i = 0; i < rects_num; ++i)
+    {
+        RenderRect rect;
+        if (!ClipInstance(&rects[i], clip, &rect)) continue;
+        u32 color = (blend != BM_NONE) ? Blend_Premultiply(rects[i].color) : rects[i].color;
+        u32 band_first = (u32)rect.y0 / BATCH_RASTER_BAND_ROWS;
+        u32 band_last = (u32)(rect.y1 - 1) / BATCH_RASTER_BAND_ROWS;
+        for (u32 band = band_first; band <= band_last; ++band)
+        {
+            s32 y0 = (s32)(band * BATCH_RASTER_BAND_ROWS);
+            s32 y1 = y0 + BATCH_RASTER_BAND_ROWS;
+            if (y0 < rect.y0) y0 = rect.y0;
+            if (y1 > rect.y1) y1 = rect.y1;
+
+            RenderRectInstance *part = &parts[band_offsets[band]++];
+            part->x0 = (u32)rect.x0;
+            part->y0 = (u32)y0;
+            part->width = (u32)(rect.x1 - rect.x0);
+            part->height = (u32)(y1 - y0);
+            part->color = color;
+        }
+    }
+
+    /* Shift the cursors back, so the band b is [band_offsets[b], band_offsets[b + 1]). */
+    memmove(band_offsets + 1, band_offsets, bands_num * sizeof(u32));
+    band_offsets[0] = 0;
+}
+
+u32
+BatchRaster_CountCircles(const RenderCircle *circles, u32 circles_num,
+    const RenderRect *clip, u32 *band_offsets)
+{
+    u32 bands_num = BatchRaster_GetBandsNum(clip);
+    memset(band_offsets, 0, (bands_num + 1) * sizeof(u32));
+
+    u32 binned_num = 0;
+    for (u32 i = 0; i < circles_num; ++i)
+    {
+        u32 band_first, band_last;
+        if (!GetCircleBands(&circles[i], clip, &band_first, &band_last)) continue;
+        for (u32 band = band_first; band <= band_last; ++band)
+        {
+            band_offsets[band + 1]++;
+        }
+        binned_num += band_last - band_first + 1;
+    }
+    return binned_num;
+}
+
+void
+BatchRaster_BinCircles(const RenderCircle *circles, u32 circles_num,
+    const RenderRect *clip, u32 *band_offsets, RenderCircle *binned)
+{
+    u32 bands_num = BatchRaster_GetBandsNum(clip);
+    for (u32 band = 1; band <= bands_num; ++band)
+    {
+        band_offsets[band] += band_offsets[band - 1];
+    }
+
+    /* Copies keep the order of the circles inside of every band. */
+    for (u32 i = 0; i < circles_num; ++i)
+    {
+        u32 band_first, band_last;
+        if (!GetCircleBands(&circles[i], clip, &band_first, &band_last)) continue;
+        for (u32 band = band_first; band <= band_last; ++band)
+        {
+            binned[band_offsets[band]++] = circles[i];
+        }
+    }
+
+    memmove(band_offsets + 1, band_offsets, bands_num * sizeof(u32));
+    band_offsets[0] = 0;
+}
+
+u32
+BatchRaster_BinPoints(const RenderPoint *points, const u32 *xs, const u32 *ys,
+    const u32 *colors, u32 points_num, const RenderRect *clip, u32 *band_offsets,
+    RenderPoint *binned)
+{
+    u32 bands_num = BatchRaster_GetBandsNum(clip);
+    memset(band_offsets, 0, (bands_num + 1) * sizeof(u32));
+
+    /* Both layouts are read through the strided pointers. */
+    u32 stride = 1;
+    if (points)
+    {
+        xs = &points->x;
+        ys = &points->y;
+        colors = &points->color;
+        stride = sizeof(RenderPoint) / sizeof(u32);
+    }
+
+    /* Coordinates are treated as signed ones, as in Render_SetPixelColor. */
+    u32 binned_num = 0;
+    for (u32 i = 0, j = 0; i < points_num; ++i, j += stride)
+    {
+        s32 x = (s32)xs[j];
+        s32 y = (s32)ys[j];
+        if ((x < clip->x0) || (x >= clip->x1) || (y < clip->y0) || (y >= clip->y1))
+            continue;
+        band_offsets[(u32)y / BATCH_RASTER_BAND_ROWS + 1]++;
+        binned_num++;
+    }
+
+    for (u32 band = 1; band <= bands_num; ++band)
+    {
+        band_offsets[band] += band_offsets[band - 1];
+    }
+
+    for (u32 i = 0, j = 0; i < points_num; ++i, j += stride)
+    {
+        s32 x = (s32)xs[j];
+        s32 y = (s32)ys[j];
+        if ((x < clip->x0) || (x >= clip->x1) || (y < clip->y0) || (y >= clip->y1))
+            continue;
+        RenderPoint *point = &binned[band_offsets[(u32)y / BATCH_RASTER_BAND_ROWS]++];
+        point->x = (u32)x;
+        point->y = (u32)y;
+        point->color = colors[j];
+    }
+
+    memmove(band_offsets + 1, band_offsets, bands_num * sizeof(u32));
+    band_offsets[0] = 0;
+    return binned_num;
+}
+
+void
+BatchRaster_FillRects(void *memory, u32 pitch, const RenderRect *clip,
+    const RenderRectInstance *parts, const u32 *band_offsets, u32 bands_num,
+    BlendMode blend)
+{
+    u32 band_begin, band_end;
+    GetBandRange(clip, bands_num, &band_begin, &band_end);
+    for (u32 i = band_offsets[band_begin]; i < band_offsets[band_end]; ++i)
+    {
+        RenderRect rect;
+        if (!ClipInstance(&parts[i], clip, &rect)) continue;
+
+        u32 *dst = (u32 *)((u8 *)memory + (size_t)pitch * (u32)rect.y0) + rect.x0;
+        u32 width = (u32)(rect.x1 - rect.x0);
+        u32 height = (u32)(rect.y1 - rect.y0);
+        if (blend == BM_NONE)
+        {
+            SpanFill_Rect(dst, pitch, width, height, parts[i].color);
+            continue;
+        }
+        for (u32 y = 0; y < height; ++y)
+        {
+            Blend_RowColor(dst, width, parts[i].color, blend);
+            dst = (u32 *)((u8 *)dst + pitch);
+        }
+    }
+}
+
+void
+BatchRaster_FillCircles(void *memory, u32 pitch, const RenderRect *clip,
+    const RenderCircle *circles, const u32 *band_offsets, u32 bands_num,
+    BlendMode blend)
+{
+    u32 band_begin, band_end;
+    GetBandRange(clip, bands_num, &band_begin, &band_end);
+    for (u32 band = band_begin; band < band_end; ++band)
+    {
+        /* Spans of a copy are restricted to the rows of its band. */
+        RenderRect band_clip = *clip;
+        s32 y0 = (s32)(band * BATCH_RASTER_BAND_ROWS);
+        s32 y1 = y0 + BATCH_RASTER_BAND_ROWS;
+        if (band_clip.y0 < y0) band_clip.y0 = y0;
+        if (band_clip.y1 > y1) band_clip.y1 = y1;
+        for (u32 i = band_offsets[band]; i < band_offsets[band + 1]; ++i)
+        {
+            const RenderCircle *circle = &circles[i];
+            EllipseRaster_Fill(memory, pitch, &band_clip, circle->x0, circle->y0,
+                circle->radius, circle->radius, 0.0f, circle->color, blend);
+        }
+    }
+}
+
+void
+BatchRaster_PlotPoints(void *memory, u32 pitch, const RenderRect *clip,
+    const RenderPoint *points, const u32 *band_offsets, u32 bands_num)
+{
+    u32 band_begin, band_end;
+    GetBandRange(clip, bands_num, &band_begin, &band_end);
+
+    /* Points of the clip bands are only tested against the clip columns and rows. */
+    u32 x_min = (u32)clip->x0;
+    u32 y_min = (u32)clip->y0;
+    u32 width = (u32)(clip->x1 - clip->x0);
+    u32 height = (u32)(clip->y1 - clip->y0);
+    for (u32 i = band_offsets[band_begin]; i < band_offsets[band_end]; ++i)
+    {
+        const RenderPoint *point = &points[i];
+        if ((point->x - x_min >= width) || (point->y - y_min >= height)) continue;
+        u32 *row = (u32 *)((u8 *)memory + (size_t)pitch * point->y);
+        row[point->x] = point->color;
+        RENDER_STATS_COUNT_ROW(&row[point->x], 1);
+    }
+}
+
+static b32
+ClipInstance(const RenderRectInstance *rect, const RenderRect *clip, RenderRect *result)
+{
+    s64 x0 = (s32)rect->x0;
+    s64 y0 = (s32)rect->y0;
+    s64 x1 = x0 + rect->width;
+    s64 y1 = y0 + rect->height;
+    if (x0 < clip->x0) x0 = clip->x0;
+    if (y0 < clip->y0) y0 = clip->y0;
+    if (x1 > clip->x1) x1 = clip->x1;
+    if (y1 > clip->y1) y1 = clip->y1;
+    if ((x0 >= x1) || (y0 >= y1)) return false;
+
+    result->x0 = (s32)x0;
+    result->y0 = (s32)y0;
+    result->x1 = (s32)x1;
+    result->y1 = (s32)y1;
+    return true;
+}
+
+static b32
+GetCircleBands(const RenderCircle *circle, const RenderRect *clip, u32 *band_first,
+    u32 *band_last)
+{
+    f32 x0 = circle->x0;
+    f32 y0 = circle->y0;
+    f32 radius = circle->radius;
+    if (!isfinite(x0) || !isfinite(y0) || !(radius > 0.0f) || !isfinite(radius))
+        return false;
+
+    /* Pixels with the centers inside of the bounding square of the circle. */
+    f32 x_begin = fmaxf(ceilf(x0 - radius - 0.5f), (f32)clip->x0);
+    f32 x_end = fminf(floorf(x0 + radius - 0.5f) + 1.0f, (f32)clip->x1);
+    f32 y_begin = fmaxf(ceilf(y0 - radius - 0.5f), (f32)clip->y0);
+    f32 y_end = fminf(floorf(y0 + radius - 0.5f) + 1.0f, (f32)clip->y1);
+    if ((x_begin >= x_end) || (y_begin >= y_end)) return false;
+
+    *band_first = (u32)y_begin / BATCH_RASTER_BAND_ROWS;
+    *band_last = (u32)(y_end - 1.0f) / BATCH_RASTER_BAND_ROWS;
+    return true;
+}
+
+static void
+GetBandRange(const RenderRect *clip, u32 bands_num, u32 *band_begin, u32 *band_end)
+{
+    *band_begin = 0;
+    *band_end = 0;
+    if ((clip->y0 >= clip->y1) || (clip->x0 >= clip->x1)) return;
+    u32 band_first = (u32)clip->y0 / BATCH_RASTER_BAND_ROWS;
+    u32 band_last = (u32)(clip->y1 - 1) / BATCH_RASTER_BAND_ROWS;
+    if (band_first >= bands_num) return;
+    *band_begin = band_first;
+    *band_end = (band_last < bands_num) ? band_last + 1 : bands_num;
+}
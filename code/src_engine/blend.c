@@ -0,0 +1,332 @@
+/**
+ * ================================================================================
+ * @file src_engine/blend.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for blending rows of 32 bit pixels (ARGB).
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/blend.h"
+
+#include <string.h>
+
+#include "include_engine/render_stats.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BLEND_X86
+#include <immintrin.h>
+#endif
+
+/* GCC and Clang need the target attribute to compile the intrinsics of an
+instruction set which is not enabled for the whole translation unit. */
+#if defined(BLEND_X86) && !defined(_MSC_VER)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+/* Amount of pixels of the tinted colors prepared at once. */
+#define BLEND_TINT_CHUNK 64
+
+/* Declare pointer to the row blend kernel. The source pointer is advanced by the step
+after every pixel, so the step 0 blends a single color. */
+typedef void blend_row_t(u32 *dst, const u32 *src, u32 src_step, u32 count, BlendMode mode);
+
+/**
+ * @brief Division of a product of two 8 bit values by 255 with rounding.
+ * @param value Product (up to 255 * 255).
+ * @return u32 Result of the division.
+ */
+static u32
+Div255(u32 value);
+
+/**
+ * @brief Blending a row of pixels with plain C code.
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel.
+ * @param src_step Step of the source pointer (0 or 1).
+ * @param count Amount of pixels in the row.
+ * @param mode Blend mode (except BM_NONE).
+ */
+static void
+BlendRowScalar(u32 *dst, const u32 *src, u32 src_step, u32 count, BlendMode mode);
+
+#ifdef BLEND_X86
+/**
+ * @brief Blending 4 pixels with SSE2 operations (channels are widened to 16 bits).
+ * @param s Source pixels.
+ * @param d Destination pixels.
+ * @param mode Blend mode (except BM_NONE).
+ * @return __m128i Blended pixels.
+ */
+static __m128i
+BlendPixelsSse2(__m128i s, __m128i d, BlendMode mode);
+
+/**
+ * @brief Blending 8 pixels with AVX2 operations (channels are widened to 16 bits).
+ * @param s Source pixels.
+ * @param d Destination pixels.
+ * @param mode Blend mode (except BM_NONE).
+ * @return __m256i Blended pixels.
+ */
+static __m256i
+BlendPixelsAvx2(__m256i s, __m256i d, BlendMode mode);
+
+/**
+ * @brief Blending a row of pixels with 128 bit SSE2 operations (4 pixels at once).
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel.
+ * @param src_step Step of the source pointer (0 or 1).
+ * @param count Amount of pixels in the row.
+ * @param mode Blend mode (except BM_NONE).
+ */
+static void
+BlendRowSse2(u32 *dst, const u32 *src, u32 src_step, u32 count, BlendMode mode);
+
+/**
+ * @brief Blending a row of pixels with 256 bit AVX2 operations (8 pixels at once).
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel.
+ * @param src_step Step of the source pointer (0 or 1).
+ * @param count Amount of pixels in the row.
+ * @param mode Blend mode (except BM_NONE).
+ */
+static void
+BlendRowAvx2(u32 *dst, const u32 *src, u32 src_step, u32 count, BlendMode mode);
+#endif
+
+/* Kernels for every instruction set of the span fill (SpanFillIsa order). */
+#ifdef BLEND_X86
+static blend_row_t *blend_row[SFI_ISA_NUM] =
+{
+    BlendRowScalar, BlendRowSse2, BlendRowAvx2
+};
+#else
+static blend_row_t *blend_row[SFI_ISA_NUM] =
+{
+    BlendRowScalar, BlendRowScalar, BlendRowScalar
+};
+#endif
+
+u32
+Blend_Premultiply(u32 color)
+{
+    u32 alpha = color >> 24;
+    u32 red = Div255(((color >> 16) & 0xff) * alpha);
+    u32 green = Div255(((color >> 8) & 0xff) * alpha);
+    u32 blue = Div255((color & 0xff) * alpha);
+    return (alpha << 24) | (red << 16) | (green << 8) | blue;
+}
+
+void
+Blend_Row(u32 *dst, const u32 *src, u32 count, BlendMode mode)
+{
+    RENDER_STATS_COUNT_ROW(dst, count);
+    if (mode == BM_NONE)
+    {
+        memcpy(dst, src, count * sizeof(u32));
+        return;
+    }
+    blend_row[SpanFill_GetIsa()](dst, src, 1, count, mode);
+}
+
+void
+Blend_RowColor(u32 *dst, u32 count, u32 color, BlendMode mode)
+{
+    if (mode == BM_NONE)
+    {
+        SpanFill_Row(dst, count, color);
+        return;
+    }
+    RENDER_STATS_COUNT_ROW(dst, count);
+    blend_row[SpanFill_GetIsa()](dst, &color, 0, count, mode);
+}
+
+void
+Blend_RowTinted(u32 *dst, const u32 *src, u32 count, u32 color, BlendMode mode)
+{
+    if (mode == BM_NONE) mode = BM_ALPHA;
+    blend_row_t *kernel = blend_row[SpanFill_GetIsa()];
+    RENDER_STATS_COUNT_ROW(dst, count);
+
+    /* The color is scaled by the alpha of every source pixel chunk by chunk. */
+    u32 tinted[BLEND_TINT_CHUNK];
+    while (count > 0)
+    {
+        u32 chunk = (count < BLEND_TINT_CHUNK) ? count : BLEND_TINT_CHUNK;
+        for (u32 i = 0; i < chunk; ++i)
+        {
+            u32 alpha = src[i] >> 24;
+            if (alpha == 0xff)
+            {
+                tinted[i] = color;
+                continue;
+            }
+            u32 value = 0;
+            for (u32 shift = 0; shift < 32; shift += 8)
+            {
+                value |= Div255(((color >> shift) & 0xff) * alpha) << shift;
+            }
+            tinted[i] = value;
+        }
+        kernel(dst, tinted, 1, chunk, mode);
+        dst += chunk;
+        src += chunk;
+        count -= chunk;
+    }
+}
+
+static u32
+Div255(u32 value)
+{
+    value += 128;
+    return (value + (value >> 8)) >> 8;
+}
+
+static void
+BlendRowScalar(u32 *dst, const u32 *src, u32 src_step, u32 count, BlendMode mode)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 s = *src;
+        u32 d = dst[i];
+        u32 s_alpha = s >> 24;
+        u32 result = 0;
+
+        /* Every channel (the alpha one included) is blended by the same rule. */
+        for (u32 shift = 0; shift < 32; shift += 8)
+        {
+            u32 s_channel = (s >> shift) & 0xff;
+            u32 d_channel = (d >> shift) & 0xff;
+            u32 channel;
+            if (mode == BM_ADD)
+            {
+                channel = s_channel + d_channel;
+                if (channel > 0xff) channel = 0xff;
+            }
+            else if (mode == BM_MULTIPLY)
+            {
+                channel = Div255(d_channel * (s_channel + 0xff - s_alpha));
+            }
+            else
+            {
+                channel = s_channel + Div255(d_channel * (0xff - s_alpha));
+            }
+            result |= channel << shift;
+        }
+        dst[i] = result;
+        src += src_step;
+    }
+}
+
+#ifdef BLEND_X86
+TARGET_SSE2 static __m128i
+BlendPixelsSse2(__m128i s, __m128i d, BlendMode mode)
+{
+    if (mode == BM_ADD) return _mm_adds_epu8(s, d);
+
+    __m128i zero = _mm_setzero_si128();
+    __m128i max = _mm_set1_epi16(0xff);
+    __m128i half = _mm_set1_epi16(128);
+    __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+    __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+    __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+    __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+
+    /* Factor of the destination: 1 - sa (or s + 1 - sa for the multiplication). */
+    __m128i f_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, 0xff), 0xff);
+    __m128i f_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, 0xff), 0xff);
+    f_lo = _mm_sub_epi16(max, f_lo);
+    f_hi = _mm_sub_epi16(max, f_hi);
+    if (mode == BM_MULTIPLY)
+    {
+        f_lo = _mm_add_epi16(f_lo, s_lo);
+        f_hi = _mm_add_epi16(f_hi, s_hi);
+    }
+
+    /* Division by 255 with rounding: (x + 128 + ((x + 128) >> 8)) >> 8. */
+    __m128i p_lo = _mm_add_epi16(_mm_mullo_epi16(d_lo, f_lo), half);
+    __m128i p_hi = _mm_add_epi16(_mm_mullo_epi16(d_hi, f_hi), half);
+    p_lo = _mm_srli_epi16(_mm_add_epi16(p_lo, _mm_srli_epi16(p_lo, 8)), 8);
+    p_hi = _mm_srli_epi16(_mm_add_epi16(p_hi, _mm_srli_epi16(p_hi, 8)), 8);
+    if (mode != BM_MULTIPLY)
+    {
+        p_lo = _mm_add_epi16(p_lo, s_lo);
+        p_hi = _mm_add_epi16(p_hi, s_hi);
+    }
+    return _mm_packus_epi16(p_lo, p_hi);
+}
+
+TARGET_SSE2 static void
+BlendRowSse2(u32 *dst, const u32 *src, u32 src_step, u32 count, BlendMode mode)
+{
+    __m128i color = _mm_set1_epi32((int)*src);
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i s = src_step ? _mm_loadu_si128((const __m128i *)(src + i)) : color;
+        __m128i d = _mm_loadu_si128((__m128i *)(dst + i));
+        _mm_storeu_si128((__m128i *)(dst + i), BlendPixelsSse2(s, d, mode));
+    }
+    BlendRowScalar(dst + i, src + i * src_step, src_step, count - i, mode);
+}
+
+TARGET_AVX2 static __m256i
+BlendPixelsAvx2(__m256i s, __m256i d, BlendMode mode)
+{
+    if (mode == BM_ADD) return _mm256_adds_epu8(s, d);
+
+    __m256i zero = _mm256_setzero_si256();
+    __m256i max = _mm256_set1_epi16(0xff);
+    __m256i half = _mm256_set1_epi16(128);
+    __m256i s_lo = _mm256_unpacklo_epi8(s, zero);
+    __m256i s_hi = _mm256_unpackhi_epi8(s, zero);
+    __m256i d_lo = _mm256_unpacklo_epi8(d, zero);
+    __m256i d_hi = _mm256_unpackhi_epi8(d, zero);
+
+    /* Factor of the destination: 1 - sa (or s + 1 - sa for the multiplication). */
+    __m256i f_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_lo, 0xff), 0xff);
+    __m256i f_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s_hi, 0xff), 0xff);
+    f_lo = _mm256_sub_epi16(max, f_lo);
+    f_hi = _mm256_sub_epi16(max, f_hi);
+    if (mode == BM_MULTIPLY)
+    {
+        f_lo = _mm256_add_epi16(f_lo, s_lo);
+        f_hi = _mm256_add_epi16(f_hi, s_hi);
+    }
+
+    /* Division by 255 with rounding: (x + 128 + ((x + 128) >> 8)) >> 8. */
+    __m256i p_lo = _mm256_add_epi16(_mm256_mullo_epi16(d_lo, f_lo), half);
+    __m256i p_hi = _mm256_add_epi16(_mm256_mullo_epi16(d_hi, f_hi), half);
+    p_lo = _mm256_srli_epi16(_mm256_add_epi16(p_lo, _mm256_srli_epi16(p_lo, 8)), 8);
+    p_hi = _mm256_srli_epi16(_mm256_add_epi16(p_hi, _mm256_srli_epi16(p_hi, 8)), 8);
+    if (mode != BM_MULTIPLY)
+    {
+        p_lo = _mm256_add_epi16(p_lo, s_lo);
+        p_hi = _mm256_add_epi16(p_hi, s_hi);
+    }
+
+    /* Unpacking and packing work inside 128 bit lanes, so the order is kept. */
+    return _mm256_packus_epi16(p_lo, p_hi);
+}
+
+TARGET_AVX2 static void
+BlendRowAvx2(u32 *dst, const u32 *src, u32 src_step, u32 count, BlendMode mode)
+{
+    __m256i color = _mm256_set1_epi32((int)*src);
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i s = src_step ? _mm256_loadu_si256((const __m256i *)(src + i)) : color;
+        __m256i d = _mm256_loadu_si256((__m256i *)(dst + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), BlendPixelsAvx2(s, d, mode));
+    }
+    BlendRowScalar(dst + i, src + i * src_step, src_step, count - i, mode);
+}
+#endif
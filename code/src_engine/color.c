@@ -12,6 +12,7 @@
 
 #include "include_engine/color.h"
 
+#include "include_engine/blend.h"
 #include "include_engine/dbg.h"
 #include "include_engine/helper_functions.h"
 #include "include_engine/utils.h"
@@ -58,52 +59,17 @@ Color_SetGray(Color *color, u8 alpha, u8 value)
 void
 Color_MakeAlphaBlending(Color *color_res, Color *color_bkg, Color *color_frg, f32 alpha)
 {
-    u8 R_res, G_res, B_res;  /* Result color components. */
+    /* Mix the colors in 8 bit fixed point: res = frg * alpha + bkg * (1 - alpha). */
+    u32 alpha_u8 = 0;
+    if (alpha >= 1.0f)
+        alpha_u8 = 0xff;
+    else if (alpha > 0.0f)
+        alpha_u8 = (u32)(alpha * 255.0f + 0.5f);
 
-    u8 R_bkg = color_bkg->red;
-    u8 G_bkg = color_bkg->green;
-    u8 B_bkg = color_bkg->blue;
-    u8 R_frg = color_frg->red;
-    u8 G_frg = color_frg->green;
-    u8 B_frg = color_frg->blue;
-       
-    /* Determine the output color components (after mixing). */
-    if (R_bkg >= R_frg)
-    {
-        f32 delta = (f32)(R_bkg - R_frg);
-        R_res = R_frg + (u8)(delta * (1.0 - alpha));
-    } 
-    else
-    {
-        f32 delta = (f32)(R_frg - R_bkg);
-        R_res = R_bkg + (u8)(delta * alpha); 
-    }
-
-    if (G_bkg >= G_frg)
-    {
-        f32 delta = (f32)(G_bkg - G_frg);
-        G_res = G_frg + (u8)(delta * (1.0 - alpha));
-    }
-    else
-    {
-        f32 delta = (f32)(G_frg - G_bkg);
-        G_res = G_bkg + (u8)(delta * alpha); 
-    }
-
-    if (B_bkg >= B_frg)
-    {
-        f32 delta = (f32)(B_bkg - B_frg);
-        B_res = B_frg + (u8)(delta * (1.0 - alpha));
-    }
-    else
-    {
-        f32 delta = (f32)(B_frg - B_bkg);
-        B_res = B_bkg + (u8)(delta * alpha); 
-    }
+    u32 color_frg_premul = Blend_Premultiply((alpha_u8 << 24) | (color_frg->color & 0x00ffffff));
+    u32 color_mix = color_bkg->color;
+    Blend_RowColor(&color_mix, 1, color_frg_premul, BM_ALPHA);
 
     /* Return the result color. */
-    color_res->alpha = 0xff;
-    color_res->red = R_res;
-    color_res->green = G_res;
-    color_res->blue = B_res;
-}
\ No newline at end of file
+    color_res->color = color_mix | 0xff000000;
+}
@@ -10,6 +10,7 @@
 
 #include "include_engine/debug_console.h"
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -18,6 +19,7 @@
 #include "include_engine/font.h"
 #include "include_engine/helper_functions.h"
 #include "include_engine/render.h"
+#include "include_engine/render_stats.h"
 #include "include_engine/utils.h"
 
 DConsole*
@@ -58,7 +60,7 @@ DConsole_Destructor(DConsole *dconsole)
 
 void
 DConsole_Init(DConsole *dconsole, u32 x, u32 y, u32 width, Color *bkg_color, 
-    Color *brd_color, u32 margin_width, Color *game_bkg_color, Font *font)
+    Color *brd_color, u32 margin_width, Font *font)
 {
     /* Initialize different DConsole fields. */
     dconsole->x = x;
@@ -70,9 +72,9 @@ DConsole_Init(DConsole *dconsole, u32 x, u32 y, u32 width, Color *bkg_color,
     dconsole->bkg_color = bkg_color;
     dconsole->brd_color = brd_color;
     dconsole->margin_width = margin_width;
-    dconsole->game_bkg_color = game_bkg_color;
     dconsole->font = font;
     dconsole->message_index = 0;  
+    dconsole->is_visible = false;
 }
 
 void
@@ -96,6 +98,38 @@ DConsole_AddMessage(DConsole *dconsole, char *msg_str, Color *color)
     }
 }
 
+void
+DConsole_AddRenderStats(DConsole *dconsole, const RenderFrameStats *stats, u32 types_num,
+    Color *color)
+{
+    /* Lines longer than the message are truncated. */
+    char msg_str[128];
+    u32 size = (dconsole->max_msg_length < sizeof(msg_str)) ? dconsole->max_msg_length :
+        (u32)sizeof(msg_str);
+    char name[32];
+    snprintf(name, sizeof(name), "frame %llu", (unsigned long long)stats->frame);
+    RenderStats_Format(&stats->total, name, msg_str, size);
+    DConsole_AddMessage(dconsole, msg_str, color);
+
+    /* Types are picked by the selection, there are only a few of them. */
+    b32 is_added[RCT_TYPES_NUM] = {0};
+    for (u32 i = 0; i < types_num; ++i)
+    {
+        s32 slowest = -1;
+        for (u32 type = 0; type < RCT_TYPES_NUM; ++type)
+        {
+            if (is_added[type] || (stats->types[type].calls == 0)) continue;
+            if ((slowest < 0) || (stats->types[type].time_ns > stats->types[slowest].time_ns))
+                slowest = (s32)type;
+        }
+        if (slowest < 0) break;
+        is_added[slowest] = true;
+        RenderStats_Format(&stats->types[slowest],
+            RenderStats_GetTypeName((RenderCmdType)slowest), msg_str, size);
+        DConsole_AddMessage(dconsole, msg_str, color);
+    }
+}
+
 void
 DConsole_ClearMessages(DConsole *dconsole)
 {
@@ -116,8 +150,10 @@ DConsole_ClearConsole(DConsole *dconsole, Render *render)
 void
 DConsole_Hide(DConsole *dconsole, Render *render)
 {
-    Render_DrawRect(render, dconsole->x , dconsole->y, dconsole->width, dconsole->height,
-        dconsole->game_bkg_color);
+    if (!dconsole->is_visible) return;
+    Render_SetLayerVisible(render, RL_DEBUG, false);
+    Render_DisableStats(render);
+    dconsole->is_visible = false;
 }
 
 void
@@ -127,6 +163,15 @@ DConsole_Render(DConsole *dconsole, Render *render)
     u32 y_pos = dconsole->y + dconsole->height - dconsole->margin_width - 7;  
     u32 max_width = dconsole->width - dconsole->margin_width * 2;
     
+    /* The console is drawn over the game in its own layer. */
+    RenderLayerId layer = Render_GetLayer(render);
+    Render_SetLayer(render, RL_DEBUG);
+    if (!dconsole->is_visible)
+    {
+        Render_SetLayerVisible(render, RL_DEBUG, true);
+        Render_EnableStats(render, false);
+        dconsole->is_visible = true;
+    }
     DConsole_ClearConsole(dconsole, render);
     
     for (u32 i = 0; i < dconsole->messages_num; ++i) 
@@ -138,4 +183,5 @@ DConsole_Render(DConsole *dconsole, Render *render)
         }
         y_pos -= (7 + 7);
     }
+    Render_SetLayer(render, layer);
 }
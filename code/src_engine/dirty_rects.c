@@ -0,0 +1,171 @@
+/**
+ * ================================================================================
+ * @file src_engine/dirty_rects.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the tracking of the dirty regions of
+ * the render buffer.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/dirty_rects.h"
+
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Getting the area of a rectangle.
+ * @param rect Pointer to the rectangle.
+ * @return s64 Area in pixels.
+ */
+static s64
+GetRectArea(const RenderRect *rect);
+
+/**
+ * @brief Getting the bounding rectangle of two rectangles.
+ * @param a Pointer to the first rectangle.
+ * @param b Pointer to the second rectangle.
+ * @return RenderRect The bounding rectangle.
+ */
+static RenderRect
+GetRectsUnion(const RenderRect *a, const RenderRect *b);
+
+/**
+ * @brief Getting the area which would be presented needlessly if the two rectangles
+ * were replaced by their bounding rectangle.
+ * @param a Pointer to the first rectangle.
+ * @param b Pointer to the second rectangle.
+ * @return s64 Wasted area in pixels.
+ */
+static s64
+GetMergeWaste(const RenderRect *a, const RenderRect *b);
+
+/**
+ * @brief Removing the rectangle from the set (the last one takes its place).
+ * @param dirty_rects Pointer to the DirtyRects structure.
+ * @param index Index of the rectangle.
+ */
+static void
+RemoveRect(DirtyRects *dirty_rects, u32 index);
+
+DirtyRects*
+DirtyRects_Constructor(void)
+{
+    size_t size = sizeof(DirtyRects);
+    DirtyRects *dirty_rects = (DirtyRects *)HelperFcn_MemAllocate(size);
+    return dirty_rects;
+}
+
+DirtyRects*
+DirtyRects_Destructor(DirtyRects *dirty_rects)
+{
+    HelperFcn_MemFree(dirty_rects);
+    return NULL;
+}
+
+void
+DirtyRects_Clear(DirtyRects *dirty_rects)
+{
+    dirty_rects->rects_num = 0;
+}
+
+void
+DirtyRects_Add(DirtyRects *dirty_rects, const RenderRect *rect)
+{
+    if ((rect->x0 >= rect->x1) || (rect->y0 >= rect->y1)) return;
+    RenderRect merged = *rect;
+
+    /* Absorb the rectangles which are cheap to merge with. Every merge enlarges the
+    rectangle, so the search is repeated until nothing is absorbed. */
+    b32 is_absorbed = true;
+    while (is_absorbed)
+    {
+        is_absorbed = false;
+        for (u32 i = 0; i < dirty_rects->rects_num; ++i)
+        {
+            if (GetMergeWaste(&dirty_rects->rects[i], &merged) <= DIRTY_RECTS_SLACK)
+            {
+                merged = GetRectsUnion(&dirty_rects->rects[i], &merged);
+                RemoveRect(dirty_rects, i);
+                is_absorbed = true;
+                break;
+            }
+        }
+
+        /* No room for one more rectangle, so merge with the cheapest one. */
+        if (!is_absorbed && (dirty_rects->rects_num == DIRTY_RECTS_MAX))
+        {
+            u32 best_index = 0;
+            s64 best_waste = GetMergeWaste(&dirty_rects->rects[0], &merged);
+            for (u32 i = 1; i < dirty_rects->rects_num; ++i)
+            {
+                s64 waste = GetMergeWaste(&dirty_rects->rects[i], &merged);
+                if (waste < best_waste)
+                {
+                    best_waste = waste;
+                    best_index = i;
+                }
+            }
+            merged = GetRectsUnion(&dirty_rects->rects[best_index], &merged);
+            RemoveRect(dirty_rects, best_index);
+            is_absorbed = true;
+        }
+    }
+    dirty_rects->rects[dirty_rects->rects_num++] = merged;
+}
+
+u64
+DirtyRects_GetArea(DirtyRects *dirty_rects)
+{
+    u64 area = 0;
+    for (u32 i = 0; i < dirty_rects->rects_num; ++i)
+    {
+        area += (u64)GetRectArea(&dirty_rects->rects[i]);
+    }
+    return area;
+}
+
+static s64
+GetRectArea(const RenderRect *rect)
+{
+    return (s64)(rect->x1 - rect->x0) * (s64)(rect->y1 - rect->y0);
+}
+
+static RenderRect
+GetRectsUnion(const RenderRect *a, const RenderRect *b)
+{
+    RenderRect rect;
+    rect.x0 = (a->x0 < b->x0) ? a->x0 : b->x0;
+    rect.y0 = (a->y0 < b->y0) ? a->y0 : b->y0;
+    rect.x1 = (a->x1 > b->x1) ? a->x1 : b->x1;
+    rect.y1 = (a->y1 > b->y1) ? a->y1 : b->y1;
+    return rect;
+}
+
+static s64
+GetMergeWaste(const RenderRect *a, const RenderRect *b)
+{
+    /* Area covered by the both rectangles (the intersection is counted once). */
+    s64 covered = GetRectArea(a) + GetRectArea(b);
+    RenderRect intersection;
+    intersection.x0 = (a->x0 > b->x0) ? a->x0 : b->x0;
+    intersection.y0 = (a->y0 > b->y0) ? a->y0 : b->y0;
+    intersection.x1 = (a->x1 < b->x1) ? a->x1 : b->x1;
+    intersection.y1 = (a->y1 < b->y1) ? a->y1 : b->y1;
+    if ((intersection.x0 < intersection.x1) && (intersection.y0 < intersection.y1))
+    {
+        covered -= GetRectArea(&intersection);
+    }
+
+    RenderRect bounding = GetRectsUnion(a, b);
+    return GetRectArea(&bounding) - covered;
+}
+
+static void
+RemoveRect(DirtyRects *dirty_rects, u32 index)
+{
+    dirty_rects->rects_num--;
+    dirty_rects->rects[index] = dirty_rects->rects[dirty_rects->rects_num];
+}
@@ -0,0 +1,119 @@
+/**
+ * ================================================================================
+ * @file src_engine/ellipse_raster.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the rasterization of the filled ellipses and
+ * rings by the horizontal spans.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/ellipse_raster.h"
+
+#include <math.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Getting the pixels of a row with the centers inside of the ellipse.
+ * @param dy Vertical distance from the center of the ellipse to the pixel centers.
+ * @param radius_x Horizontal radius.
+ * @param radius_y Vertical radius.
+ * @param x0 X coordinate of the center.
+ * @param x_begin First pixel of the span (included).
+ * @param x_end Last pixel of the span (excluded, not greater than x_begin if empty).
+ */
+static void
+GetRowSpan(f32 dy, f32 radius_x, f32 radius_y, f32 x0, f32 *x_begin, f32 *x_end);
+
+/**
+ * @brief Filling the part of the row span [x_begin, x_end) inside the clip rectangle.
+ * @param row Pointer to the pixel (0, y) of the row.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param x_begin First pixel of the span (included).
+ * @param x_end Last pixel of the span (excluded).
+ * @param color 32 bit color (ARGB, premultiplied if blended).
+ * @param blend Blend mode.
+ */
+static void
+FillSpan(u32 *row, const RenderRect *clip, f32 x_begin, f32 x_end, u32 color,
+    BlendMode blend);
+
+void
+EllipseRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, f32 x0, f32 y0,
+    f32 radius_x, f32 radius_y, f32 thickness, u32 color, BlendMode blend)
+{
+    if (!isfinite(x0) || !isfinite(y0) || !(radius_x > 0.0f) || !(radius_y > 0.0f) ||
+        !isfinite(radius_x) || !isfinite(radius_y) || !(thickness >= 0.0f))
+    {
+        return;
+    }
+
+    /* Thin rings degenerate to the whole ellipse or to nothing. */
+    f32 inner_x = radius_x - thickness;
+    f32 inner_y = radius_y - thickness;
+    b32 is_ring = (thickness > 0.0f) && (inner_x > 0.0f) && (inner_y > 0.0f);
+
+    /* Rows with the centers inside of the ellipse (clamped before the conversion). */
+    f32 y_begin = fmaxf(ceilf(y0 - radius_y - 0.5f), (f32)clip->y0);
+    f32 y_end = fminf(floorf(y0 + radius_y - 0.5f) + 1.0f, (f32)clip->y1);
+    if (y_begin >= y_end) return;
+
+    if (blend != BM_NONE) color = Blend_Premultiply(color);
+    for (s32 y = (s32)y_begin; y < (s32)y_end; ++y)
+    {
+        f32 dy = (f32)y + 0.5f - y0;
+        f32 x_begin, x_end;
+        GetRowSpan(dy, radius_x, radius_y, x0, &x_begin, &x_end);
+        if (x_begin >= x_end) continue;
+
+        u32 *row = (u32 *)((u8 *)memory + (size_t)pitch * (u32)y);
+        f32 hole_begin = x_end;
+        f32 hole_end = x_end;
+        if (is_ring) GetRowSpan(dy, inner_x, inner_y, x0, &hole_begin, &hole_end);
+        if (hole_begin >= hole_end)
+        {
+            FillSpan(row, clip, x_begin, x_end, color, blend);
+        }
+        else
+        {
+            FillSpan(row, clip, x_begin, hole_begin, color, blend);
+            FillSpan(row, clip, hole_end, x_end, color, blend);
+        }
+    }
+}
+
+static void
+GetRowSpan(f32 dy, f32 radius_x, f32 radius_y, f32 x0, f32 *x_begin, f32 *x_end)
+{
+    f32 t = 1.0f - (dy * dy) / (radius_y * radius_y);
+    if (t < 0.0f)
+    {
+        *x_begin = 0.0f;
+        *x_end = 0.0f;
+        return;
+    }
+    f32 half_width = radius_x * sqrtf(t);
+    *x_begin = ceilf(x0 - half_width - 0.5f);
+    *x_end = floorf(x0 + half_width - 0.5f) + 1.0f;
+}
+
+static void
+FillSpan(u32 *row, const RenderRect *clip, f32 x_begin, f32 x_end, u32 color,
+    BlendMode blend)
+{
+    x_begin = fmaxf(x_begin, (f32)clip->x0);
+    x_end = fminf(x_end, (f32)clip->x1);
+    if (x_begin >= x_end) return;
+
+    u32 *dst = row + (s32)x_begin;
+    u32 count = (u32)((s32)x_end - (s32)x_begin);
+    if (blend == BM_NONE)
+        SpanFill_Row(dst, count, color);
+    else
+        Blend_RowColor(dst, count, color, blend);
+}
@@ -10,10 +10,11 @@
 
 #include "include_engine/font.h"
 
-#include "include_engine/color.h"
+#include "include_engine/atomic.h"
 #include "include_engine/dbg.h"
 #include "include_engine/helper_functions.h"
 #include "include_engine/image.h"
+#include "include_engine/pixel_format.h"
 #include "include_engine/render.h"
 #include "include_engine/utils.h"
 
@@ -22,6 +23,10 @@ Font_Constructor(void)
 {
     size_t size = sizeof(Font);
     Font *font = (Font *)HelperFcn_MemAllocate(size);
+
+    /* Fonts could be created by the game and by the render threads. */
+    static atomic_s32 fonts_created = 0;
+    font->id = (u32)Atomic_Increment(&fonts_created);
     return font;
 }
 
@@ -47,6 +52,8 @@ Font_Init(Font *font, s32 rows_num, s32 cols_num, s32 sym_width, s32 sym_height,
     font->sym_height = sym_height;
 
     /* Extract symbols from the font image file. */
+    dbg_check(img_font->format == PF_BGRA, "%s", "Font image is not in the BGRA format!");
+    const u32 *pixels = (const u32 *)img_font->data;
     for (s32 sym_i = (rows_num - 1); sym_i >= 0; --sym_i) 
     {
         for (s32 sym_j = 0; sym_j < cols_num; ++sym_j) 
@@ -72,18 +79,16 @@ Font_Init(Font *font, s32 rows_num, s32 cols_num, s32 sym_width, s32 sym_height,
                 u32 width_on_line = 0;  /* Width of the symbol on current line. */
                 for (s32 j = j_0; j < (j_0 + sym_width); ++j) 
                 {
-                    Color color;
                     u32 black = 0xff000000;  /* Black color (pixel of the font symbol). */
                     u32 red = 0xffff0000;  /* Red color (defines shift to bottom). */
                     u32 index = i * img_font->width + j;   
-                    
-                    Color_SetFromImageColorData(&color, *(img_font->data + index));
-                    if (color.color == black)
+                    u32 color = pixels[index];  /* Already in the render buffer order. */
+                    if (color == black)
                     {
                         symbols_data[win1251_code].symbol_array[p] = (u8)1;
                         width_on_line = j - j_0 + 1;
                     }
-                    else if (color.color == red)
+                    else if (color == red)
                     {
                         symbols_data[win1251_code].symbol_array[p] = (u8)0;
                         shift_bottom = i - i_0;
@@ -112,57 +117,5 @@ void
 Font_DrawString(Font *font, char *str, s32 str_max_width, u32 x, u32 y, 
     u32 size, Color *color, Render *render)
 {
-    SymbolData *symbols_data = font->symbols_data;
-    u32 sym_width = font->sym_width;
-    u32 sym_height = font->sym_height;
-    u32 x_init = x;  /* Initial x position of the very first symbol. */
-    u32 char_index = 0;  /* Index of the char in str. */
-    u32 str_width = 0;  /* Current width of the string in pixels. */
-    b32 stop_print = false;  /* Flag to stop print the symbols. */
-    
-    while (str[char_index] != '\0') 
-    {
-        SymbolData *symbol;  /* Pointer to the current symbol. */
-       
-        if ((str_max_width > 0) && (str_width >= str_max_width - (sym_width + 1))) 
-        {
-            /* Print "..." and then stop */
-            symbol = &(symbols_data[133]);
-            stop_print = true;
-        }
-        else 
-        {
-            symbol = &(symbols_data[(str[char_index])]);
-        }
-
-        /* Add necessary bottom shift */
-        y -= (symbol->shift_bottom) * size;
-        
-        u32 p = 0;
-        for (u32 i = 0; i < sym_height; ++i) 
-        {
-            for (u32 j = 0; j < sym_width; ++j) 
-            {
-                u32 x_pos = x + j * size;
-                u32 y_pos = y + i * size;
-
-                if (symbol->symbol_array[p]) 
-                {
-                    Render_DrawRect(render, x_pos, y_pos, size, size, color);
-                }
-                p++;
-            }
-        }
-
-        /* Restore the normal y position. */
-        y += (symbol->shift_bottom) * size;
-
-        /* Determine the x position of the next symbol in str. */
-        x += ((sym_width + 1) - symbol->shift_left) * size;
-        str_width = x - x_init;
-        char_index++;
-        
-        /* Check to exit the printing procedure. */
-        if (stop_print) break;
-    }  
+    Render_DrawString(render, font, str, str_max_width, x, y, size, color);
 }
@@ -0,0 +1,502 @@
+/**
+ * ================================================================================
+ * @file src_engine/frame_capture.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the capture of the presented frames
+ * by the background writer thread.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/frame_capture.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <semaphore.h>
+#endif
+
+#include "include_engine/atomic.h"
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/memory_object.h"
+#include "include_engine/png_writer.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Structure with the handle of the writer thread.
+ */
+struct FrameCaptureThread_
+{
+#ifdef _WIN32
+    HANDLE handle;  /**< Handle to the thread. */
+#else
+    pthread_t handle;  /**< Handle to the thread. */
+#endif
+};
+
+/**
+ * @brief Creating a counting semaphore with zero initial count.
+ * @return void* Pointer to the semaphore.
+ */
+static void*
+SignalCreate(void);
+
+/**
+ * @brief Releasing the semaphore once.
+ * @param signal Pointer to the semaphore.
+ */
+static void
+SignalPost(void *signal);
+
+/**
+ * @brief Waiting for the semaphore.
+ * @param signal Pointer to the semaphore.
+ */
+static void
+SignalWait(void *signal);
+
+/**
+ * @brief Destroying the semaphore.
+ * @param signal Pointer to the semaphore.
+ */
+static void
+SignalDestroy(void *signal);
+
+/**
+ * @brief Opening the file for the binary writing.
+ * @param file_path Path to the file.
+ * @return FILE* Pointer to the opened file (NULL - not opened).
+ */
+static FILE*
+OpenFile(const char *file_path);
+
+/**
+ * @brief Opening the stream of the raw video (file, standard output or pipe).
+ * @param capture Pointer to the FrameCapture structure.
+ */
+static void
+OpenStream(FrameCapture *capture);
+
+/**
+ * @brief Closing the stream of the raw video.
+ * @param capture Pointer to the FrameCapture structure.
+ */
+static void
+CloseStream(FrameCapture *capture);
+
+/**
+ * @brief Writing the pool frame to the output (writer thread).
+ * @param capture Pointer to the FrameCapture structure.
+ * @param frame Pointer to the pool frame (alpha is made opaque in place).
+ * @param frame_index Index of the frame among the captured ones.
+ * @return b32 True if the frame was written.
+ */
+static b32
+WriteFrame(FrameCapture *capture, u32 *frame, u32 frame_index);
+
+/**
+ * @brief Main loop of the writer thread: a frame is written for every release of the
+ * semaphore, the release without a frame stops the thread.
+ * @param capture Pointer to the FrameCapture structure.
+ */
+static void
+WriterLoop(FrameCapture *capture);
+
+#ifdef _WIN32
+/**
+ * @brief Writer procedure to be executed in the separate thread.
+ * @param capture Pointer to the FrameCapture structure.
+ */
+static DWORD WINAPI
+WriterThreadProc(void *capture);
+#else
+/**
+ * @brief Writer procedure to be executed in the separate thread.
+ * @param capture Pointer to the FrameCapture structure.
+ */
+static void*
+WriterThreadProc(void *capture);
+#endif
+
+FrameCapture*
+FrameCapture_Constructor(void)
+{
+    size_t size = sizeof(FrameCapture);
+    FrameCapture *capture = (FrameCapture *)HelperFcn_MemAllocate(size);
+    return capture;
+}
+
+FrameCapture*
+FrameCapture_Destructor(FrameCapture *capture)
+{
+    /* The stop is signaled after all the pooled frames, so they are written first. */
+    if (capture->thread)
+    {
+        Atomic_Store(&capture->is_running, false);
+        SignalPost(capture->signal);
+#ifdef _WIN32
+        WaitForSingleObject(capture->thread->handle, INFINITE);
+        CloseHandle(capture->thread->handle);
+#else
+        pthread_join(capture->thread->handle, NULL);
+#endif
+        HelperFcn_MemFree(capture->thread);
+        SignalDestroy(capture->signal);
+    }
+
+    CloseStream(capture);
+    HelperFcn_PageFree(capture->frames);
+    if (capture->converted) HelperFcn_MemFree(capture->converted);
+    HelperFcn_MemFree(capture);
+    return NULL;
+}
+
+void
+FrameCapture_Init(FrameCapture *capture, FrameCaptureFormat format, const char *path,
+    u32 width, u32 height, u32 fps, u32 frames_num)
+{
+    dbg_check((width > 0) && (height > 0) && (frames_num > 0), "%s",
+        "Frame capture should have a size and at least one pool frame!");
+    dbg_check(strlen(path) < FRAME_CAPTURE_PATH_MAX, "%s", "Capture path is too long!");
+
+    capture->format = format;
+    memcpy(capture->path, path, strlen(path) + 1);
+    capture->width = width;
+    capture->height = height;
+    capture->frames_num = frames_num;
+    size_t pool_size = sizeof(u32) * (size_t)width * height * frames_num;
+    capture->frames = (u32 *)HelperFcn_PageAllocate(pool_size);
+
+    /* The pages are touched now, so the drawing thread does not fault them in. */
+    memset(capture->frames, 0, pool_size);
+    Atomic_Store(&capture->write_count, 0);
+    Atomic_Store(&capture->read_count, 0);
+    Atomic_Store(&capture->frames_encoded, 0);
+    Atomic_Store(&capture->frames_dropped, 0);
+    Atomic_Store(&capture->frames_failed, 0);
+
+    /* Raw streams are written by the whole frames (Y4M planes) or rows (RGBA). */
+    if (format == FCF_Y4M)
+    {
+        capture->converted = (u8 *)HelperFcn_MemAllocate(3 * (size_t)width * height);
+    }
+    else if (format == FCF_RGBA)
+    {
+        capture->converted = (u8 *)HelperFcn_MemAllocate(4 * (size_t)width);
+    }
+    if (format != FCF_PNG) OpenStream(capture);
+    if (format == FCF_Y4M)
+    {
+        fprintf(capture->file, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", width, height,
+            (fps > 0) ? fps : 60);
+    }
+
+    capture->signal = SignalCreate();
+    Atomic_Store(&capture->is_running, true);
+    capture->thread = (FrameCaptureThread *)HelperFcn_MemAllocate(sizeof(FrameCaptureThread));
+#ifdef _WIN32
+    capture->thread->handle = CreateThread(0, 0, WriterThreadProc, capture, 0, 0);
+    if (capture->thread->handle == NULL)
+    {
+        dbg_error("%s", "Capture writer thread was not created!");
+    }
+#else
+    if (pthread_create(&capture->thread->handle, NULL, WriterThreadProc, capture) != 0)
+    {
+        dbg_error("%s", "Capture writer thread was not created!");
+    }
+#endif
+}
+
+b32
+FrameCapture_Submit(FrameCapture *capture, const u32 *pixels, u32 width, u32 height,
+    u32 pitch)
+{
+    /* Only the drawing thread changes the write count, the writer could only free a
+    frame meanwhile, so the check is safe. */
+    s32 write_count = Atomic_Load(&capture->write_count);
+    s32 pending = write_count - Atomic_Load(&capture->read_count);
+    if (((u32)pending >= capture->frames_num) || (width != capture->width) ||
+        (height != capture->height))
+    {
+        Atomic_Increment(&capture->frames_dropped);
+        return false;
+    }
+
+    size_t frame_size = (size_t)width * height;
+    u32 *frame = capture->frames + ((u32)write_count % capture->frames_num) * frame_size;
+    if (pitch == width * sizeof(u32))
+    {
+        memcpy(frame, pixels, sizeof(u32) * frame_size);
+    }
+    else
+    {
+        for (u32 y = 0; y < height; ++y)
+        {
+            memcpy(frame + (size_t)y * width, (const u8 *)pixels + (size_t)y * pitch,
+                sizeof(u32) * width);
+        }
+    }
+
+    /* The frame is published after it is copied. */
+    Atomic_Increment(&capture->write_count);
+    SignalPost(capture->signal);
+    return true;
+}
+
+void
+FrameCapture_GetStats(FrameCapture *capture, FrameCaptureStats *stats)
+{
+    s32 write_count = Atomic_Load(&capture->write_count);
+    s32 read_count = Atomic_Load(&capture->read_count);
+    stats->frames_captured = (u32)write_count;
+    stats->frames_encoded = (u32)Atomic_Load(&capture->frames_encoded);
+    stats->frames_dropped = (u32)Atomic_Load(&capture->frames_dropped);
+    stats->frames_failed = (u32)Atomic_Load(&capture->frames_failed);
+    stats->frames_pending = (u32)(write_count - read_count);
+}
+
+static void*
+SignalCreate(void)
+{
+#ifdef _WIN32
+    HANDLE semaphore = CreateSemaphore(NULL, 0, 0x7fffffff, NULL);
+    if (semaphore == NULL)
+    {
+        dbg_error("%s", "Semaphore was not created!");
+    }
+    return (void *)semaphore;
+#else
+    sem_t *semaphore = (sem_t *)HelperFcn_MemAllocate(sizeof(sem_t));
+    if (sem_init(semaphore, 0, 0) != 0)
+    {
+        dbg_error("%s", "Semaphore was not created!");
+    }
+    return (void *)semaphore;
+#endif
+}
+
+static void
+SignalPost(void *signal)
+{
+#ifdef _WIN32
+    ReleaseSemaphore((HANDLE)signal, 1, NULL);
+#else
+    sem_post((sem_t *)signal);
+#endif
+}
+
+static void
+SignalWait(void *signal)
+{
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)signal, INFINITE);
+#else
+    while (sem_wait((sem_t *)signal) != 0)
+    {
+        /* Interrupted by a signal handler, wait again. */
+    }
+#endif
+}
+
+static void
+SignalDestroy(void *signal)
+{
+#ifdef _WIN32
+    CloseHandle((HANDLE)signal);
+#else
+    sem_destroy((sem_t *)signal);
+    HelperFcn_MemFree(signal);
+#endif
+}
+
+static FILE*
+OpenFile(const char *file_path)
+{
+#ifdef _WIN32
+    FILE *file = NULL;
+    if (fopen_s(&file, file_path, "wb") != 0) return NULL;
+    return file;
+#else
+    return fopen(file_path, "wb");
+#endif
+}
+
+static void
+OpenStream(FrameCapture *capture)
+{
+    const char *path = capture->path;
+    capture->is_pipe = false;
+    if (strcmp(path, "-") == 0)
+    {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        capture->file = stdout;
+    }
+    else if (path[0] == '|')
+    {
+#ifdef _WIN32
+        capture->file = _popen(path + 1, "wb");
+#else
+        capture->file = popen(path + 1, "w");
+#endif
+        capture->is_pipe = true;
+    }
+    else
+    {
+        capture->file = OpenFile(path);
+    }
+
+    if (capture->file == NULL)
+    {
+        dbg_error("Capture output %s was not opened!", path);
+    }
+}
+
+static void
+CloseStream(FrameCapture *capture)
+{
+    FILE *file = capture->file;
+    if (file == NULL) return;
+    if (file == stdout)
+    {
+        fflush(file);
+    }
+    else if (capture->is_pipe)
+    {
+#ifdef _WIN32
+        _pclose(file);
+#else
+        pclose(file);
+#endif
+    }
+    else
+    {
+        fclose(file);
+    }
+    capture->file = NULL;
+}
+
+static b32
+WriteFrame(FrameCapture *capture, u32 *frame, u32 frame_index)
+{
+    u32 width = capture->width;
+    u32 height = capture->height;
+    size_t frame_size = (size_t)width * height;
+    FILE *file = capture->file;
+
+    if (capture->format == FCF_PNG)
+    {
+        /* Alpha of the buffer is not presented, the captured frames are opaque. */
+        for (size_t i = 0; i < frame_size; ++i)
+        {
+            frame[i] |= 0xff000000;
+        }
+        char file_path[FRAME_CAPTURE_PATH_MAX + 16];
+        snprintf(file_path, sizeof(file_path), capture->path, frame_index);
+        MemObject *png = MemObject_Constructor();
+        PngWriter_Encode(png, frame, width, height, width * sizeof(u32));
+        FILE *png_file = OpenFile(file_path);
+        b32 is_written = (png_file != NULL) &&
+            (fwrite(png->data, 1, (size_t)png->size, png_file) == png->size);
+        if (png_file) is_written = (fclose(png_file) == 0) && is_written;
+        png = MemObject_Destructor(png);
+        return is_written;
+    }
+
+    if (capture->format == FCF_Y4M)
+    {
+        /* BT.601 limited range, the planes are written from the top row. */
+        u8 *plane_y = capture->converted;
+        u8 *plane_u = plane_y + frame_size;
+        u8 *plane_v = plane_u + frame_size;
+        for (u32 y = 0; y < height; ++y)
+        {
+            const u32 *src = frame + (size_t)(height - 1 - y) * width;
+            size_t offset = (size_t)y * width;
+            for (u32 x = 0; x < width; ++x)
+            {
+                s32 r = (s32)((src[x] >> 16) & 0xff);
+                s32 g = (s32)((src[x] >> 8) & 0xff);
+                s32 b = (s32)(src[x] & 0xff);
+                plane_y[offset + x] = (u8)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+                plane_u[offset + x] = (u8)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                plane_v[offset + x] = (u8)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+        }
+        if (fputs("FRAME\n", file) < 0) return false;
+        return fwrite(capture->converted, 1, 3 * frame_size, file) == 3 * frame_size;
+    }
+
+    /* FCF_RGBA: bytes R, G, B, A from the top row. */
+    u8 *row = capture->converted;
+    for (u32 y = 0; y < height; ++y)
+    {
+        const u32 *src = frame + (size_t)(height - 1 - y) * width;
+        for (u32 x = 0; x < width; ++x)
+        {
+            row[4 * x + 0] = (u8)(src[x] >> 16);
+            row[4 * x + 1] = (u8)(src[x] >> 8);
+            row[4 * x + 2] = (u8)src[x];
+            row[4 * x + 3] = 0xff;
+        }
+        if (fwrite(row, 1, 4 * (size_t)width, file) != 4 * (size_t)width) return false;
+    }
+    return true;
+}
+
+static void
+WriterLoop(FrameCapture *capture)
+{
+    size_t frame_size = (size_t)capture->width * capture->height;
+
+    while (true)
+    {
+        SignalWait(capture->signal);
+        s32 read_count = Atomic_Load(&capture->read_count);
+        if (read_count == Atomic_Load(&capture->write_count))
+        {
+            if (!Atomic_Load(&capture->is_running)) break;
+            continue;
+        }
+
+        /* The frame belongs to the writer until the read count is incremented. */
+        u32 *frame = capture->frames + ((u32)read_count % capture->frames_num) * frame_size;
+        if (WriteFrame(capture, frame, (u32)read_count))
+        {
+            Atomic_Increment(&capture->frames_encoded);
+        }
+        else
+        {
+            Atomic_Increment(&capture->frames_failed);
+        }
+        Atomic_Increment(&capture->read_count);
+    }
+
+    if (capture->file) fflush(capture->file);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI
+WriterThreadProc(void *capture)
+{
+    WriterLoop((FrameCapture *)capture);
+    return 0;
+}
+#else
+static void*
+WriterThreadProc(void *capture)
+{
+    WriterLoop((FrameCapture *)capture);
+    return NULL;
+}
+#endif
@@ -0,0 +1,446 @@
+/**
+ * ================================================================================
+ * @file src_engine/glyph_cache.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the caching of the rasterized text.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/glyph_cache.h"
+
+#include <string.h>
+
+#include "include_engine/font.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Rasterizing all the glyphs of the font with the pixel size.
+ * @param set Pointer to the GlyphSet structure.
+ * @param font Pointer to the font.
+ * @param size Size of a single symbol pixel.
+ */
+static void
+RasterizeGlyphs(GlyphSet *set, const Font *font, u32 size);
+
+/**
+ * @brief Placing the glyphs of the string in the same way as they were drawn symbol by
+ * symbol. Called twice: to count the rectangles and to copy them.
+ * @param set Pointer to the GlyphSet structure.
+ * @param font Pointer to the font.
+ * @param str Null terminated string.
+ * @param max_width Maximum width of the string in pixels (0 - unlimited).
+ * @param rects Array for the rectangles of the string (NULL - counting only).
+ * @return u32 Amount of the rectangles of the string.
+ */
+static u32
+LayoutString(const GlyphSet *set, const Font *font, const char *str, s32 max_width,
+    RenderRect *rects);
+
+/**
+ * @brief Converting the rectangles of the string into the spans of its rows.
+ * @param run Pointer to the text run (bounds are calculated here).
+ * @param rects Array of the rectangles of the string.
+ * @param rects_num Amount of the rectangles.
+ */
+static void
+BuildRowSpans(TextRun *run, const RenderRect *rects, u32 rects_num);
+
+/**
+ * @brief Calculation of the hash of the string and of its layout parameters (FNV-1a).
+ * @param font_id Identifier of the font.
+ * @param str Null terminated string.
+ * @param size Size of a single symbol pixel.
+ * @param max_width Maximum width of the string in pixels.
+ * @return u64 Hash value.
+ */
+static u64
+HashString(u32 font_id, const char *str, u32 size, s32 max_width);
+
+/**
+ * @brief Inserting the run into the hash table (the table should have a free slot).
+ * @param glyph_cache Pointer to the GlyphCache structure.
+ * @param run Pointer to the text run.
+ */
+static void
+InsertRun(GlyphCache *glyph_cache, TextRun *run);
+
+/**
+ * @brief Rebuilding the hash table with the new capacity. Runs not used since the
+ * frame are freed.
+ * @param glyph_cache Pointer to the GlyphCache structure.
+ * @param capacity New capacity of the hash table (power of two).
+ * @param frame_min Runs used before this frame are freed.
+ */
+static void
+RebuildRuns(GlyphCache *glyph_cache, u32 capacity, u64 frame_min);
+
+/**
+ * @brief Freeing the text run.
+ * @param run Pointer to the text run.
+ */
+static void
+FreeRun(TextRun *run);
+
+/**
+ * @brief Freeing the glyph set.
+ * @param set Pointer to the GlyphSet structure.
+ */
+static void
+FreeSet(GlyphSet *set);
+
+GlyphCache*
+GlyphCache_Constructor(void)
+{
+    size_t size = sizeof(GlyphCache);
+    GlyphCache *glyph_cache = (GlyphCache *)HelperFcn_MemAllocate(size);
+    glyph_cache->runs_capacity = GLYPH_CACHE_RUNS_CAPACITY;
+    glyph_cache->runs = (TextRun **)HelperFcn_MemAllocate(glyph_cache->runs_capacity *
+        sizeof(TextRun *));
+    return glyph_cache;
+}
+
+GlyphCache*
+GlyphCache_Destructor(GlyphCache *glyph_cache)
+{
+    for (u32 i = 0; i < glyph_cache->sets_num; ++i)
+    {
+        FreeSet(glyph_cache->sets[i]);
+    }
+    for (u32 i = 0; i < glyph_cache->runs_capacity; ++i)
+    {
+        if (glyph_cache->runs[i]) FreeRun(glyph_cache->runs[i]);
+    }
+    if (glyph_cache->sets) HelperFcn_MemFree(glyph_cache->sets);
+    HelperFcn_MemFree(glyph_cache->runs);
+    HelperFcn_MemFree(glyph_cache);
+    return NULL;
+}
+
+const GlyphSet*
+GlyphCache_GetSet(GlyphCache *glyph_cache, const Font *font, u32 size)
+{
+    for (u32 i = 0; i < glyph_cache->sets_num; ++i)
+    {
+        GlyphSet *set = glyph_cache->sets[i];
+        if ((set->font_id == font->id) && (set->size == size))
+        {
+            set->frame = glyph_cache->frame;
+            return set;
+        }
+    }
+
+    GlyphSet *set = (GlyphSet *)HelperFcn_MemAllocate(sizeof(GlyphSet));
+    RasterizeGlyphs(set, font, size);
+    set->frame = glyph_cache->frame;
+
+    glyph_cache->sets = (GlyphSet **)HelperFcn_MemReallocate(glyph_cache->sets,
+        (glyph_cache->sets_num + 1) * sizeof(GlyphSet *));
+    glyph_cache->sets[glyph_cache->sets_num++] = set;
+    return set;
+}
+
+const TextRun*
+GlyphCache_GetRun(GlyphCache *glyph_cache, const Font *font, const char *str, u32 size,
+    s32 max_width)
+{
+    u64 hash = HashString(font->id, str, size, max_width);
+
+    /* Look for the same string in the hash table. */
+    u32 mask = glyph_cache->runs_capacity - 1;
+    for (u32 i = (u32)hash & mask; glyph_cache->runs[i]; i = (i + 1) & mask)
+    {
+        TextRun *run = glyph_cache->runs[i];
+        if ((run->hash == hash) && (run->font_id == font->id) && (run->size == size) &&
+            (run->max_width == max_width) && (strcmp(run->str, str) == 0))
+        {
+            run->frame = glyph_cache->frame;
+            return run;
+        }
+    }
+
+    /* Build the layout of the new string. */
+    const GlyphSet *set = GlyphCache_GetSet(glyph_cache, font, size);
+    TextRun *run = (TextRun *)HelperFcn_MemAllocate(sizeof(TextRun));
+    size_t length = strlen(str);
+    run->hash = hash;
+    run->str = (char *)HelperFcn_MemAllocate(length + 1);
+    memcpy(run->str, str, length + 1);
+    run->font_id = font->id;
+    run->size = size;
+    run->max_width = max_width;
+    run->frame = glyph_cache->frame;
+
+    u32 rects_num = LayoutString(set, font, str, max_width, NULL);
+    RenderRect *rects = (RenderRect *)HelperFcn_MemAllocate((rects_num ? rects_num : 1) *
+        sizeof(RenderRect));
+    LayoutString(set, font, str, max_width, rects);
+    BuildRowSpans(run, rects, rects_num);
+    HelperFcn_MemFree(rects);
+
+    /* Keep the hash table at most half full. */
+    if ((glyph_cache->runs_num + 1) * 2 > glyph_cache->runs_capacity)
+        RebuildRuns(glyph_cache, glyph_cache->runs_capacity * 2, 0);
+    InsertRun(glyph_cache, run);
+    return run;
+}
+
+void
+GlyphCache_NextFrame(GlyphCache *glyph_cache)
+{
+    u64 frame = glyph_cache->frame;
+
+    /* Free the glyph sets and the text runs not used during the frame. */
+    u32 sets_num = 0;
+    for (u32 i = 0; i < glyph_cache->sets_num; ++i)
+    {
+        GlyphSet *set = glyph_cache->sets[i];
+        if (set->frame == frame)
+            glyph_cache->sets[sets_num++] = set;
+        else
+            FreeSet(set);
+    }
+    glyph_cache->sets_num = sets_num;
+    RebuildRuns(glyph_cache, glyph_cache->runs_capacity, frame);
+
+    glyph_cache->frame = frame + 1;
+}
+
+static void
+RasterizeGlyphs(GlyphSet *set, const Font *font, u32 size)
+{
+    u32 sym_width = font->sym_width;
+    u32 sym_height = font->sym_height;
+    u32 symbols_num = (u32)(font->rows_num * font->cols_num);
+    if (symbols_num > GLYPH_CACHE_SYMBOLS_NUM) symbols_num = GLYPH_CACHE_SYMBOLS_NUM;
+
+    set->font_id = font->id;
+    set->size = size;
+
+    /* Every row of a symbol has at most (sym_width + 1) / 2 spans. */
+    u32 rects_capacity = symbols_num * sym_height * ((sym_width + 1) / 2);
+    set->rects = (RenderRect *)HelperFcn_MemAllocate((rects_capacity ? rects_capacity : 1) *
+        sizeof(RenderRect));
+    set->rects_num = 0;
+
+    for (u32 s = 0; s < GLYPH_CACHE_SYMBOLS_NUM; ++s)
+    {
+        Glyph *glyph = &set->glyphs[s];
+        glyph->rects_offset = set->rects_num;
+        glyph->rects_num = 0;
+
+        /* Symbols missing in the font image are drawn as the empty ones. */
+        if (s >= symbols_num)
+        {
+            glyph->advance = (s32)((sym_width + 1) * size);
+            continue;
+        }
+
+        const SymbolData *symbol = &font->symbols_data[s];
+        glyph->advance = (s32)(((sym_width + 1) - symbol->shift_left) * size);
+        s32 shift_bottom = (s32)symbol->shift_bottom;
+
+        const u8 *pixels = symbol->symbol_array;
+        for (u32 i = 0; i < sym_height; ++i)
+        {
+            for (u32 j = 0; j < sym_width; ++j)
+            {
+                if (!pixels[i * sym_width + j]) continue;
+
+                /* Collect the whole span of the lit pixels. */
+                u32 span_begin = j;
+                while ((j < sym_width) && pixels[i * sym_width + j]) j++;
+
+                RenderRect span;
+                span.x0 = (s32)(span_begin * size);
+                span.x1 = (s32)(j * size);
+                span.y0 = ((s32)i - shift_bottom) * (s32)size;
+                span.y1 = span.y0 + (s32)size;
+
+                /* Extend the same span of the row below, if there is one. */
+                RenderRect *rects = &set->rects[glyph->rects_offset];
+                b32 is_merged = false;
+                for (u32 k = 0; k < glyph->rects_num; ++k)
+                {
+                    if ((rects[k].x0 == span.x0) && (rects[k].x1 == span.x1) &&
+                        (rects[k].y1 == span.y0))
+                    {
+                        rects[k].y1 = span.y1;
+                        is_merged = true;
+                        break;
+                    }
+                }
+                if (!is_merged)
+                {
+                    set->rects[set->rects_num++] = span;
+                    glyph->rects_num++;
+                }
+            }
+        }
+    }
+}
+
+static u32
+LayoutString(const GlyphSet *set, const Font *font, const char *str, s32 max_width,
+    RenderRect *rects)
+{
+    u32 sym_width = font->sym_width;
+    s32 x = 0;  /* Position of the current symbol relatively to the first one. */
+    u32 str_width = 0;  /* Current width of the string in pixels. */
+    b32 stop_print = false;  /* Flag to stop print the symbols. */
+    u32 rects_num = 0;
+
+    for (u32 char_index = 0; str[char_index] != '\0'; ++char_index)
+    {
+        const Glyph *glyph;
+
+        if ((max_width > 0) && (str_width >= max_width - (sym_width + 1)))
+        {
+            /* Print "..." and then stop */
+            glyph = &set->glyphs[GLYPH_CACHE_ELLIPSIS];
+            stop_print = true;
+        }
+        else
+        {
+            glyph = &set->glyphs[(u8)str[char_index]];
+        }
+
+        if (rects)
+        {
+            const RenderRect *glyph_rects = &set->rects[glyph->rects_offset];
+            for (u32 i = 0; i < glyph->rects_num; ++i)
+            {
+                RenderRect *rect = &rects[rects_num + i];
+                rect->x0 = glyph_rects[i].x0 + x;
+                rect->y0 = glyph_rects[i].y0;
+                rect->x1 = glyph_rects[i].x1 + x;
+                rect->y1 = glyph_rects[i].y1;
+            }
+        }
+        rects_num += glyph->rects_num;
+
+        x += glyph->advance;
+        str_width = (u32)x;
+
+        if (stop_print) break;
+    }
+    return rects_num;
+}
+
+static void
+BuildRowSpans(TextRun *run, const RenderRect *rects, u32 rects_num)
+{
+    RenderRect *bounds = &run->bounds;
+    for (u32 i = 0; i < rects_num; ++i)
+    {
+        const RenderRect *rect = &rects[i];
+        if ((i == 0) || (rect->x0 < bounds->x0)) bounds->x0 = rect->x0;
+        if ((i == 0) || (rect->y0 < bounds->y0)) bounds->y0 = rect->y0;
+        if ((i == 0) || (rect->x1 > bounds->x1)) bounds->x1 = rect->x1;
+        if ((i == 0) || (rect->y1 > bounds->y1)) bounds->y1 = rect->y1;
+    }
+
+    /* Count the spans of every row (counts are stored with the shift by one). */
+    u32 rows_num = (u32)(bounds->y1 - bounds->y0);
+    run->row_spans = (u32 *)HelperFcn_MemAllocate((rows_num + 1) * sizeof(u32));
+    for (u32 i = 0; i < rects_num; ++i)
+    {
+        for (s32 y = rects[i].y0; y < rects[i].y1; ++y)
+        {
+            run->row_spans[y - bounds->y0 + 1]++;
+        }
+    }
+    for (u32 row = 1; row <= rows_num; ++row)
+    {
+        run->row_spans[row] += run->row_spans[row - 1];
+    }
+    run->spans_num = run->row_spans[rows_num];
+    run->spans = (TextSpan *)HelperFcn_MemAllocate((run->spans_num ? run->spans_num : 1) *
+        sizeof(TextSpan));
+
+    /* Rectangles are placed symbol by symbol, so the spans of a row are almost sorted
+    and the insertion sort is enough. */
+    u32 *row_ends = (u32 *)HelperFcn_MemAllocate((rows_num ? rows_num : 1) * sizeof(u32));
+    memcpy(row_ends, run->row_spans, rows_num * sizeof(u32));
+    for (u32 i = 0; i < rects_num; ++i)
+    {
+        for (s32 y = rects[i].y0; y < rects[i].y1; ++y)
+        {
+            u32 row = (u32)(y - bounds->y0);
+            u32 j = row_ends[row]++;
+            while ((j > run->row_spans[row]) && (run->spans[j - 1].x0 > rects[i].x0))
+            {
+                run->spans[j] = run->spans[j - 1];
+                j--;
+            }
+            run->spans[j].x0 = rects[i].x0;
+            run->spans[j].x1 = rects[i].x1;
+        }
+    }
+    HelperFcn_MemFree(row_ends);
+}
+
+static u64
+HashString(u32 font_id, const char *str, u32 size, s32 max_width)
+{
+    u64 hash = 14695981039346656037ULL;
+    for (const u8 *c = (const u8 *)str; *c; ++c)
+    {
+        hash = (hash ^ *c) * 1099511628211ULL;
+    }
+    hash = (hash ^ font_id) * 1099511628211ULL;
+    hash = (hash ^ size) * 1099511628211ULL;
+    hash = (hash ^ (u32)max_width) * 1099511628211ULL;
+    return hash;
+}
+
+static void
+InsertRun(GlyphCache *glyph_cache, TextRun *run)
+{
+    u32 mask = glyph_cache->runs_capacity - 1;
+    u32 i = (u32)run->hash & mask;
+    while (glyph_cache->runs[i]) i = (i + 1) & mask;
+    glyph_cache->runs[i] = run;
+    glyph_cache->runs_num++;
+}
+
+static void
+RebuildRuns(GlyphCache *glyph_cache, u32 capacity, u64 frame_min)
+{
+    TextRun **runs = glyph_cache->runs;
+    u32 runs_capacity = glyph_cache->runs_capacity;
+
+    glyph_cache->runs = (TextRun **)HelperFcn_MemAllocate(capacity * sizeof(TextRun *));
+    glyph_cache->runs_capacity = capacity;
+    glyph_cache->runs_num = 0;
+
+    for (u32 i = 0; i < runs_capacity; ++i)
+    {
+        TextRun *run = runs[i];
+        if (run == NULL) continue;
+        if (run->frame >= frame_min)
+            InsertRun(glyph_cache, run);
+        else
+            FreeRun(run);
+    }
+    HelperFcn_MemFree(runs);
+}
+
+static void
+FreeRun(TextRun *run)
+{
+    HelperFcn_MemFree(run->str);
+    HelperFcn_MemFree(run->spans);
+    HelperFcn_MemFree(run->row_spans);
+    HelperFcn_MemFree(run);
+}
+
+static void
+FreeSet(GlyphSet *set)
+{
+    HelperFcn_MemFree(set->rects);
+    HelperFcn_MemFree(set);
+}
@@ -15,6 +15,12 @@
 #include <math.h>
 #include <stdlib.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 #include "include_engine/dbg.h"
 #include "include_engine/vector2.h"
 #include "include_engine/utils.h"
@@ -112,3 +118,55 @@ HelperFcn_MemFree(void *object)
     }
     free(object);
 }
+
+void*
+HelperFcn_MemReallocate(void *object, size_t memory_size)
+{
+    void *new_object = realloc(object, memory_size);
+    if (new_object == NULL)
+    {
+        dbg_error("%s", "Memory reallocation error!");
+    }
+    return new_object;
+}
+
+void*
+HelperFcn_PageAllocate(size_t memory_size)
+{
+#ifdef _WIN32
+    void *object = VirtualAlloc(0, memory_size, MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
+#else
+    void *object = calloc(1, memory_size ? memory_size : 1);
+#endif
+    if (object == NULL)
+    {
+        dbg_error("%s", "Memory allocation error!");
+    }
+    return object;
+}
+
+void
+HelperFcn_PageFree(void *object)
+{
+    if (object == NULL) return;
+#ifdef _WIN32
+    VirtualFree(object, 0, MEM_RELEASE);
+#else
+    free(object);
+#endif
+}
+
+u64
+HelperFcn_GetTimeNs(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (u64)((f64)counter.QuadPart * 1.0e9 / (f64)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+#endif
+}
@@ -18,6 +18,9 @@
 #define STBI_NO_FAILURE_STRINGS  /* Generate no error messages. */
 #include "include_engine/stb_image.h"
 #include "include_engine/memory_object.h"
+#include "include_engine/pixel_format.h"
+#include "include_engine/sprite.h"
+#include "include_engine/texture.h"
 #include "include_engine/utils.h"
 
 Image*
@@ -31,6 +34,8 @@ Image_Constructor(void)
 Image*
 Image_Destructor(Image *image)
 {
+    if (image->sprite) image->sprite = Sprite_Destructor(image->sprite);
+    if (image->texture) image->texture = Texture_Destructor(image->texture);
     HelperFcn_MemFree(image->data);  /* NOTE: Test this, because mem allocated in stbi module. */
     HelperFcn_MemFree(image);
     return NULL;
@@ -50,11 +55,64 @@ Image_InitByMemObject(Image *image, MemObject *mem_object)
     int img_height;  /* Height of the uncompressed image. */
     int img_channels;  /* Number of channels of the uncompressed image. */
 
-    image->data = (u32 *)stbi_load_from_memory((void *)mem_obj_data, mem_obj_size, 
+    image->data = stbi_load_from_memory((void *)mem_obj_data, mem_obj_size, 
         &img_width, &img_height, &img_channels, 4);
     image->width = img_width;
     image->height = img_height;
     image->channels = img_channels;
+    image->format = PF_RGBA;
+
+    /* Prepare the image for the drawing. The pixels are swizzled to the render buffer
+    order once here. */
+    Image_Convert(image, PF_BGRA);
+    Image_CompileSprite(image);
+}
+
+void
+Image_Convert(Image *image, PixelFormat format)
+{
+    if (image->format == format) return;
+
+    /* Formats of the same pixel size are converted in place. */
+    u32 src_pitch = PixelFormat_GetPitch(image->format, image->width);
+    u32 dst_pitch = PixelFormat_GetPitch(format, image->width);
+    u8 *src = (u8 *)image->data;
+    u8 *dst = src;
+    if (dst_pitch != src_pitch)
+    {
+        size_t size = (size_t)dst_pitch * image->height;
+        dst = (u8 *)HelperFcn_MemAllocate(size ? size : 1);
+    }
+    for (u32 i = 0; i < image->height; ++i)
+    {
+        PixelFormat_ConvertRow(dst + (size_t)dst_pitch * i, format,
+            src + (size_t)src_pitch * i, image->format, image->width);
+    }
+    if (dst != src)
+    {
+        HelperFcn_MemFree(image->data);
+        image->data = dst;
+    }
+    image->format = format;
+
+    if (image->sprite) Image_CompileSprite(image);
+    if (image->texture) Image_CompileTexture(image, image->texture->layout);
+}
+
+void
+Image_CompileSprite(Image *image)
+{
+    if (image->sprite) image->sprite = Sprite_Destructor(image->sprite);
+    image->sprite = Sprite_Constructor();
+    Sprite_InitByImage(image->sprite, image);
+}
+
+void 
+Image_CompileTexture(Image *image, TextureLayout layout)
+{
+    if (image->texture) image->texture = Texture_Destructor(image->texture);
+    image->texture = Texture_Constructor();
+    Texture_InitByImage(image->texture, image, layout);
 }
 
 void 
@@ -0,0 +1,321 @@
+/**
+ * ================================================================================
+ * @file src_engine/job_pool.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the work with the pool of worker
+ * threads.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/job_pool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <semaphore.h>
+#include <unistd.h>
+#endif
+
+#include "include_engine/atomic.h"
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Structure with data passed to a single worker thread.
+ */
+struct JobPoolThread_
+{
+    JobPool *job_pool;  /**< Pointer to the owning JobPool structure. */
+    u32 worker_index;  /**< Index of the worker passed to the job procedures. */
+#ifdef _WIN32
+    HANDLE handle;  /**< Handle to the thread. */
+#else
+    pthread_t handle;  /**< Handle to the thread. */
+#endif
+};
+
+/**
+ * @brief Creating a counting semaphore with zero initial count.
+ * @return void* Pointer to the semaphore.
+ */
+static void*
+SignalCreate(void);
+
+/**
+ * @brief Releasing the semaphore a specified number of times.
+ * @param signal Pointer to the semaphore.
+ * @param count Amount of releases.
+ */
+static void
+SignalPost(void *signal, u32 count);
+
+/**
+ * @brief Waiting for the semaphore.
+ * @param signal Pointer to the semaphore.
+ */
+static void
+SignalWait(void *signal);
+
+/**
+ * @brief Destroying the semaphore.
+ * @param signal Pointer to the semaphore.
+ */
+static void
+SignalDestroy(void *signal);
+
+/**
+ * @brief Taking and executing the jobs of the current batch until none is left.
+ * @param job_pool Pointer to the JobPool structure.
+ * @param worker_index Index of the executing worker.
+ */
+static void
+ExecuteJobs(JobPool *job_pool, u32 worker_index);
+
+/**
+ * @brief Main loop of a worker thread.
+ * @param thread Pointer to the worker thread data.
+ */
+static void
+WorkerLoop(JobPoolThread *thread);
+
+#ifdef _WIN32
+/**
+ * @brief Worker procedure to be executed in the separate thread.
+ * @param thread Pointer to the worker thread data.
+ */
+static DWORD WINAPI
+WorkerThreadProc(void *thread);
+#else
+/**
+ * @brief Worker procedure to be executed in the separate thread.
+ * @param thread Pointer to the worker thread data.
+ */
+static void*
+WorkerThreadProc(void *thread);
+#endif
+
+JobPool*
+JobPool_Constructor(void)
+{
+    size_t size = sizeof(JobPool);
+    JobPool *job_pool = (JobPool *)HelperFcn_MemAllocate(size);
+    return job_pool;
+}
+
+JobPool*
+JobPool_Destructor(JobPool *job_pool)
+{
+    /* Wake up all the workers with the cleared running flag and wait for them. */
+    Atomic_Store(&job_pool->is_running, false);
+    SignalPost(job_pool->start_signal, job_pool->threads_num);
+    for (u32 i = 0; i < job_pool->threads_num; ++i)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(job_pool->threads[i].handle, INFINITE);
+        CloseHandle(job_pool->threads[i].handle);
+#else
+        pthread_join(job_pool->threads[i].handle, NULL);
+#endif
+    }
+
+    SignalDestroy(job_pool->start_signal);
+    SignalDestroy(job_pool->done_signal);
+    if (job_pool->threads) HelperFcn_MemFree(job_pool->threads);
+    HelperFcn_MemFree(job_pool);
+    return NULL;
+}
+
+void
+JobPool_Init(JobPool *job_pool, u32 threads_num)
+{
+    if (threads_num == 0)
+    {
+        threads_num = JobPool_GetCpuCoresNum() - 1;
+    }
+
+    job_pool->threads_num = threads_num;
+    job_pool->start_signal = SignalCreate();
+    job_pool->done_signal = SignalCreate();
+    Atomic_Store(&job_pool->is_running, true);
+
+    if (threads_num == 0) return;
+
+    size_t size = threads_num * sizeof(JobPoolThread);
+    job_pool->threads = (JobPoolThread *)HelperFcn_MemAllocate(size);
+    for (u32 i = 0; i < threads_num; ++i)
+    {
+        JobPoolThread *thread = &job_pool->threads[i];
+        thread->job_pool = job_pool;
+        thread->worker_index = i;
+#ifdef _WIN32
+        thread->handle = CreateThread(0, 0, WorkerThreadProc, thread, 0, 0);
+        if (thread->handle == NULL)
+        {
+            dbg_error("%s", "Worker thread was not created!");
+        }
+#else
+        if (pthread_create(&thread->handle, NULL, WorkerThreadProc, thread) != 0)
+        {
+            dbg_error("%s", "Worker thread was not created!");
+        }
+#endif
+    }
+}
+
+u32
+JobPool_GetWorkersNum(JobPool *job_pool)
+{
+    return job_pool->threads_num + 1;
+}
+
+void
+JobPool_Run(JobPool *job_pool, job_proc_t *job_proc, void *job_data, u32 jobs_num)
+{
+    /* The caller is the worker with the last index. */
+    u32 caller_index = job_pool->threads_num;
+
+    /* Nothing to share with the worker threads. */
+    if ((job_pool->threads_num == 0) || (jobs_num <= 1))
+    {
+        for (u32 i = 0; i < jobs_num; ++i)
+        {
+            job_proc(job_data, i, caller_index);
+        }
+        return;
+    }
+
+    /* Publish the batch and wake up the workers. */
+    job_pool->job_proc = job_proc;
+    job_pool->job_data = job_data;
+    job_pool->jobs_num = jobs_num;
+    Atomic_Store(&job_pool->next_job, 0);
+    Atomic_Store(&job_pool->active_workers, (s32)job_pool->threads_num);
+    SignalPost(job_pool->start_signal, job_pool->threads_num);
+
+    /* Take part in the batch and wait for the rest of the workers. */
+    ExecuteJobs(job_pool, caller_index);
+    SignalWait(job_pool->done_signal);
+}
+
+u32
+JobPool_GetCpuCoresNum(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    u32 cores_num = (u32)system_info.dwNumberOfProcessors;
+#else
+    long cores_num_raw = sysconf(_SC_NPROCESSORS_ONLN);
+    u32 cores_num = (cores_num_raw > 0) ? (u32)cores_num_raw : 1;
+#endif
+    return (cores_num > 0) ? cores_num : 1;
+}
+
+static void*
+SignalCreate(void)
+{
+#ifdef _WIN32
+    HANDLE semaphore = CreateSemaphore(NULL, 0, 0x7fffffff, NULL);
+    if (semaphore == NULL)
+    {
+        dbg_error("%s", "Semaphore was not created!");
+    }
+    return (void *)semaphore;
+#else
+    sem_t *semaphore = (sem_t *)HelperFcn_MemAllocate(sizeof(sem_t));
+    if (sem_init(semaphore, 0, 0) != 0)
+    {
+        dbg_error("%s", "Semaphore was not created!");
+    }
+    return (void *)semaphore;
+#endif
+}
+
+static void
+SignalPost(void *signal, u32 count)
+{
+    if (count == 0) return;
+#ifdef _WIN32
+    ReleaseSemaphore((HANDLE)signal, (LONG)count, NULL);
+#else
+    for (u32 i = 0; i < count; ++i)
+    {
+        sem_post((sem_t *)signal);
+    }
+#endif
+}
+
+static void
+SignalWait(void *signal)
+{
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)signal, INFINITE);
+#else
+    while (sem_wait((sem_t *)signal) != 0)
+    {
+        /* Interrupted by a signal handler, wait again. */
+    }
+#endif
+}
+
+static void
+SignalDestroy(void *signal)
+{
+#ifdef _WIN32
+    CloseHandle((HANDLE)signal);
+#else
+    sem_destroy((sem_t *)signal);
+    HelperFcn_MemFree(signal);
+#endif
+}
+
+static void
+ExecuteJobs(JobPool *job_pool, u32 worker_index)
+{
+    while (true)
+    {
+        u32 job_index = (u32)(Atomic_Increment(&job_pool->next_job) - 1);
+        if (job_index >= job_pool->jobs_num) break;
+        job_pool->job_proc(job_pool->job_data, job_index, worker_index);
+    }
+}
+
+static void
+WorkerLoop(JobPoolThread *thread)
+{
+    JobPool *job_pool = thread->job_pool;
+
+    while (true)
+    {
+        SignalWait(job_pool->start_signal);
+        if (!Atomic_Load(&job_pool->is_running)) break;
+
+        ExecuteJobs(job_pool, thread->worker_index);
+
+        /* The last finished worker notifies the caller. */
+        if (Atomic_Decrement(&job_pool->active_workers) == 0)
+        {
+            SignalPost(job_pool->done_signal, 1);
+        }
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI
+WorkerThreadProc(void *thread)
+{
+    WorkerLoop((JobPoolThread *)thread);
+    return 0;
+}
+#else
+static void*
+WorkerThreadProc(void *thread)
+{
+    WorkerLoop((JobPoolThread *)thread);
+    return NULL;
+}
+#endif
@@ -0,0 +1,319 @@
+/**
+ * ================================================================================
+ * @file src_engine/line_raster.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the rasterization of the anti-aliased lines.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/line_raster.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#define LINE_RASTER_ONE (1 << LINE_RASTER_FRACTION_BITS)  /* 1.0 in fixed point. */
+#define LINE_RASTER_STACK_MASK 4096  /* Coverage mask kept without allocation (bytes). */
+
+/**
+ * @brief Traversal of the pixels of an anti-aliased line. The coverage of every pixel is
+ * blended with the color or kept in the coverage mask (the larger one stays).
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer or to the pixel
+ * (clip->x0, clip->y0) of the coverage mask (a byte per pixel).
+ * @param row_pixels Distance between two rows of the buffer or the mask in pixels.
+ * @param is_mask Flag of the coverage mask.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param x0 X coordinate of the beginning point.
+ * @param y0 Y coordinate of the beginning point.
+ * @param x1 X coordinate of the ending point.
+ * @param y1 Y coordinate of the ending point.
+ * @param color 32 bit color (ARGB) with the premultiplied alpha (buffer only).
+ * @param blend Blend mode except BM_NONE (buffer only).
+ */
+static void
+TraverseLine(void *memory, s32 row_pixels, b32 is_mask, const RenderRect *clip, f32 x0,
+    f32 y0, f32 x1, f32 y1, u32 color, BlendMode blend);
+
+/**
+ * @brief Clipping a line segment by a rectangle (Liang-Barsky algorithm). The points
+ * inside of the rectangle are left untouched, so usual lines keep their pixels.
+ * @param x0 X coordinate of the beginning point (updated).
+ * @param y0 Y coordinate of the beginning point (updated).
+ * @param x1 X coordinate of the ending point (updated).
+ * @param y1 Y coordinate of the ending point (updated).
+ * @param rect Rectangle: minimal x, minimal y, maximal x and maximal y.
+ * @return b32 False if the segment lies outside of the rectangle.
+ */
+static b32
+ClipSegment(f32 *x0, f32 *y0, f32 *x1, f32 *y1, const f32 *rect);
+
+/**
+ * @brief Multiplication of every channel of the color by a factor.
+ * @param color 32 bit color (ARGB).
+ * @param factor Factor from 0 (zero) to 255 (one).
+ * @return u32 Scaled color.
+ */
+static u32
+ScaleColor(u32 color, u32 factor);
+
+/**
+ * @brief Blending the color with a single pixel by the coverage of the pixel.
+ * @param dst Pointer to the pixel.
+ * @param color 32 bit color (ARGB) with the premultiplied alpha.
+ * @param coverage Coverage of the pixel from 0 (none) to 255 (full).
+ * @param blend Blend mode (except BM_NONE).
+ */
+static void
+BlendPixel(u32 *dst, u32 color, u32 coverage, BlendMode blend);
+
+void
+LineRaster_DrawAA(void *memory, u32 pitch, const RenderRect *clip, f32 x0, f32 y0,
+    f32 x1, f32 y1, u32 color, BlendMode blend)
+{
+    if (blend == BM_NONE) blend = BM_ALPHA;
+    TraverseLine(memory, (s32)(pitch / sizeof(u32)), false, clip, x0, y0, x1, y1,
+        Blend_Premultiply(color), blend);
+}
+
+void
+LineRaster_DrawPolylineAA(void *memory, u32 pitch, const RenderRect *clip,
+    const Vec2 *points, u32 points_num, u32 color, BlendMode blend)
+{
+    /* Coverage reaches the pixels next to the points, segments with infinite or
+    undefined points are not drawn. */
+    f32 x_min = INFINITY, x_max = -INFINITY;
+    f32 y_min = INFINITY, y_max = -INFINITY;
+    for (u32 i = 0; i < points_num; ++i)
+    {
+        if (!isfinite(points[i].x) || !isfinite(points[i].y)) continue;
+        x_min = fminf(x_min, points[i].x);
+        x_max = fmaxf(x_max, points[i].x);
+        y_min = fminf(y_min, points[i].y);
+        y_max = fmaxf(y_max, points[i].y);
+    }
+    if ((points_num < 2) || (x_min > x_max)) return;
+
+    RenderRect area;
+    area.x0 = (s32)fmaxf(floorf(x_min - 1.0f), (f32)clip->x0);
+    area.y0 = (s32)fmaxf(floorf(y_min - 1.0f), (f32)clip->y0);
+    area.x1 = (s32)fminf(ceilf(x_max + 1.0f), (f32)clip->x1);
+    area.y1 = (s32)fminf(ceilf(y_max + 1.0f), (f32)clip->y1);
+    if ((area.x0 >= area.x1) || (area.y0 >= area.y1)) return;
+
+    /* Small masks are kept on the stack. */
+    u32 width = (u32)(area.x1 - area.x0);
+    u32 height = (u32)(area.y1 - area.y0);
+    size_t mask_size = (size_t)width * height;
+    u8 stack_mask[LINE_RASTER_STACK_MASK];
+    u8 *mask = stack_mask;
+    if (mask_size > LINE_RASTER_STACK_MASK)
+        mask = (u8 *)HelperFcn_MemAllocate(mask_size);
+    else
+        memset(mask, 0, mask_size);
+
+    for (u32 i = 1; i < points_num; ++i)
+    {
+        TraverseLine(mask, (s32)width, true, &area, points[i - 1].x, points[i - 1].y,
+            points[i].x, points[i].y, 0, BM_ALPHA);
+    }
+
+    /* Every covered pixel is blended once. */
+    if (blend == BM_NONE) blend = BM_ALPHA;
+    color = Blend_Premultiply(color);
+    for (u32 y = 0; y < height; ++y)
+    {
+        u32 *row = (u32 *)((u8 *)memory + (size_t)pitch * (u32)(area.y0 + (s32)y)) +
+            area.x0;
+        const u8 *coverage = mask + (size_t)width * y;
+        for (u32 x = 0; x < width; ++x)
+        {
+            BlendPixel(&row[x], color, coverage[x], blend);
+        }
+    }
+    if (mask != stack_mask) HelperFcn_MemFree(mask);
+}
+
+static void
+TraverseLine(void *memory, s32 row_pixels, b32 is_mask, const RenderRect *clip, f32 x0,
+    f32 y0, f32 x1, f32 y1, u32 color, BlendMode blend)
+{
+    if (!isfinite(x0) || !isfinite(y0) || !isfinite(x1) || !isfinite(y1)) return;
+
+    const f32 limit = LINE_RASTER_GUARD_BAND;
+    f32 rect[4] = {-limit, -limit, limit, limit};
+    if (!ClipSegment(&x0, &y0, &x1, &y1, rect)) return;
+
+    /* The line is traversed along the major axis (a) from the lower coordinate, the
+    minor axis (b) is stepped in the fixed point. Pixel centers are moved to the
+    integer coordinates. */
+    b32 is_steep = fabsf(y1 - y0) > fabsf(x1 - x0);
+    f32 a0 = (is_steep ? y0 : x0) - 0.5f;
+    f32 b0 = (is_steep ? x0 : y0) - 0.5f;
+    f32 a1 = (is_steep ? y1 : x1) - 0.5f;
+    f32 b1 = (is_steep ? x1 : y1) - 0.5f;
+    if (a0 > a1)
+    {
+        f32 tmp = a0; a0 = a1; a1 = tmp;
+        tmp = b0; b0 = b1; b1 = tmp;
+    }
+    f32 gradient = (a1 > a0) ? (b1 - b0) / (a1 - a0) : 0.0f;
+
+    ptrdiff_t major_step = is_steep ? row_pixels : 1;
+    ptrdiff_t minor_step = is_steep ? 1 : row_pixels;
+    s32 major_lo = is_steep ? clip->y0 : clip->x0;
+    s32 major_hi = is_steep ? clip->y1 : clip->x1;
+    s32 minor_lo = is_steep ? clip->x0 : clip->y0;
+    s32 minor_hi = is_steep ? clip->x1 : clip->y1;
+
+    /* End pixels are covered only by the part of the line inside of them. */
+    s32 a_begin = (s32)floorf(a0 + 0.5f);
+    s32 a_end = (s32)floorf(a1 + 0.5f);
+    u32 weight_begin = (u32)((1.0f - (a0 + 0.5f - (f32)a_begin)) * 255.0f + 0.5f);
+    u32 weight_end = (u32)((a1 + 0.5f - (f32)a_end) * 255.0f + 0.5f);
+    if (a_begin == a_end)
+    {
+        weight_begin = (u32)((a1 - a0) * 255.0f + 0.5f);
+        weight_end = weight_begin;
+    }
+
+    s32 a_first = (a_begin > major_lo) ? a_begin : major_lo;
+    s32 a_last = (a_end < major_hi - 1) ? a_end : major_hi - 1;
+    if (a_first > a_last) return;
+
+    /* The minor coordinate at the first visible pixel is stepped from the beginning in
+    integers, so the pixels are the same for any clip rectangle (tiles). */
+    s64 step = (s64)lroundf(gradient * (f32)LINE_RASTER_ONE);
+    s64 b = (s64)llroundf((b0 + gradient * ((f32)a_begin - a0)) * (f32)LINE_RASTER_ONE);
+    b += step * (a_first - a_begin);
+    s32 minor = (s32)(b >> LINE_RASTER_FRACTION_BITS);
+    ptrdiff_t offset = (ptrdiff_t)a_first * major_step + (ptrdiff_t)minor * minor_step;
+    if (is_mask) offset -= (ptrdiff_t)clip->y0 * row_pixels + clip->x0;
+    u32 *first = (u32 *)memory;
+    u8 *first_mask = (u8 *)memory;
+    for (s32 a = a_first; a <= a_last; ++a)
+    {
+        /* Two pixels across the line share the coverage by the fraction. */
+        u32 fraction = ((u32)b >> (LINE_RASTER_FRACTION_BITS - 8)) & 0xff;
+        u32 coverage_lo = 0xff - fraction;
+        u32 coverage_hi = fraction;
+        if ((a == a_begin) || (a == a_end))
+        {
+            u32 weight = (a == a_begin) ? weight_begin : weight_end;
+            coverage_lo = (coverage_lo * weight + 127) / 255;
+            coverage_hi = (coverage_hi * weight + 127) / 255;
+        }
+        if (is_mask)
+        {
+            /* Pixels of the joints and the crossings keep the larger coverage. */
+            if ((minor >= minor_lo) && (minor < minor_hi) &&
+                (coverage_lo > first_mask[offset]))
+            {
+                first_mask[offset] = (u8)coverage_lo;
+            }
+            if ((minor + 1 >= minor_lo) && (minor + 1 < minor_hi) &&
+                (coverage_hi > first_mask[offset + minor_step]))
+            {
+                first_mask[offset + minor_step] = (u8)coverage_hi;
+            }
+        }
+        else
+        {
+            if ((minor >= minor_lo) && (minor < minor_hi))
+            {
+                BlendPixel(first + offset, color, coverage_lo, blend);
+            }
+            if ((minor + 1 >= minor_lo) && (minor + 1 < minor_hi))
+            {
+                BlendPixel(first + offset + minor_step, color, coverage_hi, blend);
+            }
+        }
+
+        /* The minor coordinate changes by one pixel at most. */
+        b += step;
+        s32 next_minor = (s32)(b >> LINE_RASTER_FRACTION_BITS);
+        offset += major_step;
+        if (next_minor != minor)
+        {
+            offset += (next_minor > minor) ? minor_step : -minor_step;
+            minor = next_minor;
+        }
+    }
+}
+
+static b32
+ClipSegment(f32 *x0, f32 *y0, f32 *x1, f32 *y1, const f32 *rect)
+{
+    /* Parameters of the segment p0 + t * (p1 - p0) entering and leaving the rectangle. */
+    f32 dx = *x1 - *x0;
+    f32 dy = *y1 - *y0;
+    f32 p[4] = {-dx, dx, -dy, dy};
+    f32 q[4] = {*x0 - rect[0], rect[2] - *x0, *y0 - rect[1], rect[3] - *y0};
+    f32 t_enter = 0.0f;
+    f32 t_leave = 1.0f;
+    for (u32 i = 0; i < 4; ++i)
+    {
+        if (p[i] == 0.0f)
+        {
+            if (q[i] < 0.0f) return false;  /* Parallel to the side and outside. */
+            continue;
+        }
+        f32 t = q[i] / p[i];
+        if (p[i] < 0.0f)
+        {
+            if (t > t_enter) t_enter = t;
+        }
+        else
+        {
+            if (t < t_leave) t_leave = t;
+        }
+    }
+    if (t_enter > t_leave) return false;
+
+    f32 begin_x = *x0;
+    f32 begin_y = *y0;
+    if (t_enter > 0.0f)
+    {
+        *x0 = begin_x + t_enter * dx;
+        *y0 = begin_y + t_enter * dy;
+    }
+    if (t_leave < 1.0f)
+    {
+        *x1 = begin_x + t_leave * dx;
+        *y1 = begin_y + t_leave * dy;
+    }
+    return true;
+}
+
+static u32
+ScaleColor(u32 color, u32 factor)
+{
+    /* Two channels are scaled at once, the division by 255 is rounded. */
+    u32 rb = (color & 0x00ff00ff) * factor + 0x00800080;
+    u32 ag = ((color >> 8) & 0x00ff00ff) * factor + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+    return rb | ag;
+}
+
+static void
+BlendPixel(u32 *dst, u32 color, u32 coverage, BlendMode blend)
+{
+    if (coverage == 0) return;
+    u32 src = (coverage == 0xff) ? color : ScaleColor(color, coverage);
+    if (blend != BM_ALPHA)
+    {
+        Blend_RowColor(dst, 1, src, blend);
+        return;
+    }
+    *dst = src + ScaleColor(*dst, 0xff - (src >> 24));
+    RENDER_STATS_COUNT_ROW(dst, 1);
+}
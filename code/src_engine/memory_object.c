@@ -10,7 +10,11 @@
 
 #include "include_engine/memory_object.h"
 
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <stdio.h>
+#endif
 
 #include "include_engine/dbg.h"
 #include "include_engine/helper_functions.h"
@@ -27,7 +31,7 @@ MemObject_Constructor(void)
 MemObject*
 MemObject_Destructor(MemObject *mem_object)
 {
-    VirtualFree(mem_object->data, 0, MEM_RELEASE);
+    HelperFcn_PageFree(mem_object->data);
     HelperFcn_MemFree(mem_object);
     return NULL;
 }
@@ -35,6 +39,7 @@ MemObject_Destructor(MemObject *mem_object)
 void
 MemObject_InitByFile(MemObject *mem_object, const char *file_path)
 {
+#ifdef _WIN32
     HANDLE file_handle = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, 0, 
         OPEN_EXISTING, 0, 0);
     if (file_handle == INVALID_HANDLE_VALUE) 
@@ -43,27 +48,75 @@ MemObject_InitByFile(MemObject *mem_object, const char *file_path)
     }
 
     DWORD size = GetFileSize(file_handle, 0);
-    LPVOID data = VirtualAlloc(0, size, MEM_COMMIT|MEM_RESERVE, PAGE_READWRITE);
-    if (data == NULL)
-    {
-        dbg_error("%s", "Attempt to delete an empty object!");
-    }
+    LPVOID data = HelperFcn_PageAllocate(size);
     
     DWORD bytes_read;  /* Amount of bytes that was really read from the disc. */
     BOOL flag = (ReadFile(file_handle, data, size, &bytes_read, 0)) && (size == bytes_read);
+    CloseHandle(file_handle);
     if (!flag) 
     {
         dbg_error("%s", "Error reading file into memory object!");
     }
+#else
+    FILE *file = fopen(file_path, "rb");
+    if (file == NULL)
+    {
+        dbg_error("%s", "File not found!");
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void *data = HelperFcn_PageAllocate((size_t)size);
+    b32 flag = (fread(data, 1, (size_t)size, file) == (size_t)size);
+    fclose(file);
+    if (!flag)
+    {
+        dbg_error("%s", "Error reading file into memory object!");
+    }
+#endif
 
     mem_object->size = (u64)size;
     mem_object->data = (u8 *)data;
 }
 
+void
+MemObject_InitBySize(MemObject *mem_object, u64 size)
+{
+    void *data = HelperFcn_PageAllocate((size_t)size);
+    mem_object->size = size;
+    mem_object->data = (u8 *)data;
+}
+
 void
 MemObject_WriteToDisc(MemObject *mem_object, char *file_path)
 {
-    /* TODO: Make definition of this method later on. */
-   UNUSED(mem_object);
-   UNUSED(file_path);
+#ifdef _WIN32
+    HANDLE file_handle = CreateFileA(file_path, GENERIC_WRITE, 0, 0, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL, 0);
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        dbg_error("%s", "File could not be created!");
+    }
+
+    DWORD size = (DWORD)mem_object->size;
+    DWORD bytes_written;  /* Amount of bytes that was really written to the disc. */
+    BOOL flag = (WriteFile(file_handle, mem_object->data, size, &bytes_written, 0)) &&
+        (size == bytes_written);
+    CloseHandle(file_handle);
+#else
+    FILE *file = fopen(file_path, "wb");
+    if (file == NULL)
+    {
+        dbg_error("%s", "File could not be created!");
+    }
+
+    size_t size = (size_t)mem_object->size;
+    b32 flag = (fwrite(mem_object->data, 1, size, file) == size);
+    fclose(file);
+#endif
+    if (!flag)
+    {
+        dbg_error("%s", "Error writing memory object to the file!");
+    }
 }
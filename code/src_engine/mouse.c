@@ -35,6 +35,10 @@ Mouse_Destructor(Mouse *mouse)
 void
 Mouse_PrepareInput(Mouse *mouse, Render *render)
 {
-    mouse->cur_x = (u32)mouse->raw_cursor.x;
-    mouse->cur_y = render->height - (u32)mouse->raw_cursor.y;
+    /* Window coordinates (from the top) are mapped to the render buffer pixels. */
+    s32 x, y;
+    Render_MapWindowPoint(render, (s32)mouse->raw_cursor.x,
+        (s32)render->height - (s32)mouse->raw_cursor.y, &x, &y);
+    mouse->cur_x = (u32)x;
+    mouse->cur_y = (u32)y;
 }
\ No newline at end of file
@@ -0,0 +1,505 @@
+/**
+ * ================================================================================
+ * @file src_engine/pixel_format.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the conversion of pixel rows between the formats.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/pixel_format.h"
+
+#include <string.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PIXEL_FORMAT_X86
+#include <immintrin.h>
+#endif
+
+/* GCC and Clang need the target attribute to compile the intrinsics of an
+instruction set which is not enabled for the whole translation unit. */
+#if defined(PIXEL_FORMAT_X86) && !defined(_MSC_VER)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+/* Amount of pixels converted at once through the alpha only format. */
+#define PIXEL_FORMAT_CHUNK 256
+
+/* Declare pointer to the kernel converting a row of 32 bit pixels. */
+typedef void convert_row_t(u32 *dst, const u32 *src, u32 count);
+
+/* Declare pointer to the kernel extracting the alpha of a row of 32 bit pixels. */
+typedef void alpha_row_t(u8 *dst, const u32 *src, u32 count);
+
+/* Declare pointer to the kernel packing a row of 8 bit alpha into bits. */
+typedef void bits_row_t(u8 *dst, const u8 *src, u32 count);
+
+/* Descriptions of the formats (PixelFormat order). */
+static const PixelFormatInfo pixel_formats[PF_FORMATS_NUM] =
+{
+    {32, true, false, "RGBA"},
+    {32, true, false, "BGRA"},
+    {32, true, true, "BGRA premultiplied"},
+    {8, false, false, "A8"},
+    {1, false, false, "A1"}
+};
+
+/**
+ * @brief Exchanging the red and the blue channels with plain C code.
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+SwapRedBlueScalar(u32 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Multiplication of the color channels by the alpha with plain C code.
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+PremultiplyScalar(u32 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Extraction of the alpha channel with plain C code.
+ * @param dst Pointer to the destination alpha values.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+ExtractAlphaScalar(u8 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Packing of the alpha values into bits with plain C code.
+ * @param dst Pointer to the destination bytes.
+ * @param src Pointer to the source alpha values.
+ * @param count Amount of pixels.
+ */
+static void
+PackBitsScalar(u8 *dst, const u8 *src, u32 count);
+
+/**
+ * @brief Division of the color channels by the alpha (the inverse of premultiplying).
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+Unpremultiply(u32 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Expanding the alpha values to the black 32 bit pixels.
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source alpha values.
+ * @param count Amount of pixels.
+ */
+static void
+ExpandAlpha(u32 *dst, const u8 *src, u32 count);
+
+/**
+ * @brief Unpacking of the alpha bits into the alpha values.
+ * @param dst Pointer to the destination alpha values.
+ * @param src Pointer to the source bytes.
+ * @param count Amount of pixels.
+ */
+static void
+UnpackBits(u8 *dst, const u8 *src, u32 count);
+
+#ifdef PIXEL_FORMAT_X86
+/**
+ * @brief Exchanging the red and the blue channels with SSE2 shifts.
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+SwapRedBlueSse2(u32 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Exchanging the red and the blue channels with AVX2 byte shuffles.
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+SwapRedBlueAvx2(u32 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Multiplication of the color channels by the alpha with SSE2.
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+PremultiplySse2(u32 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Multiplication of the color channels by the alpha with AVX2.
+ * @param dst Pointer to the destination pixels.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+PremultiplyAvx2(u32 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Extraction of the alpha channel with SSE2 packs (16 pixels per step).
+ * @param dst Pointer to the destination alpha values.
+ * @param src Pointer to the source pixels.
+ * @param count Amount of pixels.
+ */
+static void
+ExtractAlphaSse2(u8 *dst, const u32 *src, u32 count);
+
+/**
+ * @brief Packing of the alpha values into bits with the SSE2 byte mask.
+ * @param dst Pointer to the destination bytes.
+ * @param src Pointer to the source alpha values.
+ * @param count Amount of pixels.
+ */
+static void
+PackBitsSse2(u8 *dst, const u8 *src, u32 count);
+#endif
+
+/* Kernels for every instruction set of the span fill (SpanFillIsa order). The packs of
+AVX2 work inside the 128 bit lanes, so the narrow kernels are used for them. */
+#ifdef PIXEL_FORMAT_X86
+static convert_row_t *swap_red_blue[SFI_ISA_NUM] =
+{
+    SwapRedBlueScalar, SwapRedBlueSse2, SwapRedBlueAvx2
+};
+static convert_row_t *premultiply[SFI_ISA_NUM] =
+{
+    PremultiplyScalar, PremultiplySse2, PremultiplyAvx2
+};
+static alpha_row_t *extract_alpha[SFI_ISA_NUM] =
+{
+    ExtractAlphaScalar, ExtractAlphaSse2, ExtractAlphaSse2
+};
+static bits_row_t *pack_bits[SFI_ISA_NUM] =
+{
+    PackBitsScalar, PackBitsSse2, PackBitsSse2
+};
+#else
+static convert_row_t *swap_red_blue[SFI_ISA_NUM] =
+{
+    SwapRedBlueScalar, SwapRedBlueScalar, SwapRedBlueScalar
+};
+static convert_row_t *premultiply[SFI_ISA_NUM] =
+{
+    PremultiplyScalar, PremultiplyScalar, PremultiplyScalar
+};
+static alpha_row_t *extract_alpha[SFI_ISA_NUM] =
+{
+    ExtractAlphaScalar, ExtractAlphaScalar, ExtractAlphaScalar
+};
+static bits_row_t *pack_bits[SFI_ISA_NUM] =
+{
+    PackBitsScalar, PackBitsScalar, PackBitsScalar
+};
+#endif
+
+const PixelFormatInfo*
+PixelFormat_GetInfo(PixelFormat format)
+{
+    dbg_check(format < PF_FORMATS_NUM, "%s", "Unknown pixel format!");
+    return &pixel_formats[format];
+}
+
+u32
+PixelFormat_GetPitch(PixelFormat format, u32 width)
+{
+    return (u32)(((u64)width * PixelFormat_GetInfo(format)->bits_per_pixel + 7) / 8);
+}
+
+void
+PixelFormat_ConvertRow(void *dst, PixelFormat dst_format, const void *src,
+    PixelFormat src_format, u32 count)
+{
+    if (src_format == dst_format)
+    {
+        memmove(dst, src, PixelFormat_GetPitch(dst_format, count));
+        return;
+    }
+
+    SpanFillIsa isa = SpanFill_GetIsa();
+    b32 is_src_color = PixelFormat_GetInfo(src_format)->has_color;
+    b32 is_dst_color = PixelFormat_GetInfo(dst_format)->has_color;
+    u8 alpha[PIXEL_FORMAT_CHUNK];
+
+    if (is_src_color && is_dst_color)
+    {
+        /* Straight alpha first, then the channel order, then the premultiplying. */
+        const u32 *pixels = (const u32 *)src;
+        if (src_format == PF_BGRA_PREMULTIPLIED)
+        {
+            Unpremultiply((u32 *)dst, pixels, count);
+            pixels = (const u32 *)dst;
+            src_format = PF_BGRA;
+        }
+        if ((src_format == PF_RGBA) != (dst_format == PF_RGBA))
+        {
+            swap_red_blue[isa]((u32 *)dst, pixels, count);
+            pixels = (const u32 *)dst;
+        }
+        if (dst_format == PF_BGRA_PREMULTIPLIED)
+            premultiply[isa]((u32 *)dst, pixels, count);
+        else if (pixels != (const u32 *)dst)
+            memmove(dst, pixels, count * sizeof(u32));
+    }
+    else if (is_src_color)
+    {
+        /* The alpha is the highest byte of all the color formats. */
+        if (dst_format == PF_A8)
+        {
+            extract_alpha[isa]((u8 *)dst, (const u32 *)src, count);
+            return;
+        }
+        for (u32 i = 0; i < count; i += PIXEL_FORMAT_CHUNK)
+        {
+            u32 chunk = (count - i < PIXEL_FORMAT_CHUNK) ? count - i : PIXEL_FORMAT_CHUNK;
+            extract_alpha[isa](alpha, (const u32 *)src + i, chunk);
+            pack_bits[isa]((u8 *)dst + i / 8, alpha, chunk);
+        }
+    }
+    else if (is_dst_color)
+    {
+        /* Black pixels are the same for the straight and the premultiplied alpha. */
+        if (src_format == PF_A8)
+        {
+            ExpandAlpha((u32 *)dst, (const u8 *)src, count);
+            return;
+        }
+        for (u32 i = 0; i < count; i += PIXEL_FORMAT_CHUNK)
+        {
+            u32 chunk = (count - i < PIXEL_FORMAT_CHUNK) ? count - i : PIXEL_FORMAT_CHUNK;
+            UnpackBits(alpha, (const u8 *)src + i / 8, chunk);
+            ExpandAlpha((u32 *)dst + i, alpha, chunk);
+        }
+    }
+    else if (dst_format == PF_A1)
+    {
+        pack_bits[isa]((u8 *)dst, (const u8 *)src, count);
+    }
+    else
+    {
+        UnpackBits((u8 *)dst, (const u8 *)src, count);
+    }
+}
+
+static void
+SwapRedBlueScalar(u32 *dst, const u32 *src, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 pixel = src[i];
+        dst[i] = (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+    }
+}
+
+static void
+PremultiplyScalar(u32 *dst, const u32 *src, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 pixel = src[i];
+        u32 alpha = pixel >> 24;
+        u32 result = pixel & 0xff000000;
+        for (u32 shift = 0; shift < 24; shift += 8)
+        {
+            /* Division by 255 with rounding, as in the blend kernels. */
+            u32 value = ((pixel >> shift) & 0xff) * alpha + 128;
+            result |= ((value + (value >> 8)) >> 8) << shift;
+        }
+        dst[i] = result;
+    }
+}
+
+static void
+ExtractAlphaScalar(u8 *dst, const u32 *src, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        dst[i] = (u8)(src[i] >> 24);
+    }
+}
+
+static void
+PackBitsScalar(u8 *dst, const u8 *src, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        if ((i % 8) == 0) dst[i / 8] = 0;
+        if (src[i] >= 0x80) dst[i / 8] |= (u8)(1 << (i % 8));
+    }
+}
+
+static void
+Unpremultiply(u32 *dst, const u32 *src, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 pixel = src[i];
+        u32 alpha = pixel >> 24;
+        u32 result = pixel & 0xff000000;
+        if (alpha != 0)
+        {
+            for (u32 shift = 0; shift < 24; shift += 8)
+            {
+                u32 value = (((pixel >> shift) & 0xff) * 0xff + alpha / 2) / alpha;
+                result |= ((value > 0xff) ? 0xff : value) << shift;
+            }
+        }
+        dst[i] = result;
+    }
+}
+
+static void
+ExpandAlpha(u32 *dst, const u8 *src, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        dst[i] = (u32)src[i] << 24;
+    }
+}
+
+static void
+UnpackBits(u8 *dst, const u8 *src, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        dst[i] = ((src[i / 8] >> (i % 8)) & 1) ? 0xff : 0x00;
+    }
+}
+
+#ifdef PIXEL_FORMAT_X86
+TARGET_SSE2 static void
+SwapRedBlueSse2(u32 *dst, const u32 *src, u32 count)
+{
+    __m128i mask_ag = _mm_set1_epi32((int)0xff00ff00);
+    __m128i mask_rb = _mm_set1_epi32(0x00ff00ff);
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        /* Shifts of the red and blue lanes drop the other channel out of the pixel. */
+        __m128i pixels = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i rb = _mm_and_si128(pixels, mask_rb);
+        rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_and_si128(pixels, mask_ag),
+            rb));
+    }
+    SwapRedBlueScalar(dst + i, src + i, count - i);
+}
+
+TARGET_AVX2 static void
+SwapRedBlueAvx2(u32 *dst, const u32 *src, u32 count)
+{
+    __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(pixels, shuffle));
+    }
+    SwapRedBlueScalar(dst + i, src + i, count - i);
+}
+
+TARGET_SSE2 static void
+PremultiplySse2(u32 *dst, const u32 *src, u32 count)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i half = _mm_set1_epi16(128);
+    __m128i mask_alpha = _mm_set1_epi32((int)0xff000000);
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xff), 0xff);
+        __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xff), 0xff);
+
+        /* Division by 255 with rounding: (x + 128 + ((x + 128) >> 8)) >> 8. */
+        lo = _mm_add_epi16(_mm_mullo_epi16(lo, a_lo), half);
+        hi = _mm_add_epi16(_mm_mullo_epi16(hi, a_hi), half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        __m128i result = _mm_packus_epi16(lo, hi);
+        result = _mm_or_si128(_mm_andnot_si128(mask_alpha, result),
+            _mm_and_si128(mask_alpha, pixels));
+        _mm_storeu_si128((__m128i *)(dst + i), result);
+    }
+    PremultiplyScalar(dst + i, src + i, count - i);
+}
+
+TARGET_AVX2 static void
+PremultiplyAvx2(u32 *dst, const u32 *src, u32 count)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i half = _mm256_set1_epi16(128);
+    __m256i mask_alpha = _mm256_set1_epi32((int)0xff000000);
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        /* Unpacks and packs work inside the 128 bit lanes, so the order is kept. */
+        __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+        __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+        __m256i a_lo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xff), 0xff);
+        __m256i a_hi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xff), 0xff);
+
+        lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, a_lo), half);
+        hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, a_hi), half);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        __m256i result = _mm256_packus_epi16(lo, hi);
+        result = _mm256_or_si256(_mm256_andnot_si256(mask_alpha, result),
+            _mm256_and_si256(mask_alpha, pixels));
+        _mm256_storeu_si256((__m256i *)(dst + i), result);
+    }
+    PremultiplyScalar(dst + i, src + i, count - i);
+}
+
+TARGET_SSE2 static void
+ExtractAlphaSse2(u8 *dst, const u32 *src, u32 count)
+{
+    u32 i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a0 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i)), 24);
+        __m128i a1 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i + 4)), 24);
+        __m128i a2 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i + 8)), 24);
+        __m128i a3 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i + 12)), 24);
+        __m128i a01 = _mm_packs_epi32(a0, a1);
+        __m128i a23 = _mm_packs_epi32(a2, a3);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(a01, a23));
+    }
+    ExtractAlphaScalar(dst + i, src + i, count - i);
+}
+
+TARGET_SSE2 static void
+PackBitsSse2(u8 *dst, const u8 *src, u32 count)
+{
+    u32 i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        /* The highest bit of every alpha is set for the values 128 and above. */
+        u16 bits = (u16)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(src + i)));
+        dst[i / 8] = (u8)bits;
+        dst[i / 8 + 1] = (u8)(bits >> 8);
+    }
+    PackBitsScalar(dst + i / 8, src + i, count - i);
+}
+#endif
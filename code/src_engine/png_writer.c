@@ -0,0 +1,355 @@
+/**
+ * ================================================================================
+ * @file src_engine/png_writer.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of the functions for the encoding of the frames into the png files.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/png_writer.h"
+
+#include <string.h>
+
+#include "include_engine/helper_functions.h"
+#include "include_engine/memory_object.h"
+#include "include_engine/utils.h"
+
+#define PNG_HASH_BITS 15  /* Size of the hash table of the LZ77 matching (log2). */
+#define PNG_WINDOW_SIZE 32768  /* Maximal distance of the deflate matches. */
+#define PNG_MATCH_MIN 3  /* Minimal length of the deflate matches. */
+#define PNG_MATCH_MAX 258  /* Maximal length of the deflate matches. */
+
+/**
+ * @brief Structure for the writer of the bits of the deflate stream (the lowest bit
+ * first).
+ */
+struct BitWriter_
+{
+    u8 *data;  /**< Pointer to the next byte of the output. */
+    u64 bits;  /**< Bits waiting for the output. */
+    u32 bits_num;  /**< Amount of the waiting bits. */
+};
+typedef struct BitWriter_ BitWriter;
+
+/**
+ * @brief Adding the bits to the stream.
+ * @param writer Pointer to the bit writer.
+ * @param value Bits to add (the lowest one first).
+ * @param count Amount of the bits (up to 32).
+ */
+static void
+PutBits(BitWriter *writer, u32 value, u32 count);
+
+/**
+ * @brief Adding a Huffman code to the stream (codes are stored from the highest bit).
+ * @param writer Pointer to the bit writer.
+ * @param code Huffman code.
+ * @param length Length of the code in bits.
+ */
+static void
+PutCode(BitWriter *writer, u32 code, u32 length);
+
+/**
+ * @brief Adding a literal or the end of block symbol by the fixed Huffman code.
+ * @param writer Pointer to the bit writer.
+ * @param symbol Symbol of the literal/length alphabet.
+ */
+static void
+PutSymbol(BitWriter *writer, u32 symbol);
+
+/**
+ * @brief Adding a match by the fixed Huffman codes.
+ * @param writer Pointer to the bit writer.
+ * @param length Length of the match.
+ * @param distance Distance of the match.
+ */
+static void
+PutMatch(BitWriter *writer, u32 length, u32 distance);
+
+/**
+ * @brief Compression of the data into the zlib stream (a single fixed Huffman block).
+ * @param dst Pointer to the output (at least size + size / 8 + 64 bytes).
+ * @param src Pointer to the data.
+ * @param size Size of the data in bytes.
+ * @return size_t Size of the zlib stream in bytes.
+ */
+static size_t
+Compress(u8 *dst, const u8 *src, size_t size);
+
+/**
+ * @brief Writing a png chunk with its length and checksum.
+ * @param dst Pointer to the output.
+ * @param type Type of the chunk (4 characters).
+ * @param data Pointer to the data of the chunk.
+ * @param size Size of the data in bytes.
+ * @param crc_table Table of the CRC32 checksum.
+ * @return size_t Size of the written chunk in bytes.
+ */
+static size_t
+WriteChunk(u8 *dst, const char *type, const u8 *data, u32 size, const u32 *crc_table);
+
+/**
+ * @brief Filling the table of the CRC32 checksum of the png chunks (on the stack, so
+ * the frames could be encoded by several threads).
+ * @param crc_table Pointer to the table of 256 items.
+ */
+static void
+InitCrcTable(u32 *crc_table);
+
+/**
+ * @brief Storing a 32 bit value in the big endian order.
+ * @param dst Pointer to the output.
+ * @param value Value to store.
+ */
+static void
+StoreBigEndian(u8 *dst, u32 value);
+
+void
+PngWriter_Encode(MemObject *mem_object, const u32 *pixels, u32 width, u32 height,
+    u32 pitch)
+{
+    /* Every row starts with the filter type (none), the pixels are stored as RGBA. */
+    size_t row_size = (size_t)width * 4 + 1;
+    size_t raw_size = row_size * height;
+    u8 *raw = (u8 *)HelperFcn_MemAllocate(raw_size ? raw_size : 1);
+    for (u32 y = 0; y < height; ++y)
+    {
+        const u8 *src_row = (const u8 *)pixels + (size_t)(height - 1 - y) * pitch;
+        const u32 *src = (const u32 *)src_row;
+        u8 *dst = raw + row_size * y;
+        *dst++ = 0;
+        for (u32 x = 0; x < width; ++x)
+        {
+            u32 color = src[x];
+            *dst++ = (u8)(color >> 16);
+            *dst++ = (u8)(color >> 8);
+            *dst++ = (u8)color;
+            *dst++ = (u8)(color >> 24);
+        }
+    }
+
+    /* Signature, header, compressed data and the end of the file. */
+    static const u8 signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    size_t capacity = sizeof(signature) + 3 * 12 + 13 + raw_size + raw_size / 8 + 64;
+    u8 *file = (u8 *)HelperFcn_MemAllocate(capacity);
+    u8 *zlib = (u8 *)HelperFcn_MemAllocate(raw_size + raw_size / 8 + 64);
+    size_t zlib_size = Compress(zlib, raw, raw_size);
+
+    u8 header[13];
+    StoreBigEndian(header, width);
+    StoreBigEndian(header + 4, height);
+    header[8] = 8;  /* Bits per channel. */
+    header[9] = 6;  /* Color type: RGBA. */
+    header[10] = 0;  /* Compression: deflate. */
+    header[11] = 0;  /* Filtering: adaptive. */
+    header[12] = 0;  /* Interlace: none. */
+
+    u32 crc_table[256];
+    InitCrcTable(crc_table);
+    size_t size = 0;
+    memcpy(file, signature, sizeof(signature));
+    size += sizeof(signature);
+    size += WriteChunk(file + size, "IHDR", header, sizeof(header), crc_table);
+    size += WriteChunk(file + size, "IDAT", zlib, (u32)zlib_size, crc_table);
+    size += WriteChunk(file + size, "IEND", NULL, 0, crc_table);
+
+    MemObject_InitBySize(mem_object, size);
+    memcpy(mem_object->data, file, size);
+    HelperFcn_MemFree(zlib);
+    HelperFcn_MemFree(file);
+    HelperFcn_MemFree(raw);
+}
+
+static void
+PutBits(BitWriter *writer, u32 value, u32 count)
+{
+    writer->bits |= (u64)value << writer->bits_num;
+    writer->bits_num += count;
+    while (writer->bits_num >= 8)
+    {
+        *writer->data++ = (u8)writer->bits;
+        writer->bits >>= 8;
+        writer->bits_num -= 8;
+    }
+}
+
+static void
+PutCode(BitWriter *writer, u32 code, u32 length)
+{
+    u32 reversed = 0;
+    for (u32 i = 0; i < length; ++i)
+    {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    PutBits(writer, reversed, length);
+}
+
+static void
+PutSymbol(BitWriter *writer, u32 symbol)
+{
+    if (symbol < 144)
+        PutCode(writer, 0x30 + symbol, 8);
+    else if (symbol < 256)
+        PutCode(writer, 0x190 + (symbol - 144), 9);
+    else if (symbol < 280)
+        PutCode(writer, symbol - 256, 7);
+    else
+        PutCode(writer, 0xc0 + (symbol - 280), 8);
+}
+
+static void
+PutMatch(BitWriter *writer, u32 length, u32 distance)
+{
+    static const u16 length_base[29] =
+    {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83,
+        99, 115, 131, 163, 195, 227, 258
+    };
+    static const u8 length_extra[29] =
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    static const u16 distance_base[30] =
+    {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+        1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+    };
+    static const u8 distance_extra[30] =
+    {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+        12, 12, 13, 13
+    };
+
+    u32 code = 28;
+    while (length_base[code] > length) --code;
+    PutSymbol(writer, 257 + code);
+    PutBits(writer, length - length_base[code], length_extra[code]);
+
+    code = 29;
+    while (distance_base[code] > distance) --code;
+    PutCode(writer, code, 5);
+    PutBits(writer, distance - distance_base[code], distance_extra[code]);
+}
+
+static size_t
+Compress(u8 *dst, const u8 *src, size_t size)
+{
+    /* Header of the zlib stream: deflate with the 32K window, fastest compression. */
+    dst[0] = 0x78;
+    dst[1] = 0x01;
+
+    BitWriter writer;
+    writer.data = dst + 2;
+    writer.bits = 0;
+    writer.bits_num = 0;
+    PutBits(&writer, 1, 1);  /* Final block. */
+    PutBits(&writer, 1, 2);  /* Fixed Huffman codes. */
+
+    /* The latest position of every hash of three bytes is the match candidate. */
+    const u32 hash_size = 1u << PNG_HASH_BITS;
+    s64 *positions = (s64 *)HelperFcn_MemAllocate(hash_size * sizeof(s64));
+    for (u32 i = 0; i < hash_size; ++i) positions[i] = -1;
+
+    size_t i = 0;
+    while (i < size)
+    {
+        u32 length = 0;
+        size_t distance = 0;
+        if (i + PNG_MATCH_MIN <= size)
+        {
+            u32 hash = ((u32)src[i] | ((u32)src[i + 1] << 8) | ((u32)src[i + 2] << 16)) *
+                2654435761u >> (32 - PNG_HASH_BITS);
+            s64 candidate = positions[hash];
+            positions[hash] = (s64)i;
+            if ((candidate >= 0) && (i - (size_t)candidate <= PNG_WINDOW_SIZE))
+            {
+                size_t max_length = size - i;
+                if (max_length > PNG_MATCH_MAX) max_length = PNG_MATCH_MAX;
+                const u8 *match = src + candidate;
+                while ((length < max_length) && (match[length] == src[i + length])) ++length;
+                distance = i - (size_t)candidate;
+            }
+        }
+
+        if (length >= PNG_MATCH_MIN)
+        {
+            PutMatch(&writer, length, (u32)distance);
+
+            /* Positions inside of the match are remembered for the following matches. */
+            for (size_t j = i + 1; (j < i + length) && (j + PNG_MATCH_MIN <= size); ++j)
+            {
+                u32 hash = ((u32)src[j] | ((u32)src[j + 1] << 8) |
+                    ((u32)src[j + 2] << 16)) * 2654435761u >> (32 - PNG_HASH_BITS);
+                positions[hash] = (s64)j;
+            }
+            i += length;
+        }
+        else
+        {
+            PutSymbol(&writer, src[i]);
+            ++i;
+        }
+    }
+    PutSymbol(&writer, 256);
+    if (writer.bits_num > 0) PutBits(&writer, 0, 8 - writer.bits_num);
+    HelperFcn_MemFree(positions);
+
+    /* Adler-32 checksum of the uncompressed data. */
+    u32 a = 1;
+    u32 b = 0;
+    for (size_t j = 0; j < size;)
+    {
+        size_t block_end = (size - j > 5552) ? (j + 5552) : size;
+        for (; j < block_end; ++j)
+        {
+            a += src[j];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    StoreBigEndian(writer.data, (b << 16) | a);
+    return (size_t)(writer.data + 4 - dst);
+}
+
+static size_t
+WriteChunk(u8 *dst, const char *type, const u8 *data, u32 size, const u32 *crc_table)
+{
+    StoreBigEndian(dst, size);
+    memcpy(dst + 4, type, 4);
+    if (size > 0) memcpy(dst + 8, data, size);
+
+    /* The checksum covers the type and the data. */
+    u32 crc = 0xffffffffu;
+    for (size_t i = 4; i < (size_t)size + 8; ++i)
+    {
+        crc = crc_table[(crc ^ dst[i]) & 0xff] ^ (crc >> 8);
+    }
+    StoreBigEndian(dst + 8 + size, ~crc);
+    return (size_t)size + 12;
+}
+
+static void
+InitCrcTable(u32 *crc_table)
+{
+    for (u32 n = 0; n < 256; ++n)
+    {
+        u32 c = n;
+        for (u32 k = 0; k < 8; ++k)
+        {
+            c = (c & 1) ? (0xedb88320u ^ (c >> 1)) : (c >> 1);
+        }
+        crc_table[n] = c;
+    }
+}
+
+static void
+StoreBigEndian(u8 *dst, u32 value)
+{
+    dst[0] = (u8)(value >> 24);
+    dst[1] = (u8)(value >> 16);
+    dst[2] = (u8)(value >> 8);
+    dst[3] = (u8)value;
+}
@@ -0,0 +1,271 @@
+/**
+ * ================================================================================
+ * @file src_engine/polygon_raster.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the rasterization of the filled polygons by the
+ * scanlines with the active edge table.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/polygon_raster.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+/**
+ * @brief Structure for a single not horizontal edge of the polygon.
+ */
+struct PolygonEdge_
+{
+    f64 x0;  /**< X coordinate of the lower end of the edge. */
+    f64 y0;  /**< Y coordinate of the lower end of the edge. */
+    f64 slope;  /**< Change of the X coordinate per row. */
+    f64 x;  /**< X coordinate of the crossing with the center of the current row. */
+    s32 row_begin;  /**< First row crossed by the edge (clipped). */
+    s32 row_end;  /**< Row after the last row crossed by the edge (clipped). */
+    s32 winding;  /**< Direction of the edge: +1 - upwards, -1 - downwards. */
+};
+typedef struct PolygonEdge_ PolygonEdge;
+
+/**
+ * @brief Building the edge table: the edges crossing the centers of the rows of the
+ * clip rectangle.
+ * @param vertices Array of the vertices of the contours.
+ * @param vertices_num Amount of the vertices.
+ * @param contour_size Amount of the vertices of every contour.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param edges Array for the edges (at least vertices_num elements).
+ * @return u32 Amount of the edges (0 - nothing to draw).
+ */
+static u32
+BuildEdges(const Vec2 *vertices, u32 vertices_num, u32 contour_size,
+    const RenderRect *clip, PolygonEdge *edges);
+
+/**
+ * @brief Comparison of the edges by their first rows (for qsort).
+ * @param a Pointer to the first edge.
+ * @param b Pointer to the second edge.
+ * @return int Result of the comparison.
+ */
+static int
+CompareEdges(const void *a, const void *b);
+
+/**
+ * @brief Traversal of the rows crossed by the edges and filling the inside spans.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param edges Array of the edges sorted by their first rows.
+ * @param edges_num Amount of the edges.
+ * @param active Array for the active edges (at least edges_num elements).
+ * @param rule Fill rule of the polygon.
+ * @param color 32 bit color (ARGB, premultiplied if blended).
+ * @param blend Blend mode.
+ */
+static void
+FillEdges(void *memory, u32 pitch, const RenderRect *clip, PolygonEdge *edges,
+    u32 edges_num, PolygonEdge **active, PolygonFillRule rule, u32 color,
+    BlendMode blend);
+
+/**
+ * @brief Filling the span of the pixels [x_begin, x_end) of the row.
+ * @param row Pointer to the pixel (0, y) of the row.
+ * @param x_begin First pixel of the span (included).
+ * @param x_end Last pixel of the span (excluded).
+ * @param color 32 bit color (ARGB, premultiplied if blended).
+ * @param blend Blend mode.
+ */
+static void
+FillSpan(u32 *row, s32 x_begin, s32 x_end, u32 color, BlendMode blend);
+
+void
+PolygonRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, const Vec2 *vertices,
+    u32 vertices_num, PolygonFillRule rule, u32 color, BlendMode blend)
+{
+    PolygonRaster_FillContours(memory, pitch, clip, vertices, 1, vertices_num, rule, color,
+        blend);
+}
+
+void
+PolygonRaster_FillContours(void *memory, u32 pitch, const RenderRect *clip,
+    const Vec2 *vertices, u32 contours_num, u32 contour_size, PolygonFillRule rule,
+    u32 color, BlendMode blend)
+{
+    if ((contours_num == 0) || (contour_size < 3) || (contours_num > 0xffffffffu /
+        contour_size) || (rule >= PFR_RULES_NUM) || (clip->x0 >= clip->x1) ||
+        (clip->y0 >= clip->y1))
+    {
+        return;
+    }
+    u32 vertices_num = contours_num * contour_size;
+
+    /* Usual polygons are small enough for the tables on the stack. */
+    PolygonEdge stack_edges[POLYGON_RASTER_STACK_EDGES];
+    PolygonEdge *stack_active[POLYGON_RASTER_STACK_EDGES];
+    PolygonEdge *edges = stack_edges;
+    PolygonEdge **active = stack_active;
+    if (vertices_num > POLYGON_RASTER_STACK_EDGES)
+    {
+        edges = (PolygonEdge *)HelperFcn_MemAllocate(vertices_num * sizeof(PolygonEdge));
+        active = (PolygonEdge **)HelperFcn_MemAllocate(vertices_num * sizeof(PolygonEdge *));
+    }
+
+    u32 edges_num = BuildEdges(vertices, vertices_num, contour_size, clip, edges);
+    if (edges_num > 0)
+    {
+        qsort(edges, edges_num, sizeof(PolygonEdge), CompareEdges);
+        if (blend != BM_NONE) color = Blend_Premultiply(color);
+        FillEdges(memory, pitch, clip, edges, edges_num, active, rule, color, blend);
+    }
+
+    if (edges != stack_edges)
+    {
+        HelperFcn_MemFree(edges);
+        HelperFcn_MemFree(active);
+    }
+}
+
+static u32
+BuildEdges(const Vec2 *vertices, u32 vertices_num, u32 contour_size,
+    const RenderRect *clip, PolygonEdge *edges)
+{
+    /* Vertices with infinite or undefined coordinates make the inside undefined. */
+    for (u32 i = 0; i < vertices_num; ++i)
+    {
+        if (!isfinite(vertices[i].x) || !isfinite(vertices[i].y)) return 0;
+    }
+
+    /* The last vertex of a contour is connected with its first one. */
+    u32 edges_num = 0;
+    for (u32 i = 0, first = 0; i < vertices_num; ++i)
+    {
+        if (i - first == contour_size) first = i;
+        const Vec2 *a = &vertices[i];
+        const Vec2 *b = &vertices[(i + 1 - first < contour_size) ? i + 1 : first];
+        if (a->y == b->y) continue;
+
+        /* Edges are described from the lower end, so an edge shared by two polygons
+        gives the same crossings for both of them. */
+        s32 winding = (b->y > a->y) ? 1 : -1;
+        const Vec2 *lower = (winding > 0) ? a : b;
+        const Vec2 *upper = (winding > 0) ? b : a;
+
+        /* Rows with the centers in [lower, upper), clamped before the conversion. */
+        f64 row_begin = fmax(ceil((f64)lower->y - 0.5), (f64)clip->y0);
+        f64 row_end = fmin(ceil((f64)upper->y - 0.5), (f64)clip->y1);
+        if (row_begin >= row_end) continue;
+
+        PolygonEdge *edge = &edges[edges_num++];
+        edge->x0 = lower->x;
+        edge->y0 = lower->y;
+        edge->slope = ((f64)upper->x - lower->x) / ((f64)upper->y - lower->y);
+        edge->x = 0.0;
+        edge->row_begin = (s32)row_begin;
+        edge->row_end = (s32)row_end;
+        edge->winding = winding;
+    }
+    return edges_num;
+}
+
+static int
+CompareEdges(const void *a, const void *b)
+{
+    s32 row_a = ((const PolygonEdge *)a)->row_begin;
+    s32 row_b = ((const PolygonEdge *)b)->row_begin;
+    return (row_a > row_b) - (row_a < row_b);
+}
+
+static void
+FillEdges(void *memory, u32 pitch, const RenderRect *clip, PolygonEdge *edges,
+    u32 edges_num, PolygonEdge **active, PolygonFillRule rule, u32 color,
+    BlendMode blend)
+{
+    u32 next = 0;  /* First edge of the table not yet active. */
+    u32 active_num = 0;
+    s32 y = edges[0].row_begin;
+    while ((next < edges_num) || (active_num > 0))
+    {
+        /* Rows without the edges are skipped. */
+        if ((active_num == 0) && (edges[next].row_begin > y)) y = edges[next].row_begin;
+        while ((next < edges_num) && (edges[next].row_begin <= y))
+            active[active_num++] = &edges[next++];
+
+        /* Crossings are found from the ends of the edges (no error is accumulated), the
+        order of the edges changes little from row to row, so the insertion sort is used. */
+        f64 row_center = (f64)y + 0.5;
+        for (u32 i = 0; i < active_num; ++i)
+        {
+            PolygonEdge *edge = active[i];
+            edge->x = edge->x0 + (row_center - edge->y0) * edge->slope;
+            u32 j = i;
+            while ((j > 0) && (active[j - 1]->x > edge->x))
+            {
+                active[j] = active[j - 1];
+                j--;
+            }
+            active[j] = edge;
+        }
+
+        /* Pixels with the centers in [x_left, x_right) of an inside run are covered, the
+        runs touching each other are merged into a single span. */
+        u32 *row = (u32 *)((u8 *)memory + (size_t)pitch * (u32)y);
+        s32 span_begin = 0;
+        s32 span_end = 0;
+        s32 winding = 0;
+        f64 x_left = 0.0;
+        for (u32 i = 0; i < active_num; ++i)
+        {
+            b32 was_inside = (rule == PFR_EVEN_ODD) ? (winding & 1) : (winding != 0);
+            winding += active[i]->winding;
+            b32 is_inside = (rule == PFR_EVEN_ODD) ? (winding & 1) : (winding != 0);
+            if (is_inside == was_inside) continue;
+            if (is_inside)
+            {
+                x_left = active[i]->x;
+                continue;
+            }
+
+            f64 x_begin = fmax(ceil(x_left - 0.5), (f64)clip->x0);
+            f64 x_end = fmin(ceil(active[i]->x - 0.5), (f64)clip->x1);
+            if (x_begin >= x_end) continue;
+            if ((s32)x_begin > span_end)
+            {
+                FillSpan(row, span_begin, span_end, color, blend);
+                span_begin = (s32)x_begin;
+            }
+            span_end = (s32)x_end;
+        }
+        FillSpan(row, span_begin, span_end, color, blend);
+
+        /* Edges ending at this row leave the table. */
+        y++;
+        u32 kept = 0;
+        for (u32 i = 0; i < active_num; ++i)
+        {
+            if (active[i]->row_end > y) active[kept++] = active[i];
+        }
+        active_num = kept;
+    }
+}
+
+static void
+FillSpan(u32 *row, s32 x_begin, s32 x_end, u32 color, BlendMode blend)
+{
+    if (x_begin >= x_end) return;
+
+    u32 *dst = row + x_begin;
+    u32 count = (u32)(x_end - x_begin);
+    if (blend == BM_NONE)
+        SpanFill_Row(dst, count, color);
+    else
+        Blend_RowColor(dst, count, color, blend);
+}
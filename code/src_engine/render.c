@@ -4,8 +4,8 @@
  * @author Dmitry Safonov (juvusoft@gmail.com)
  * @brief Definition of functions necessary for the work with the software 
  * rendering. 
- * @version 0.3
- * @date 2022-12-15
+ * @version 0.4
+ * @date 2026-10-16
  * ================================================================================ 
  */
 
@@ -16,61 +16,470 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
+#include "include_engine/batch_raster.h"
+#include "include_engine/blend.h"
 #include "include_engine/color.h"
 #include "include_engine/dbg.h"
+#include "include_engine/dirty_rects.h"
+#include "include_engine/ellipse_raster.h"
+#include "include_engine/font.h"
+#include "include_engine/frame_capture.h"
+#include "include_engine/glyph_cache.h"
 #include "include_engine/helper_functions.h"
 #include "include_engine/image.h"
+#include "include_engine/line_raster.h"
 #include "include_engine/math_functions.h"
+#include "include_engine/polygon_raster.h"
+#include "include_engine/render_cmd.h"
+#include "include_engine/render_cmd_buffer.h"
+#include "include_engine/render_layers.h"
+#include "include_engine/render_occlusion.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/render_target.h"
+#include "include_engine/render_tiler.h"
+#include "include_engine/scale_raster.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/sprite.h"
+#include "include_engine/swap_chain.h"
+#include "include_engine/texture.h"
+#include "include_engine/texture_raster.h"
+#include "include_engine/triangle_raster.h"
+#include "include_engine/upscaler.h"
 #include "include_engine/utils.h"
 #include "include_engine/vector2.h"
 
-#include "include_game/game.h"
+#define RENDER_POLYLINE_STACK_CONTOURS 32  /* Contours of a polyline kept on the stack. */
+
+/**
+ * @brief Getting the address of a pixel in the render buffer.
+ * @param buffer Pointer to the render buffer structure.
+ * @param x X coordinate of the pixel.
+ * @param y Y coordinate of the pixel.
+ * @return u32* Pointer to the pixel.
+ */
+static u32*
+GetPixelAddress(RenderBuffer *buffer, u32 x, u32 y);
+
+/**
+ * @brief Getting the distance between two rows of the render buffer.
+ * @param buffer Pointer to the render buffer structure.
+ * @return u32 Pitch of the buffer in bytes.
+ */
+static u32
+GetPitch(RenderBuffer *buffer);
+
+/**
+ * @brief Allocating the bitmap memory of the render buffer (the previous memory is
+ * freed). Drawing is allowed in the entire buffer.
+ * @param render Pointer to the render structure.
+ * @param width Width of the buffer.
+ * @param height Height of the buffer.
+ */
+static void
+AllocateBuffer(Render *render, u32 width, u32 height);
+
+/**
+ * @brief Redirecting the drawing to the frame memory (with the layers enabled), so the
+ * frame could be composited, presented or reallocated.
+ * @param render Pointer to the render structure.
+ */
+static void
+BeginFrameTarget(Render *render);
+
+/**
+ * @brief Redirecting the drawing back to the current layer (with the layers enabled).
+ * The frame memory could be changed while it was the target (swap chain).
+ * @param render Pointer to the render structure.
+ */
+static void
+EndFrameTarget(Render *render);
+
+/**
+ * @brief Selecting the layer the following commands are executed into. Drawing of the
+ * previous layer is flushed first.
+ * @param render Pointer to the render structure.
+ * @param layer Identifier of the layer.
+ */
+static void
+SelectLayer(Render *render, RenderLayerId layer);
+
+/**
+ * @brief Recording or applying a change of the layers state (RCT_LAYER command).
+ * @param render Pointer to the render structure.
+ * @param layer Identifier of the layer.
+ * @param action Action with the layer.
+ * @param is_visible Flag of the visible layer (RLA_SET_VISIBLE).
+ */
+static void
+EmitLayerCmd(Render *render, RenderLayerId layer, RenderLayerAction action,
+    b32 is_visible);
+
+/**
+ * @brief Applying the RCT_LAYER command to the layers.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the render command.
+ */
+static void
+ExecuteLayerCmd(Render *render, const RenderCmd *cmd);
+
+/**
+ * @brief Recording or applying an action with the statistics (RCT_STATS command).
+ * @param render Pointer to the render structure.
+ * @param action Action with the statistics.
+ * @param is_heatmap Flag of the counting of the heatmap (RSA_ENABLE).
+ */
+static void
+EmitStatsCmd(Render *render, RenderStatsAction action, b32 is_heatmap);
+
+/**
+ * @brief Applying the RCT_STATS command to the statistics.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the render command.
+ */
+static void
+ExecuteStatsCmd(Render *render, const RenderCmd *cmd);
+
+/**
+ * @brief Checking whether the command changes the state of the render (layers or
+ * statistics). Such commands have no bounds, they are applied in the order of the
+ * drawing and are not counted by the statistics.
+ * @param cmd Pointer to the render command.
+ * @return b32 True for the state changing command.
+ */
+static b32
+IsStateCmd(const RenderCmd *cmd);
+
+/**
+ * @brief Presenting the buffer in the window.
+ * @param render Pointer to the render structure.
+ * @param memory Pointer to the bitmap memory of the buffer.
+ * @param dirty_rects Regions changed since the last present (NULL - whole buffer).
+ */
+static void
+PresentBuffer(Render *render, void *memory, DirtyRects *dirty_rects);
+
+/**
+ * @brief Handing the drawn frame over to the present thread and switching the drawing
+ * to the next buffer of the swap chain (brought up to the handed over frame).
+ * @param render Pointer to the render structure.
+ */
+static void
+HandOverFrame(Render *render);
+
+/**
+ * @brief Appending the command to the recorded command buffer or drawing it. The
+ * current blend mode of the render is assigned to the command.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the render command.
+ */
+static void
+EmitCmd(Render *render, RenderCmd *cmd);
+
+/**
+ * @brief Preparing the command for the drawing: the layout of the string is looked up,
+ * the instances of the batch are binned by the current clip rectangle.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the submitted command.
+ * @param prepared_cmd Pointer to the place for the prepared command.
+ * @return const RenderCmd* Command to be drawn (the submitted one if nothing changed).
+ */
+static const RenderCmd*
+PrepareCmd(Render *render, const RenderCmd *cmd, RenderCmd *prepared_cmd);
+
+/**
+ * @brief Drawing the prepared command immediately or by the tiler.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the prepared command.
+ * @param bounds Pointer to the bounds of the command (the tiler clips by them).
+ */
+static void
+DispatchCmd(Render *render, const RenderCmd *cmd, const RenderRect *bounds);
+
+/**
+ * @brief Submitting a command of the front to back drawing. Only the parts of the bounds
+ * not covered yet are drawn: the opaque commands are drawn immediately, others are
+ * deferred till the end of the occlusion. The opaque pixels of the command are covered.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the submitted command (it is copied if deferred).
+ * @param drawn_cmd Pointer to the prepared command.
+ * @param bounds Pointer to the bounds of the command.
+ */
+static void
+SubmitOccludedCmd(Render *render, const RenderCmd *cmd, const RenderCmd *drawn_cmd,
+    const RenderRect *bounds);
+
+/**
+ * @brief Covering the pixels of the command which replace the destination (filled
+ * rectangles and fully opaque spans of the images).
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the render command.
+ * @param bounds Pointer to the bounds of the command.
+ * @return b32 True if all the written pixels replace the destination, so the command
+ * could be drawn before the content behind it.
+ */
+static b32
+CoverOpaqueCmd(Render *render, const RenderCmd *cmd, const RenderRect *bounds);
+
+/**
+ * @brief Getting the corners of the quad of a thick line (in the order around it).
+ * @param v0 Beginning point of the line.
+ * @param v1 Ending point of the line.
+ * @param width Width of the line.
+ * @param quad Array of the 4 corners (v0 + n, v1 + n, v1 - n, v0 - n, n is the half
+ * width normal).
+ * @return b32 False if the line has no length or no width.
+ */
+static b32
+GetThickLineQuad(Vec2 v0, Vec2 v1, f32 width, Vec2 *quad);
+
+/**
+ * @brief Putting a contour of 4 vertices of the thick polyline turned clockwise, so the
+ * windings of the contours never cancel each other.
+ * @param contour Array for the 4 vertices of the contour.
+ * @param vertices Array of the 4 vertices in the order around the contour.
+ * @return b32 False if the vertices are infinite or undefined (nothing is put).
+ */
+static b32
+PutPolylineContour(Vec2 *contour, const Vec2 *vertices);
+
+/**
+ * @brief Getting the polygon of the RCT_TEXTURE command. The fourth corner of the
+ * parallelogram is placed between the neighbours of the first one.
+ * @param cmd Pointer to the RCT_TEXTURE render command.
+ * @param vertices Array of the 4 vertices of the polygon.
+ * @param uvs Array of the 4 texture coordinates of the vertices.
+ * @return u32 Amount of the vertices (3 or 4).
+ */
+static u32
+GetTexturePolygon(const RenderCmd *cmd, Vec2 *vertices, Vec2 *uvs);
+
+/**
+ * @brief Determination of the screen rectangle containing all the pixels which could be
+ * written by the command, clipped by the clip rectangle of the render.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the render command.
+ * @param bounds Determined bounds of the command.
+ * @return b32 False if the command writes no pixels inside the clip rectangle.
+ */
+static b32
+GetCmdBounds(Render *render, const RenderCmd *cmd, RenderRect *bounds);
+
+/**
+ * @brief Binning of the instances of the RCT_RECTS, RCT_POINTS or RCT_CIRCLES command
+ * into the bands of rows. The binned instances are kept in the batch memory of the render
+ * until the next binning.
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the not binned command.
+ * @param binned_cmd Pointer to the command with the binned instances.
+ */
+static void
+BinBatchCmd(Render *render, const RenderCmd *cmd, RenderCmd *binned_cmd);
+
+/**
+ * @brief Getting the batch memory of at least the specified size (its content is kept).
+ * @param render Pointer to the render structure.
+ * @param size Required size in bytes.
+ * @return u8* Pointer to the batch memory.
+ */
+static u8*
+GetBatchMemory(Render *render, size_t size);
+
+#ifdef RENDER_STATS
+/**
+ * @brief Counting the submitted command: the call, the culling and the pixels of its
+ * bounds outside of the clip rectangle (the pixels of the instances for the batches).
+ * @param render Pointer to the render structure.
+ * @param cmd Pointer to the command as it was submitted.
+ * @param drawn_cmd Pointer to the command being drawn (binned or the same).
+ * @param bounds Pointer to the clipped bounds of the command (NULL - culled).
+ */
+static void
+CountSubmittedCmd(Render *render, const RenderCmd *cmd, const RenderCmd *drawn_cmd,
+    const RenderRect *bounds);
+
+/**
+ * @brief Executing the command with the measurement of its time, the pixels written by
+ * the kernels are counted along the way.
+ * @param render Pointer to the render structure (or to the tiler worker).
+ * @param cmd Pointer to the render command.
+ */
+static void
+ExecuteCmdWithStats(Render *render, const RenderCmd *cmd);
+#endif
+
+/**
+ * @brief Intersection of a rectangle with the clip rectangle of the render.
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the BL corner (included).
+ * @param y0 Y coordinate of the BL corner (included).
+ * @param x1 X coordinate of the UR corner (excluded).
+ * @param y1 Y coordinate of the UR corner (excluded).
+ * @param rect Result of the intersection.
+ * @return b32 False if the intersection is empty.
+ */
+static b32
+ClipRect(Render *render, s64 x0, s64 y0, s64 x1, s64 y1, RenderRect *rect);
+
+/**
+ * @brief Intersection of a rectangle with the floating point coordinates with the clip
+ * rectangle of the render. The corners are rounded outwards.
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the BL corner.
+ * @param y0 Y coordinate of the BL corner.
+ * @param x1 X coordinate of the UR corner.
+ * @param y1 Y coordinate of the UR corner.
+ * @param rect Result of the intersection.
+ * @return b32 False if the intersection is empty.
+ */
+static b32
+ClipRectF(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, RenderRect *rect);
+
+/**
+ * @brief Clipping a line segment by the guard band (Liang-Barsky algorithm), so its
+ * coordinates could be safely converted to integers.
+ * @param v0 Beginning point of the segment (updated).
+ * @param v1 Ending point of the segment (updated).
+ * @return b32 False if the segment lies outside of the guard band.
+ */
+static b32
+ClipLineByGuardBand(Vec2 *v0, Vec2 *v1);
+
+/**
+ * @brief Restriction of the range of steps of the Brezenham line to the steps with one
+ * coordinate inside the [lo, hi] range (integer form of the Liang-Barsky algorithm).
+ * Coordinate after the n-th step is start + inc * floor((n * delta - 1) / d).
+ * @param start Coordinate of the beginning point.
+ * @param inc Increment of the coordinate (-1, 0 or 1).
+ * @param delta Absolute value of the coordinate projection of the line.
+ * @param d Length of the line projection (amount of the steps minus one).
+ * @param lo Minimal allowed coordinate.
+ * @param hi Maximal allowed coordinate.
+ * @param step_begin First step of the range (updated).
+ * @param step_end Last step of the range (updated).
+ * @return b32 False if the range is empty.
+ */
+static b32
+ClipLineSteps(s64 start, s32 inc, s32 delta, s32 d, s64 lo, s64 hi, s64 *step_begin,
+    s64 *step_end);
+
+/**
+ * @brief Setting color of a single pixel if it lies inside the clip rectangle.
+ * @param render Pointer to the render structure.
+ * @param x X coordinate of the pixel.
+ * @param y Y coordinate of the pixel.
+ * @param color 32 bit color (ARGB).
+ */
+static void
+PlotPixel(Render *render, s32 x, s32 y, u32 color);
+
+/**
+ * @brief Filling the part of the rectangle [x0, x1) x [y0, y1) inside the clip rectangle.
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the BL corner (included).
+ * @param y0 Y coordinate of the BL corner (included).
+ * @param x1 X coordinate of the UR corner (excluded).
+ * @param y1 Y coordinate of the UR corner (excluded).
+ * @param color 32 bit color (ARGB).
+ * @param blend Blend mode.
+ */
+static void
+FillRect(Render *render, s64 x0, s64 y0, s64 x1, s64 y1, u32 color, BlendMode blend);
 
 /**
  * @brief Drawing a pixelized line from one point to another by using 
- * Brezenham algorithm. This version also record the X coordinates for 
- * further rasterization of filling of the triangle.
+ * Brezenham algorithm.
  * @param render Pointer to the render_buffer structure.
  * @param v0 Vector for the beginning point.
  * @param v1 Vector for the ending point.
- * @param color Pointer to the color structure (line color).
- * @param SX_array Left/Right Side X array.
- * @param SX_i Left/Right Side X array index.
+ * @param color 32 bit color (ARGB) of the line.
  */
 static void 
-DrawLineExtended(Render *render, Vec2 v0, Vec2 v1, const Color *color, u32 *SX_array, 
-    u32 *SX_i);
+DrawLine(Render *render, Vec2 v0, Vec2 v1, u32 color);
 
 /**
- * @brief Drawing a filled bottom/top flat triangle.
+ * @brief Drawing the polyline of the RCT_POLYLINE command. Thick polylines are filled
+ * as a single shape and anti-aliased ones are blended once per pixel, so the joints are
+ * not blended twice.
  * @param render Pointer to the render structure.
- * @param v1 Top/Bottom most vertix of the triangle.
- * @param v2 Left most vertix of the triangle.
- * @param v3 Right most vertix of the triangle.
- * @param side_flag Flag inicating flat side.
- * @param color Pointer to the color structure (triangle color).
+ * @param cmd Pointer to the RCT_POLYLINE render command.
  */
-static void 
-DrawFillSideFlatTriangle(Render *render, Vec2 v1, Vec2 v2, Vec2 v3, FlatSideFlag side_flag,
-    const Color *color);
+static void
+DrawPolyline(Render *render, const RenderCmd *cmd);
+
+/**
+ * @brief Drawing a circle using Brezenhame algorithm. The filled circle is drawn by a
+ * single span per row, covering the pixels of the outline and everything inside.
+ * @param render Pointer to the render structure.
+ * @param x0 X coordinate of the circle center.
+ * @param y0 Y coordinate of the circle center.
+ * @param radius Radius of the circle.
+ * @param is_filled Flag indicating the fill of the circle.
+ * @param color 32 bit color (ARGB) of the circle.
+ * @param blend Blend mode (filled circle only).
+ */
+static void
+DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled, u32 color,
+    BlendMode blend);
 
 /**
  * @brief Drawing an image in the extended mode. Method could be used for direct copy of the 
  * loaded bitmap into the render buffer as well as for copy of the image while changing all 
- * untransparent pixels with the specified color (is_mask flag should be true).
- * @param x X coordinate of the bottom-left corner of the image (BL).
- * @param y Y coordinate of the bottom-left corner of the image (BL).
- * @param image Pointer to the image (mask) to be drawn.
+ * untransparent pixels with the specified color (is_mask flag should be true). The image
+ * is drawn by the spans of its compiled sprite, translucent pixels are blended.
+ * @param x X coordinate of the bottom-left corner of the image region (BL).
+ * @param y Y coordinate of the bottom-left corner of the image region (BL).
+ * @param region Pointer to the region of the image (mask) to be drawn.
  * @param scale Scale of the image.
  * @param is_mask Flag indicating the mask.
  * @param mask_color A 32 bit color (ARGB) to be used along with the mask.
+ * @param blend Blend mode.
+ * @param render Pointer to the render structure.
+ */
+static void
+DrawBitmapExtended(Render *render, u32 x, u32 y, const ImageRegion *region, u32 scale,
+    b32 is_mask, u32 mask_color, BlendMode blend);
+
+/**
+ * @brief Drawing a span of the sprite pixels (not scaled).
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first sprite pixel (premultiplied alpha).
+ * @param count Amount of pixels in the span.
+ * @param is_opaque Flag of the fully opaque sprite pixels.
+ * @param is_mask Flag indicating the mask.
+ * @param mask_color A 32 bit color (ARGB) to be used along with the mask.
+ * @param tint Mask color prepared for the blending (premultiplied alpha).
+ * @param blend Blend mode.
+ */
+static void
+DrawSpriteSpan(u32 *dst, const u32 *src, u32 count, b32 is_opaque, b32 is_mask,
+    u32 mask_color, u32 tint, BlendMode blend);
+
+/**
+ * @brief Drawing a string by the row spans of its cached layout.
  * @param render Pointer to the render structure.
+ * @param cmd Pointer to the RCT_TEXT render command.
  */
 static void
-DrawBitmapExtended(Render *render, u32 x, u32 y, const Image *image, u32 scale, b32 is_mask, 
-    const Color *mask_color);
+DrawString(Render *render, const RenderCmd *cmd);
+
+static u32*
+GetPixelAddress(RenderBuffer *buffer, u32 x, u32 y)
+{
+    u8 *row = (u8 *)buffer->bitmap_memory + (size_t)GetPitch(buffer) * y;
+    return (u32 *)row + x;
+}
+
+static u32
+GetPitch(RenderBuffer *buffer)
+{
+    return buffer->pitch;
+}
 
 Render*
 Render_Constructor(void)
@@ -78,166 +487,2346 @@ Render_Constructor(void)
     size_t size = sizeof(RenderBuffer);
     RenderBuffer *buffer = (RenderBuffer *)HelperFcn_MemAllocate(size);
     
-    size = sizeof(TriangleData);
-    TriangleData *triangle_data = (TriangleData *)HelperFcn_MemAllocate(size);
-    
     size = sizeof(Render);
     Render *render = (Render *)HelperFcn_MemAllocate(size);
     
     render->buffer = buffer;
-    render->triangle_data = triangle_data;
+    render->tiler = NULL;
+    render->cmd_buffer = NULL;
+    render->dirty_rects = DirtyRects_Constructor();
+    render->target_dirty_rects = DirtyRects_Constructor();
+    render->glyph_cache = GlyphCache_Constructor();
+    render->stats_exchange = RenderStatsExchange_Constructor();
+    RenderStatsExchange_Init(render->stats_exchange);
+
+    /* Select the span fill kernels supported by the CPU. */
+    SpanFill_Init();
     return render;
 }
 
-Render*
-Render_Destructor(Render *render)
+Render*
+Render_Destructor(Render *render)
+{
+    Render_SetTarget(render, NULL);
+    Render_StopCapture(render);
+    Render_DisableLayers(render);
+    Render_DisableSwapChain(render);
+    if (render->upscaler) render->upscaler = Upscaler_Destructor(render->upscaler);
+    if (render->tiler) render->tiler = RenderTiler_Destructor(render->tiler);
+    render->dirty_rects = DirtyRects_Destructor(render->dirty_rects);
+    render->target_dirty_rects = DirtyRects_Destructor(render->target_dirty_rects);
+    render->glyph_cache = GlyphCache_Destructor(render->glyph_cache);
+    if (render->batch_memory) HelperFcn_MemFree(render->batch_memory);
+    if (render->occlusion) render->occlusion = RenderOcclusion_Destructor(render->occlusion);
+    if (render->stats) render->stats = RenderStats_Destructor(render->stats);
+    render->stats_exchange = RenderStatsExchange_Destructor(render->stats_exchange);
+    HelperFcn_PageFree(render->buffer->bitmap_memory);
+#ifdef _WIN32
+    if (render->window) ReleaseDC(render->window, render->hdc);
+#endif
+    HelperFcn_MemFree(render->buffer);
+    HelperFcn_MemFree(render);
+    return NULL;
+}
+
+#ifdef _WIN32
+void
+Render_Init(Render *render, HWND window)
+{
+    /* Get and save header to the window and its drawing context. */
+    render->window = window;
+    render->hdc = GetDC(window);
+
+    /* Calculate width and height of the window (client area) for the buffer. */
+    RECT rect;
+    GetClientRect(window, &rect);
+    u32 rect_width = (u32)(rect.right - rect.left);
+    u32 rect_height = (u32)(rect.bottom - rect.top);
+    render->width = rect_width;
+    render->height = rect_height;
+
+    /* The buffer of the internal resolution does not depend on the window. */
+    if (render->upscaler)
+        AllocateBuffer(render, render->buffer->width, render->buffer->height);
+    else
+        AllocateBuffer(render, rect_width, rect_height);
+}
+#endif
+
+void
+Render_InitHeadless(Render *render, u32 width, u32 height)
+{
+    /* The frame is not shown anywhere, so the "window" is of the buffer size. */
+    render->width = width;
+    render->height = height;
+    AllocateBuffer(render, width, height);
+}
+
+void 
+Render_ResizeWindow(Render *render)
+{    
+#ifdef _WIN32
+    if (render->window == NULL) return;
+    RECT rect;
+    GetClientRect(render->window, &rect);
+    render->width = (u32)(rect.right - rect.left);
+    render->height = (u32)(rect.bottom - rect.top);
+    Render_InvalidateWindow(render);
+#else
+    (void)render;
+#endif
+}
+
+void
+Render_SetInternalResolution(Render *render, u32 width, u32 height, UpscaleFilter filter)
+{
+    /* The layers and the chain buffers are reallocated with the new size. */
+    b32 has_layers = (render->layers != NULL);
+    RenderLayerId layer = render->layer;
+    Render_DisableLayers(render);
+    u32 buffers_num = render->swap_chain ? render->swap_chain->buffers_num : 0;
+    if (render->swap_chain) Render_DisableSwapChain(render);
+    Render_Flush(render);
+
+    if ((width == 0) || (height == 0))
+    {
+        if (render->upscaler) render->upscaler = Upscaler_Destructor(render->upscaler);
+        width = render->width;
+        height = render->height;
+    }
+    else
+    {
+        if (render->upscaler == NULL)
+        {
+            render->upscaler = Upscaler_Constructor();
+            Upscaler_Init(render->upscaler, 0);
+        }
+        render->upscaler->filter = filter;
+    }
+
+    AllocateBuffer(render, width, height);
+    DirtyRects_Clear(render->dirty_rects);
+    if (buffers_num > 0) Render_EnableSwapChain(render, buffers_num);
+    if (has_layers)
+    {
+        Render_EnableLayers(render);
+        SelectLayer(render, layer);
+        render->cmd_layer = layer;
+    }
+}
+
+void
+Render_MapWindowPoint(Render *render, s32 x, s32 y, s32 *buffer_x, s32 *buffer_y)
+{
+    u32 width = render->width;
+    u32 height = render->height;
+    RenderBuffer *buffer = render->buffer;
+    if ((width == 0) || (height == 0))
+    {
+        *buffer_x = x;
+        *buffer_y = y;
+    }
+    else if (render->upscaler && (render->upscaler->dst_width == width) &&
+        (render->upscaler->dst_height == height))
+    {
+        /* The layout of the last presented output is used (it is not changed by the
+        present thread unless the window is resized). */
+        Upscaler_MapPoint(render->upscaler, x, y, buffer_x, buffer_y);
+    }
+    else
+    {
+        /* The buffer is stretched to the window (or not scaled at all). */
+        *buffer_x = (s32)(((s64)x * buffer->width) / width);
+        *buffer_y = (s32)(((s64)y * buffer->height) / height);
+    }
+}
+
+void 
+Render_UpdateWindow(Render *render)
+{
+    dbg_check(render->target == NULL, "%s", "Frame is changed while drawing into a target!");
+    dbg_check(!render->is_front_to_back, "%s", "Frame is presented inside of the occlusion!");
+    /* All the recorded drawing should be in the buffer before presenting. */
+    Render_Flush(render);
+
+    /* Changed regions of the layers are composited into the frame. */
+    BeginFrameTarget(render);
+    if (render->layers)
+    {
+        RenderLayers_Composite(render->layers, render->buffer->bitmap_memory,
+            render->dirty_rects);
+    }
+
+    /* The capture copies the frame, so the drawing thread does not wait for it. */
+    if (render->capture)
+    {
+        RenderBuffer *buffer = render->buffer;
+        FrameCapture_Submit(render->capture, (const u32 *)buffer->bitmap_memory,
+            buffer->width, buffer->height, GetPitch(buffer));
+    }
+
+    if (render->swap_chain)
+    {
+        HandOverFrame(render);
+    }
+    else
+    {
+        PresentBuffer(render, render->buffer->bitmap_memory, render->dirty_rects);
+        DirtyRects_Clear(render->dirty_rects);
+    }
+    EndFrameTarget(render);
+
+    /* The frame is over, the strings not drawn during it are forgotten. */
+    GlyphCache_NextFrame(render->glyph_cache);
+#ifdef RENDER_STATS
+    if (render->stats)
+    {
+        RenderStats_NextFrame(render->stats, render->buffer->width, render->buffer->height);
+        RenderStatsExchange_Publish(render->stats_exchange, &render->stats->last);
+    }
+#endif
+}
+
+void
+Render_EnableSwapChain(Render *render, u32 buffers_num)
+{
+    dbg_check(render->target == NULL, "%s", "Frame is changed while drawing into a target!");
+    if (render->swap_chain) Render_DisableSwapChain(render);
+    Render_Flush(render);
+    BeginFrameTarget(render);
+
+    render->swap_chain = SwapChain_Constructor();
+    SwapChain_Init(render->swap_chain, buffers_num);
+
+    /* The current buffer becomes the front one, all the buffers start equal. */
+    RenderBuffer *buffer = render->buffer;
+    size_t mem_size = sizeof(u32) * buffer->width * buffer->height;
+    for (u32 i = 0; i < buffers_num; ++i)
+    {
+        if (i == 0)
+        {
+            render->swap_memory[i] = buffer->bitmap_memory;
+        }
+        else
+        {
+            render->swap_memory[i] = HelperFcn_PageAllocate(mem_size);
+            memcpy(render->swap_memory[i], buffer->bitmap_memory, mem_size);
+        }
+        render->swap_drawn[i] = DirtyRects_Constructor();
+        render->swap_stale[i] = DirtyRects_Constructor();
+    }
+    render->presented_frame = 0;
+    buffer->bitmap_memory = render->swap_memory[render->swap_chain->back];
+    Render_InvalidateWindow(render);
+    EndFrameTarget(render);
+}
+
+void
+Render_DisableSwapChain(Render *render)
+{
+    if (render->swap_chain == NULL) return;
+    dbg_check(render->target == NULL, "%s", "Frame is changed while drawing into a target!");
+    Render_Flush(render);
+    BeginFrameTarget(render);
+
+    /* The back buffer is always brought up to the newest frame, so it is kept. */
+    SwapChain *swap_chain = render->swap_chain;
+    for (s32 i = 0; i < (s32)swap_chain->buffers_num; ++i)
+    {
+        if (i != swap_chain->back) HelperFcn_PageFree(render->swap_memory[i]);
+        render->swap_memory[i] = NULL;
+        render->swap_drawn[i] = DirtyRects_Destructor(render->swap_drawn[i]);
+        render->swap_stale[i] = DirtyRects_Destructor(render->swap_stale[i]);
+    }
+    render->swap_chain = SwapChain_Destructor(swap_chain);
+    Render_InvalidateWindow(render);
+    EndFrameTarget(render);
+}
+
+b32
+Render_PresentFrame(Render *render)
+{
+    SwapChain *swap_chain = render->swap_chain;
+    if (!SwapChain_AcquireFront(swap_chain))
+    {
+        /* Uncovered window is repainted from the same frame. */
+        if (Atomic_Load(&render->is_invalidated))
+            PresentBuffer(render, render->swap_memory[swap_chain->front], NULL);
+        return false;
+    }
+
+    /* Regions of the dropped frames are not known, so the whole buffer is presented. */
+    s32 front = swap_chain->front;
+    u32 frame = swap_chain->frames[front];
+    b32 is_consecutive = (frame == render->presented_frame + 1);
+    render->presented_frame = frame;
+    PresentBuffer(render, render->swap_memory[front],
+        is_consecutive ? render->swap_drawn[front] : NULL);
+    return true;
+}
+
+void
+Render_GetSwapChainStats(Render *render, SwapChainStats *stats)
+{
+    if (render->swap_chain)
+    {
+        SwapChain_GetStats(render->swap_chain, stats);
+    }
+    else
+    {
+        stats->frames_published = 0;
+        stats->frames_presented = 0;
+        stats->frames_dropped = 0;
+        stats->frames_repeated = 0;
+    }
+}
+
+void
+Render_StartCapture(Render *render, FrameCaptureFormat format, const char *path, u32 fps,
+    u32 frames_num)
+{
+    Render_StopCapture(render);
+    render->capture = FrameCapture_Constructor();
+    FrameCapture_Init(render->capture, format, path, render->buffer->width,
+        render->buffer->height, fps, frames_num);
+}
+
+void
+Render_StopCapture(Render *render)
+{
+    if (render->capture) render->capture = FrameCapture_Destructor(render->capture);
+}
+
+void
+Render_GetCaptureStats(Render *render, FrameCaptureStats *stats)
+{
+    if (render->capture)
+    {
+        FrameCapture_GetStats(render->capture, stats);
+    }
+    else
+    {
+        stats->frames_captured = 0;
+        stats->frames_encoded = 0;
+        stats->frames_dropped = 0;
+        stats->frames_failed = 0;
+        stats->frames_pending = 0;
+    }
+}
+
+void
+Render_EnableStats(Render *render, b32 is_heatmap)
+{
+#ifdef RENDER_STATS
+    EmitStatsCmd(render, RSA_ENABLE, is_heatmap);
+#else
+    (void)render;
+    (void)is_heatmap;
+#endif
+}
+
+void
+Render_DisableStats(Render *render)
+{
+    EmitStatsCmd(render, RSA_DISABLE, false);
+}
+
+void
+Render_GetStats(Render *render, RenderFrameStats *stats)
+{
+    RenderStatsExchange_Read(render->stats_exchange, stats);
+}
+
+void
+Render_DrawStatsHeatmap(Render *render)
+{
+    EmitStatsCmd(render, RSA_DRAW_HEATMAP, false);
+}
+
+void
+Render_InvalidateWindow(Render *render)
+{
+    Atomic_Store(&render->is_invalidated, true);
+}
+
+const RenderRect*
+Render_GetDirtyRects(Render *render, u32 *rects_num)
+{
+    *rects_num = render->dirty_rects->rects_num;
+    return render->dirty_rects->rects;
+}
+
+void
+Render_ClearDirtyRects(Render *render)
+{
+    DirtyRects_Clear(render->dirty_rects);
+}
+
+void
+Render_EnableTiling(Render *render, u32 tile_size, u32 threads_num)
+{
+    if (render->tiler) Render_DisableTiling(render);
+    render->tiler = RenderTiler_Constructor();
+    RenderTiler_Init(render->tiler, tile_size, threads_num);
+}
+
+void
+Render_DisableTiling(Render *render)
+{
+    if (render->tiler == NULL) return;
+    Render_Flush(render);
+    render->tiler = RenderTiler_Destructor(render->tiler);
+}
+
+void
+Render_Flush(Render *render)
+{
+    if (render->tiler == NULL) return;
+#ifdef RENDER_STATS
+    /* Every worker counts into its own slot. */
+    if (render->stats)
+        RenderStats_ReserveSlots(render->stats, render->tiler->workers_num + 1);
+#endif
+    RenderTiler_Flush(render->tiler, render);
+}
+
+void
+Render_EnableLayers(Render *render)
+{
+    if (render->layers) return;
+    dbg_check(render->target == NULL, "%s", "Frame is changed while drawing into a target!");
+    Render_Flush(render);
+
+    RenderBuffer *buffer = render->buffer;
+    render->layers = RenderLayers_Constructor();
+    RenderLayers_Init(render->layers, buffer->width, buffer->height);
+
+    /* The frame content is kept as the background (drawn in the whole buffer). */
+    RenderLayer *background = &render->layers->layers[RL_BACKGROUND];
+    memcpy(background->memory, buffer->bitmap_memory,
+        sizeof(u32) * buffer->width * buffer->height);
+    RenderRect rect = {0, 0, (s32)buffer->width, (s32)buffer->height};
+    background->bounds = rect;
+
+    render->frame_memory = buffer->bitmap_memory;
+    render->frame_dirty_rects = render->dirty_rects;
+    render->layer = RL_BACKGROUND;
+    render->cmd_layer = RL_BACKGROUND;
+    EndFrameTarget(render);
+}
+
+void
+Render_DisableLayers(Render *render)
+{
+    if (render->layers == NULL) return;
+    dbg_check(render->target == NULL, "%s", "Frame is changed while drawing into a target!");
+    Render_Flush(render);
+
+    BeginFrameTarget(render);
+    RenderLayers_Composite(render->layers, render->buffer->bitmap_memory,
+        render->dirty_rects);
+    render->layers = RenderLayers_Destructor(render->layers);
+    render->frame_memory = NULL;
+    render->frame_dirty_rects = NULL;
+    render->layer = RL_BACKGROUND;
+    render->cmd_layer = RL_BACKGROUND;
+}
+
+void
+Render_SetLayer(Render *render, RenderLayerId layer)
+{
+    dbg_check(layer < RL_LAYERS_NUM, "%s", "Unknown render layer!");
+    if (render->cmd_layer == layer) return;
+    render->cmd_layer = layer;
+    EmitLayerCmd(render, layer, RLA_SELECT, false);
+}
+
+RenderLayerId
+Render_GetLayer(Render *render)
+{
+    return render->cmd_layer;
+}
+
+void
+Render_SetLayerVisible(Render *render, RenderLayerId layer, b32 is_visible)
+{
+    dbg_check(layer < RL_LAYERS_NUM, "%s", "Unknown render layer!");
+    EmitLayerCmd(render, layer, RLA_SET_VISIBLE, is_visible);
+}
+
+void
+Render_ClearLayer(Render *render)
+{
+    EmitLayerCmd(render, render->cmd_layer, RLA_CLEAR, false);
+}
+
+void
+Render_SetTarget(Render *render, RenderTarget *target)
+{
+    if (render->target == target) return;
+    dbg_check(!render->is_front_to_back, "%s", "Target is changed before the occlusion end!");
+    Render_Flush(render);
+
+    /* The pixels drawn into the image are taken into its sprite and texture. */
+    RenderTarget *previous = render->target;
+    if (previous && previous->image)
+    {
+        Image *image = previous->image;
+        Image_CompileSprite(image);
+        if (image->texture) Image_CompileTexture(image, image->texture->layout);
+    }
+
+    /* The frame (or the layer) is saved when the first target is set. */
+    RenderBuffer *buffer = render->buffer;
+    if (previous == NULL)
+    {
+        render->saved_buffer = *buffer;
+        render->saved_clip = render->clip;
+        render->saved_dirty_rects = render->dirty_rects;
+    }
+    render->target = target;
+    if (target == NULL)
+    {
+        *buffer = render->saved_buffer;
+        render->clip = render->saved_clip;
+        render->dirty_rects = render->saved_dirty_rects;
+        return;
+    }
+
+    /* The regions drawn into the target are not presented, so they are collected
+    aside. */
+    buffer->width = target->width;
+    buffer->height = target->height;
+    buffer->pitch = target->pitch;
+    buffer->bitmap_memory = target->memory;
+    render->clip.x0 = 0;
+    render->clip.y0 = 0;
+    render->clip.x1 = (s32)target->width;
+    render->clip.y1 = (s32)target->height;
+    DirtyRects_Clear(render->target_dirty_rects);
+    render->dirty_rects = render->target_dirty_rects;
+}
+
+RenderTarget*
+Render_GetTarget(Render *render)
+{
+    return render->target;
+}
+
+void
+Render_BeginRecording(Render *render, RenderCmdBuffer *cmd_buffer)
+{
+    render->cmd_buffer = cmd_buffer;
+}
+
+void
+Render_EndRecording(Render *render)
+{
+    render->cmd_buffer = NULL;
+}
+
+void
+Render_BeginOcclusion(Render *render)
+{
+    dbg_check(!render->is_front_to_back, "%s", "Occlusion is already begun!");
+    if (render->occlusion == NULL) render->occlusion = RenderOcclusion_Constructor();
+    RenderOcclusion_Begin(render->occlusion, render->buffer->height);
+    render->is_front_to_back = true;
+}
+
+void
+Render_EndOcclusion(Render *render)
+{
+    if (!render->is_front_to_back) return;
+    render->is_front_to_back = false;
+
+    /* Deferred commands are drawn from the back to the front, every one of them only in
+    the parts not covered by the content in front of it. */
+    RenderOcclusion *occlusion = render->occlusion;
+    RenderRect clip = render->clip;
+    for (u32 i = occlusion->cmds_num; i > 0; --i)
+    {
+        RenderCmd cmd;
+        u32 rects_num;
+        const RenderRect *rects = RenderOcclusion_GetDeferredCmd(occlusion, i - 1, &cmd,
+            &rects_num);
+        for (u32 j = 0; j < rects_num; ++j)
+        {
+            render->clip = rects[j];
+            RenderCmd prepared_cmd;
+            const RenderCmd *drawn_cmd = PrepareCmd(render, &cmd, &prepared_cmd);
+            RenderRect bounds;
+            if (GetCmdBounds(render, drawn_cmd, &bounds))
+                DispatchCmd(render, drawn_cmd, &bounds);
+        }
+    }
+    render->clip = clip;
+}
+
+void
+Render_SetBlendMode(Render *render, BlendMode blend_mode)
+{
+    render->blend_mode = blend_mode;
+}
+
+BlendMode
+Render_GetBlendMode(Render *render)
+{
+    return render->blend_mode;
+}
+
+void
+Render_ExecuteCmd(Render *render, const RenderCmd *cmd)
+{
+#ifdef RENDER_STATS
+    if (render->stats && !IsStateCmd(cmd))
+    {
+        ExecuteCmdWithStats(render, cmd);
+        return;
+    }
+#endif
+
+    switch (cmd->type)
+    {
+    case RCT_CLEAR:
+    {
+        RenderRect rect;
+        if (ClipRect(render, 0, 0, render->buffer->width, render->buffer->height, &rect))
+        {
+            SpanFill_Clear(GetPixelAddress(render->buffer, rect.x0, rect.y0),
+                GetPitch(render->buffer), (u32)(rect.x1 - rect.x0),
+                (u32)(rect.y1 - rect.y0), cmd->color);
+        }
+    } break;
+
+    case RCT_PIXEL:
+    {
+        PlotPixel(render, (s32)cmd->pixel.x, (s32)cmd->pixel.y, cmd->color);
+    } break;
+
+    case RCT_LINE:
+    {
+        Vec2 v0;  /* Vector for the beginning point. */
+        v0.x = cmd->line.x0;
+        v0.y = cmd->line.y0;
+
+        Vec2 v1;  /* Vector for the ending point. */
+        v1.x = cmd->line.x1;
+        v1.y = cmd->line.y1;
+
+        if (ClipLineByGuardBand(&v0, &v1)) DrawLine(render, v0, v1, cmd->color);
+    } break;
+
+    case RCT_RECT:
+    {
+        s64 x0 = (s32)cmd->rect.x0;
+        s64 y0 = (s32)cmd->rect.y0;
+        FillRect(render, x0, y0, x0 + cmd->rect.width, y0 + cmd->rect.height, cmd->color,
+            cmd->blend);
+    } break;
+
+    case RCT_TRIANGLE:
+    {
+        RenderBuffer *buffer = render->buffer;
+        TriangleRaster_Fill(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->triangle.v1, cmd->triangle.v2, cmd->triangle.v3, cmd->color, cmd->blend);
+    } break;
+
+    case RCT_POLYGON:
+    {
+        RenderBuffer *buffer = render->buffer;
+        PolygonRaster_Fill(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->polygon.vertices, cmd->polygon.vertices_num, cmd->polygon.rule, cmd->color,
+            cmd->blend);
+    } break;
+
+    case RCT_POLYLINE:
+    {
+        DrawPolyline(render, cmd);
+    } break;
+
+    case RCT_RECTS:
+    {
+        RenderBuffer *buffer = render->buffer;
+        BatchRaster_FillRects(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->rects.rects, cmd->rects.band_offsets, cmd->rects.bands_num, cmd->blend);
+    } break;
+
+    case RCT_POINTS:
+    {
+        RenderBuffer *buffer = render->buffer;
+        BatchRaster_PlotPoints(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->points.points, cmd->points.band_offsets, cmd->points.bands_num);
+    } break;
+
+    case RCT_CIRCLES:
+    {
+        RenderBuffer *buffer = render->buffer;
+        BatchRaster_FillCircles(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->circles.circles, cmd->circles.band_offsets, cmd->circles.bands_num,
+            cmd->blend);
+    } break;
+
+    case RCT_CIRCLE:
+    {
+        DrawCircle(render, cmd->circle.x0, cmd->circle.y0, cmd->circle.radius,
+            cmd->circle.is_filled, cmd->color, cmd->blend);
+    } break;
+
+    case RCT_LINE_AA:
+    {
+        RenderBuffer *buffer = render->buffer;
+        LineRaster_DrawAA(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->line.x0, cmd->line.y0, cmd->line.x1, cmd->line.y1, cmd->color, cmd->blend);
+    } break;
+
+    case RCT_ELLIPSE:
+    {
+        RenderBuffer *buffer = render->buffer;
+        EllipseRaster_Fill(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->ellipse.x0, cmd->ellipse.y0, cmd->ellipse.radius_x, cmd->ellipse.radius_y,
+            cmd->ellipse.thickness, cmd->color, cmd->blend);
+    } break;
+
+    case RCT_TEXTURE:
+    {
+        Vec2 vertices[4];
+        Vec2 uvs[4];
+        u32 vertices_num = GetTexturePolygon(cmd, vertices, uvs);
+        RenderBuffer *buffer = render->buffer;
+        TextureRaster_Fill(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->texture.image->texture, vertices, uvs, vertices_num, cmd->texture.filter,
+            cmd->blend);
+    } break;
+
+    case RCT_BITMAP_SCALED:
+    {
+        RenderBuffer *buffer = render->buffer;
+        ScaleRaster_Blit(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+            cmd->scaled.image->texture, cmd->scaled.x, cmd->scaled.y, cmd->scaled.src_x,
+            cmd->scaled.src_y, cmd->scaled.width, cmd->scaled.height, cmd->scaled.scale_x,
+            cmd->scaled.scale_y, cmd->scaled.filter, cmd->blend);
+    } break;
+
+    case RCT_BITMAP:
+    case RCT_BITMAP_MASK:
+    {
+        ImageRegion region;
+        region.image = cmd->bitmap.image;
+        region.x = cmd->bitmap.src_x;
+        region.y = cmd->bitmap.src_y;
+        region.width = cmd->bitmap.width;
+        region.height = cmd->bitmap.height;
+        DrawBitmapExtended(render, cmd->bitmap.x, cmd->bitmap.y, &region, cmd->bitmap.scale,
+            (cmd->type == RCT_BITMAP_MASK), cmd->color, cmd->blend);
+    } break;
+
+    case RCT_TEXT:
+    {
+        DrawString(render, cmd);
+    } break;
+
+    case RCT_LAYER:
+    {
+        ExecuteLayerCmd(render, cmd);
+    } break;
+
+    case RCT_STATS:
+    {
+        ExecuteStatsCmd(render, cmd);
+    } break;
+
+    default:
+    {
+        dbg_error("%s", "Unknown render command!");
+    }}
+}
+
+void
+Render_ClearScreen(Render *render, const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_CLEAR;
+    cmd.color = color->color;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_SetPixelColor(Render *render, u32 x, u32 y, const Color *color)
+{    
+    RenderCmd cmd;
+    cmd.type = RCT_PIXEL;
+    cmd.color = color->color;
+    cmd.pixel.x = x;
+    cmd.pixel.y = y;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_GetPixelColor(Render *render, u32 x, u32 y, Color *color)
+{  
+    /* Recorded drawing could change the pixel. */
+    Render_Flush(render);
+
+    /* Get color of a pixel with desired coordinates. */
+    color->color = *GetPixelAddress(render->buffer, x, y);
+}
+
+void
+Render_DrawLine(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_LINE;
+    cmd.color = color->color;
+    cmd.line.x0 = x0;
+    cmd.line.y0 = y0;
+    cmd.line.x1 = x1;
+    cmd.line.y1 = y1;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawLineAA(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_LINE_AA;
+    cmd.color = color->color;
+    cmd.line.x0 = x0;
+    cmd.line.y0 = y0;
+    cmd.line.x1 = x1;
+    cmd.line.y1 = y1;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawThickLine(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, f32 width,
+    const Color *color)
+{
+    Vec2 v0, v1;  /* Beginning and ending points of the line. */
+    v0.x = x0; v0.y = y0;
+    v1.x = x1; v1.y = y1;
+    Vec2 quad[4];
+    if (!GetThickLineQuad(v0, v1, width, quad)) return;
+
+    /* The fill rule covers the pixels of the common diagonal exactly once. */
+    Render_DrawFillTriangle(render, quad[0], quad[1], quad[2], color);
+    Render_DrawFillTriangle(render, quad[0], quad[2], quad[3], color);
+}
+
+void
+Render_DrawPolyline(Render *render, const Vec2 *points, u32 points_num, f32 width,
+    b32 is_anti_aliased, const Color *color)
+{
+    if (points_num < 2) return;
+    RenderCmd cmd;
+    cmd.type = RCT_POLYLINE;
+    cmd.color = color->color;
+    cmd.polyline.points = points;
+    cmd.polyline.points_num = points_num;
+    cmd.polyline.width = width;
+    cmd.polyline.is_anti_aliased = is_anti_aliased;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawHorLine(Render *render, u32 x0, u32 y0, u32 length, u32 width, const Color *color)
+{
+    Render_DrawRect(render, x0, y0, length, width, color);
+}
+
+void
+Render_DrawVerLine(Render *render, u32 x0, u32 y0, u32 length, u32 width, const Color *color)
+{   
+    Render_DrawRect(render, x0, y0, width, length, color);
+}
+
+void
+Render_DrawRect(Render *render, u32 x0, u32 y0, u32 width, u32 height, const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_RECT;
+    cmd.color = color->color;
+    cmd.rect.x0 = x0;
+    cmd.rect.y0 = y0;
+    cmd.rect.width = width;
+    cmd.rect.height = height;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawRectWithBrd(Render *render, u32 x0, u32 y0, u32 width, u32 height,
+    u32 brd_width, const Color *color, const Color *brd_color)
+{
+    /* Draw the inner rectangle. */
+    Render_DrawRect(render, x0 + brd_width, y0 + brd_width, width - brd_width * 2,
+        height - brd_width * 2, color);
+
+    /* Draw the boarders with desired width and color. The side ones are drawn between
+    the bottom and the top ones, so the corners are not written twice. */
+    if (brd_width)
+    {
+        Render_DrawRect(render, x0, y0, width, brd_width, brd_color);
+        Render_DrawRect(render, x0, y0 + height - brd_width, width, brd_width, brd_color);
+        if (height > brd_width * 2)
+        {
+            Render_DrawRect(render, x0, y0 + brd_width, brd_width, height - brd_width * 2,
+                brd_color);
+            Render_DrawRect(render, x0 + width - brd_width, y0 + brd_width, brd_width,
+                height - brd_width * 2, brd_color);
+        }
+    }
+}
+
+void
+Render_DrawFillTriangle(Render *render, Vec2 v1, Vec2 v2, Vec2 v3, const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_TRIANGLE;
+    cmd.color = color->color;
+    cmd.triangle.v1 = v1;
+    cmd.triangle.v2 = v2;
+    cmd.triangle.v3 = v3;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawPolygon(Render *render, const Vec2 *vertices, u32 vertices_num,
+    PolygonFillRule rule, const Color *color)
+{
+    dbg_check(rule < PFR_RULES_NUM, "%s", "Unknown polygon fill rule!");
+    if (vertices_num < 3) return;
+
+    RenderCmd cmd;
+    cmd.type = RCT_POLYGON;
+    cmd.color = color->color;
+    cmd.polygon.vertices = vertices;
+    cmd.polygon.vertices_num = vertices_num;
+    cmd.polygon.rule = rule;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawRotatedRect(Render *render, f32 x0, f32 y0, f32 width, f32 height, f32 angle,
+    const Color *color)
+{
+    /* Initialize the points with the data. */
+    Vec2 BL, BR, UL, UR; /* Initial points of the rectangle. */
+    BL.x = x0; BL.y = y0;
+    BR.x = x0 + width; BR.y = y0;
+    UL.x = x0; UL.y = y0 + height;
+    UR.x = x0 + width; UR.y = y0 + height;
+
+    /* Transform degrees to radians. */
+    f32 angle_rad = angle * (f32)M_PI / 180.0f;
+
+    /* Determine the center point of the rectangle. */
+    f32 xc = x0 + width / 2.0f;
+    f32 yc = y0 + height / 2.0f;
+
+    /* Determine new points coordinates (with recpect to the rect center). */
+    Vec2 BL_c, BR_c, UL_c, UR_c; /* Coordinates with respect to the rect center. */
+    BL_c.x = BL.x - roundf(xc); BL_c.y = BL.y - roundf(yc);
+    BR_c.x = BR.x - roundf(xc); BR_c.y = BR.y - roundf(yc);
+    UL_c.x = UL.x - roundf(xc); UL_c.y = UL.y - roundf(yc);
+    UR_c.x = UR.x - roundf(xc); UR_c.y = UR.y - roundf(yc);
+
+    /* Transform the points by rotation. */
+    Vec2 BL_tr, BR_tr, UL_tr, UR_tr; /* Points after rotation transformation. */
+    BL_tr.x = roundf(xc + (BL_c.x * cosf(angle_rad) - BL_c.y * sinf(angle_rad)));
+    BL_tr.y = roundf(yc + (BL_c.x * sinf(angle_rad) + BL_c.y * cosf(angle_rad)));
+    BR_tr.x = roundf(xc + (BR_c.x * cosf(angle_rad) - BR_c.y * sinf(angle_rad)));
+    BR_tr.y = roundf(yc + (BR_c.x * sinf(angle_rad) + BR_c.y * cosf(angle_rad)));
+    UL_tr.x = roundf(xc + (UL_c.x * cosf(angle_rad) - UL_c.y * sinf(angle_rad)));
+    UL_tr.y = roundf(yc + (UL_c.x * sinf(angle_rad) + UL_c.y * cosf(angle_rad)));
+    UR_tr.x = roundf(xc + (UR_c.x * cosf(angle_rad) - UR_c.y * sinf(angle_rad)));
+    UR_tr.y = roundf(yc + (UR_c.x * sinf(angle_rad) + UR_c.y * cosf(angle_rad)));
+
+    /* Draw the rectangle (by drawing two triangles). The fill rule covers the pixels of
+    the common diagonal exactly once. */
+    Render_DrawFillTriangle(render, BL_tr, BR_tr, UR_tr, color);
+    Render_DrawFillTriangle(render, BL_tr, UL_tr, UR_tr, color);
+}
+
+void
+Render_DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled,
+    const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_CIRCLE;
+    cmd.color = color->color;
+    cmd.circle.x0 = x0;
+    cmd.circle.y0 = y0;
+    cmd.circle.radius = radius;
+    cmd.circle.is_filled = is_filled;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawEllipse(Render *render, f32 x0, f32 y0, f32 radius_x, f32 radius_y,
+    const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_ELLIPSE;
+    cmd.color = color->color;
+    cmd.ellipse.x0 = x0;
+    cmd.ellipse.y0 = y0;
+    cmd.ellipse.radius_x = radius_x;
+    cmd.ellipse.radius_y = radius_y;
+    cmd.ellipse.thickness = 0.0f;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawRing(Render *render, f32 x0, f32 y0, f32 radius, f32 thickness,
+    const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_ELLIPSE;
+    cmd.color = color->color;
+    cmd.ellipse.x0 = x0;
+    cmd.ellipse.y0 = y0;
+    cmd.ellipse.radius_x = radius;
+    cmd.ellipse.radius_y = radius;
+    cmd.ellipse.thickness = thickness;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawCircles(Render *render, const RenderCircle *circles, u32 circles_num)
+{
+    if (circles_num == 0) return;
+    RenderCmd cmd;
+    cmd.type = RCT_CIRCLES;
+    cmd.color = 0;  /* Every circle has its own color. */
+    cmd.circles.circles = circles;
+    cmd.circles.circles_num = circles_num;
+    cmd.circles.band_offsets = NULL;
+    cmd.circles.bands_num = 0;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawRects(Render *render, const RenderRectInstance *rects, u32 rects_num)
+{
+    if (rects_num == 0) return;
+    RenderCmd cmd;
+    cmd.type = RCT_RECTS;
+    cmd.color = 0;  /* Every rectangle has its own color. */
+    cmd.rects.rects = rects;
+    cmd.rects.rects_num = rects_num;
+    cmd.rects.band_offsets = NULL;
+    cmd.rects.bands_num = 0;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawPoints(Render *render, const RenderPoint *points, u32 points_num)
+{
+    if (points_num == 0) return;
+    RenderCmd cmd;
+    cmd.type = RCT_POINTS;
+    cmd.color = 0;  /* Every point has its own color. */
+    cmd.points.points = points;
+    cmd.points.xs = NULL;
+    cmd.points.ys = NULL;
+    cmd.points.colors = NULL;
+    cmd.points.points_num = points_num;
+    cmd.points.band_offsets = NULL;
+    cmd.points.bands_num = 0;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawPointArrays(Render *render, const u32 *xs, const u32 *ys, const u32 *colors,
+    u32 points_num)
+{
+    if (points_num == 0) return;
+    RenderCmd cmd;
+    cmd.type = RCT_POINTS;
+    cmd.color = 0;  /* Every point has its own color. */
+    cmd.points.points = NULL;
+    cmd.points.xs = xs;
+    cmd.points.ys = ys;
+    cmd.points.colors = colors;
+    cmd.points.points_num = points_num;
+    cmd.points.band_offsets = NULL;
+    cmd.points.bands_num = 0;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawBitmap(Render *render, u32 x, u32 y, Image *image, u32 scale)
+{
+    dbg_check(image->sprite, "%s", "Image is drawn without the compiled sprite!");
+    RenderCmd cmd;
+    cmd.type = RCT_BITMAP;
+    cmd.color = 0xffffff;  /* Color to replace the mask (will not be used). */
+    cmd.bitmap.x = x;
+    cmd.bitmap.y = y;
+    cmd.bitmap.scale = scale;
+    cmd.bitmap.src_x = 0;
+    cmd.bitmap.src_y = 0;
+    cmd.bitmap.width = image->width;
+    cmd.bitmap.height = image->height;
+    cmd.bitmap.image = image;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawBitmapByMask(Render *render, u32 x, u32 y, const Image *mask, const Color *color,
+    u32 scale)
+{
+    dbg_check(mask->sprite, "%s", "Image is drawn without the compiled sprite!");
+    RenderCmd cmd;
+    cmd.type = RCT_BITMAP_MASK;
+    cmd.color = color->color;
+    cmd.bitmap.x = x;
+    cmd.bitmap.y = y;
+    cmd.bitmap.scale = scale;
+    cmd.bitmap.src_x = 0;
+    cmd.bitmap.src_y = 0;
+    cmd.bitmap.width = mask->width;
+    cmd.bitmap.height = mask->height;
+    cmd.bitmap.image = mask;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawBitmapRegion(Render *render, u32 x, u32 y, const ImageRegion *region, u32 scale)
+{
+    dbg_check(region->image->sprite, "%s", "Image is drawn without the compiled sprite!");
+    dbg_check((region->x + region->width <= region->image->width)
+        && (region->y + region->height <= region->image->height), "%s",
+        "Region is outside of the image!");
+    RenderCmd cmd;
+    cmd.type = RCT_BITMAP;
+    cmd.color = 0xffffff;  /* Color to replace the mask (will not be used). */
+    cmd.bitmap.x = x;
+    cmd.bitmap.y = y;
+    cmd.bitmap.scale = scale;
+    cmd.bitmap.src_x = region->x;
+    cmd.bitmap.src_y = region->y;
+    cmd.bitmap.width = region->width;
+    cmd.bitmap.height = region->height;
+    cmd.bitmap.image = region->image;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawBitmapRegionByMask(Render *render, u32 x, u32 y, const ImageRegion *mask,
+    const Color *color, u32 scale)
+{
+    dbg_check(mask->image->sprite, "%s", "Image is drawn without the compiled sprite!");
+    dbg_check((mask->x + mask->width <= mask->image->width)
+        && (mask->y + mask->height <= mask->image->height), "%s",
+        "Region is outside of the image!");
+    RenderCmd cmd;
+    cmd.type = RCT_BITMAP_MASK;
+    cmd.color = color->color;
+    cmd.bitmap.x = x;
+    cmd.bitmap.y = y;
+    cmd.bitmap.scale = scale;
+    cmd.bitmap.src_x = mask->x;
+    cmd.bitmap.src_y = mask->y;
+    cmd.bitmap.width = mask->width;
+    cmd.bitmap.height = mask->height;
+    cmd.bitmap.image = mask->image;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawTexturedTriangle(Render *render, const Image *image, Vec2 v1, Vec2 v2, Vec2 v3,
+    Vec2 uv1, Vec2 uv2, Vec2 uv3, TextureFilter filter)
+{
+    dbg_check(image->texture, "%s", "Image is drawn without the compiled texture!");
+    RenderCmd cmd;
+    cmd.type = RCT_TEXTURE;
+    cmd.color = 0xffffff;  /* Color is not used by the textures. */
+    cmd.texture.vertices[0] = v1;
+    cmd.texture.vertices[1] = v2;
+    cmd.texture.vertices[2] = v3;
+    cmd.texture.uvs[0] = uv1;
+    cmd.texture.uvs[1] = uv2;
+    cmd.texture.uvs[2] = uv3;
+    cmd.texture.is_quad = false;
+    cmd.texture.filter = filter;
+    cmd.texture.image = image;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawRotatedBitmap(Render *render, f32 x0, f32 y0, const Image *image, f32 angle,
+    f32 scale, TextureFilter filter)
+{
+    dbg_check(image->texture, "%s", "Image is drawn without the compiled texture!");
+
+    /* Half sizes of the scaled image rotated around its center. */
+    f32 angle_rad = angle * (f32)M_PI / 180.0f;
+    f32 cos_a = cosf(angle_rad);
+    f32 sin_a = sinf(angle_rad);
+    f32 half_w = 0.5f * scale * (f32)image->width;
+    f32 half_h = 0.5f * scale * (f32)image->height;
+
+    RenderCmd cmd;
+    cmd.type = RCT_TEXTURE;
+    cmd.color = 0xffffff;  /* Color is not used by the textures. */
+
+    /* The BL corner and its neighbours: the BR and the UL corners. */
+    cmd.texture.vertices[0].x = x0 - half_w * cos_a + half_h * sin_a;
+    cmd.texture.vertices[0].y = y0 - half_w * sin_a - half_h * cos_a;
+    cmd.texture.vertices[1].x = x0 + half_w * cos_a + half_h * sin_a;
+    cmd.texture.vertices[1].y = y0 + half_w * sin_a - half_h * cos_a;
+    cmd.texture.vertices[2].x = x0 - half_w * cos_a - half_h * sin_a;
+    cmd.texture.vertices[2].y = y0 - half_w * sin_a + half_h * cos_a;
+    cmd.texture.uvs[0].x = 0.0f;
+    cmd.texture.uvs[0].y = 0.0f;
+    cmd.texture.uvs[1].x = (f32)image->width;
+    cmd.texture.uvs[1].y = 0.0f;
+    cmd.texture.uvs[2].x = 0.0f;
+    cmd.texture.uvs[2].y = (f32)image->height;
+    cmd.texture.is_quad = true;
+    cmd.texture.filter = filter;
+    cmd.texture.image = image;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawScaledBitmap(Render *render, f32 x, f32 y, const Image *image, f32 scale_x,
+    f32 scale_y, TextureFilter filter)
+{
+    ImageRegion region;
+    region.image = image;
+    region.x = 0;
+    region.y = 0;
+    region.width = image->width;
+    region.height = image->height;
+    Render_DrawScaledBitmapRegion(render, x, y, &region, scale_x, scale_y, filter);
+}
+
+void
+Render_DrawScaledBitmapRegion(Render *render, f32 x, f32 y, const ImageRegion *region,
+    f32 scale_x, f32 scale_y, TextureFilter filter)
+{
+    dbg_check(region->image->texture, "%s", "Image is drawn without the compiled texture!");
+    dbg_check((region->x + region->width <= region->image->width)
+        && (region->y + region->height <= region->image->height), "%s",
+        "Region is outside of the image!");
+    RenderCmd cmd;
+    cmd.type = RCT_BITMAP_SCALED;
+    cmd.color = 0xffffff;  /* Color is not used by the textures. */
+    cmd.scaled.x = x;
+    cmd.scaled.y = y;
+    cmd.scaled.scale_x = scale_x;
+    cmd.scaled.scale_y = scale_y;
+    cmd.scaled.src_x = region->x;
+    cmd.scaled.src_y = region->y;
+    cmd.scaled.width = region->width;
+    cmd.scaled.height = region->height;
+    cmd.scaled.filter = filter;
+    cmd.scaled.image = region->image;
+    EmitCmd(render, &cmd);
+}
+
+void
+Render_DrawString(Render *render, const Font *font, const char *str, s32 str_max_width,
+    u32 x, u32 y, u32 size, const Color *color)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_TEXT;
+    cmd.color = color->color;
+    cmd.text.x = x;
+    cmd.text.y = y;
+    cmd.text.size = size;
+    cmd.text.max_width = str_max_width;
+    cmd.text.font = font;
+    cmd.text.str = str;
+    cmd.text.run = NULL;
+    EmitCmd(render, &cmd);
+}
+
+static void
+EmitCmd(Render *render, RenderCmd *cmd)
+{
+    cmd->blend = render->blend_mode;
+    if (render->cmd_buffer)
+        RenderCmdBuffer_PushCmd(render->cmd_buffer, cmd);
+    else
+        Render_SubmitCmd(render, cmd);
+}
+
+static b32
+GetThickLineQuad(Vec2 v0, Vec2 v1, f32 width, Vec2 *quad)
+{
+    f32 dx = v1.x - v0.x;
+    f32 dy = v1.y - v0.y;
+    f32 length = sqrtf(dx * dx + dy * dy);
+    if (!(length > 0.0f) || !(width > 0.0f)) return false;
+
+    /* Normal to the line (to the left of it) of the half width length. */
+    f32 nx = -dy * (0.5f * width / length);
+    f32 ny = dx * (0.5f * width / length);
+    quad[0].x = v0.x + nx; quad[0].y = v0.y + ny;
+    quad[1].x = v1.x + nx; quad[1].y = v1.y + ny;
+    quad[2].x = v1.x - nx; quad[2].y = v1.y - ny;
+    quad[3].x = v0.x - nx; quad[3].y = v0.y - ny;
+    return true;
+}
+
+static b32
+PutPolylineContour(Vec2 *contour, const Vec2 *vertices)
+{
+    f32 area = 0.0f;
+    for (u32 i = 0; i < 4; ++i)
+    {
+        const Vec2 *a = &vertices[i];
+        const Vec2 *b = &vertices[(i + 1) & 3];
+        if (!isfinite(a->x) || !isfinite(a->y)) return false;
+        area += a->x * b->y - b->x * a->y;
+    }
+    for (u32 i = 0; i < 4; ++i)
+    {
+        contour[i] = vertices[(area > 0.0f) ? 3 - i : i];
+    }
+    return true;
+}
+
+static u32
+GetTexturePolygon(const RenderCmd *cmd, Vec2 *vertices, Vec2 *uvs)
+{
+    const Vec2 *v = cmd->texture.vertices;
+    const Vec2 *t = cmd->texture.uvs;
+    vertices[0] = v[0];
+    vertices[1] = v[1];
+    uvs[0] = t[0];
+    uvs[1] = t[1];
+    if (!cmd->texture.is_quad)
+    {
+        vertices[2] = v[2];
+        uvs[2] = t[2];
+        return 3;
+    }
+
+    vertices[2].x = v[1].x + v[2].x - v[0].x;
+    vertices[2].y = v[1].y + v[2].y - v[0].y;
+    vertices[3] = v[2];
+    uvs[2].x = t[1].x + t[2].x - t[0].x;
+    uvs[2].y = t[1].y + t[2].y - t[0].y;
+    uvs[3] = t[2];
+    return 4;
+}
+
+void
+Render_SubmitCmd(Render *render, const RenderCmd *cmd)
+{
+    /* State changes have no bounds, they are applied in the order of the drawing. */
+    if (IsStateCmd(cmd))
+    {
+        Render_ExecuteCmd(render, cmd);
+        return;
+    }
+
+    RenderCmd prepared_cmd;
+    const RenderCmd *drawn_cmd = PrepareCmd(render, cmd, &prepared_cmd);
+
+    RenderRect bounds;  /* Screen bounds of the command. */
+    b32 is_visible = GetCmdBounds(render, drawn_cmd, &bounds);
+#ifdef RENDER_STATS
+    if (render->stats)
+        CountSubmittedCmd(render, cmd, drawn_cmd, is_visible ? &bounds : NULL);
+#endif
+    if (!is_visible) return;
+    DirtyRects_Add(render->dirty_rects, &bounds);
+
+    if (render->is_front_to_back)
+        SubmitOccludedCmd(render, cmd, drawn_cmd, &bounds);
+    else
+        DispatchCmd(render, drawn_cmd, &bounds);
+}
+
+static const RenderCmd*
+PrepareCmd(Render *render, const RenderCmd *cmd, RenderCmd *prepared_cmd)
+{
+    /* Layout of the string is taken from the cache here, as the execution could be
+    done in parallel by the tiler. */
+    if ((cmd->type == RCT_TEXT) && (cmd->text.run == NULL))
+    {
+        *prepared_cmd = *cmd;
+        prepared_cmd->text.run = GlyphCache_GetRun(render->glyph_cache, cmd->text.font,
+            cmd->text.str, cmd->text.size, cmd->text.max_width);
+        return prepared_cmd;
+    }
+
+    /* Batches are binned once here, so every tile only visits the instances of its
+    bands. */
+    if (((cmd->type == RCT_RECTS) && (cmd->rects.band_offsets == NULL)) ||
+        ((cmd->type == RCT_POINTS) && (cmd->points.band_offsets == NULL)) ||
+        ((cmd->type == RCT_CIRCLES) && (cmd->circles.band_offsets == NULL)))
+    {
+        BinBatchCmd(render, cmd, prepared_cmd);
+        return prepared_cmd;
+    }
+    return cmd;
+}
+
+static void
+DispatchCmd(Render *render, const RenderCmd *cmd, const RenderRect *bounds)
+{
+    if (render->tiler)
+        RenderTiler_PushCmd(render->tiler, cmd, bounds);
+    else
+        Render_ExecuteCmd(render, cmd);
+}
+
+static b32
+GetCmdBounds(Render *render, const RenderCmd *cmd, RenderRect *bounds)
+{
+    /* Unsigned coordinates are treated as signed ones, so the positions that are slightly
+    left or below of the screen (wrapped around zero) are clipped correctly. */
+    switch (cmd->type)
+    {
+    case RCT_CLEAR:
+    {
+        return ClipRect(render, 0, 0, render->buffer->width, render->buffer->height,
+            bounds);
+    }
+
+    case RCT_PIXEL:
+    {
+        s64 x = (s32)cmd->pixel.x;
+        s64 y = (s32)cmd->pixel.y;
+        return ClipRect(render, x, y, x + 1, y + 1, bounds);
+    }
+
+    case RCT_LINE:
+    {
+        /* Same start point and projections as in DrawLine. */
+        Vec2 v0;
+        v0.x = cmd->line.x0;
+        v0.y = cmd->line.y0;
+        Vec2 v1;
+        v1.x = cmd->line.x1;
+        v1.y = cmd->line.y1;
+        if (!ClipLineByGuardBand(&v0, &v1)) return false;
+
+        s64 x_begin = (s32)v0.x;
+        s64 y_begin = (s32)v0.y;
+        s64 x_end = x_begin + (s32)(v1.x - v0.x);
+        s64 y_end = y_begin + (s32)(v1.y - v0.y);
+        s64 x_min = (x_begin < x_end) ? x_begin : x_end;
+        s64 x_max = (x_begin < x_end) ? x_end : x_begin;
+        s64 y_min = (y_begin < y_end) ? y_begin : y_end;
+        s64 y_max = (y_begin < y_end) ? y_end : y_begin;
+        return ClipRect(render, x_min, y_min, x_max + 1, y_max + 1, bounds);
+    }
+
+    case RCT_LINE_AA:
+    {
+        /* Coverage reaches the pixels next to the line and its ends. */
+        f32 x0 = cmd->line.x0;
+        f32 y0 = cmd->line.y0;
+        f32 x1 = cmd->line.x1;
+        f32 y1 = cmd->line.y1;
+        if (!isfinite(x0) || !isfinite(y0) || !isfinite(x1) || !isfinite(y1)) return false;
+        return ClipRectF(render, fminf(x0, x1) - 1.0f, fminf(y0, y1) - 1.0f,
+            fmaxf(x0, x1) + 1.0f, fmaxf(y0, y1) + 1.0f, bounds);
+    }
+
+    case RCT_RECT:
+    {
+        s64 x0 = (s32)cmd->rect.x0;
+        s64 y0 = (s32)cmd->rect.y0;
+        return ClipRect(render, x0, y0, x0 + cmd->rect.width, y0 + cmd->rect.height,
+            bounds);
+    }
+
+    case RCT_TRIANGLE:
+    {
+        /* Only the pixels with the centers inside of the triangle are covered. */
+        const Vec2 *v1 = &cmd->triangle.v1;
+        const Vec2 *v2 = &cmd->triangle.v2;
+        const Vec2 *v3 = &cmd->triangle.v3;
+        f32 x_min = fminf(v1->x, fminf(v2->x, v3->x));
+        f32 x_max = fmaxf(v1->x, fmaxf(v2->x, v3->x));
+        f32 y_min = fminf(v1->y, fminf(v2->y, v3->y));
+        f32 y_max = fmaxf(v1->y, fmaxf(v2->y, v3->y));
+        return ClipRectF(render, x_min, y_min, x_max, y_max, bounds);
+    }
+
+    case RCT_POLYGON:
+    {
+        /* Only the pixels with the centers inside of the polygon are covered. */
+        const Vec2 *vertices = cmd->polygon.vertices;
+        f32 x_min = vertices[0].x, x_max = vertices[0].x;
+        f32 y_min = vertices[0].y, y_max = vertices[0].y;
+        for (u32 i = 1; i < cmd->polygon.vertices_num; ++i)
+        {
+            x_min = fminf(x_min, vertices[i].x);
+            x_max = fmaxf(x_max, vertices[i].x);
+            y_min = fminf(y_min, vertices[i].y);
+            y_max = fmaxf(y_max, vertices[i].y);
+        }
+        return ClipRectF(render, x_min, y_min, x_max, y_max, bounds);
+    }
+
+    case RCT_POLYLINE:
+    {
+        const Vec2 *points = cmd->polyline.points;
+        f32 width = cmd->polyline.width;
+        if (width > 1.0f)
+        {
+            /* Corners of the quads and the bevels are half the width from the points. */
+            f32 x_min = INFINITY, x_max = -INFINITY;
+            f32 y_min = INFINITY, y_max = -INFINITY;
+            for (u32 i = 0; i < cmd->polyline.points_num; ++i)
+            {
+                if (!isfinite(points[i].x) || !isfinite(points[i].y)) continue;
+                x_min = fminf(x_min, points[i].x);
+                x_max = fmaxf(x_max, points[i].x);
+                y_min = fminf(y_min, points[i].y);
+                y_max = fmaxf(y_max, points[i].y);
+            }
+            if (x_min > x_max) return false;
+            f32 half = 0.5f * width;
+            return ClipRectF(render, x_min - half, y_min - half, x_max + half,
+                y_max + half, bounds);
+        }
+
+        /* Thin polylines are bounded by the union of their lines. */
+        RenderCmd line;
+        line.type = cmd->polyline.is_anti_aliased ? RCT_LINE_AA : RCT_LINE;
+        b32 is_visible = false;
+        for (u32 i = 1; i < cmd->polyline.points_num; ++i)
+        {
+            RenderRect line_bounds;
+            line.line.x0 = points[i - 1].x;
+            line.line.y0 = points[i - 1].y;
+            line.line.x1 = points[i].x;
+            line.line.y1 = points[i].y;
+            if (!GetCmdBounds(render, &line, &line_bounds)) continue;
+            if (!is_visible)
+            {
+                *bounds = line_bounds;
+                is_visible = true;
+                continue;
+            }
+            if (line_bounds.x0 < bounds->x0) bounds->x0 = line_bounds.x0;
+            if (line_bounds.y0 < bounds->y0) bounds->y0 = line_bounds.y0;
+            if (line_bounds.x1 > bounds->x1) bounds->x1 = line_bounds.x1;
+            if (line_bounds.y1 > bounds->y1) bounds->y1 = line_bounds.y1;
+        }
+        return is_visible;
+    }
+
+    case RCT_RECTS:
+    {
+        /* Binned parts are already clipped. */
+        if (cmd->rects.rects_num == 0) return false;
+        const RenderRectInstance *rects = cmd->rects.rects;
+        s64 x0 = rects[0].x0, y0 = rects[0].y0;
+        s64 x1 = x0 + rects[0].width, y1 = y0 + rects[0].height;
+        for (u32 i = 1; i < cmd->rects.rects_num; ++i)
+        {
+            const RenderRectInstance *rect = &rects[i];
+            if (rect->x0 < x0) x0 = rect->x0;
+            if (rect->y0 < y0) y0 = rect->y0;
+            if (rect->x0 + rect->width > x1) x1 = rect->x0 + rect->width;
+            if (rect->y0 + rect->height > y1) y1 = rect->y0 + rect->height;
+        }
+        return ClipRect(render, x0, y0, x1, y1, bounds);
+    }
+
+    case RCT_POINTS:
+    {
+        /* Binned points are already clipped. */
+        if (cmd->points.points_num == 0) return false;
+        const RenderPoint *points = cmd->points.points;
+        s64 x0 = points[0].x, y0 = points[0].y;
+        s64 x1 = x0 + 1, y1 = y0 + 1;
+        for (u32 i = 1; i < cmd->points.points_num; ++i)
+        {
+            const RenderPoint *point = &points[i];
+            if (point->x < x0) x0 = point->x;
+            if (point->y < y0) y0 = point->y;
+            if (point->x >= x1) x1 = point->x + 1;
+            if (point->y >= y1) y1 = point->y + 1;
+        }
+        return ClipRect(render, x0, y0, x1, y1, bounds);
+    }
+
+    case RCT_CIRCLES:
+    {
+        /* Pixels with the centers inside of the circles, as of RCT_ELLIPSE. */
+        f32 x_min = INFINITY, x_max = -INFINITY;
+        f32 y_min = INFINITY, y_max = -INFINITY;
+        for (u32 i = 0; i < cmd->circles.circles_num; ++i)
+        {
+            const RenderCircle *circle = &cmd->circles.circles[i];
+            f32 radius = circle->radius;
+            if (!(radius > 0.0f)) continue;
+            x_min = fminf(x_min, circle->x0 - radius);
+            x_max = fmaxf(x_max, circle->x0 + radius);
+            y_min = fminf(y_min, circle->y0 - radius);
+            y_max = fmaxf(y_max, circle->y0 + radius);
+        }
+        if (x_min > x_max) return false;
+        return ClipRectF(render, x_min, y_min, x_max, y_max, bounds);
+    }
+
+    case RCT_CIRCLE:
+    {
+        f32 x0 = cmd->circle.x0;
+        f32 y0 = cmd->circle.y0;
+        f32 radius = fabsf(cmd->circle.radius);
+        return ClipRectF(render, x0 - radius - 2.0f, y0 - radius - 2.0f,
+            x0 + radius + 3.0f, y0 + radius + 3.0f, bounds);
+    }
+
+    case RCT_ELLIPSE:
+    {
+        /* Only the pixels with the centers inside of the ellipse are covered. */
+        f32 x0 = cmd->ellipse.x0;
+        f32 y0 = cmd->ellipse.y0;
+        f32 radius_x = cmd->ellipse.radius_x;
+        f32 radius_y = cmd->ellipse.radius_y;
+        if (!(radius_x > 0.0f) || !(radius_y > 0.0f)) return false;
+        return ClipRectF(render, x0 - radius_x, y0 - radius_y, x0 + radius_x,
+            y0 + radius_y, bounds);
+    }
+
+    case RCT_TEXTURE:
+    {
+        /* Only the pixels with the centers inside of the polygon are covered. */
+        Vec2 vertices[4];
+        Vec2 uvs[4];
+        u32 vertices_num = GetTexturePolygon(cmd, vertices, uvs);
+        f32 x_min = vertices[0].x, x_max = vertices[0].x;
+        f32 y_min = vertices[0].y, y_max = vertices[0].y;
+        for (u32 i = 1; i < vertices_num; ++i)
+        {
+            x_min = fminf(x_min, vertices[i].x);
+            x_max = fmaxf(x_max, vertices[i].x);
+            y_min = fminf(y_min, vertices[i].y);
+            y_max = fmaxf(y_max, vertices[i].y);
+        }
+        return ClipRectF(render, x_min, y_min, x_max, y_max, bounds);
+    }
+
+    case RCT_BITMAP_SCALED:
+    {
+        /* Only the pixels with the centers inside of the scaled image are covered. */
+        RenderRect rect;
+        if (!ScaleRaster_GetRect(cmd->scaled.x, cmd->scaled.y, cmd->scaled.width,
+            cmd->scaled.height, cmd->scaled.scale_x, cmd->scaled.scale_y, &rect))
+        {
+            return false;
+        }
+        return ClipRect(render, rect.x0, rect.y0, rect.x1, rect.y1, bounds);
+    }
+
+    case RCT_BITMAP:
+    case RCT_BITMAP_MASK:
+    {
+        s64 x = (s32)cmd->bitmap.x;
+        s64 y = (s32)cmd->bitmap.y;
+        s64 width = (s64)cmd->bitmap.width * cmd->bitmap.scale;
+        s64 height = (s64)cmd->bitmap.height * cmd->bitmap.scale;
+        return ClipRect(render, x, y, x + width, y + height, bounds);
+    }
+
+    case RCT_TEXT:
+    {
+        const TextRun *run = cmd->text.run;
+        if (run->spans_num == 0) return false;
+        s64 x = (s32)cmd->text.x;
+        s64 y = (s32)cmd->text.y;
+        return ClipRect(render, x + run->bounds.x0, y + run->bounds.y0, x + run->bounds.x1,
+            y + run->bounds.y1, bounds);
+    }
+
+    default:
+    {
+        dbg_error("%s", "Unknown render command!");
+    }}
+    return false;
+}
+
+static void
+BinBatchCmd(Render *render, const RenderCmd *cmd, RenderCmd *binned_cmd)
+{
+    /* Offsets of the bands are followed by the binned instances. */
+    const RenderRect *clip = &render->clip;
+    u32 bands_num = BatchRaster_GetBandsNum(clip);
+    size_t offsets_size = (bands_num + 1) * sizeof(u32);
+    *binned_cmd = *cmd;
+
+    if (cmd->type == RCT_RECTS)
+    {
+        u8 *memory = GetBatchMemory(render, offsets_size);
+        u32 parts_num = BatchRaster_CountRects(cmd->rects.rects, cmd->rects.rects_num, clip,
+            (u32 *)memory);
+        size_t parts_size = parts_num * sizeof(RenderRectInstance);
+        memory = GetBatchMemory(render, offsets_size + parts_size);
+        RenderRectInstance *parts = (RenderRectInstance *)(memory + offsets_size);
+        BatchRaster_BinRects(cmd->rects.rects, cmd->rects.rects_num, clip, cmd->blend,
+            (u32 *)memory, parts);
+        binned_cmd->rects.rects = parts;
+        binned_cmd->rects.rects_num = parts_num;
+        binned_cmd->rects.band_offsets = (const u32 *)memory;
+        binned_cmd->rects.bands_num = bands_num;
+    }
+    else if (cmd->type == RCT_CIRCLES)
+    {
+        u8 *memory = GetBatchMemory(render, offsets_size);
+        u32 binned_num = BatchRaster_CountCircles(cmd->circles.circles,
+            cmd->circles.circles_num, clip, (u32 *)memory);
+        size_t binned_size = binned_num * sizeof(RenderCircle);
+        memory = GetBatchMemory(render, offsets_size + binned_size);
+        RenderCircle *binned = (RenderCircle *)(memory + offsets_size);
+        BatchRaster_BinCircles(cmd->circles.circles, cmd->circles.circles_num, clip,
+            (u32 *)memory, binned);
+        binned_cmd->circles.circles = binned;
+        binned_cmd->circles.circles_num = binned_num;
+        binned_cmd->circles.band_offsets = (const u32 *)memory;
+        binned_cmd->circles.bands_num = bands_num;
+    }
+    else
+    {
+        u32 points_num = cmd->points.points_num;
+        u8 *memory = GetBatchMemory(render, offsets_size + points_num * sizeof(RenderPoint));
+        RenderPoint *points = (RenderPoint *)(memory + offsets_size);
+        binned_cmd->points.points_num = BatchRaster_BinPoints(cmd->points.points,
+            cmd->points.xs, cmd->points.ys, cmd->points.colors, points_num, clip,
+            (u32 *)memory, points);
+        binned_cmd->points.points = points;
+        binned_cmd->points.xs = NULL;
+        binned_cmd->points.ys = NULL;
+        binned_cmd->points.colors = NULL;
+        binned_cmd->points.band_offsets = (const u32 *)memory;
+        binned_cmd->points.bands_num = bands_num;
+    }
+}
+
+static u8*
+GetBatchMemory(Render *render, size_t size)
+{
+    if (size > render->batch_capacity)
+    {
+        size_t capacity = render->batch_capacity ? render->batch_capacity : 4096;
+        while (capacity < size) capacity *= 2;
+        render->batch_memory = HelperFcn_MemReallocate(render->batch_memory, capacity);
+        render->batch_capacity = capacity;
+    }
+    return (u8 *)render->batch_memory;
+}
+
+static void
+SubmitOccludedCmd(Render *render, const RenderCmd *cmd, const RenderCmd *drawn_cmd,
+    const RenderRect *bounds)
+{
+    /* Commands behind the opaque content are dropped entirely. */
+    RenderOcclusion *occlusion = render->occlusion;
+    u32 rects_num;
+    const RenderRect *rects = RenderOcclusion_GetUncoveredRects(occlusion, bounds,
+        &rects_num);
+    if (rects_num == 0) return;
+
+    /* Uncovered parts are found before the command covers its own pixels. */
+    if (!CoverOpaqueCmd(render, drawn_cmd, bounds))
+    {
+        RenderOcclusion_DeferCmd(occlusion, cmd, rects, rects_num);
+        return;
+    }
+
+    RenderRect clip = render->clip;
+    for (u32 i = 0; i < rects_num; ++i)
+    {
+        render->clip = rects[i];
+        DispatchCmd(render, drawn_cmd, &rects[i]);
+    }
+    render->clip = clip;
+}
+
+static b32
+CoverOpaqueCmd(Render *render, const RenderCmd *cmd, const RenderRect *bounds)
+{
+    RenderOcclusion *occlusion = render->occlusion;
+    b32 is_opaque_color = (cmd->blend == BM_NONE) ||
+        ((cmd->blend == BM_ALPHA) && ((cmd->color >> 24) == 0xff));
+    switch (cmd->type)
+    {
+    case RCT_CLEAR:
+    {
+        RenderOcclusion_CoverRect(occlusion, bounds);
+        return true;
+    }
+
+    case RCT_RECT:
+    {
+        if (!is_opaque_color) return false;
+        RenderOcclusion_CoverRect(occlusion, bounds);
+        return true;
+    }
+
+    case RCT_BITMAP:
+    case RCT_BITMAP_MASK:
+    {
+        /* Opaque spans replace the destination in the same cases as in the
+        DrawBitmapExtended (the mask color should be opaque too). */
+        b32 is_mask = (cmd->type == RCT_BITMAP_MASK);
+        b32 is_replacing = is_mask ? is_opaque_color :
+            ((cmd->blend == BM_NONE) || (cmd->blend == BM_ALPHA));
+        if (!is_replacing) return false;
+
+        const Sprite *sprite = cmd->bitmap.image->sprite;
+        s64 x0 = (s32)cmd->bitmap.x;
+        s64 y0 = (s32)cmd->bitmap.y;
+        u32 scale = cmd->bitmap.scale;
+        u32 region_x0 = cmd->bitmap.src_x;
+        u32 region_x1 = cmd->bitmap.src_x + cmd->bitmap.width;
+        b32 is_opaque = true;
+        for (s32 y = bounds->y0; y < bounds->y1; ++y)
+        {
+            u32 row = cmd->bitmap.src_y + (u32)((y - y0) / scale);
+            const SpriteSpan *span = sprite->spans + sprite->row_spans[row];
+            const SpriteSpan *spans_end = sprite->spans + sprite->row_spans[row + 1];
+            for (; span < spans_end; ++span)
+            {
+                /* Part of the span inside of the region and the bounds. */
+                if (span->x >= region_x1) break;
+                if (span->x + span->length <= region_x0) continue;
+                u32 column_x0 = (span->x > region_x0) ? span->x : region_x0;
+                u32 column_x1 = (span->x + span->length < region_x1) ?
+                    (span->x + span->length) : region_x1;
+                s64 span_x0 = x0 + (s64)(column_x0 - region_x0) * scale;
+                s64 span_x1 = x0 + (s64)(column_x1 - region_x0) * scale;
+                if (span_x0 < bounds->x0) span_x0 = bounds->x0;
+                if (span_x1 > bounds->x1) span_x1 = bounds->x1;
+                if (span_x0 >= span_x1) continue;
+
+                if (span->is_opaque)
+                    RenderOcclusion_CoverSpan(occlusion, y, (s32)span_x0, (s32)span_x1);
+                else
+                    is_opaque = false;
+            }
+        }
+        return is_opaque;
+    }
+
+    case RCT_BITMAP_SCALED:
+    {
+        /* Opaque texels (interpolated ones too) replace the destination. */
+        b32 is_replacing = (cmd->blend == BM_NONE) || (cmd->blend == BM_ALPHA);
+        if (!is_replacing || !cmd->scaled.image->texture->is_opaque) return false;
+        RenderOcclusion_CoverRect(occlusion, bounds);
+        return true;
+    }
+
+    default:
+    {
+        /* Other commands are blended or do not cover much. */
+        return false;
+    }}
+}
+
+#ifdef RENDER_STATS
+static void
+CountSubmittedCmd(Render *render, const RenderCmd *cmd, const RenderCmd *drawn_cmd,
+    const RenderRect *bounds)
+{
+    RenderStats *stats = render->stats;
+    RenderStatsCounters *counters = RenderStats_GetCounters(stats, 0, cmd->type);
+    counters->calls++;
+    if (bounds == NULL) counters->culled++;
+
+    u64 drawn_pixels = 0;
+    if (bounds)
+        drawn_pixels = (u64)(bounds->x1 - bounds->x0) * (u64)(bounds->y1 - bounds->y0);
+    if ((cmd->type == RCT_RECTS) && (cmd != drawn_cmd))
+    {
+        /* Binned parts are the clipped rectangles. */
+        u64 pixels = 0;
+        for (u32 i = 0; i < cmd->rects.rects_num; ++i)
+        {
+            pixels += (u64)cmd->rects.rects[i].width * cmd->rects.rects[i].height;
+        }
+        for (u32 i = 0; i < drawn_cmd->rects.rects_num; ++i)
+        {
+            pixels -= (u64)drawn_cmd->rects.rects[i].width * drawn_cmd->rects.rects[i].height;
+        }
+        counters->pixels_rejected += pixels;
+    }
+    else if ((cmd->type == RCT_POINTS) && (cmd != drawn_cmd))
+    {
+        counters->pixels_rejected += cmd->points.points_num - drawn_cmd->points.points_num;
+    }
+    else
+    {
+        /* Bounds are found once more without the clipping (far away ones are clamped),
+        binned circles are only the ones inside of the clip rectangle. */
+        RenderRect clip = render->clip;
+        RenderRect full_bounds;
+        render->clip.x0 = -(1 << 30);
+        render->clip.y0 = -(1 << 30);
+        render->clip.x1 = 1 << 30;
+        render->clip.y1 = 1 << 30;
+        const RenderCmd *bounded_cmd = (cmd->type == RCT_CIRCLES) ? cmd : drawn_cmd;
+        if (GetCmdBounds(render, bounded_cmd, &full_bounds))
+        {
+            counters->pixels_rejected += (u64)(full_bounds.x1 - full_bounds.x0) *
+                (u64)(full_bounds.y1 - full_bounds.y0) - drawn_pixels;
+        }
+        render->clip = clip;
+    }
+}
+
+static void
+ExecuteCmdWithStats(Render *render, const RenderCmd *cmd)
+{
+    /* Statistics are detached, so the command is executed by the usual way, the kernels
+    count the written pixels into the counters of the command. */
+    RenderStats *stats = render->stats;
+    RenderStatsCounters *counters = RenderStats_GetCounters(stats, render->stats_slot,
+        cmd->type);
+    RenderBuffer *buffer = render->buffer;
+    render->stats = NULL;
+    RenderStats_BeginCmd(stats, counters, buffer->bitmap_memory, GetPitch(buffer),
+        buffer->height, (render->target == NULL));
+
+    u64 begin = HelperFcn_GetTimeNs();
+    Render_ExecuteCmd(render, cmd);
+    counters->time_ns += HelperFcn_GetTimeNs() - begin;
+
+    RenderStats_EndCmd();
+    render->stats = stats;
+}
+#endif
+
+static void
+AllocateBuffer(Render *render, u32 width, u32 height)
+{
+    dbg_check(render->target == NULL, "%s", "Frame is changed while drawing into a target!");
+    RenderBuffer *buffer = render->buffer;
+    buffer->width = width;
+    buffer->height = height;
+    buffer->pitch = width * sizeof(u32);
+
+    /* Drawing is allowed in the entire buffer. */
+    render->clip.x0 = 0;
+    render->clip.y0 = 0;
+    render->clip.x1 = (s32)width;
+    render->clip.y1 = (s32)height;
+    Render_InvalidateWindow(render);
+
+    /* Delete the bitmap memory if it was previously allocated. */
+    if (buffer->bitmap_memory)
+    {
+        HelperFcn_PageFree(buffer->bitmap_memory);
+        buffer->bitmap_memory = NULL;
+    }
+
+    /* Allocate the bitmap memory. */
+    size_t mem_size = sizeof(u32) * width * height;
+    buffer->bitmap_memory = HelperFcn_PageAllocate(mem_size);
+
+#ifdef _WIN32
+    /* Fill the bitmap_info structure. */
+    render->bitmap_info.bmiHeader.biSize = sizeof(render->bitmap_info.bmiHeader);
+    render->bitmap_info.bmiHeader.biWidth = width;
+    render->bitmap_info.bmiHeader.biHeight = height;
+    render->bitmap_info.bmiHeader.biPlanes = 1;
+    render->bitmap_info.bmiHeader.biBitCount = 32;
+    render->bitmap_info.bmiHeader.biCompression = BI_RGB;
+#endif
+}
+
+static void
+BeginFrameTarget(Render *render)
+{
+    if (render->layers == NULL) return;
+    render->buffer->bitmap_memory = render->frame_memory;
+    render->dirty_rects = render->frame_dirty_rects;
+}
+
+static void
+EndFrameTarget(Render *render)
+{
+    if (render->layers == NULL) return;
+    if (render->dirty_rects == render->frame_dirty_rects)
+    {
+        render->frame_memory = render->buffer->bitmap_memory;
+    }
+    RenderLayer *layer = &render->layers->layers[render->layer];
+    render->buffer->bitmap_memory = layer->memory;
+    render->dirty_rects = layer->dirty_rects;
+}
+
+static void
+SelectLayer(Render *render, RenderLayerId layer)
+{
+    if (render->layer == layer) return;
+    dbg_check(render->target == NULL, "%s", "Frame is changed while drawing into a target!");
+    dbg_check(!render->is_front_to_back, "%s", "Layer is changed before the occlusion end!");
+    Render_Flush(render);
+    render->layer = layer;
+    if (render->layers) EndFrameTarget(render);
+}
+
+static void
+EmitLayerCmd(Render *render, RenderLayerId layer, RenderLayerAction action,
+    b32 is_visible)
+{
+    RenderCmd cmd;
+    cmd.type = RCT_LAYER;
+    cmd.color = 0;
+    cmd.layer.layer = (u32)layer;
+    cmd.layer.action = (u32)action;
+    cmd.layer.is_visible = is_visible;
+    EmitCmd(render, &cmd);
+}
+
+static void
+ExecuteLayerCmd(Render *render, const RenderCmd *cmd)
+{
+    RenderLayerId layer = (RenderLayerId)cmd->layer.layer;
+    switch (cmd->layer.action)
+    {
+    case RLA_SELECT:
+    {
+        SelectLayer(render, layer);
+    } break;
+
+    case RLA_SET_VISIBLE:
+    {
+        if (render->layers)
+            RenderLayers_SetVisible(render->layers, layer, cmd->layer.is_visible);
+    } break;
+
+    case RLA_CLEAR:
+    {
+        if (render->layers == NULL) return;
+        Render_Flush(render);
+        RenderLayers_Clear(render->layers, layer);
+    } break;
+
+    default:
+    {
+        dbg_error("%s", "Unknown layer action!");
+    }}
+}
+
+static void
+EmitStatsCmd(Render *render, RenderStatsAction action, b32 is_heatmap)
 {
-    VirtualFree(render->buffer->bitmap_memory, 0, MEM_RELEASE);
-    ReleaseDC(render->window, render->hdc);
-    HelperFcn_MemFree(render->buffer);
-    HelperFcn_MemFree(render->triangle_data);
-    HelperFcn_MemFree(render);
-    return NULL;
+    RenderCmd cmd;
+    cmd.type = RCT_STATS;
+    cmd.color = 0;
+    cmd.stats.action = (u32)action;
+    cmd.stats.is_heatmap = is_heatmap;
+    EmitCmd(render, &cmd);
 }
 
-void
-Render_Init(Render *render, HWND window)
+static void
+ExecuteStatsCmd(Render *render, const RenderCmd *cmd)
 {
-    /* Get and save header to the window and its drawing context. */
-    render->window = window;
-    render->hdc = GetDC(window);
-
-    /* Calculate width and height of the window (client area) for the buffer. */
-    RECT rect;
-    GetClientRect(window, &rect);
-    u32 rect_width = (u32)(rect.right - rect.left);
-    u32 rect_height = (u32)(rect.bottom - rect.top);
-    render->buffer->width = rect_width;
-    render->buffer->height = rect_height;
-    render->width = rect_width;
-    render->height = rect_height;
+    switch (cmd->stats.action)
+    {
+    case RSA_ENABLE:
+    {
+#ifdef RENDER_STATS
+        /* Drawing submitted before is not counted. */
+        Render_Flush(render);
+        if (render->stats == NULL) render->stats = RenderStats_Constructor();
+        RenderStats_Init(render->stats, render->buffer->width, render->buffer->height,
+            cmd->stats.is_heatmap);
+        RenderStatsExchange_Publish(render->stats_exchange, &render->stats->last);
+#endif
+    } break;
 
-     /* Delete the bitmap memory if it was previously allocated. */
-    if (render->buffer->bitmap_memory) 
+    case RSA_DISABLE:
     {
-        VirtualFree(render->buffer->bitmap_memory, 0, MEM_RELEASE);
-        render->buffer->bitmap_memory = NULL;
-    }
+        if (render->stats == NULL) return;
+        Render_Flush(render);
+        render->stats = RenderStats_Destructor(render->stats);
 
-    /* Allocate the bitmap memory. */
-    SIZE_T mem_size = sizeof(u32) * rect_width * rect_height;
-    render->buffer->bitmap_memory = VirtualAlloc(0, mem_size, MEM_COMMIT|MEM_RESERVE, 
-        PAGE_READWRITE);
+        /* Reader gets zeros without the statistics. */
+        RenderFrameStats stats;
+        memset(&stats, 0, sizeof(stats));
+        RenderStatsExchange_Publish(render->stats_exchange, &stats);
+    } break;
 
-    /* Fill the bitmap_info structure. */
-    render->bitmap_info.bmiHeader.biSize = sizeof(render->bitmap_info.bmiHeader);
-    render->bitmap_info.bmiHeader.biWidth = rect_width;
-    render->bitmap_info.bmiHeader.biHeight = rect_height;
-    render->bitmap_info.bmiHeader.biPlanes = 1;
-    render->bitmap_info.bmiHeader.biBitCount = 32;
-    render->bitmap_info.bmiHeader.biCompression = BI_RGB;
-}
+    case RSA_DRAW_HEATMAP:
+    {
+        if ((render->stats == NULL) || !render->stats->is_heatmap) return;
+        Render_Flush(render);
+        RenderBuffer *buffer = render->buffer;
+        RenderStats_DrawHeatmap(render->stats, buffer->bitmap_memory, GetPitch(buffer),
+            &render->clip);
+        DirtyRects_Add(render->dirty_rects, &render->clip);
+    } break;
 
-void 
-Render_ResizeWindow(Render *render)
-{    
-    RECT rect;
-    GetClientRect(render->window, &rect);
-    render->width = (u32)(rect.right - rect.left);
-    render->height = (u32)(rect.bottom - rect.top);
+    default:
+    {
+        dbg_error("%s", "Unknown statistics action!");
+    }}
 }
 
-void 
-Render_UpdateWindow(Render *render)
+static b32
+IsStateCmd(const RenderCmd *cmd)
 {
-    StretchDIBits(render->hdc, 0, 0, (int)render->width, (int)render->height, 0, 0,
-    (int)render->buffer->width, (int)render->buffer->height, render->buffer->bitmap_memory,
-    &render->bitmap_info, DIB_RGB_COLORS, SRCCOPY);
+    return (cmd->type == RCT_LAYER) || (cmd->type == RCT_STATS);
 }
 
-void
-Render_ClearScreen(Render *render, const Color *color)
+static void
+PresentBuffer(Render *render, void *memory, DirtyRects *dirty_rects)
 {
-    u32 pitch = render->buffer->width * 4;
-    u32 width = render->buffer->width;
-    u32 height = render->buffer->height;
-    u8 *row = (u8*)render->buffer->bitmap_memory;
+    /* The frame of the headless render stays in the memory. */
+#ifdef _WIN32
+    if (render->hdc == NULL)
+#endif
+    {
+        Atomic_Exchange(&render->is_invalidated, false);
+        return;
+    }
+
+#ifdef _WIN32
+    RenderBuffer *buffer = render->buffer;
+
+    /* The buffer of the internal resolution is scaled to the window by the upscaler,
+    the output is presented as a whole. */
+    u32 width = render->width;
+    u32 height = render->height;
+    if (render->upscaler && (width > 0) && (height > 0) &&
+        ((width != buffer->width) || (height != buffer->height)))
+    {
+        Upscaler *upscaler = render->upscaler;
+        Upscaler_Configure(upscaler, buffer->width, buffer->height, width, height,
+            upscaler->filter);
+        const u32 *output = Upscaler_Run(upscaler, memory);
+        BITMAPINFO output_info = render->bitmap_info;
+        output_info.bmiHeader.biWidth = (LONG)width;
+        output_info.bmiHeader.biHeight = (LONG)height;
+        Atomic_Exchange(&render->is_invalidated, false);
+        StretchDIBits(render->hdc, 0, 0, (int)width, (int)height, 0, 0, (int)width,
+            (int)height, output, &output_info, DIB_RGB_COLORS, SRCCOPY);
+        return;
+    }
 
-    /* Procedure to fill the pixeld in optimized way. */
-    for (u32 y = 0; y < height; y++)
+    /* Present the whole buffer when it is stretched, invalidated or mostly changed. */
+    u64 buffer_area = (u64)buffer->width * buffer->height;
+    b32 is_stretched = (render->width != buffer->width) || (render->height != buffer->height);
+    b32 is_invalidated = (Atomic_Exchange(&render->is_invalidated, false) != 0);
+    if (is_invalidated || is_stretched || (dirty_rects == NULL) ||
+        (DirtyRects_GetArea(dirty_rects) * 2 > buffer_area))
+    {
+        StretchDIBits(render->hdc, 0, 0, (int)render->width, (int)render->height, 0, 0,
+        (int)buffer->width, (int)buffer->height, memory,
+        &render->bitmap_info, DIB_RGB_COLORS, SRCCOPY);
+    }
+    else
     {
-        u32 *pixel = (u32*)row;
-        for (u32 x = 0; x < width; x++)
+        /* The source origin of the bottom-up bitmap is the BL corner, while the window
+        origin is the UL corner. */
+        for (u32 i = 0; i < dirty_rects->rects_num; ++i)
         {
-            *(pixel) = color->color;
-            ++pixel;
+            RenderRect *rect = &dirty_rects->rects[i];
+            int width = rect->x1 - rect->x0;
+            int height = rect->y1 - rect->y0;
+            StretchDIBits(render->hdc, rect->x0, (int)buffer->height - rect->y1, width,
+                height, rect->x0, rect->y0, width, height, memory,
+                &render->bitmap_info, DIB_RGB_COLORS, SRCCOPY);
         }
-        row += pitch;
     }
+#else
+    (void)memory;
+    (void)dirty_rects;
+#endif
 }
 
-void
-Render_SetPixelColor(Render *render, u32 x, u32 y, const Color *color)
-{    
-    /* Set color of a pixel with desired coordinates. */
-    u32 *pixel = (u32*)render->buffer->bitmap_memory;
-    *(pixel + x + render->buffer->width * y) = color->color;
-}
+static void
+HandOverFrame(Render *render)
+{
+    SwapChain *swap_chain = render->swap_chain;
+    s32 published = swap_chain->back;
 
-void
-Render_GetPixelColor(Render *render, u32 x, u32 y, Color *color)
-{  
-    /* Get color of a pixel with desired coordinates. */
-    u32 *pixel = (u32*)render->buffer->bitmap_memory; 
-    color->color = *(pixel + x + render->buffer->width * y);
+    /* Regions drawn in the frame are presented with it, the content of all the other
+    buffers is behind the frame by these regions. */
+    DirtyRects *dirty_rects = render->dirty_rects;
+    *render->swap_drawn[published] = *dirty_rects;
+    for (s32 i = 0; i < (s32)swap_chain->buffers_num; ++i)
+    {
+        if (i == published) continue;
+        for (u32 j = 0; j < dirty_rects->rects_num; ++j)
+        {
+            DirtyRects_Add(render->swap_stale[i], &dirty_rects->rects[j]);
+        }
+    }
+    DirtyRects_Clear(dirty_rects);
+    SwapChain_Publish(swap_chain);
+
+    /* Bring the next back buffer up to the published frame (the published buffer is
+    only read by the present thread, so it could be read here as well). */
+    s32 back = SwapChain_WaitBack(swap_chain);
+    RenderBuffer *buffer = render->buffer;
+    u32 pitch = GetPitch(buffer);
+    DirtyRects *stale = render->swap_stale[back];
+    for (u32 i = 0; i < stale->rects_num; ++i)
+    {
+        const RenderRect *rect = &stale->rects[i];
+        size_t offset = (size_t)pitch * (u32)rect->y0 + (u32)rect->x0 * sizeof(u32);
+        u8 *src = (u8 *)render->swap_memory[published] + offset;
+        u8 *dst = (u8 *)render->swap_memory[back] + offset;
+        size_t size = (u32)(rect->x1 - rect->x0) * sizeof(u32);
+        for (s32 y = rect->y0; y < rect->y1; ++y)
+        {
+            memcpy(dst, src, size);
+            src += pitch;
+            dst += pitch;
+        }
+    }
+    DirtyRects_Clear(stale);
+    buffer->bitmap_memory = render->swap_memory[back];
 }
 
-void
-Render_DrawLine(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, const Color *color)
+static b32
+ClipRect(Render *render, s64 x0, s64 y0, s64 x1, s64 y1, RenderRect *rect)
 {
-    /* TODO: add posibility to draw a line with the desired width. */
-    Vec2 v0;  /* Vector for the beginning point. */
-    v0.x = x0;
-    v0.y = y0;
+    RenderRect *clip = &render->clip;
+    if (x0 < clip->x0) x0 = clip->x0;
+    if (y0 < clip->y0) y0 = clip->y0;
+    if (x1 > clip->x1) x1 = clip->x1;
+    if (y1 > clip->y1) y1 = clip->y1;
+    if ((x0 >= x1) || (y0 >= y1)) return false;
 
-    Vec2 v1;  /* Vector for the ending point. */
-    v1.x = x1;
-    v1.y = y1;
+    rect->x0 = (s32)x0;
+    rect->y0 = (s32)y0;
+    rect->x1 = (s32)x1;
+    rect->y1 = (s32)y1;
+    return true;
+}
 
-    u32 *LSX_array = render->triangle_data->LSX_array;
-    u32 *pLSX_i = &(render->triangle_data->LSX_i);
-    DrawLineExtended(render, v0, v1, color, LSX_array, pLSX_i);
+static b32
+ClipRectF(Render *render, f32 x0, f32 y0, f32 x1, f32 y1, RenderRect *rect)
+{
+    /* Far away coordinates are clamped before the conversion to integers. */
+    const f32 limit = TRIANGLE_RASTER_GUARD_BAND;
+    x0 = fminf(fmaxf(floorf(x0), -limit), limit);
+    y0 = fminf(fmaxf(floorf(y0), -limit), limit);
+    x1 = fminf(fmaxf(ceilf(x1), -limit), limit);
+    y1 = fminf(fmaxf(ceilf(y1), -limit), limit);
+    return ClipRect(render, (s64)x0, (s64)y0, (s64)x1, (s64)y1, rect);
 }
 
-void
-Render_DrawHorLine(Render *render, u32 x0, u32 y0, u32 length, u32 width, const Color *color)
+static b32
+ClipLineByGuardBand(Vec2 *v0, Vec2 *v1)
 {
-    u32 *pixel = (u32*)render->buffer->bitmap_memory;
-    for (u32 x = x0; x < (x0 + length); ++x)
+    const f32 limit = TRIANGLE_RASTER_GUARD_BAND;
+    if (!isfinite(v0->x) || !isfinite(v0->y) || !isfinite(v1->x) || !isfinite(v1->y))
+    {
+        return false;
+    }
+
+    /* Usual lines are left untouched to keep their pixels. */
+    if ((fabsf(v0->x) <= limit) && (fabsf(v0->y) <= limit) &&
+        (fabsf(v1->x) <= limit) && (fabsf(v1->y) <= limit))
     {
-        for (u32 y = y0; y < (y0 + width); ++y)
+        return true;
+    }
+
+    /* Parameters of the segment v0 + t * (v1 - v0) entering and leaving the band. */
+    f32 dx = v1->x - v0->x;
+    f32 dy = v1->y - v0->y;
+    f32 p[4] = {-dx, dx, -dy, dy};
+    f32 q[4] = {v0->x + limit, limit - v0->x, v0->y + limit, limit - v0->y};
+    f32 t_enter = 0.0f;
+    f32 t_leave = 1.0f;
+    for (u32 i = 0; i < 4; ++i)
+    {
+        if (p[i] == 0.0f)
+        {
+            if (q[i] < 0.0f) return false;  /* Parallel to the side and outside. */
+            continue;
+        }
+        f32 t = q[i] / p[i];
+        if (p[i] < 0.0f)
+        {
+            if (t > t_enter) t_enter = t;
+        }
+        else
         {
-            *(pixel + x + render->buffer->width * y) = color->color;
+            if (t < t_leave) t_leave = t;
         }
     }
+    if (t_enter > t_leave) return false;
+
+    Vec2 begin = *v0;
+    v0->x = begin.x + t_enter * dx;
+    v0->y = begin.y + t_enter * dy;
+    v1->x = begin.x + t_leave * dx;
+    v1->y = begin.y + t_leave * dy;
+    return true;
 }
 
-void
-Render_DrawVerLine(Render *render, u32 x0, u32 y0, u32 length, u32 width, const Color *color)
-{   
-    u32 *pixel = (u32*)render->buffer->bitmap_memory;
-    for (u32 y = y0; y < (y0 + length); ++y)
+static b32
+ClipLineSteps(s64 start, s32 inc, s32 delta, s32 d, s64 lo, s64 hi, s64 *step_begin,
+    s64 *step_end)
+{
+    /* The coordinate does not change along the line. */
+    if (inc == 0) return (start >= lo) && (start <= hi);
+
+    /* Allowed range of the amount of moves k of the coordinate. */
+    s64 k_min = (inc > 0) ? lo - start : start - hi;
+    s64 k_max = (inc > 0) ? hi - start : start - lo;
+    if (k_max < 0) return false;
+
+    /* k(n) >= k_min is equivalent to n * delta >= k_min * d + 1. */
+    if (k_min > 0)
     {
-        for (u32 x = x0; x < (x0 + width); ++x)
-        {
-            *(pixel + x + render->buffer->width * y) = color->color;
-        }
+        s64 n = (k_min * d + delta) / delta;
+        if (n > *step_begin) *step_begin = n;
+    }
+
+    /* k(n) <= k_max is equivalent to n * delta <= (k_max + 1) * d. */
+    s64 n = (k_max + 1) * d / delta;
+    if (n < *step_end) *step_end = n;
+    return *step_begin <= *step_end;
+}
+
+static void
+PlotPixel(Render *render, s32 x, s32 y, u32 color)
+{
+    RenderRect *clip = &render->clip;
+    if ((x < clip->x0) || (x >= clip->x1) || (y < clip->y0) || (y >= clip->y1)) return;
+    u32 *pixel = GetPixelAddress(render->buffer, (u32)x, (u32)y);
+    *pixel = color;
+    RENDER_STATS_COUNT_ROW(pixel, 1);
+}
+
+static void
+FillRect(Render *render, s64 x0, s64 y0, s64 x1, s64 y1, u32 color, BlendMode blend)
+{
+    RenderRect rect;
+    if (!ClipRect(render, x0, y0, x1, y1, &rect)) return;
+
+    RenderBuffer *buffer = render->buffer;
+    u32 width = (u32)(rect.x1 - rect.x0);
+    if (blend == BM_NONE)
+    {
+        SpanFill_Rect(GetPixelAddress(buffer, (u32)rect.x0, (u32)rect.y0), GetPitch(buffer),
+            width, (u32)(rect.y1 - rect.y0), color);
+        return;
+    }
+
+    /* Blended rectangles are drawn row by row. */
+    u32 premultiplied = Blend_Premultiply(color);
+    for (s32 y = rect.y0; y < rect.y1; ++y)
+    {
+        Blend_RowColor(GetPixelAddress(buffer, (u32)rect.x0, (u32)y), width, premultiplied,
+            blend);
     }
 }
 
 static void
-DrawLineExtended(Render *render, Vec2 v0, Vec2 v1, const Color *color, u32 *SX_array, 
-    u32 *SX_i)
+DrawLine(Render *render, Vec2 v0, Vec2 v1, u32 color)
 {
     /* TODO: Изменить алгоритм так, чтобы он рисовал линии только в 1 или 4-й четверти
     т.е линия нарисованная с одной точки до друго будет одинаковая. Если линия рисуется не
@@ -275,14 +2864,31 @@ DrawLineExtended(Render *render, Vec2 v0, Vec2 v1, const Color *color, u32 *SX_a
     else
         d = dy;  /* Line is closer to Oy axis. */
         
+    /* Clip the line. Only the steps with the pixels inside of the clip rectangle are
+    traversed, the visible pixels are the same as for the unclipped line. */
+    s64 x_start = (s32)v0.x;
+    s64 y_start = (s32)v0.y;
+    s64 step_begin = 1;
+    s64 step_end = (s64)d + 1;
+    RenderRect *clip = &render->clip;
+    if (!ClipLineSteps(x_start, inc_x, dx, d, clip->x0, clip->x1 - 1, &step_begin, &step_end) ||
+        !ClipLineSteps(y_start, inc_y, dy, d, clip->y0, clip->y1 - 1, &step_begin, &step_end))
+    {
+        return;
+    }
+
+    /* Restore the state of the algorithm after the skipped steps. */
+    s64 x_sum = (step_begin - 1) * dx;
+    s64 y_sum = (step_begin - 1) * dy;
+    s64 x_moves = (x_sum > 0) ? (x_sum - 1) / d : 0;
+    s64 y_moves = (y_sum > 0) ? (y_sum - 1) / d : 0;
+
     /* Render the line. */
-    u32 *pixel = (u32*)render->buffer->bitmap_memory;
-    s32 x = (s32)v0.x; 
-    s32 y = (s32)v0.y; 
-    s32 x_err = 0;
-    s32 y_err = 0;
-    *SX_i = 0;
-    for (s32 i = 0; i <= d; ++i)
+    s32 x = (s32)(x_start + inc_x * x_moves);
+    s32 y = (s32)(y_start + inc_y * y_moves);
+    s32 x_err = (s32)(x_sum - x_moves * d);
+    s32 y_err = (s32)(y_sum - y_moves * d);
+    for (s64 i = step_begin; i <= step_end; ++i)
     {          
         x_err += dx;
         y_err += dy;
@@ -297,193 +2903,89 @@ DrawLineExtended(Render *render, Vec2 v0, Vec2 v1, const Color *color, u32 *SX_a
         { 
             y_err -= d; 
             y += inc_y;
-            SX_array[*SX_i] = x; /* Record x when y has changed. */
-            (*SX_i)++;
         }
-        *(pixel + x + render->buffer->width * y) = color->color;
+        u32 *pixel = GetPixelAddress(render->buffer, (u32)x, (u32)y);
+        *pixel = color;
+        RENDER_STATS_COUNT_ROW(pixel, 1);
     }
-    (*SX_i)--;
 }
 
-void
-Render_DrawRect(Render *render, u32 x0, u32 y0, u32 width, u32 height, const Color *color)
+static void
+DrawPolyline(Render *render, const RenderCmd *cmd)
 {
-    u32 *pixel = (u32*)render->buffer->bitmap_memory;
-    for(u32 y = y0; y < height + y0; y++)
+    RenderBuffer *buffer = render->buffer;
+    const Vec2 *points = cmd->polyline.points;
+    u32 points_num = cmd->polyline.points_num;
+    f32 width = cmd->polyline.width;
+    if (points_num < 2) return;
+    if (!(width > 1.0f))
     {
-        for (u32 x = x0; x < width + x0; x++)
+        if (cmd->polyline.is_anti_aliased)
         {
-            *(pixel + x + render->buffer->width * y) = color->color;
+            LineRaster_DrawPolylineAA(buffer->bitmap_memory, GetPitch(buffer),
+                &render->clip, points, points_num, cmd->color, cmd->blend);
+            return;
         }
-    }
-}
-
-void
-Render_DrawRectWithBrd(Render *render, u32 x0, u32 y0, u32 width, u32 height, 
-    u32 brd_width, const Color *color, const Color *brd_color)
-{
-    /* Draw the inner rectangle. */
-    Render_DrawRect(render, x0 + brd_width, y0 + brd_width, width - brd_width * 2, 
-        height - brd_width * 2, color);
-
-    /* Draw the boarders with desired width and color. */
-    if (brd_width)
-    {
-        Render_DrawRect(render, x0, y0, width, brd_width, brd_color);
-        Render_DrawRect(render, x0, y0 + height - brd_width, width, brd_width, brd_color);
-        Render_DrawRect(render, x0, y0, brd_width, height, brd_color);
-        Render_DrawRect(render, x0 + width -brd_width, y0, brd_width, height, brd_color);
-    }
-}
-
-static void 
-DrawFillSideFlatTriangle(Render *render, Vec2 v1, Vec2 v2, Vec2 v3, FlatSideFlag side_flag, 
-    const Color *color)
-{
-    /* Draw the side lines of the triangle. */
-    u32 *LSX_array = render->triangle_data->LSX_array;
-    u32 *RSX_array = render->triangle_data->RSX_array;
-    u32 *pLSX_i = &(render->triangle_data->LSX_i);
-    u32 *pRSX_i = &(render->triangle_data->RSX_i); 
-    DrawLineExtended(render, v1, v2, color, LSX_array, pLSX_i);
-    DrawLineExtended(render, v1, v3, color, RSX_array, pRSX_i);
-
-    /* Determine value for the delta varuable. */
-    u32 delta = (side_flag == SF_BOTTOM_FLAT) ? -1: 1;
-
-    /* Fill the rectangle with horisontal lines. */
-    u32 y = (u32)(v1.y + delta);  /* Start from the 1 line lower/upper then top/bottom  point. */
-    for (u32 i = 0; i <= *pLSX_i; ++i)
-    {
-        u32 length = RSX_array[i] - LSX_array[i];
-        Render_DrawHorLine(render, LSX_array[i], y, length, 1, color);
-        y += delta;
-    }
-}
-
-void 
-Render_DrawFillTriangle(Render *render, Vec2 v1, Vec2 v2, Vec2 v3, const Color *color)
-{   
-    /* Sort the three vertices by y-coordinate so that v1 is the topmost vertix,
-    v2 is the middle vertix and v3 is bottommost vertix (bubble sort). */
-    if (v1.y < v2.y) Math_SwapVec2(&v1, &v2);
-    if (v2.y < v3.y) Math_SwapVec2(&v2, &v3);
-    if (v1.y < v2.y) Math_SwapVec2(&v1, &v2);
-
-    /* Check for different triangle shapes to draw. */
-    /* Case 1. Simple point. */
-    if ((v1.y == v2.y) && (v2.y  == v3.y) && (v1.x == v2.x) && (v2.x == v3.x))
-    {
-        Render_SetPixelColor(render, (u32)v1.x, (u32)v1.y, color);
-    }
 
-    /* Case 2. Horisontal or vertical line. */
-    else if (((v1.y == v2.y) && (v2.y  == v3.y)) || ((v1.x == v2.x) && (v2.x == v3.x)))
-    {
-        Render_DrawLine(render, v1.x, v1.y, v2.x, v2.y, color);
-        Render_DrawLine(render, v2.x, v2.y, v3.x, v3.y, color);       
+        /* Pixelized lines are not blended, so their joints are just set twice. */
+        for (u32 i = 1; i < points_num; ++i)
+        {
+            Vec2 v0 = points[i - 1];
+            Vec2 v1 = points[i];
+            if (ClipLineByGuardBand(&v0, &v1)) DrawLine(render, v0, v1, cmd->color);
+        }
+        return;
     }
 
-    /* Case 3. Bottom-flat triangle. */
-    else if (v2.y == v3.y)
-    {
-        (v2.x < v3.x) ?
-            /* v1 - top vertex, v2 - left vertex, v3 - right vertex. */
-            DrawFillSideFlatTriangle(render, v1, v2, v3, SF_BOTTOM_FLAT, color):
-            /* v1 - top vertex, v3 - left vertex, v2 - right vertex. */
-            DrawFillSideFlatTriangle(render, v1, v3, v2, SF_BOTTOM_FLAT, color);    
-    }
+    /* Segments are the quads, the gap on the outer side of a turn is closed by a bevel
+    (the triangle with a repeated vertex). The contours are filled together by the
+    nonzero rule, so their overlaps are written once. */
+    Vec2 stack_contours[RENDER_POLYLINE_STACK_CONTOURS * 4];
+    Vec2 *contours = stack_contours;
+    size_t contours_max = 2 * (size_t)(points_num - 1);
+    if (contours_max > RENDER_POLYLINE_STACK_CONTOURS)
+        contours = (Vec2 *)HelperFcn_MemAllocate(contours_max * 4 * sizeof(Vec2));
 
-    /* Case 4. Top-flat triangle. */
-    else if (v1.y == v2.y)
+    u32 contours_num = 0;
+    for (u32 i = 1; i < points_num; ++i)
     {
-        (v1.x < v2.x) ?
-            /* v3 - bottom vertex, v1 - left vertex, v2 - right vertex. */
-            DrawFillSideFlatTriangle(render, v3, v1, v2, SF_TOP_FLAT, color):
-            /* v3 - bottom vertex, v2 - left vertex, v1 - right vertex. */
-            DrawFillSideFlatTriangle(render, v3, v2, v1, SF_TOP_FLAT, color);
-    }
+        Vec2 quad[4];
+        if (!GetThickLineQuad(points[i - 1], points[i], width, quad)) continue;
+        if (PutPolylineContour(&contours[contours_num * 4], quad)) contours_num++;
 
-    /* Case 5. General case, split the triangle in a top-flat and bottom-flat. */
-    else
-    {
-        f32 temp = (v3.x - v1.x) * (v1.y - v2.y) / (v1.y - v3.y);
-        Vec2 v4;
-        v4.x = roundf(temp + v1.x);
-        v4.y = v2.y;
-
-        /* Draw top triangle which is bottom-flat triangle. */
-        (v2.x < v4.x) ? 
-            /* v1 - top vertex, v2 - left vertex, v3 - right vertex. */
-            DrawFillSideFlatTriangle(render, v1, v2, v4, SF_BOTTOM_FLAT, color):
-            /* v1 - top vertex, v4 - left vertex, v2 - right vertex. */
-            DrawFillSideFlatTriangle(render, v1, v4, v2, SF_BOTTOM_FLAT, color);
-        
-        /* Draw bottom triangle which is top-flat triangle. */
-        (v2.x < v4.x) ?
-            /* v3 - bottom vertex, v2 - left vertex, v4 - right vertex. */
-            DrawFillSideFlatTriangle(render, v3, v2, v4, SF_TOP_FLAT, color):
-            /* v3 - bottom vertex, v4 - left vertex, v2 - right vertex. */
-            DrawFillSideFlatTriangle(render, v3, v4, v2, SF_TOP_FLAT, color);
+        Vec2 next_quad[4];
+        if ((i + 1 == points_num) ||
+            !GetThickLineQuad(points[i], points[i + 1], width, next_quad))
+        {
+            continue;
+        }
+        f32 cross = (points[i].x - points[i - 1].x) * (points[i + 1].y - points[i].y) -
+            (points[i].y - points[i - 1].y) * (points[i + 1].x - points[i].x);
+        if (cross == 0.0f) continue;
+        Vec2 bevel[4];
+        bevel[0] = points[i];
+        bevel[1] = (cross > 0.0f) ? quad[2] : quad[1];
+        bevel[2] = (cross > 0.0f) ? next_quad[3] : next_quad[0];
+        bevel[3] = points[i];
+        if (PutPolylineContour(&contours[contours_num * 4], bevel)) contours_num++;
     }
 
-    /* Clean-up. Draw additional lines to to each vertices. */
-    /* NOTE: This could be deleted later. */
-    Render_DrawLine(render, v1.x, v1.y, v2.x, v2.y, color);
-    Render_DrawLine(render, v2.x, v2.y, v1.x, v1.y, color);
-
-    Render_DrawLine(render, v2.x, v2.y, v3.x, v3.y, color);
-    Render_DrawLine(render, v3.x, v3.y, v2.x, v2.y, color);
-
-    Render_DrawLine(render, v1.x, v1.y, v3.x, v3.y, color);
-    Render_DrawLine(render, v3.x, v3.y, v1.x, v1.y, color);  
+    PolygonRaster_FillContours(buffer->bitmap_memory, GetPitch(buffer), &render->clip,
+        contours, contours_num, 4, PFR_NON_ZERO, cmd->color, cmd->blend);
+    if (contours != stack_contours) HelperFcn_MemFree(contours);
 }
 
-void 
-Render_DrawRotatedRect(Render *render, f32 x0, f32 y0, f32 width, f32 height, f32 angle, 
-    const Color *color)
+static void
+DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled, u32 color,
+    BlendMode blend)
 {       
-    /* Initialize the points with the data. */
-    Vec2 BL, BR, UL, UR; /* Initial points of the rectangle. */
-    BL.x = x0; BL.y = y0;
-    BR.x = x0 + width; BR.y = y0;
-    UL.x = x0; UL.y = y0 + height;
-    UR.x = x0 + width; UR.y = y0 + height;
-    
-    /* Transform degrees to radians. */
-    f32 angle_rad = angle * (f32)M_PI / 180.0f;
-
-    /* Determine the center point of the rectangle. */
-    f32 xc = x0 + width / 2.0f;
-    f32 yc = y0 + height / 2.0f;
-
-    /* Determine new points coordinates (with recpect to the rect center). */
-    Vec2 BL_c, BR_c, UL_c, UR_c; /* Coordinates with respect to the rect center. */
-    BL_c.x = BL.x - roundf(xc); BL_c.y = BL.y - roundf(yc);
-    BR_c.x = BR.x - roundf(xc); BR_c.y = BR.y - roundf(yc);
-    UL_c.x = UL.x - roundf(xc); UL_c.y = UL.y - roundf(yc);
-    UR_c.x = UR.x - roundf(xc); UR_c.y = UR.y - roundf(yc);
-
-    /* Transform the points by rotation. */
-    Vec2 BL_tr, BR_tr, UL_tr, UR_tr; /* Points after rotation transformation. */
-    BL_tr.x = roundf(xc + (BL_c.x * cosf(angle_rad) - BL_c.y * sinf(angle_rad)));
-    BL_tr.y = roundf(yc + (BL_c.x * sinf(angle_rad) + BL_c.y * cosf(angle_rad)));
-    BR_tr.x = roundf(xc + (BR_c.x * cosf(angle_rad) - BR_c.y * sinf(angle_rad)));
-    BR_tr.y = roundf(yc + (BR_c.x * sinf(angle_rad) + BR_c.y * cosf(angle_rad)));
-    UL_tr.x = roundf(xc + (UL_c.x * cosf(angle_rad) - UL_c.y * sinf(angle_rad)));
-    UL_tr.y = roundf(yc + (UL_c.x * sinf(angle_rad) + UL_c.y * cosf(angle_rad)));
-    UR_tr.x = roundf(xc + (UR_c.x * cosf(angle_rad) - UR_c.y * sinf(angle_rad)));
-    UR_tr.y = roundf(yc + (UR_c.x * sinf(angle_rad) + UR_c.y * cosf(angle_rad)));
-
-    /* Draw the rectangle (by drawing two triangles). */
-    Render_DrawFillTriangle(render, BL_tr, BR_tr, UR_tr, color);
-    Render_DrawFillTriangle(render, BL_tr, UL_tr, UR_tr, color);        
-}
+    /* The points of the circle are traversed one by one, so huge circles are skipped. */
+    const f32 limit = TRIANGLE_RASTER_GUARD_BAND;
+    if (!(fabsf(x0) <= limit) || !(fabsf(y0) <= limit) || !(fabsf(radius) <= limit)) return;
 
-void
-Render_DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled, 
-    const Color *color)
-{
+    s32 xc = (s32)x0;
+    s32 yc = (s32)y0;
+    
     s32 x = 0;
     s32 y = (s32)radius;
     s32 delta = (2 - 2 * (s32)radius);
@@ -491,16 +2993,12 @@ Render_DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled,
     while (y >= 0)
     {
         /* Draw points lying on a circle */
-        Render_SetPixelColor(render, (u32)x0 + (u32)x, (u32)y0 + (u32)y, color);
-        Render_SetPixelColor(render, (u32)x0 + (u32)x, (u32)y0 - (u32)y, color);
-        Render_SetPixelColor(render, (u32)x0 - (u32)x, (u32)y0 - (u32)y, color);
-        Render_SetPixelColor(render, (u32)x0 - (u32)x, (u32)y0 + (u32)y, color);
-
-        /* Fill the circle if it is necessary (with lines from top to bottom)*/
-        if (is_filled)
+        if (!is_filled)
         {    
-            Render_DrawLine(render, x0 + (f32)x, y0 + (f32)y, x0 + (f32)x, y0 - (f32)y,  color);
-            Render_DrawLine(render, x0 - (f32)x, y0 + (f32)y, x0 - (f32)x, y0 - (f32)y,  color);
+            PlotPixel(render, xc + x, yc + y, color);
+            PlotPixel(render, xc + x, yc - y, color);
+            PlotPixel(render, xc - x, yc - y, color);
+            PlotPixel(render, xc - x, yc + y, color);
         }
 
         s32 gap = 2 * (delta + y) - 1;
@@ -511,6 +3009,19 @@ Render_DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled,
             continue;
         }
 
+        /* Fill the circle if it is necessary. The rows +-y are complete when the next
+        point goes below them, so each of them is filled by a single span. */
+        if (is_filled)
+        {
+            FillRect(render, (s64)xc - x, (s64)yc + y, (s64)xc + x + 1, (s64)yc + y + 1,
+                color, blend);
+            if (y != 0)
+            {
+                FillRect(render, (s64)xc - x, (s64)yc - y, (s64)xc + x + 1,
+                    (s64)yc - y + 1, color, blend);
+            }
+        }
+
         if ((delta > 0) && (gap > 0))
         {
             y--;
@@ -525,53 +3036,183 @@ Render_DrawCircle(Render *render, f32 x0, f32 y0, f32 radius, b32 is_filled,
 }
 
 static void
-DrawBitmapExtended(Render *render, u32 x, u32 y, const Image* image, u32 scale, b32 is_mask, 
-    const Color *mask_color)
+DrawBitmapExtended(Render *render, u32 x, u32 y, const ImageRegion *region, u32 scale,
+    b32 is_mask, u32 mask_color, BlendMode blend)
 {
-    u32 *pixel = (u32*)render->buffer->bitmap_memory;
-    u32 index = 0;
+    /* Only the visible part of the scaled region is traversed. */
+    s64 x0 = (s32)x;
+    s64 y0 = (s32)y;
+    RenderRect rect;
+    if (!ClipRect(render, x0, y0, x0 + (s64)region->width * scale,
+        y0 + (s64)region->height * scale, &rect))
+    {
+        return;
+    }
+    u32 region_x0 = region->x;
+    u32 region_x1 = region->x + region->width;
     
-    for (u32 i = 0; i < image->height; ++i)
+    /* Without the blending the mask color is applied as an opaque one. */
+    u32 tint = (blend == BM_NONE) ? (mask_color | 0xff000000) : Blend_Premultiply(mask_color);
+
+    const Sprite *sprite = region->image->sprite;
+    RenderBuffer *buffer = render->buffer;
+    u32 pitch = GetPitch(buffer);
+    u32 expanded[256];  /* Part of the scaled span. */
+
+    for (s32 y_scaled = rect.y0; y_scaled < rect.y1; ++y_scaled)
     {
-        for (u32 j = 0; j < image->width; ++j)
+        /* Rows of the same image row are identical, unless they are blended. */
+        u32 i = (u32)((y_scaled - y0) / scale);
+        b32 is_repeated = (y_scaled > rect.y0) && ((u32)((y_scaled - 1 - y0) / scale) == i);
+        u32 *row = GetPixelAddress(buffer, 0, (u32)y_scaled);
+
+        /* Spans to the left of the region are skipped by the binary search. */
+        u32 first = sprite->row_spans[region->y + i];
+        u32 last = sprite->row_spans[region->y + i + 1];
+        while ((region_x0 > 0) && (first < last))
+        {
+            u32 middle = first + (last - first) / 2;
+            const SpriteSpan *middle_span = sprite->spans + middle;
+            if (middle_span->x + middle_span->length <= region_x0)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+
+        const SpriteSpan *span = sprite->spans + first;
+        const SpriteSpan *spans_end = sprite->spans + sprite->row_spans[region->y + i + 1];
+        for (; span < spans_end; ++span)
         {
-            /* Get the color of the pixel. */
-            Color color;
-            Color_SetFromImageColorData(&color, *(image->data + index));
+            /* Part of the span inside of the region. */
+            if (span->x >= region_x1) break;
+            u32 column_x0 = (span->x > region_x0) ? span->x : region_x0;
+            u32 column_x1 = (span->x + span->length < region_x1) ?
+                (span->x + span->length) : region_x1;
+
+            /* Visible part of the scaled span. */
+            s64 span_x0 = x0 + (s64)(column_x0 - region_x0) * scale;
+            s64 span_x1 = x0 + (s64)(column_x1 - region_x0) * scale;
+            if (span_x0 >= rect.x1) break;
+            s64 x_begin = (span_x0 > rect.x0) ? span_x0 : rect.x0;
+            s64 x_end = (span_x1 < rect.x1) ? span_x1 : rect.x1;
+            if (x_begin >= x_end) continue;
+
+            u32 *dst = row + x_begin;
+            u32 count = (u32)(x_end - x_begin);
+            const u32 *src = sprite->pixels + span->offset + (column_x0 - span->x) +
+                (x_begin - span_x0) / scale;
+
+            /* Spans replacing the destination are copied from the previous row. */
+            b32 is_replaced = span->is_opaque && (is_mask ? (blend == BM_NONE) :
+                ((blend == BM_NONE) || (blend == BM_ALPHA)));
+            if (is_repeated && is_replaced)
+            {
+                memcpy(dst, (u8 *)dst - pitch, count * sizeof(u32));
+                RENDER_STATS_COUNT_ROW(dst, count);
+                continue;
+            }
+
+            if (scale == 1)
+            {
+                DrawSpriteSpan(dst, src, count, span->is_opaque, is_mask, mask_color, tint,
+                    blend);
+                continue;
+            }
 
-            /* Check the alpha channel. */
-            if (color.alpha != 0x00)
+            /* Every pixel of the span is repeated scale times. */
+            u32 m = (u32)((x_begin - span_x0) % scale);
+            while (count > 0)
             {
-                /* Use color from loaded bitmap or from the mask color. */
-                if (is_mask) color.color = mask_color->color;
-                
-                /* Draw scaled pixel */
-                for (u32 n = 0; n < scale; ++n)
+                u32 chunk = (count < 256) ? count : 256;
+                for (u32 n = 0; n < chunk; ++n)
                 {
-                    for (u32 m = 0; m < scale; ++m)
+                    expanded[n] = *src;
+                    if (++m == scale)
                     {
-                        u32 x_scaled = x + j * scale + m;
-                        u32 y_scaled = y + i * scale + n;
-                        *(pixel + x_scaled + render->buffer->width * y_scaled) = color.color;                    
-                    }        
+                        m = 0;
+                        src++;
+                    }
                 }
+                DrawSpriteSpan(dst, expanded, chunk, span->is_opaque, is_mask, mask_color,
+                    tint, blend);
+                dst += chunk;
+                count -= chunk;
             }
-            index++;
         }
     }
 }
 
-void
-Render_DrawBitmap(Render *render, u32 x, u32 y, Image *image, u32 scale)
+static void
+DrawSpriteSpan(u32 *dst, const u32 *src, u32 count, b32 is_opaque, b32 is_mask,
+    u32 mask_color, u32 tint, BlendMode blend)
 {
-    Color color;  /* Color to replace the mask (will not be used). */
-    color.color = 0xffffff;
-    DrawBitmapExtended(render, x, y, image, scale, false, &color);
+    if (is_mask)
+    {
+        /* Translucent pixels of the mask scale the alpha of the color. */
+        if (is_opaque && (blend == BM_NONE))
+            SpanFill_Row(dst, count, mask_color);
+        else if (is_opaque)
+            Blend_RowColor(dst, count, tint, blend);
+        else
+            Blend_RowTinted(dst, src, count, tint, blend);
+        return;
+    }
+
+    /* Opaque pixels replace the destination unless they are added or multiplied. */
+    if (is_opaque && ((blend == BM_NONE) || (blend == BM_ALPHA)))
+    {
+        memcpy(dst, src, count * sizeof(u32));
+        RENDER_STATS_COUNT_ROW(dst, count);
+        return;
+    }
+    Blend_Row(dst, src, count, (blend == BM_NONE) ? BM_ALPHA : blend);
 }
 
-void
-Render_DrawBitmapByMask(Render *render, u32 x, u32 y, const Image *mask, const Color *color,
-    u32 scale)
+static void
+DrawString(Render *render, const RenderCmd *cmd)
 {
-    DrawBitmapExtended(render, x, y, mask, scale, true, color);
+    /* Commands executed directly are not looked up by the submit. */
+    const TextRun *run = cmd->text.run;
+    if (run == NULL)
+    {
+        run = GlyphCache_GetRun(render->glyph_cache, cmd->text.font, cmd->text.str,
+            cmd->text.size, cmd->text.max_width);
+    }
+
+    s64 x = (s32)cmd->text.x;
+    s64 y = (s32)cmd->text.y;
+    const RenderRect *bounds = &run->bounds;
+    RenderRect rect;
+    if (!ClipRect(render, x + bounds->x0, y + bounds->y0, x + bounds->x1, y + bounds->y1,
+        &rect)) return;
+
+    /* Only the visible rows are walked, every row is a few spans. */
+    BlendMode blend = cmd->blend;
+    u32 color = (blend == BM_NONE) ? cmd->color : Blend_Premultiply(cmd->color);
+    for (s32 row_y = rect.y0; row_y < rect.y1; ++row_y)
+    {
+        u32 *row_memory = GetPixelAddress(render->buffer, 0, (u32)row_y);
+        u32 row = (u32)(row_y - (y + bounds->y0));
+        for (u32 i = run->row_spans[row]; i < run->row_spans[row + 1]; ++i)
+        {
+            s64 x0 = x + run->spans[i].x0;
+            s64 x1 = x + run->spans[i].x1;
+            if (x0 >= rect.x1) break;
+            if (x0 < rect.x0) x0 = rect.x0;
+            if (x1 > rect.x1) x1 = rect.x1;
+            if (x0 >= x1) continue;
+
+            if ((blend == BM_NONE) && (x1 - x0 <= GLYPH_CACHE_SHORT_SPAN))
+            {
+                /* Symbol spans are mostly a few pixels long, the kernel call costs more
+                than the stores. */
+                for (s64 px = x0; px < x1; ++px) row_memory[px] = color;
+                RENDER_STATS_COUNT_ROW(row_memory + x0, (u32)(x1 - x0));
+            }
+            else if (blend == BM_NONE)
+                SpanFill_Row(row_memory + x0, (u32)(x1 - x0), color);
+            else
+                Blend_RowColor(row_memory + x0, (u32)(x1 - x0), color, blend);
+        }
+    }
 }
@@ -0,0 +1,973 @@
+/**
+ * ================================================================================
+ * @file src_engine/render_cmd_buffer.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the work with the recorded render
+ * command buffer.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/render_cmd_buffer.h"
+
+#include <string.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/font.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/image.h"
+#include "include_engine/memory_object.h"
+#include "include_engine/pixel_format.h"
+#include "include_engine/polygon_raster.h"
+#include "include_engine/render.h"
+#include "include_engine/render_cmd.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Allocation of a packed command at the end of the arena.
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param cmd Pointer to the command (type, blend mode and color are used).
+ * @param data_size Size of the command data following the header in bytes.
+ * @return void* Pointer to the command data.
+ */
+static void*
+AllocCmd(RenderCmdBuffer *cmd_buffer, const RenderCmd *cmd, size_t data_size);
+
+/**
+ * @brief Getting the index of the image in the images table (adding it if necessary).
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param image Pointer to the image.
+ * @return u32 Index of the image.
+ */
+static u32
+GetImageIndex(RenderCmdBuffer *cmd_buffer, const Image *image);
+
+/**
+ * @brief Getting the index of the font in the fonts table (adding it if necessary).
+ * @param cmd_buffer Pointer to the RenderCmdBuffer structure.
+ * @param font Pointer to the font.
+ * @return u32 Index of the font.
+ */
+static u32
+GetFontIndex(RenderCmdBuffer *cmd_buffer, const Font *font);
+
+/**
+ * @brief Getting the minimal size of the packed data of a command type (the data of the
+ * fixed size, the arrays and strings following it are not counted).
+ * @param type Type of the command.
+ * @return u32 Size of the data in bytes.
+ */
+static u32
+GetMinDataSize(RenderCmdType type);
+
+/**
+ * @brief Copying the bytes to the cursor and moving the cursor forward.
+ * @param cursor Pointer to the write cursor.
+ * @param data Pointer to the bytes to copy.
+ * @param size Amount of bytes.
+ */
+static void
+WriteBytes(u8 **cursor, const void *data, size_t size);
+
+/**
+ * @brief Copying the bytes from the cursor and moving the cursor forward. The reading
+ * past the end of the serialized data is an error.
+ * @param cursor Pointer to the read cursor.
+ * @param end Pointer to the end of the serialized data.
+ * @param data Pointer to the destination.
+ * @param size Amount of bytes.
+ */
+static void
+ReadBytes(const u8 **cursor, const u8 *end, void *data, size_t size);
+
+RenderCmdBuffer*
+RenderCmdBuffer_Constructor(void)
+{
+    size_t size = sizeof(RenderCmdBuffer);
+    RenderCmdBuffer *cmd_buffer = (RenderCmdBuffer *)HelperFcn_MemAllocate(size);
+    return cmd_buffer;
+}
+
+RenderCmdBuffer*
+RenderCmdBuffer_Destructor(RenderCmdBuffer *cmd_buffer)
+{
+    if (cmd_buffer->is_owner)
+    {
+        for (u32 i = 0; i < cmd_buffer->images_num; ++i)
+        {
+            Image_Destructor((Image *)cmd_buffer->images[i]);
+        }
+        for (u32 i = 0; i < cmd_buffer->fonts_num; ++i)
+        {
+            Font_Destructor((Font *)cmd_buffer->fonts[i]);
+        }
+    }
+    if (cmd_buffer->data) HelperFcn_MemFree(cmd_buffer->data);
+    if (cmd_buffer->images) HelperFcn_MemFree((void *)cmd_buffer->images);
+    if (cmd_buffer->fonts) HelperFcn_MemFree((void *)cmd_buffer->fonts);
+    HelperFcn_MemFree(cmd_buffer);
+    return NULL;
+}
+
+void
+RenderCmdBuffer_Init(RenderCmdBuffer *cmd_buffer, u32 capacity)
+{
+    if (capacity < 256) capacity = 256;
+    cmd_buffer->data = (u8 *)HelperFcn_MemAllocate(capacity);
+    cmd_buffer->capacity = capacity;
+    cmd_buffer->size = 0;
+    cmd_buffer->cmds_num = 0;
+}
+
+void
+RenderCmdBuffer_Reset(RenderCmdBuffer *cmd_buffer)
+{
+    /* Loaded resources are kept, since they belong to the buffer. */
+    dbg_check(!cmd_buffer->is_owner, "%s", "Loaded command buffer could not be reset!");
+    cmd_buffer->size = 0;
+    cmd_buffer->cmds_num = 0;
+    cmd_buffer->images_num = 0;
+    cmd_buffer->fonts_num = 0;
+}
+
+void
+RenderCmdBuffer_PushCmd(RenderCmdBuffer *cmd_buffer, const RenderCmd *cmd)
+{
+    switch (cmd->type)
+    {
+    case RCT_CLEAR:
+    {
+        AllocCmd(cmd_buffer, cmd, 0);
+    } break;
+
+    case RCT_PIXEL:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->pixel));
+        memcpy(data, &cmd->pixel, sizeof(cmd->pixel));
+    } break;
+
+    case RCT_LINE:
+    case RCT_LINE_AA:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->line));
+        memcpy(data, &cmd->line, sizeof(cmd->line));
+    } break;
+
+    case RCT_RECT:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->rect));
+        memcpy(data, &cmd->rect, sizeof(cmd->rect));
+    } break;
+
+    case RCT_TRIANGLE:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->triangle));
+        memcpy(data, &cmd->triangle, sizeof(cmd->triangle));
+    } break;
+
+    case RCT_CIRCLE:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->circle));
+        memcpy(data, &cmd->circle, sizeof(cmd->circle));
+    } break;
+
+    case RCT_ELLIPSE:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->ellipse));
+        memcpy(data, &cmd->ellipse, sizeof(cmd->ellipse));
+    } break;
+
+    case RCT_LAYER:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->layer));
+        memcpy(data, &cmd->layer, sizeof(cmd->layer));
+    } break;
+
+    case RCT_STATS:
+    {
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(cmd->stats));
+        memcpy(data, &cmd->stats, sizeof(cmd->stats));
+    } break;
+
+    case RCT_BITMAP:
+    case RCT_BITMAP_MASK:
+    {
+        RenderCmdBitmapData bitmap;
+        bitmap.x = cmd->bitmap.x;
+        bitmap.y = cmd->bitmap.y;
+        bitmap.scale = cmd->bitmap.scale;
+        bitmap.src_x = cmd->bitmap.src_x;
+        bitmap.src_y = cmd->bitmap.src_y;
+        bitmap.width = cmd->bitmap.width;
+        bitmap.height = cmd->bitmap.height;
+        bitmap.image_index = GetImageIndex(cmd_buffer, cmd->bitmap.image);
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(bitmap));
+        memcpy(data, &bitmap, sizeof(bitmap));
+    } break;
+
+    case RCT_BITMAP_SCALED:
+    {
+        RenderCmdScaledData scaled;
+        scaled.x = cmd->scaled.x;
+        scaled.y = cmd->scaled.y;
+        scaled.scale_x = cmd->scaled.scale_x;
+        scaled.scale_y = cmd->scaled.scale_y;
+        scaled.src_x = cmd->scaled.src_x;
+        scaled.src_y = cmd->scaled.src_y;
+        scaled.width = cmd->scaled.width;
+        scaled.height = cmd->scaled.height;
+        scaled.filter = (u32)cmd->scaled.filter;
+        scaled.image_index = GetImageIndex(cmd_buffer, cmd->scaled.image);
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(scaled));
+        memcpy(data, &scaled, sizeof(scaled));
+    } break;
+
+    case RCT_TEXTURE:
+    {
+        RenderCmdTextureData texture;
+        memcpy(texture.vertices, cmd->texture.vertices, sizeof(texture.vertices));
+        memcpy(texture.uvs, cmd->texture.uvs, sizeof(texture.uvs));
+        texture.is_quad = cmd->texture.is_quad ? 1 : 0;
+        texture.filter = (u32)cmd->texture.filter;
+        texture.image_index = GetImageIndex(cmd_buffer, cmd->texture.image);
+        void *data = AllocCmd(cmd_buffer, cmd, sizeof(texture));
+        memcpy(data, &texture, sizeof(texture));
+    } break;
+
+    case RCT_POLYGON:
+    {
+        RenderCmdPolygonData polygon;
+        polygon.rule = (u32)cmd->polygon.rule;
+        polygon.vertices_num = cmd->polygon.vertices_num;
+
+        /* The vertices are copied right after the data. */
+        size_t vertices_size = (size_t)polygon.vertices_num * sizeof(Vec2);
+        u8 *data = (u8 *)AllocCmd(cmd_buffer, cmd, sizeof(polygon) + vertices_size);
+        memcpy(data, &polygon, sizeof(polygon));
+        memcpy(data + sizeof(polygon), cmd->polygon.vertices, vertices_size);
+    } break;
+
+    case RCT_POLYLINE:
+    {
+        RenderCmdPolylineData polyline;
+        polyline.width = cmd->polyline.width;
+        polyline.is_anti_aliased = cmd->polyline.is_anti_aliased ? 1 : 0;
+        polyline.points_num = cmd->polyline.points_num;
+
+        /* The points are copied right after the data. */
+        size_t points_size = (size_t)polyline.points_num * sizeof(Vec2);
+        u8 *data = (u8 *)AllocCmd(cmd_buffer, cmd, sizeof(polyline) + points_size);
+        memcpy(data, &polyline, sizeof(polyline));
+        memcpy(data + sizeof(polyline), cmd->polyline.points, points_size);
+    } break;
+
+    case RCT_RECTS:
+    {
+        /* Large batches are split into the parts of up to 64 KB. */
+        u32 part_max = (u32)((0xfffc - sizeof(RenderCmdHeader) - sizeof(RenderCmdBatchData)) /
+            sizeof(RenderRectInstance));
+        for (u32 first = 0; first < cmd->rects.rects_num; first += part_max)
+        {
+            RenderCmdBatchData batch;
+            batch.instances_num = cmd->rects.rects_num - first;
+            if (batch.instances_num > part_max) batch.instances_num = part_max;
+            size_t size = batch.instances_num * sizeof(RenderRectInstance);
+            u8 *data = (u8 *)AllocCmd(cmd_buffer, cmd, (u32)(sizeof(batch) + size));
+            memcpy(data, &batch, sizeof(batch));
+            memcpy(data + sizeof(batch), cmd->rects.rects + first, size);
+        }
+    } break;
+
+    case RCT_CIRCLES:
+    {
+        u32 part_max = (u32)((0xfffc - sizeof(RenderCmdHeader) - sizeof(RenderCmdBatchData)) /
+            sizeof(RenderCircle));
+        for (u32 first = 0; first < cmd->circles.circles_num; first += part_max)
+        {
+            RenderCmdBatchData batch;
+            batch.instances_num = cmd->circles.circles_num - first;
+            if (batch.instances_num > part_max) batch.instances_num = part_max;
+            size_t size = batch.instances_num * sizeof(RenderCircle);
+            u8 *data = (u8 *)AllocCmd(cmd_buffer, cmd, (u32)(sizeof(batch) + size));
+            memcpy(data, &batch, sizeof(batch));
+            memcpy(data + sizeof(batch), cmd->circles.circles + first, size);
+        }
+    } break;
+
+    case RCT_POINTS:
+    {
+        /* Points of the separate arrays are packed as the array of structures. */
+        u32 part_max = (u32)((0xfffc - sizeof(RenderCmdHeader) - sizeof(RenderCmdBatchData)) /
+            sizeof(RenderPoint));
+        for (u32 first = 0; first < cmd->points.points_num; first += part_max)
+        {
+            RenderCmdBatchData batch;
+            batch.instances_num = cmd->points.points_num - first;
+            if (batch.instances_num > part_max) batch.instances_num = part_max;
+            size_t size = batch.instances_num * sizeof(RenderPoint);
+            u8 *data = (u8 *)AllocCmd(cmd_buffer, cmd, (u32)(sizeof(batch) + size));
+            memcpy(data, &batch, sizeof(batch));
+            if (cmd->points.points)
+            {
+                memcpy(data + sizeof(batch), cmd->points.points + first, size);
+                continue;
+            }
+            for (u32 i = 0; i < batch.instances_num; ++i)
+            {
+                RenderPoint point;
+                point.x = cmd->points.xs[first + i];
+                point.y = cmd->points.ys[first + i];
+                point.color = cmd->points.colors[first + i];
+                memcpy(data + sizeof(batch) + i * sizeof(point), &point, sizeof(point));
+            }
+        }
+    } break;
+
+    case RCT_TEXT:
+    {
+        RenderCmdTextData text;
+        text.x = cmd->text.x;
+        text.y = cmd->text.y;
+        text.size = cmd->text.size;
+        text.max_width = cmd->text.max_width;
+        text.font_index = GetFontIndex(cmd_buffer, cmd->text.font);
+        text.length = (u32)strlen(cmd->text.str);
+
+        /* The string is copied right after the data with the terminating null. */
+        u8 *data = (u8 *)AllocCmd(cmd_buffer, cmd, sizeof(text) + text.length + 1);
+        memcpy(data, &text, sizeof(text));
+        memcpy(data + sizeof(text), cmd->text.str, text.length + 1);
+    } break;
+
+    default:
+    {
+        dbg_error("%s", "Unknown render command!");
+    }}
+}
+
+void
+RenderCmdBuffer_Execute(RenderCmdBuffer *cmd_buffer, Render *render)
+{
+    u32 offset = 0;
+    while (offset < cmd_buffer->size)
+    {
+        RenderCmd cmd;
+        offset = RenderCmdBuffer_ReadCmd(cmd_buffer, offset, &cmd);
+        Render_SubmitCmd(render, &cmd);
+    }
+}
+
+u32
+RenderCmdBuffer_ReadCmd(const RenderCmdBuffer *cmd_buffer, u32 offset, RenderCmd *cmd)
+{
+    RenderCmdHeader header;
+    const u8 *cursor = cmd_buffer->data + offset;
+    memcpy(&header, cursor, sizeof(header));
+    const u8 *data = cursor + sizeof(header);
+
+    cmd->type = (RenderCmdType)header.type;
+    cmd->blend = (BlendMode)header.blend;
+    cmd->color = header.color;
+    switch (cmd->type)
+    {
+    case RCT_CLEAR:
+    {
+    } break;
+
+    case RCT_PIXEL:
+    {
+        memcpy(&cmd->pixel, data, sizeof(cmd->pixel));
+    } break;
+
+    case RCT_LINE:
+    case RCT_LINE_AA:
+    {
+        memcpy(&cmd->line, data, sizeof(cmd->line));
+    } break;
+
+    case RCT_RECT:
+    {
+        memcpy(&cmd->rect, data, sizeof(cmd->rect));
+    } break;
+
+    case RCT_TRIANGLE:
+    {
+        memcpy(&cmd->triangle, data, sizeof(cmd->triangle));
+    } break;
+
+    case RCT_CIRCLE:
+    {
+        memcpy(&cmd->circle, data, sizeof(cmd->circle));
+    } break;
+
+    case RCT_ELLIPSE:
+    {
+        memcpy(&cmd->ellipse, data, sizeof(cmd->ellipse));
+    } break;
+
+    case RCT_LAYER:
+    {
+        memcpy(&cmd->layer, data, sizeof(cmd->layer));
+    } break;
+
+    case RCT_STATS:
+    {
+        memcpy(&cmd->stats, data, sizeof(cmd->stats));
+    } break;
+
+    case RCT_BITMAP:
+    case RCT_BITMAP_MASK:
+    {
+        RenderCmdBitmapData bitmap;
+        memcpy(&bitmap, data, sizeof(bitmap));
+        cmd->bitmap.x = bitmap.x;
+        cmd->bitmap.y = bitmap.y;
+        cmd->bitmap.scale = bitmap.scale;
+        cmd->bitmap.src_x = bitmap.src_x;
+        cmd->bitmap.src_y = bitmap.src_y;
+        cmd->bitmap.width = bitmap.width;
+        cmd->bitmap.height = bitmap.height;
+        cmd->bitmap.image = cmd_buffer->images[bitmap.image_index];
+    } break;
+
+    case RCT_BITMAP_SCALED:
+    {
+        RenderCmdScaledData scaled;
+        memcpy(&scaled, data, sizeof(scaled));
+        cmd->scaled.x = scaled.x;
+        cmd->scaled.y = scaled.y;
+        cmd->scaled.scale_x = scaled.scale_x;
+        cmd->scaled.scale_y = scaled.scale_y;
+        cmd->scaled.src_x = scaled.src_x;
+        cmd->scaled.src_y = scaled.src_y;
+        cmd->scaled.width = scaled.width;
+        cmd->scaled.height = scaled.height;
+        cmd->scaled.filter = (TextureFilter)scaled.filter;
+        cmd->scaled.image = cmd_buffer->images[scaled.image_index];
+    } break;
+
+    case RCT_TEXTURE:
+    {
+        RenderCmdTextureData texture;
+        memcpy(&texture, data, sizeof(texture));
+        memcpy(cmd->texture.vertices, texture.vertices, sizeof(texture.vertices));
+        memcpy(cmd->texture.uvs, texture.uvs, sizeof(texture.uvs));
+        cmd->texture.is_quad = texture.is_quad;
+        cmd->texture.filter = (TextureFilter)texture.filter;
+        cmd->texture.image = cmd_buffer->images[texture.image_index];
+    } break;
+
+    case RCT_POLYGON:
+    {
+        RenderCmdPolygonData polygon;
+        memcpy(&polygon, data, sizeof(polygon));
+        cmd->polygon.vertices = (const Vec2 *)(data + sizeof(polygon));
+        cmd->polygon.vertices_num = polygon.vertices_num;
+        cmd->polygon.rule = (PolygonFillRule)polygon.rule;
+    } break;
+
+    case RCT_POLYLINE:
+    {
+        RenderCmdPolylineData polyline;
+        memcpy(&polyline, data, sizeof(polyline));
+        cmd->polyline.points = (const Vec2 *)(data + sizeof(polyline));
+        cmd->polyline.points_num = polyline.points_num;
+        cmd->polyline.width = polyline.width;
+        cmd->polyline.is_anti_aliased = polyline.is_anti_aliased;
+    } break;
+
+    case RCT_RECTS:
+    {
+        RenderCmdBatchData batch;
+        memcpy(&batch, data, sizeof(batch));
+        cmd->rects.rects = (const RenderRectInstance *)(data + sizeof(batch));
+        cmd->rects.rects_num = batch.instances_num;
+        cmd->rects.band_offsets = NULL;
+        cmd->rects.bands_num = 0;
+    } break;
+
+    case RCT_POINTS:
+    {
+        RenderCmdBatchData batch;
+        memcpy(&batch, data, sizeof(batch));
+        cmd->points.points = (const RenderPoint *)(data + sizeof(batch));
+        cmd->points.xs = NULL;
+        cmd->points.ys = NULL;
+        cmd->points.colors = NULL;
+        cmd->points.points_num = batch.instances_num;
+        cmd->points.band_offsets = NULL;
+        cmd->points.bands_num = 0;
+    } break;
+
+    case RCT_CIRCLES:
+    {
+        RenderCmdBatchData batch;
+        memcpy(&batch, data, sizeof(batch));
+        cmd->circles.circles = (const RenderCircle *)(data + sizeof(batch));
+        cmd->circles.circles_num = batch.instances_num;
+        cmd->circles.band_offsets = NULL;
+        cmd->circles.bands_num = 0;
+    } break;
+
+    case RCT_TEXT:
+    {
+        RenderCmdTextData text;
+        memcpy(&text, data, sizeof(text));
+        cmd->text.x = text.x;
+        cmd->text.y = text.y;
+        cmd->text.size = text.size;
+        cmd->text.max_width = text.max_width;
+        cmd->text.font = cmd_buffer->fonts[text.font_index];
+        cmd->text.str = (const char *)(data + sizeof(text));
+        cmd->text.run = NULL;
+    } break;
+
+    default:
+    {
+        dbg_error("%s", "Unknown render command!");
+    }}
+
+    return offset + header.size;
+}
+
+void
+RenderCmdBuffer_Serialize(RenderCmdBuffer *cmd_buffer, MemObject *mem_object)
+{
+    /* Header: magic, version, images_num, fonts_num, cmds_num and commands size. */
+    u32 header[6];
+    header[0] = RENDER_CMD_BUFFER_MAGIC;
+    header[1] = RENDER_CMD_BUFFER_VERSION;
+    header[2] = cmd_buffer->images_num;
+    header[3] = cmd_buffer->fonts_num;
+    header[4] = cmd_buffer->cmds_num;
+    header[5] = cmd_buffer->size;
+
+    /* Determine the size of the serialized data. */
+    u64 size = sizeof(header) + cmd_buffer->size;
+    for (u32 i = 0; i < cmd_buffer->images_num; ++i)
+    {
+        const Image *image = cmd_buffer->images[i];
+        size += 4 * sizeof(u32) + (u64)PixelFormat_GetPitch(image->format, image->width) *
+            image->height;
+    }
+    for (u32 i = 0; i < cmd_buffer->fonts_num; ++i)
+    {
+        const Font *font = cmd_buffer->fonts[i];
+        size += 4 * sizeof(s32) + (u64)font->rows_num * font->cols_num * sizeof(SymbolData);
+    }
+    MemObject_InitBySize(mem_object, size);
+
+    u8 *cursor = mem_object->data;
+    WriteBytes(&cursor, header, sizeof(header));
+
+    /* Images: width, height, channels, pixel format and the pixels. */
+    for (u32 i = 0; i < cmd_buffer->images_num; ++i)
+    {
+        const Image *image = cmd_buffer->images[i];
+        u32 image_header[4];
+        image_header[0] = image->width;
+        image_header[1] = image->height;
+        image_header[2] = image->channels;
+        image_header[3] = image->format;
+        WriteBytes(&cursor, image_header, sizeof(image_header));
+        WriteBytes(&cursor, image->data,
+            (size_t)PixelFormat_GetPitch(image->format, image->width) * image->height);
+    }
+
+    /* Fonts: rows, columns, symbol width and height and the symbols data. */
+    for (u32 i = 0; i < cmd_buffer->fonts_num; ++i)
+    {
+        const Font *font = cmd_buffer->fonts[i];
+        s32 font_header[4];
+        font_header[0] = font->rows_num;
+        font_header[1] = font->cols_num;
+        font_header[2] = font->sym_width;
+        font_header[3] = font->sym_height;
+        WriteBytes(&cursor, font_header, sizeof(font_header));
+        WriteBytes(&cursor, font->symbols_data,
+            (size_t)font->rows_num * font->cols_num * sizeof(SymbolData));
+    }
+
+    WriteBytes(&cursor, cmd_buffer->data, cmd_buffer->size);
+}
+
+void
+RenderCmdBuffer_InitByMemObject(RenderCmdBuffer *cmd_buffer, MemObject *mem_object)
+{
+    const u8 *cursor = mem_object->data;
+    const u8 *end = mem_object->data + mem_object->size;
+
+    u32 header[6];
+    ReadBytes(&cursor, end, header, sizeof(header));
+    if ((header[0] != RENDER_CMD_BUFFER_MAGIC) || (header[1] != RENDER_CMD_BUFFER_VERSION))
+    {
+        dbg_error("%s", "Unsupported render command buffer format!");
+    }
+    u32 images_num = header[2];
+    u32 fonts_num = header[3];
+    u32 cmds_num = header[4];
+    u32 data_size = header[5];
+
+    RenderCmdBuffer_Init(cmd_buffer, data_size);
+    cmd_buffer->is_owner = true;
+
+    /* Restore the images. */
+    cmd_buffer->images_capacity = images_num;
+    if (images_num)
+    {
+        cmd_buffer->images = (const Image **)HelperFcn_MemAllocate(images_num *
+            sizeof(Image *));
+    }
+    for (u32 i = 0; i < images_num; ++i)
+    {
+        u32 image_header[4];
+        ReadBytes(&cursor, end, image_header, sizeof(image_header));
+        if (image_header[3] >= PF_FORMATS_NUM)
+        {
+            dbg_error("%s", "Unsupported pixel format of the image!");
+        }
+
+        /* Pixels have to fit the data, the row size has to fit the 32 bit pitch. */
+        PixelFormat format = (PixelFormat)image_header[3];
+        u64 pitch = ((u64)image_header[0] * PixelFormat_GetInfo(format)->bits_per_pixel +
+            7) / 8;
+        if ((pitch > 0xffffffffu) || ((image_header[1] > 0) &&
+            (pitch > (u64)(end - cursor) / image_header[1])))
+        {
+            dbg_error("%s", "Broken image of the command buffer!");
+        }
+        Image *image = Image_Constructor();
+        image->width = image_header[0];
+        image->height = image_header[1];
+        image->channels = image_header[2];
+        image->format = format;
+        size_t size = (size_t)pitch * image->height;
+        image->data = HelperFcn_MemAllocate(size ? size : 1);
+        ReadBytes(&cursor, end, image->data, size);
+        Image_CompileSprite(image);
+        cmd_buffer->images[cmd_buffer->images_num++] = image;
+    }
+
+    /* Restore the fonts. */
+    cmd_buffer->fonts_capacity = fonts_num;
+    if (fonts_num)
+    {
+        cmd_buffer->fonts = (const Font **)HelperFcn_MemAllocate(fonts_num *
+            sizeof(Font *));
+    }
+    for (u32 i = 0; i < fonts_num; ++i)
+    {
+        s32 font_header[4];
+        ReadBytes(&cursor, end, font_header, sizeof(font_header));
+
+        /* Symbol pixels have to fit the symbol array, the symbols have to fit the data. */
+        s32 pixels_max = (s32)sizeof(((SymbolData *)0)->symbol_array);
+        if ((font_header[0] < 0) || (font_header[1] < 0) || (font_header[2] < 0) ||
+            (font_header[3] < 0) || ((font_header[2] > 0) &&
+            (font_header[3] > pixels_max / font_header[2])) || ((font_header[0] > 0) &&
+            ((size_t)font_header[1] > (size_t)(end - cursor) / sizeof(SymbolData) /
+            (size_t)font_header[0])))
+        {
+            dbg_error("%s", "Broken font of the command buffer!");
+        }
+        Font *font = Font_Constructor();
+        font->rows_num = font_header[0];
+        font->cols_num = font_header[1];
+        font->sym_width = font_header[2];
+        font->sym_height = font_header[3];
+        size_t size = (size_t)font->rows_num * font->cols_num * sizeof(SymbolData);
+        font->symbols_data = (SymbolData *)HelperFcn_MemAllocate(size ? size : 1);
+        ReadBytes(&cursor, end, font->symbols_data, size);
+        cmd_buffer->fonts[cmd_buffer->fonts_num++] = font;
+    }
+
+    /* Restore the commands and check them, so the execution is safe. */
+    ReadBytes(&cursor, end, cmd_buffer->data, data_size);
+    cmd_buffer->size = data_size;
+    cmd_buffer->cmds_num = cmds_num;
+
+    u32 offset = 0;
+    u32 cmds_checked = 0;
+    while (offset < data_size)
+    {
+        RenderCmdHeader cmd_header;
+        dbg_check(data_size - offset >= sizeof(cmd_header), "%s", "Broken command!");
+        memcpy(&cmd_header, cmd_buffer->data + offset, sizeof(cmd_header));
+        dbg_check((cmd_header.type < RCT_TYPES_NUM) && (cmd_header.blend < BM_MODES_NUM)
+            && (cmd_header.size >= sizeof(cmd_header) +
+            GetMinDataSize((RenderCmdType)cmd_header.type))
+            && (cmd_header.size <= data_size - offset), "%s", "Broken command!");
+
+        u8 *data = cmd_buffer->data + offset + sizeof(cmd_header);
+        if ((cmd_header.type == RCT_BITMAP) || (cmd_header.type == RCT_BITMAP_MASK))
+        {
+            RenderCmdBitmapData bitmap;
+            memcpy(&bitmap, data, sizeof(bitmap));
+            dbg_check(bitmap.image_index < images_num, "%s", "Broken command!");
+            const Image *image = cmd_buffer->images[bitmap.image_index];
+            dbg_check((bitmap.src_x <= image->width)
+                && (bitmap.width <= image->width - bitmap.src_x)
+                && (bitmap.src_y <= image->height)
+                && (bitmap.height <= image->height - bitmap.src_y), "%s",
+                "Broken command!");
+        }
+        else if (cmd_header.type == RCT_BITMAP_SCALED)
+        {
+            /* Scaled images are sampled from the textures, as the texture mapped ones. */
+            RenderCmdScaledData scaled;
+            memcpy(&scaled, data, sizeof(scaled));
+            dbg_check((scaled.image_index < images_num) &&
+                (scaled.filter < TF_FILTERS_NUM), "%s", "Broken command!");
+            Image *image = (Image *)cmd_buffer->images[scaled.image_index];
+            dbg_check((scaled.src_x <= image->width)
+                && (scaled.width <= image->width - scaled.src_x)
+                && (scaled.src_y <= image->height)
+                && (scaled.height <= image->height - scaled.src_y), "%s",
+                "Broken command!");
+            if (image->texture == NULL) Image_CompileTexture(image, TL_LINEAR);
+        }
+        else if (cmd_header.type == RCT_TEXTURE)
+        {
+            /* Textures are not serialized, the loaded images are compiled instead. */
+            RenderCmdTextureData texture;
+            memcpy(&texture, data, sizeof(texture));
+            dbg_check((texture.image_index < images_num) &&
+                (texture.filter < TF_FILTERS_NUM), "%s", "Broken command!");
+            Image *image = (Image *)cmd_buffer->images[texture.image_index];
+            if (image->texture == NULL) Image_CompileTexture(image, TL_LINEAR);
+        }
+        else if (cmd_header.type == RCT_POLYGON)
+        {
+            RenderCmdPolygonData polygon;
+            memcpy(&polygon, data, sizeof(polygon));
+            dbg_check((polygon.rule < PFR_RULES_NUM) && (polygon.vertices_num <=
+                (cmd_header.size - sizeof(cmd_header) - sizeof(polygon)) / sizeof(Vec2)),
+                "%s", "Broken command!");
+        }
+        else if (cmd_header.type == RCT_POLYLINE)
+        {
+            RenderCmdPolylineData polyline;
+            memcpy(&polyline, data, sizeof(polyline));
+            dbg_check(polyline.points_num <= (cmd_header.size - sizeof(cmd_header) -
+                sizeof(polyline)) / sizeof(Vec2), "%s", "Broken command!");
+        }
+        else if ((cmd_header.type == RCT_RECTS) || (cmd_header.type == RCT_POINTS) ||
+            (cmd_header.type == RCT_CIRCLES))
+        {
+            RenderCmdBatchData batch;
+            memcpy(&batch, data, sizeof(batch));
+            size_t instance_size = (cmd_header.type == RCT_RECTS) ?
+                sizeof(RenderRectInstance) : (cmd_header.type == RCT_POINTS) ?
+                sizeof(RenderPoint) : sizeof(RenderCircle);
+            dbg_check(batch.instances_num <= (cmd_header.size - sizeof(cmd_header) -
+                sizeof(batch)) / instance_size, "%s", "Broken command!");
+        }
+        else if (cmd_header.type == RCT_TEXT)
+        {
+            RenderCmdTextData text;
+            memcpy(&text, data, sizeof(text));
+            dbg_check((text.font_index < fonts_num) && (text.length <
+                cmd_header.size - sizeof(cmd_header) - sizeof(text)) &&
+                (data[sizeof(text) + text.length] == '\0'), "%s", "Broken command!");
+        }
+        else if (cmd_header.type == RCT_LAYER)
+        {
+            RenderCmd cmd;  /* Only for the layer data. */
+            memcpy(&cmd.layer, data, sizeof(cmd.layer));
+            dbg_check((cmd.layer.layer < RL_LAYERS_NUM) &&
+                (cmd.layer.action < RLA_ACTIONS_NUM), "%s", "Broken command!");
+        }
+        else if (cmd_header.type == RCT_STATS)
+        {
+            RenderCmd cmd;  /* Only for the statistics data. */
+            memcpy(&cmd.stats, data, sizeof(cmd.stats));
+            dbg_check(cmd.stats.action < RSA_ACTIONS_NUM, "%s", "Broken command!");
+        }
+        offset += cmd_header.size;
+        cmds_checked++;
+    }
+    dbg_check(cmds_checked == cmds_num, "%s", "Broken command buffer!");
+}
+
+static u32
+GetMinDataSize(RenderCmdType type)
+{
+    RenderCmd cmd;  /* Only for the sizes of the command data. */
+    switch (type)
+    {
+    case RCT_PIXEL:
+    {
+        return sizeof(cmd.pixel);
+    }
+
+    case RCT_LINE:
+    case RCT_LINE_AA:
+    {
+        return sizeof(cmd.line);
+    }
+
+    case RCT_RECT:
+    {
+        return sizeof(cmd.rect);
+    }
+
+    case RCT_TRIANGLE:
+    {
+        return sizeof(cmd.triangle);
+    }
+
+    case RCT_CIRCLE:
+    {
+        return sizeof(cmd.circle);
+    }
+
+    case RCT_ELLIPSE:
+    {
+        return sizeof(cmd.ellipse);
+    }
+
+    case RCT_LAYER:
+    {
+        return sizeof(cmd.layer);
+    }
+
+    case RCT_STATS:
+    {
+        return sizeof(cmd.stats);
+    }
+
+    case RCT_BITMAP:
+    case RCT_BITMAP_MASK:
+    {
+        return sizeof(RenderCmdBitmapData);
+    }
+
+    case RCT_BITMAP_SCALED:
+    {
+        return sizeof(RenderCmdScaledData);
+    }
+
+    case RCT_TEXTURE:
+    {
+        return sizeof(RenderCmdTextureData);
+    }
+
+    case RCT_POLYGON:
+    {
+        return sizeof(RenderCmdPolygonData);
+    }
+
+    case RCT_POLYLINE:
+    {
+        return sizeof(RenderCmdPolylineData);
+    }
+
+    case RCT_RECTS:
+    case RCT_POINTS:
+    case RCT_CIRCLES:
+    {
+        return sizeof(RenderCmdBatchData);
+    }
+
+    case RCT_TEXT:
+    {
+        return sizeof(RenderCmdTextData);
+    }
+
+    default:
+    {
+        /* RCT_CLEAR has no data. */
+        return 0;
+    }}
+}
+
+static void*
+AllocCmd(RenderCmdBuffer *cmd_buffer, const RenderCmd *cmd, size_t data_size)
+{
+    /* Commands are 4 bytes aligned, so the data could be read directly. Offsets of the
+    arena are 32 bit, so it is limited by 2 GB. */
+    dbg_check(data_size < 0x7ffffff0u - cmd_buffer->size, "%s",
+        "Render command buffer is too big!");
+    u32 size = (u32)((sizeof(RenderCmdHeader) + data_size + 3) & ~(size_t)3);
+
+    if (cmd_buffer->size + size > cmd_buffer->capacity)
+    {
+        u32 capacity = cmd_buffer->capacity ? cmd_buffer->capacity : 256;
+        while (cmd_buffer->size + size > capacity) capacity *= 2;
+        cmd_buffer->data = (u8 *)HelperFcn_MemReallocate(cmd_buffer->data, capacity);
+        cmd_buffer->capacity = capacity;
+    }
+
+    u8 *packed_cmd = cmd_buffer->data + cmd_buffer->size;
+    memset(packed_cmd, 0, size);
+
+    RenderCmdHeader header;
+    header.type = (u8)cmd->type;
+    header.blend = (u8)cmd->blend;
+    header.reserved = 0;
+    header.size = size;
+    header.color = cmd->color;
+    memcpy(packed_cmd, &header, sizeof(header));
+
+    cmd_buffer->size += size;
+    cmd_buffer->cmds_num++;
+    return packed_cmd + sizeof(header);
+}
+
+static u32
+GetImageIndex(RenderCmdBuffer *cmd_buffer, const Image *image)
+{
+    /* A frame refers to a few images, so the linear search is enough. */
+    for (u32 i = 0; i < cmd_buffer->images_num; ++i)
+    {
+        if (cmd_buffer->images[i] == image) return i;
+    }
+
+    if (cmd_buffer->images_num == cmd_buffer->images_capacity)
+    {
+        cmd_buffer->images_capacity = cmd_buffer->images_capacity ?
+            cmd_buffer->images_capacity * 2 : 8;
+        cmd_buffer->images = (const Image **)HelperFcn_MemReallocate(
+            (void *)cmd_buffer->images, cmd_buffer->images_capacity * sizeof(Image *));
+    }
+    cmd_buffer->images[cmd_buffer->images_num] = image;
+    return cmd_buffer->images_num++;
+}
+
+static u32
+GetFontIndex(RenderCmdBuffer *cmd_buffer, const Font *font)
+{
+    for (u32 i = 0; i < cmd_buffer->fonts_num; ++i)
+    {
+        if (cmd_buffer->fonts[i] == font) return i;
+    }
+
+    if (cmd_buffer->fonts_num == cmd_buffer->fonts_capacity)
+    {
+        cmd_buffer->fonts_capacity = cmd_buffer->fonts_capacity ?
+            cmd_buffer->fonts_capacity * 2 : 4;
+        cmd_buffer->fonts = (const Font **)HelperFcn_MemReallocate(
+            (void *)cmd_buffer->fonts, cmd_buffer->fonts_capacity * sizeof(Font *));
+    }
+    cmd_buffer->fonts[cmd_buffer->fonts_num] = font;
+    return cmd_buffer->fonts_num++;
+}
+
+static void
+WriteBytes(u8 **cursor, const void *data, size_t size)
+{
+    memcpy(*cursor, data, size);
+    *cursor += size;
+}
+
+static void
+ReadBytes(const u8 **cursor, const u8 *end, void *data, size_t size)
+{
+    if ((size_t)(end - *cursor) < size)
+    {
+        dbg_error("%s", "Unexpected end of the render command buffer data!");
+    }
+    memcpy(data, *cursor, size);
+    *cursor += size;
+}
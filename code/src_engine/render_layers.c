@@ -0,0 +1,193 @@
+/**
+ * ================================================================================
+ * @file src_engine/render_layers.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the drawing into separate layers and
+ * for their composition.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/render_layers.h"
+
+#include <string.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/dbg.h"
+#include "include_engine/dirty_rects.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Extending the bounds of the drawn pixels of the layer by a rectangle.
+ * @param layer Pointer to the layer.
+ * @param rect Pointer to the rectangle.
+ */
+static void
+ExtendBounds(RenderLayer *layer, const RenderRect *rect);
+
+/**
+ * @brief Compositing the visible layers into a single region of the frame.
+ * @param layers Pointer to the RenderLayers structure.
+ * @param frame Pointer to the bitmap memory of the frame.
+ * @param rect Pointer to the region.
+ */
+static void
+CompositeRect(RenderLayers *layers, u32 *frame, const RenderRect *rect);
+
+RenderLayers*
+RenderLayers_Constructor(void)
+{
+    size_t size = sizeof(RenderLayers);
+    RenderLayers *layers = (RenderLayers *)HelperFcn_MemAllocate(size);
+    for (u32 i = 0; i < RL_LAYERS_NUM; ++i)
+    {
+        layers->layers[i].dirty_rects = DirtyRects_Constructor();
+    }
+    return layers;
+}
+
+RenderLayers*
+RenderLayers_Destructor(RenderLayers *layers)
+{
+    for (u32 i = 0; i < RL_LAYERS_NUM; ++i)
+    {
+        RenderLayer *layer = &layers->layers[i];
+        HelperFcn_PageFree(layer->memory);
+        layer->dirty_rects = DirtyRects_Destructor(layer->dirty_rects);
+    }
+    HelperFcn_MemFree(layers);
+    return NULL;
+}
+
+void
+RenderLayers_Init(RenderLayers *layers, u32 width, u32 height)
+{
+    layers->width = width;
+    layers->height = height;
+
+    /* Fresh memory is zeroed, so all the layers are transparent. */
+    size_t mem_size = sizeof(u32) * width * height;
+    for (u32 i = 0; i < RL_LAYERS_NUM; ++i)
+    {
+        RenderLayer *layer = &layers->layers[i];
+        HelperFcn_PageFree(layer->memory);
+        layer->memory = HelperFcn_PageAllocate(mem_size);
+        DirtyRects_Clear(layer->dirty_rects);
+        memset(&layer->bounds, 0, sizeof(RenderRect));
+        layer->is_visible = true;
+    }
+}
+
+void
+RenderLayers_SetVisible(RenderLayers *layers, RenderLayerId id, b32 is_visible)
+{
+    RenderLayer *layer = &layers->layers[id];
+    if (layer->is_visible == is_visible) return;
+    layer->is_visible = is_visible;
+
+    /* Only the pixels drawn into the layer are changed in the frame. */
+    if (id == RL_BACKGROUND)
+    {
+        RenderRect rect = {0, 0, (s32)layers->width, (s32)layers->height};
+        DirtyRects_Add(layer->dirty_rects, &rect);
+    }
+    else if (layer->bounds.x1 > layer->bounds.x0)
+    {
+        DirtyRects_Add(layer->dirty_rects, &layer->bounds);
+    }
+}
+
+void
+RenderLayers_Clear(RenderLayers *layers, RenderLayerId id)
+{
+    RenderLayer *layer = &layers->layers[id];
+    RenderRect *bounds = &layer->bounds;
+    for (u32 i = 0; i < layer->dirty_rects->rects_num; ++i)
+    {
+        ExtendBounds(layer, &layer->dirty_rects->rects[i]);
+    }
+    if (bounds->x1 <= bounds->x0) return;
+
+    u32 pitch = layers->width * sizeof(u32);
+    u32 *first = (u32 *)layer->memory + (size_t)layers->width * (u32)bounds->y0 +
+        (u32)bounds->x0;
+    SpanFill_Rect(first, pitch, (u32)(bounds->x1 - bounds->x0),
+        (u32)(bounds->y1 - bounds->y0), 0);
+    DirtyRects_Add(layer->dirty_rects, bounds);
+    memset(bounds, 0, sizeof(RenderRect));
+}
+
+void
+RenderLayers_Composite(RenderLayers *layers, void *frame, DirtyRects *frame_dirty_rects)
+{
+    /* Changed regions of all the layers (hidden ones included) are collected. */
+    DirtyRects regions;
+    DirtyRects_Clear(&regions);
+    for (u32 i = 0; i < RL_LAYERS_NUM; ++i)
+    {
+        RenderLayer *layer = &layers->layers[i];
+        for (u32 j = 0; j < layer->dirty_rects->rects_num; ++j)
+        {
+            DirtyRects_Add(&regions, &layer->dirty_rects->rects[j]);
+            ExtendBounds(layer, &layer->dirty_rects->rects[j]);
+        }
+        DirtyRects_Clear(layer->dirty_rects);
+    }
+
+    for (u32 i = 0; i < regions.rects_num; ++i)
+    {
+        CompositeRect(layers, (u32 *)frame, &regions.rects[i]);
+        DirtyRects_Add(frame_dirty_rects, &regions.rects[i]);
+    }
+}
+
+static void
+ExtendBounds(RenderLayer *layer, const RenderRect *rect)
+{
+    RenderRect *bounds = &layer->bounds;
+    if (bounds->x1 <= bounds->x0)
+    {
+        *bounds = *rect;
+        return;
+    }
+    if (rect->x0 < bounds->x0) bounds->x0 = rect->x0;
+    if (rect->y0 < bounds->y0) bounds->y0 = rect->y0;
+    if (rect->x1 > bounds->x1) bounds->x1 = rect->x1;
+    if (rect->y1 > bounds->y1) bounds->y1 = rect->y1;
+}
+
+static void
+CompositeRect(RenderLayers *layers, u32 *frame, const RenderRect *rect)
+{
+    u32 width = layers->width;
+    RenderLayer *background = &layers->layers[RL_BACKGROUND];
+    u32 count = (u32)(rect->x1 - rect->x0);
+    for (s32 y = rect->y0; y < rect->y1; ++y)
+    {
+        /* The background is opaque, hidden background leaves the frame black. */
+        size_t offset = (size_t)width * (u32)y + (u32)rect->x0;
+        u32 *dst = frame + offset;
+        if (background->is_visible)
+            memcpy(dst, (u32 *)background->memory + offset, count * sizeof(u32));
+        else
+            SpanFill_Row(dst, count, 0);
+
+        /* Upper layers are blended only within the bounds of their drawn pixels. */
+        for (u32 i = RL_BACKGROUND + 1; i < RL_LAYERS_NUM; ++i)
+        {
+            RenderLayer *layer = &layers->layers[i];
+            const RenderRect *bounds = &layer->bounds;
+            if (!layer->is_visible || (y < bounds->y0) || (y >= bounds->y1)) continue;
+            s32 x0 = (rect->x0 > bounds->x0) ? rect->x0 : bounds->x0;
+            s32 x1 = (rect->x1 < bounds->x1) ? rect->x1 : bounds->x1;
+            if (x0 >= x1) continue;
+            size_t layer_offset = (size_t)width * (u32)y + (u32)x0;
+            Blend_Row(frame + layer_offset, (u32 *)layer->memory + layer_offset,
+                (u32)(x1 - x0), BM_ALPHA);
+        }
+    }
+}
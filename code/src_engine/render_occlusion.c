@@ -0,0 +1,256 @@
+/**
+ * ================================================================================
+ * @file src_engine/render_occlusion.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the occlusion of the front to back drawing.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/render_occlusion.h"
+
+#include <string.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/render_cmd.h"
+#include "include_engine/render_cmd_buffer.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Reserving the room for more uncovered rectangles.
+ * @param occlusion Pointer to the RenderOcclusion structure.
+ * @param rects_num Amount of the rectangles to be added.
+ */
+static void
+ReserveRects(RenderOcclusion *occlusion, u32 rects_num);
+
+RenderOcclusion*
+RenderOcclusion_Constructor(void)
+{
+    size_t size = sizeof(RenderOcclusion);
+    RenderOcclusion *occlusion = (RenderOcclusion *)HelperFcn_MemAllocate(size);
+    occlusion->cmd_buffer = RenderCmdBuffer_Constructor();
+    RenderCmdBuffer_Init(occlusion->cmd_buffer, 4096);
+    return occlusion;
+}
+
+RenderOcclusion*
+RenderOcclusion_Destructor(RenderOcclusion *occlusion)
+{
+    for (u32 y = 0; y < occlusion->rows_num; ++y)
+    {
+        if (occlusion->rows[y].spans) HelperFcn_MemFree(occlusion->rows[y].spans);
+    }
+    if (occlusion->rows) HelperFcn_MemFree(occlusion->rows);
+    if (occlusion->rects) HelperFcn_MemFree(occlusion->rects);
+    if (occlusion->cmds) HelperFcn_MemFree(occlusion->cmds);
+    if (occlusion->cmds_rects) HelperFcn_MemFree(occlusion->cmds_rects);
+    RenderCmdBuffer_Destructor(occlusion->cmd_buffer);
+    HelperFcn_MemFree(occlusion);
+    return NULL;
+}
+
+void
+RenderOcclusion_Begin(RenderOcclusion *occlusion, u32 height)
+{
+    if (height > occlusion->rows_num)
+    {
+        /* New rows are zeroed, the spans of the old ones are kept for the reuse. */
+        occlusion->rows = (RenderOcclusionRow *)HelperFcn_MemReallocate(occlusion->rows,
+            height * sizeof(RenderOcclusionRow));
+        memset(occlusion->rows + occlusion->rows_num, 0,
+            (height - occlusion->rows_num) * sizeof(RenderOcclusionRow));
+        occlusion->rows_num = height;
+    }
+    for (u32 y = 0; y < occlusion->rows_num; ++y)
+    {
+        occlusion->rows[y].spans_num = 0;
+    }
+
+    RenderCmdBuffer_Reset(occlusion->cmd_buffer);
+    occlusion->cmds_num = 0;
+    occlusion->cmds_rects_num = 0;
+}
+
+const RenderRect*
+RenderOcclusion_GetUncoveredRects(RenderOcclusion *occlusion, const RenderRect *bounds,
+    u32 *rects_num)
+{
+    /* Rectangles of the previous row are the last ones, they are extended by the row
+    if its uncovered spans are the same. */
+    occlusion->rects_num = 0;
+    u32 group_first = 0;
+    u32 group_num = 0;
+    for (s32 y = bounds->y0; y < bounds->y1; ++y)
+    {
+        const RenderOcclusionRow *row = ((u32)y < occlusion->rows_num) ?
+            &occlusion->rows[y] : NULL;
+        u32 spans_num = row ? row->spans_num : 0;
+
+        /* Spans to the left of the bounds are skipped by the binary search. */
+        u32 first = 0;
+        u32 last = spans_num;
+        while (first < last)
+        {
+            u32 middle = first + (last - first) / 2;
+            if (row->spans[middle].x1 <= bounds->x0)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+
+        /* Gaps between the covered spans are appended after the previous row group. */
+        u32 row_first = occlusion->rects_num;
+        s32 x = bounds->x0;
+        for (u32 i = first; (i <= spans_num) && (x < bounds->x1); ++i)
+        {
+            s32 gap_x1 = bounds->x1;
+            if (i < spans_num)
+            {
+                const RenderOcclusionSpan *span = &row->spans[i];
+                if (span->x0 < gap_x1) gap_x1 = span->x0;
+            }
+            if (x < gap_x1)
+            {
+                ReserveRects(occlusion, 1);
+                RenderRect *rect = &occlusion->rects[occlusion->rects_num++];
+                rect->x0 = x;
+                rect->y0 = y;
+                rect->x1 = gap_x1;
+                rect->y1 = y + 1;
+            }
+            if (i < spans_num) x = row->spans[i].x1;
+        }
+
+        u32 row_num = occlusion->rects_num - row_first;
+        b32 is_same = (row_num == group_num);
+        for (u32 i = 0; is_same && (i < row_num); ++i)
+        {
+            const RenderRect *rect = &occlusion->rects[row_first + i];
+            const RenderRect *group_rect = &occlusion->rects[group_first + i];
+            is_same = (rect->x0 == group_rect->x0) && (rect->x1 == group_rect->x1);
+        }
+        if (is_same)
+        {
+            for (u32 i = 0; i < group_num; ++i) occlusion->rects[group_first + i].y1++;
+            occlusion->rects_num = row_first;
+            continue;
+        }
+        group_first = row_first;
+        group_num = row_num;
+    }
+
+    *rects_num = occlusion->rects_num;
+    return occlusion->rects;
+}
+
+void
+RenderOcclusion_CoverSpan(RenderOcclusion *occlusion, s32 y, s32 x0, s32 x1)
+{
+    if (((u32)y >= occlusion->rows_num) || (x0 >= x1)) return;
+    RenderOcclusionRow *row = &occlusion->rows[y];
+
+    /* First span not to the left of the new one (touching spans are merged too). */
+    u32 first = 0;
+    u32 last = row->spans_num;
+    while (first < last)
+    {
+        u32 middle = first + (last - first) / 2;
+        if (row->spans[middle].x1 < x0)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+    last = first;
+    while ((last < row->spans_num) && (row->spans[last].x0 <= x1)) last++;
+
+    if (first == last)
+    {
+        if (row->spans_num == row->capacity)
+        {
+            row->capacity = (row->capacity == 0) ? 8 : row->capacity * 2;
+            row->spans = (RenderOcclusionSpan *)HelperFcn_MemReallocate(row->spans,
+                row->capacity * sizeof(RenderOcclusionSpan));
+        }
+        memmove(row->spans + first + 1, row->spans + first,
+            (row->spans_num - first) * sizeof(RenderOcclusionSpan));
+        row->spans[first].x0 = x0;
+        row->spans[first].x1 = x1;
+        row->spans_num++;
+        return;
+    }
+
+    /* Spans [first, last) are replaced by their union with the new one. */
+    if (row->spans[first].x0 < x0) x0 = row->spans[first].x0;
+    if (row->spans[last - 1].x1 > x1) x1 = row->spans[last - 1].x1;
+    row->spans[first].x0 = x0;
+    row->spans[first].x1 = x1;
+    memmove(row->spans + first + 1, row->spans + last,
+        (row->spans_num - last) * sizeof(RenderOcclusionSpan));
+    row->spans_num -= last - first - 1;
+}
+
+void
+RenderOcclusion_CoverRect(RenderOcclusion *occlusion, const RenderRect *rect)
+{
+    for (s32 y = rect->y0; y < rect->y1; ++y)
+    {
+        RenderOcclusion_CoverSpan(occlusion, y, rect->x0, rect->x1);
+    }
+}
+
+void
+RenderOcclusion_DeferCmd(RenderOcclusion *occlusion, const RenderCmd *cmd,
+    const RenderRect *rects, u32 rects_num)
+{
+    if (occlusion->cmds_num == occlusion->cmds_capacity)
+    {
+        occlusion->cmds_capacity = (occlusion->cmds_capacity == 0) ?
+            256 : occlusion->cmds_capacity * 2;
+        occlusion->cmds = (RenderOcclusionCmd *)HelperFcn_MemReallocate(occlusion->cmds,
+            occlusion->cmds_capacity * sizeof(RenderOcclusionCmd));
+    }
+    if (occlusion->cmds_rects_num + rects_num > occlusion->cmds_rects_capacity)
+    {
+        u32 capacity = (occlusion->cmds_rects_capacity == 0) ?
+            256 : occlusion->cmds_rects_capacity;
+        while (capacity < occlusion->cmds_rects_num + rects_num) capacity *= 2;
+        occlusion->cmds_rects = (RenderRect *)HelperFcn_MemReallocate(
+            occlusion->cmds_rects, capacity * sizeof(RenderRect));
+        occlusion->cmds_rects_capacity = capacity;
+    }
+
+    RenderOcclusionCmd *deferred = &occlusion->cmds[occlusion->cmds_num++];
+    deferred->offset = occlusion->cmd_buffer->size;
+    deferred->first_rect = occlusion->cmds_rects_num;
+    deferred->rects_num = rects_num;
+    RenderCmdBuffer_PushCmd(occlusion->cmd_buffer, cmd);
+    memcpy(occlusion->cmds_rects + occlusion->cmds_rects_num, rects,
+        rects_num * sizeof(RenderRect));
+    occlusion->cmds_rects_num += rects_num;
+}
+
+const RenderRect*
+RenderOcclusion_GetDeferredCmd(RenderOcclusion *occlusion, u32 index, RenderCmd *cmd,
+    u32 *rects_num)
+{
+    dbg_check(index < occlusion->cmds_num, "%s", "Deferred command does not exist!");
+    const RenderOcclusionCmd *deferred = &occlusion->cmds[index];
+    RenderCmdBuffer_ReadCmd(occlusion->cmd_buffer, deferred->offset, cmd);
+    *rects_num = deferred->rects_num;
+    return occlusion->cmds_rects + deferred->first_rect;
+}
+
+static void
+ReserveRects(RenderOcclusion *occlusion, u32 rects_num)
+{
+    if (occlusion->rects_num + rects_num <= occlusion->rects_capacity) return;
+    u32 capacity = (occlusion->rects_capacity == 0) ? 64 : occlusion->rects_capacity;
+    while (capacity < occlusion->rects_num + rects_num) capacity *= 2;
+    occlusion->rects = (RenderRect *)HelperFcn_MemReallocate(occlusion->rects,
+        capacity * sizeof(RenderRect));
+    occlusion->rects_capacity = capacity;
+}
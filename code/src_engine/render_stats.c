@@ -0,0 +1,318 @@
+/**
+ * ================================================================================
+ * @file src_engine/render_stats.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the statistics of the render and the heatmap of
+ * the pixel writes.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/render_stats.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/render_cmd.h"
+#include "include_engine/utils.h"
+
+/* Storage of the variables of every thread (the render thread and the tiler workers). */
+#ifdef _MSC_VER
+#define RENDER_STATS_THREAD_LOCAL __declspec(thread)
+#else
+#define RENDER_STATS_THREAD_LOCAL __thread
+#endif
+
+/**
+ * @brief Structure for the command executed by a thread.
+ */
+struct RenderStatsCmd_
+{
+    RenderStatsCounters *counters;  /**< Counters of the command (NULL - no command). */
+    const u8 *memory;  /**< Pointer to the pixel (0, 0) of the buffer being drawn into. */
+    size_t size;  /**< Size of the buffer in bytes (the pitch by the height). */
+    u32 pitch;  /**< Distance between two rows of the buffer in bytes. */
+    u32 *heat;  /**< Heatmap of the frame (NULL for a render target). */
+    u32 heat_width;  /**< Width of the heatmap. */
+    u32 heat_height;  /**< Height of the heatmap. */
+};
+typedef struct RenderStatsCmd_ RenderStatsCmd;
+
+/* Command executed by the current thread. */
+static RENDER_STATS_THREAD_LOCAL RenderStatsCmd current_cmd;
+
+/* Colors of the heatmap by the amount of the writes of a pixel. */
+static const u32 heat_colors[RENDER_STATS_HEAT_COLORS] =
+{
+    0xff000000, 0xff0000c0, 0xff00c0c0, 0xff00c000, 0xffe0e000, 0xffff8000, 0xffff0000,
+    0xffffffff
+};
+
+/* Names of the command types (in the order of RenderCmdType). */
+static const char *type_names[RCT_TYPES_NUM] =
+{
+    "clear", "pixel", "line", "rect", "triangle", "circle", "bitmap", "bitmap_mask",
+    "text", "ellipse", "line_aa", "texture", "polygon", "rects", "points", "bitmap_scaled",
+    "circles", "polyline", "layer", "stats"
+};
+
+/**
+ * @brief Adding the counters to the sum.
+ * @param sum Pointer to the sum of the counters.
+ * @param counters Pointer to the added counters.
+ */
+static void
+AddCounters(RenderStatsCounters *sum, const RenderStatsCounters *counters);
+
+RenderStats*
+RenderStats_Constructor(void)
+{
+    size_t size = sizeof(RenderStats);
+    RenderStats *stats = (RenderStats *)HelperFcn_MemAllocate(size);
+    return stats;
+}
+
+RenderStats*
+RenderStats_Destructor(RenderStats *stats)
+{
+    if (stats->slots) HelperFcn_MemFree(stats->slots);
+    HelperFcn_PageFree(stats->heat);
+    HelperFcn_PageFree(stats->last_heat);
+    HelperFcn_MemFree(stats);
+    return NULL;
+}
+
+void
+RenderStats_Init(RenderStats *stats, u32 width, u32 height, b32 is_heatmap)
+{
+    RenderStats_ReserveSlots(stats, 1);
+    memset(stats->slots, 0, stats->slots_num * RCT_TYPES_NUM * sizeof(RenderStatsCounters));
+    memset(&stats->last, 0, sizeof(RenderFrameStats));
+
+    /* Heatmaps are allocated by the first frame. */
+    stats->is_heatmap = is_heatmap;
+    HelperFcn_PageFree(stats->heat);
+    HelperFcn_PageFree(stats->last_heat);
+    stats->heat = NULL;
+    stats->last_heat = NULL;
+    stats->width = 0;
+    stats->height = 0;
+    RenderStats_NextFrame(stats, width, height);
+    stats->last.frame = 0;
+}
+
+void
+RenderStats_ReserveSlots(RenderStats *stats, u32 slots_num)
+{
+    if (slots_num <= stats->slots_num) return;
+
+    /* Counters of the new slots are zeroed, the old ones are kept. */
+    size_t slot_size = RCT_TYPES_NUM * sizeof(RenderStatsCounters);
+    stats->slots = (RenderStatsCounters *)HelperFcn_MemReallocate(stats->slots,
+        slots_num * slot_size);
+    memset(stats->slots + stats->slots_num * RCT_TYPES_NUM, 0,
+        (slots_num - stats->slots_num) * slot_size);
+    stats->slots_num = slots_num;
+}
+
+RenderStatsCounters*
+RenderStats_GetCounters(RenderStats *stats, u32 slot, RenderCmdType type)
+{
+    dbg_check(slot < stats->slots_num, "%s", "Statistics slot is not reserved!");
+    return &stats->slots[slot * RCT_TYPES_NUM + type];
+}
+
+void
+RenderStats_BeginCmd(RenderStats *stats, RenderStatsCounters *counters, void *memory,
+    u32 pitch, u32 height, b32 is_frame)
+{
+    RenderStatsCmd *cmd = &current_cmd;
+    cmd->counters = counters;
+    cmd->memory = (const u8 *)memory;
+    cmd->size = (size_t)pitch * height;
+    cmd->pitch = pitch;
+
+    /* Heatmap is of the frame size, the tiles of the workers never overlap. */
+    cmd->heat = is_frame ? stats->heat : NULL;
+    cmd->heat_width = stats->width;
+    cmd->heat_height = stats->height;
+}
+
+void
+RenderStats_EndCmd(void)
+{
+    current_cmd.counters = NULL;
+}
+
+void
+RenderStats_CountWrites(const void *dst, u32 pitch, u32 width, u32 height)
+{
+    /* Temporary buffers of the kernels (masks, samples) are not counted. */
+    RenderStatsCmd *cmd = &current_cmd;
+    if (cmd->counters == NULL) return;
+    const u8 *first = (const u8 *)dst;
+    if ((first < cmd->memory) || (first >= cmd->memory + cmd->size)) return;
+    cmd->counters->pixels_written += (u64)width * height;
+    if (cmd->heat == NULL) return;
+
+    u64 overdrawn = 0;
+    for (u32 j = 0; j < height; ++j)
+    {
+        size_t offset = (size_t)(first - cmd->memory) + (size_t)pitch * j;
+        u32 x = (u32)((offset % cmd->pitch) / sizeof(u32));
+        u32 y = (u32)(offset / cmd->pitch);
+        if ((x >= cmd->heat_width) || (y >= cmd->heat_height)) break;
+        u32 count = (width < cmd->heat_width - x) ? width : cmd->heat_width - x;
+        u32 *heat_row = cmd->heat + (size_t)y * cmd->heat_width + x;
+        for (u32 i = 0; i < count; ++i)
+        {
+            if (heat_row[i] > 0) overdrawn++;
+            heat_row[i]++;
+        }
+    }
+    cmd->counters->pixels_overdrawn += overdrawn;
+}
+
+void
+RenderStats_NextFrame(RenderStats *stats, u32 width, u32 height)
+{
+    RenderFrameStats *last = &stats->last;
+    u64 frame = last->frame;
+    memset(last, 0, sizeof(RenderFrameStats));
+    last->frame = frame + 1;
+    for (u32 slot = 0; slot < stats->slots_num; ++slot)
+    {
+        RenderStatsCounters *counters = &stats->slots[slot * RCT_TYPES_NUM];
+        for (u32 type = 0; type < RCT_TYPES_NUM; ++type)
+        {
+            AddCounters(&last->types[type], &counters[type]);
+            AddCounters(&last->total, &counters[type]);
+        }
+        memset(counters, 0, RCT_TYPES_NUM * sizeof(RenderStatsCounters));
+    }
+    if (!stats->is_heatmap) return;
+
+    /* Heatmap of the finished frame is kept for the drawing. */
+    u32 *heat = stats->heat;
+    stats->heat = stats->last_heat;
+    stats->last_heat = heat;
+    if (heat)
+    {
+        for (size_t i = 0; i < (size_t)stats->width * stats->height; ++i)
+        {
+            if (heat[i] == 0) continue;
+            last->pixels_touched++;
+            if (heat[i] > last->max_writes) last->max_writes = heat[i];
+        }
+    }
+
+    size_t mem_size = sizeof(u32) * width * height;
+    if ((width != stats->width) || (height != stats->height))
+    {
+        HelperFcn_PageFree(stats->heat);
+        HelperFcn_PageFree(stats->last_heat);
+        stats->heat = (u32 *)HelperFcn_PageAllocate(mem_size);
+        stats->last_heat = (u32 *)HelperFcn_PageAllocate(mem_size);
+        stats->width = width;
+        stats->height = height;
+        return;
+    }
+    memset(stats->heat, 0, mem_size);
+}
+
+void
+RenderStats_DrawHeatmap(const RenderStats *stats, void *memory, u32 pitch,
+    const RenderRect *clip)
+{
+    if (stats->last_heat == NULL) return;
+    s32 x1 = (clip->x1 < (s32)stats->width) ? clip->x1 : (s32)stats->width;
+    s32 y1 = (clip->y1 < (s32)stats->height) ? clip->y1 : (s32)stats->height;
+    for (s32 y = clip->y0; y < y1; ++y)
+    {
+        const u32 *heat_row = stats->last_heat + (size_t)y * stats->width;
+        u32 *row = (u32 *)((u8 *)memory + (size_t)pitch * (u32)y);
+        for (s32 x = clip->x0; x < x1; ++x)
+        {
+            u32 writes = heat_row[x];
+            if (writes >= RENDER_STATS_HEAT_COLORS) writes = RENDER_STATS_HEAT_COLORS - 1;
+            row[x] = heat_colors[writes];
+        }
+    }
+}
+
+RenderStatsExchange*
+RenderStatsExchange_Constructor(void)
+{
+    size_t size = sizeof(RenderStatsExchange);
+    RenderStatsExchange *exchange = (RenderStatsExchange *)HelperFcn_MemAllocate(size);
+    return exchange;
+}
+
+RenderStatsExchange*
+RenderStatsExchange_Destructor(RenderStatsExchange *exchange)
+{
+    HelperFcn_MemFree(exchange);
+    return NULL;
+}
+
+void
+RenderStatsExchange_Init(RenderStatsExchange *exchange)
+{
+    memset(exchange->frames, 0, sizeof(exchange->frames));
+    exchange->back = 0;
+    exchange->front = 1;
+    Atomic_Store(&exchange->slot, 2);
+}
+
+void
+RenderStatsExchange_Publish(RenderStatsExchange *exchange, const RenderFrameStats *stats)
+{
+    /* The previous content of the slot becomes the next back buffer. */
+    exchange->frames[exchange->back] = *stats;
+    s32 slot = Atomic_Exchange(&exchange->slot, exchange->back | RENDER_STATS_FRESH);
+    exchange->back = slot & ~RENDER_STATS_FRESH;
+}
+
+void
+RenderStatsExchange_Read(RenderStatsExchange *exchange, RenderFrameStats *stats)
+{
+    /* Only the reader takes the fresh buffer out of the slot, so the exchanged one is
+    still fresh (the render thread could only replace it by a fresher one). */
+    if (Atomic_Load(&exchange->slot) & RENDER_STATS_FRESH)
+    {
+        s32 slot = Atomic_Exchange(&exchange->slot, exchange->front);
+        exchange->front = slot & ~RENDER_STATS_FRESH;
+    }
+    *stats = exchange->frames[exchange->front];
+}
+
+const char*
+RenderStats_GetTypeName(RenderCmdType type)
+{
+    return (type < RCT_TYPES_NUM) ? type_names[type] : "unknown";
+}
+
+void
+RenderStats_Format(const RenderStatsCounters *counters, const char *name, char *str,
+    u32 size)
+{
+    snprintf(str, size, "%s: %llu calls %llu px %llu over %llu rej %.1f us", name,
+        (unsigned long long)counters->calls, (unsigned long long)counters->pixels_written,
+        (unsigned long long)counters->pixels_overdrawn,
+        (unsigned long long)counters->pixels_rejected, (f64)counters->time_ns / 1.0e3);
+}
+
+static void
+AddCounters(RenderStatsCounters *sum, const RenderStatsCounters *counters)
+{
+    sum->calls += counters->calls;
+    sum->culled += counters->culled;
+    sum->pixels_written += counters->pixels_written;
+    sum->pixels_overdrawn += counters->pixels_overdrawn;
+    sum->pixels_rejected += counters->pixels_rejected;
+    sum->time_ns += counters->time_ns;
+}
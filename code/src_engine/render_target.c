@@ -0,0 +1,105 @@
+/**
+ * ================================================================================
+ * @file src_engine/render_target.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the work with the render targets.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/render_target.h"
+
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/image.h"
+#include "include_engine/pixel_format.h"
+#include "include_engine/utils.h"
+
+RenderTarget*
+RenderTarget_Constructor(void)
+{
+    size_t size = sizeof(RenderTarget);
+    RenderTarget *target = (RenderTarget *)HelperFcn_MemAllocate(size);
+    return target;
+}
+
+RenderTarget*
+RenderTarget_Destructor(RenderTarget *target)
+{
+    HelperFcn_PageFree(target->allocation);
+    HelperFcn_MemFree(target);
+    return NULL;
+}
+
+void
+RenderTarget_Init(RenderTarget *target, u32 width, u32 height)
+{
+    HelperFcn_PageFree(target->allocation);
+
+    /* Allocation is padded by the alignment, the memory starts at the aligned address
+    inside it. */
+    u32 pitch = (width * sizeof(u32) + RENDER_TARGET_ALIGNMENT - 1) &
+        ~(u32)(RENDER_TARGET_ALIGNMENT - 1);
+    size_t size = (size_t)pitch * height + RENDER_TARGET_ALIGNMENT;
+    target->allocation = HelperFcn_PageAllocate(size);
+    uintptr_t address = ((uintptr_t)target->allocation + RENDER_TARGET_ALIGNMENT - 1) &
+        ~(uintptr_t)(RENDER_TARGET_ALIGNMENT - 1);
+
+    target->width = width;
+    target->height = height;
+    target->pitch = pitch;
+    target->memory = (void *)address;
+    target->image = NULL;
+}
+
+void
+RenderTarget_InitByMemory(RenderTarget *target, void *memory, u32 width, u32 height,
+    u32 pitch)
+{
+    dbg_check(pitch >= width * sizeof(u32), "%s", "Render target rows overlap!");
+    HelperFcn_PageFree(target->allocation);
+    target->allocation = NULL;
+    target->width = width;
+    target->height = height;
+    target->pitch = pitch;
+    target->memory = memory;
+    target->image = NULL;
+}
+
+void
+RenderTarget_InitByImage(RenderTarget *target, Image *image)
+{
+    Image_Convert(image, PF_BGRA_PREMULTIPLIED);
+    RenderTarget_InitByMemory(target, image->data, image->width, image->height,
+        PixelFormat_GetPitch(image->format, image->width));
+    target->image = image;
+}
+
+void
+RenderTarget_InitSubView(RenderTarget *target, const RenderTarget *parent, u32 x, u32 y,
+    u32 width, u32 height)
+{
+    dbg_check(target != parent, "%s", "Render target could not be a view of itself!");
+
+    /* The view is clipped by the parent (an empty view is at its BL corner). */
+    if (x > parent->width) x = parent->width;
+    if (y > parent->height) y = parent->height;
+    if (width > parent->width - x) width = parent->width - x;
+    if (height > parent->height - y) height = parent->height - y;
+
+    HelperFcn_PageFree(target->allocation);
+    target->allocation = NULL;
+    target->width = width;
+    target->height = height;
+    target->pitch = parent->pitch;
+    target->memory = (u8 *)parent->memory + (size_t)parent->pitch * y + x * sizeof(u32);
+    target->image = parent->image;
+}
+
+u32*
+RenderTarget_GetPixelAddress(const RenderTarget *target, u32 x, u32 y)
+{
+    u8 *row = (u8 *)target->memory + (size_t)target->pitch * y;
+    return (u32 *)row + x;
+}
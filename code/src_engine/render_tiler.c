@@ -0,0 +1,352 @@
+/**
+ * ================================================================================
+ * @file src_engine/render_tiler.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the tile-binned multithreaded
+ * rendering.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/render_tiler.h"
+
+#include <string.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/job_pool.h"
+#include "include_engine/render.h"
+#include "include_engine/render_cmd.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+/**
+ * @brief Copying the arrays referred by the recorded command (polygon vertices, polyline
+ * points, batch instances and bands) into the arrays memory of the tiler.
+ * @param tiler Pointer to the RenderTiler structure.
+ * @param cmd Pointer to the recorded command.
+ */
+static void
+CopyArrays(RenderTiler *tiler, RenderCmd *cmd);
+
+/**
+ * @brief Getting the place for the arrays of the specified size in the arrays memory.
+ * The recorded commands are pointed to the new memory when it is grown.
+ * @param tiler Pointer to the RenderTiler structure.
+ * @param size Size of the arrays in bytes.
+ * @return u8* Pointer to the place of the arrays.
+ */
+static u8*
+ReserveArrays(RenderTiler *tiler, size_t size);
+
+/**
+ * @brief Distribution of the recorded commands into the tile bins.
+ * @param tiler Pointer to the RenderTiler structure.
+ */
+static void
+BinCommands(RenderTiler *tiler);
+
+/**
+ * @brief Job procedure rasterizing all the commands of a single tile.
+ * @param data Pointer to the RenderTiler structure.
+ * @param tile_index Index of the tile.
+ * @param worker_index Index of the worker executing the job.
+ */
+static void
+RasterizeTile(void *data, u32 tile_index, u32 worker_index);
+
+RenderTiler*
+RenderTiler_Constructor(void)
+{
+    size_t size = sizeof(RenderTiler);
+    RenderTiler *tiler = (RenderTiler *)HelperFcn_MemAllocate(size);
+    return tiler;
+}
+
+RenderTiler*
+RenderTiler_Destructor(RenderTiler *tiler)
+{
+    tiler->job_pool = JobPool_Destructor(tiler->job_pool);
+    HelperFcn_MemFree(tiler->workers);
+    if (tiler->cmds) HelperFcn_MemFree(tiler->cmds);
+    if (tiler->cmds_bounds) HelperFcn_MemFree(tiler->cmds_bounds);
+    if (tiler->arrays) HelperFcn_MemFree(tiler->arrays);
+    if (tiler->bin_offsets) HelperFcn_MemFree(tiler->bin_offsets);
+    if (tiler->bin_cmds) HelperFcn_MemFree(tiler->bin_cmds);
+    HelperFcn_MemFree(tiler);
+    return NULL;
+}
+
+void
+RenderTiler_Init(RenderTiler *tiler, u32 tile_size, u32 threads_num)
+{
+    dbg_check(tile_size > 0, "%s", "Tile size should be positive!");
+    tiler->tile_size = tile_size;
+
+    /* The caller of the flush is one of the workers, so one thread less is started. */
+    if (threads_num == 0) threads_num = JobPool_GetCpuCoresNum();
+    tiler->job_pool = JobPool_Constructor();
+    JobPool_Init(tiler->job_pool, threads_num - 1);
+
+    /* Every worker gets its own render context with the clip rectangle of its tile. */
+    tiler->workers_num = JobPool_GetWorkersNum(tiler->job_pool);
+    size_t size = tiler->workers_num * sizeof(Render);
+    tiler->workers = (Render *)HelperFcn_MemAllocate(size);
+}
+
+void
+RenderTiler_PushCmd(RenderTiler *tiler, const RenderCmd *cmd, const RenderRect *bounds)
+{
+    if (tiler->cmds_num == tiler->cmds_capacity)
+    {
+        tiler->cmds_capacity = (tiler->cmds_capacity == 0) ? 1024 : tiler->cmds_capacity * 2;
+        tiler->cmds = (RenderCmd *)HelperFcn_MemReallocate(tiler->cmds,
+            tiler->cmds_capacity * sizeof(RenderCmd));
+        tiler->cmds_bounds = (RenderRect *)HelperFcn_MemReallocate(tiler->cmds_bounds,
+            tiler->cmds_capacity * sizeof(RenderRect));
+    }
+    tiler->cmds[tiler->cmds_num] = *cmd;
+    tiler->cmds_bounds[tiler->cmds_num] = *bounds;
+    CopyArrays(tiler, &tiler->cmds[tiler->cmds_num]);
+    tiler->cmds_num++;
+}
+
+void
+RenderTiler_Flush(RenderTiler *tiler, Render *render)
+{
+    if (tiler->cmds_num == 0) return;
+
+    /* Determine the tile grid for the current size of the render buffer. */
+    u32 tile_size = tiler->tile_size;
+    tiler->tiles_x = (render->buffer->width + tile_size - 1) / tile_size;
+    tiler->tiles_y = (render->buffer->height + tile_size - 1) / tile_size;
+    tiler->render = render;
+    BinCommands(tiler);
+
+    /* Worker contexts draw into the same buffer as the render, but without recording. */
+    for (u32 i = 0; i < tiler->workers_num; ++i)
+    {
+        tiler->workers[i] = *render;
+        tiler->workers[i].tiler = NULL;
+        tiler->workers[i].stats_slot = i + 1;
+    }
+
+    JobPool_Run(tiler->job_pool, RasterizeTile, tiler, tiler->tiles_x * tiler->tiles_y);
+    tiler->cmds_num = 0;
+    tiler->arrays_size = 0;
+}
+
+static void
+CopyArrays(RenderTiler *tiler, RenderCmd *cmd)
+{
+    if (cmd->type == RCT_POLYGON)
+    {
+        size_t size = cmd->polygon.vertices_num * sizeof(Vec2);
+        u8 *memory = ReserveArrays(tiler, size);
+        memcpy(memory, cmd->polygon.vertices, size);
+        cmd->polygon.vertices = (const Vec2 *)memory;
+    }
+    else if (cmd->type == RCT_POLYLINE)
+    {
+        size_t size = cmd->polyline.points_num * sizeof(Vec2);
+        u8 *memory = ReserveArrays(tiler, size);
+        memcpy(memory, cmd->polyline.points, size);
+        cmd->polyline.points = (const Vec2 *)memory;
+    }
+    else if (cmd->type == RCT_RECTS)
+    {
+        size_t offsets_size = (cmd->rects.bands_num + 1) * sizeof(u32);
+        size_t size = cmd->rects.rects_num * sizeof(RenderRectInstance);
+        u8 *memory = ReserveArrays(tiler, offsets_size + size);
+        memcpy(memory, cmd->rects.band_offsets, offsets_size);
+        memcpy(memory + offsets_size, cmd->rects.rects, size);
+        cmd->rects.band_offsets = (const u32 *)memory;
+        cmd->rects.rects = (const RenderRectInstance *)(memory + offsets_size);
+    }
+    else if (cmd->type == RCT_POINTS)
+    {
+        size_t offsets_size = (cmd->points.bands_num + 1) * sizeof(u32);
+        size_t size = cmd->points.points_num * sizeof(RenderPoint);
+        u8 *memory = ReserveArrays(tiler, offsets_size + size);
+        memcpy(memory, cmd->points.band_offsets, offsets_size);
+        memcpy(memory + offsets_size, cmd->points.points, size);
+        cmd->points.band_offsets = (const u32 *)memory;
+        cmd->points.points = (const RenderPoint *)(memory + offsets_size);
+    }
+    else if (cmd->type == RCT_CIRCLES)
+    {
+        size_t offsets_size = (cmd->circles.bands_num + 1) * sizeof(u32);
+        size_t size = cmd->circles.circles_num * sizeof(RenderCircle);
+        u8 *memory = ReserveArrays(tiler, offsets_size + size);
+        memcpy(memory, cmd->circles.band_offsets, offsets_size);
+        memcpy(memory + offsets_size, cmd->circles.circles, size);
+        cmd->circles.band_offsets = (const u32 *)memory;
+        cmd->circles.circles = (const RenderCircle *)(memory + offsets_size);
+    }
+}
+
+static u8*
+ReserveArrays(RenderTiler *tiler, size_t size)
+{
+    /* Arrays are 8 bytes aligned. */
+    size = (size + 7) & ~(size_t)7;
+    if (size > tiler->arrays_capacity - tiler->arrays_size)
+    {
+        size_t capacity = tiler->arrays_capacity ? tiler->arrays_capacity : 65536;
+        while (size > capacity - tiler->arrays_size) capacity *= 2;
+        u8 *arrays = (u8 *)HelperFcn_MemAllocate(capacity);
+        if (tiler->arrays_size > 0) memcpy(arrays, tiler->arrays, tiler->arrays_size);
+
+        /* Pointers of the recorded commands keep their offsets in the memory. */
+        for (u32 i = 0; i < tiler->cmds_num; ++i)
+        {
+            RenderCmd *recorded = &tiler->cmds[i];
+            if (recorded->type == RCT_POLYGON)
+            {
+                recorded->polygon.vertices = (const Vec2 *)(arrays +
+                    ((const u8 *)recorded->polygon.vertices - tiler->arrays));
+            }
+            else if (recorded->type == RCT_POLYLINE)
+            {
+                recorded->polyline.points = (const Vec2 *)(arrays +
+                    ((const u8 *)recorded->polyline.points - tiler->arrays));
+            }
+            else if (recorded->type == RCT_RECTS)
+            {
+                recorded->rects.band_offsets = (const u32 *)(arrays +
+                    ((const u8 *)recorded->rects.band_offsets - tiler->arrays));
+                recorded->rects.rects = (const RenderRectInstance *)(arrays +
+                    ((const u8 *)recorded->rects.rects - tiler->arrays));
+            }
+            else if (recorded->type == RCT_POINTS)
+            {
+                recorded->points.band_offsets = (const u32 *)(arrays +
+                    ((const u8 *)recorded->points.band_offsets - tiler->arrays));
+                recorded->points.points = (const RenderPoint *)(arrays +
+                    ((const u8 *)recorded->points.points - tiler->arrays));
+            }
+            else if (recorded->type == RCT_CIRCLES)
+            {
+                recorded->circles.band_offsets = (const u32 *)(arrays +
+                    ((const u8 *)recorded->circles.band_offsets - tiler->arrays));
+                recorded->circles.circles = (const RenderCircle *)(arrays +
+                    ((const u8 *)recorded->circles.circles - tiler->arrays));
+            }
+        }
+        if (tiler->arrays) HelperFcn_MemFree(tiler->arrays);
+        tiler->arrays = arrays;
+        tiler->arrays_capacity = capacity;
+    }
+
+    u8 *memory = tiler->arrays + tiler->arrays_size;
+    tiler->arrays_size += size;
+    return memory;
+}
+
+static void
+BinCommands(RenderTiler *tiler)
+{
+    u32 tile_size = tiler->tile_size;
+    u32 tiles_num = tiler->tiles_x * tiler->tiles_y;
+
+    if (tiles_num + 1 > tiler->bins_capacity)
+    {
+        tiler->bins_capacity = tiles_num + 1;
+        tiler->bin_offsets = (u32 *)HelperFcn_MemReallocate(tiler->bin_offsets,
+            tiler->bins_capacity * sizeof(u32));
+    }
+    memset(tiler->bin_offsets, 0, (tiles_num + 1) * sizeof(u32));
+
+    /* Count the commands of every tile (counts are stored with the shift by one). */
+    u32 refs_num = 0;
+    for (u32 i = 0; i < tiler->cmds_num; ++i)
+    {
+        RenderRect *bounds = &tiler->cmds_bounds[i];
+        u32 tx0 = (u32)bounds->x0 / tile_size;
+        u32 ty0 = (u32)bounds->y0 / tile_size;
+        u32 tx1 = (u32)(bounds->x1 - 1) / tile_size;
+        u32 ty1 = (u32)(bounds->y1 - 1) / tile_size;
+        for (u32 ty = ty0; ty <= ty1; ++ty)
+        {
+            for (u32 tx = tx0; tx <= tx1; ++tx)
+            {
+                tiler->bin_offsets[tx + ty * tiler->tiles_x + 1]++;
+            }
+        }
+        refs_num += (tx1 - tx0 + 1) * (ty1 - ty0 + 1);
+    }
+
+    /* Prefix sum: bin_offsets[t] becomes the beginning of the bin t. */
+    for (u32 t = 1; t <= tiles_num; ++t)
+    {
+        tiler->bin_offsets[t] += tiler->bin_offsets[t - 1];
+    }
+
+    if (refs_num > tiler->bin_cmds_capacity)
+    {
+        tiler->bin_cmds_capacity = refs_num;
+        tiler->bin_cmds = (u32 *)HelperFcn_MemReallocate(tiler->bin_cmds,
+            tiler->bin_cmds_capacity * sizeof(u32));
+    }
+
+    /* Fill the bins keeping the order of the commands. bin_offsets[t] is used as the
+    write cursor of the bin t, so it ends up at the beginning of the bin t + 1. */
+    for (u32 i = 0; i < tiler->cmds_num; ++i)
+    {
+        RenderRect *bounds = &tiler->cmds_bounds[i];
+        u32 tx0 = (u32)bounds->x0 / tile_size;
+        u32 ty0 = (u32)bounds->y0 / tile_size;
+        u32 tx1 = (u32)(bounds->x1 - 1) / tile_size;
+        u32 ty1 = (u32)(bounds->y1 - 1) / tile_size;
+        for (u32 ty = ty0; ty <= ty1; ++ty)
+        {
+            for (u32 tx = tx0; tx <= tx1; ++tx)
+            {
+                u32 t = tx + ty * tiler->tiles_x;
+                tiler->bin_cmds[tiler->bin_offsets[t]++] = i;
+            }
+        }
+    }
+
+    /* Shift the cursors back, so the bin t is [bin_offsets[t], bin_offsets[t + 1]). */
+    memmove(tiler->bin_offsets + 1, tiler->bin_offsets, tiles_num * sizeof(u32));
+    tiler->bin_offsets[0] = 0;
+}
+
+static void
+RasterizeTile(void *data, u32 tile_index, u32 worker_index)
+{
+    RenderTiler *tiler = (RenderTiler *)data;
+    Render *worker = &tiler->workers[worker_index];
+    Render *render = tiler->render;
+
+    u32 begin = tiler->bin_offsets[tile_index];
+    u32 end = tiler->bin_offsets[tile_index + 1];
+    if (begin == end) return;
+
+    /* Restrict all the drawing of the worker to the tile. */
+    s32 tile_size = (s32)tiler->tile_size;
+    RenderRect tile;
+    tile.x0 = (s32)(tile_index % tiler->tiles_x) * tile_size;
+    tile.y0 = (s32)(tile_index / tiler->tiles_x) * tile_size;
+    tile.x1 = tile.x0 + tile_size;
+    tile.y1 = tile.y0 + tile_size;
+    if (tile.x0 < render->clip.x0) tile.x0 = render->clip.x0;
+    if (tile.y0 < render->clip.y0) tile.y0 = render->clip.y0;
+    if (tile.x1 > render->clip.x1) tile.x1 = render->clip.x1;
+    if (tile.y1 > render->clip.y1) tile.y1 = render->clip.y1;
+
+    /* Commands are clipped by their bounds too, since they could be submitted with a
+    smaller clip rectangle than the current one (uncovered parts of the occlusion). */
+    for (u32 i = begin; i < end; ++i)
+    {
+        u32 cmd_index = tiler->bin_cmds[i];
+        const RenderRect *bounds = &tiler->cmds_bounds[cmd_index];
+        worker->clip.x0 = (tile.x0 > bounds->x0) ? tile.x0 : bounds->x0;
+        worker->clip.y0 = (tile.y0 > bounds->y0) ? tile.y0 : bounds->y0;
+        worker->clip.x1 = (tile.x1 < bounds->x1) ? tile.x1 : bounds->x1;
+        worker->clip.y1 = (tile.y1 < bounds->y1) ? tile.y1 : bounds->y1;
+        Render_ExecuteCmd(worker, &tiler->cmds[cmd_index]);
+    }
+}
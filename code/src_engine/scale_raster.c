@@ -0,0 +1,375 @@
+/**
+ * ================================================================================
+ * @file src_engine/scale_raster.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the blitting of the image regions scaled by any
+ * positive factors with the precomputed sampling tables.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/scale_raster.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/render.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/texture.h"
+#include "include_engine/triangle_raster.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Structure for the cache of two source rows filtered horizontally (usually the
+ * lower and the upper rows of the previous destination row).
+ */
+struct ScaleRowCache_
+{
+    u32 *rows[2];  /**< Filtered rows (as wide as the drawn part of the destination). */
+    u32 row_offsets[2];  /**< Offsets of the source rows in the texels. */
+    b32 is_valid[2];  /**< Flags of the rows being filtered already. */
+};
+typedef struct ScaleRowCache_ ScaleRowCache;
+
+/**
+ * @brief Filling the table of the nearest texels for the pixels of a row or a column.
+ * @param origin Coordinate of the beginning of the scaled region.
+ * @param scale Scale of the region.
+ * @param begin Coordinate of the first pixel.
+ * @param count Amount of the pixels.
+ * @param first Index of the first texel of the region.
+ * @param size Amount of the texels of the region.
+ * @param offsets Offsets of the texture columns or rows.
+ * @param table Pointer to the offsets of the nearest texels.
+ */
+static void
+SetupNearestTable(f64 origin, f64 scale, s32 begin, u32 count, u32 first, u32 size,
+    const u32 *offsets, u32 *table);
+
+/**
+ * @brief Filling the tables of the two texels around the pixels of a row or a column.
+ * @param origin Coordinate of the beginning of the scaled region.
+ * @param scale Scale of the region.
+ * @param begin Coordinate of the first pixel.
+ * @param count Amount of the pixels.
+ * @param first Index of the first texel of the region.
+ * @param size Amount of the texels of the region.
+ * @param offsets Offsets of the texture columns or rows.
+ * @param table0 Pointer to the offsets of the texels before the pixel centers.
+ * @param table1 Pointer to the offsets of the texels after the pixel centers.
+ * @param weights Pointer to the weights of the second texels (from 0 to 255).
+ */
+static void
+SetupBilinearTable(f64 origin, f64 scale, s32 begin, u32 count, u32 first, u32 size,
+    const u32 *offsets, u32 *table0, u32 *table1, u32 *weights);
+
+/**
+ * @brief Blitting with the nearest filter.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param rect Pointer to the drawn pixels.
+ * @param texture Pointer to the texture.
+ * @param columns Offsets of the texels of every column of the rectangle.
+ * @param rows Offsets of the texel rows of every row of the rectangle.
+ * @param samples Pointer to a row of the samples to be blended.
+ * @param blend Blend mode.
+ */
+static void
+BlitNearest(void *memory, u32 pitch, const RenderRect *rect, const Texture *texture,
+    const u32 *columns, const u32 *rows, u32 *samples, BlendMode blend);
+
+/**
+ * @brief Blitting with the bilinear filter.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param rect Pointer to the drawn pixels.
+ * @param texture Pointer to the texture.
+ * @param columns Offsets of the left texels, the right ones and the weights of the right
+ * ones for every column of the rectangle (three tables one after another).
+ * @param rows Offsets of the lower texel rows, the upper ones and the weights of the
+ * upper ones for every row of the rectangle (three tables one after another).
+ * @param filtered Pointer to two rows of the horizontally filtered texels.
+ * @param samples Pointer to a row of the samples.
+ * @param blend Blend mode.
+ */
+static void
+BlitBilinear(void *memory, u32 pitch, const RenderRect *rect, const Texture *texture,
+    const u32 *columns, const u32 *rows, u32 *filtered, u32 *samples, BlendMode blend);
+
+/**
+ * @brief Getting a source row filtered horizontally from the cache, the missing row is
+ * filtered into the place of the row which is not kept.
+ * @param cache Pointer to the cache.
+ * @param texture Pointer to the texture.
+ * @param row_offset Offset of the source row.
+ * @param kept_row_offset Offset of the source row which should stay in the cache.
+ * @param columns Tables of the columns (as in BlitBilinear).
+ * @param count Amount of the columns.
+ * @return const u32* Filtered row.
+ */
+static const u32*
+GetFilteredRow(ScaleRowCache *cache, const Texture *texture, u32 row_offset,
+    u32 kept_row_offset, const u32 *columns, u32 count);
+
+/**
+ * @brief Linear interpolation of two colors (two channels at once).
+ * @param a First color (ARGB, premultiplied alpha).
+ * @param b Second color (ARGB, premultiplied alpha).
+ * @param weight Weight of the second color from 0 (none) to 255.
+ * @return u32 Interpolated color.
+ */
+static u32
+LerpColor(u32 a, u32 b, u32 weight);
+
+b32
+ScaleRaster_GetRect(f32 x, f32 y, u32 width, u32 height, f32 scale_x, f32 scale_y,
+    RenderRect *rect)
+{
+    if ((width == 0) || (height == 0)) return false;
+    if (!isfinite(x) || !isfinite(y) || !isfinite(scale_x) || !isfinite(scale_y) ||
+        !(scale_x > 0.0f) || !(scale_y > 0.0f))
+    {
+        return false;
+    }
+
+    /* First pixel with the center inside of the region and the one after the last. */
+    const f64 limit = TRIANGLE_RASTER_GUARD_BAND;
+    f64 x0 = ceil((f64)x - 0.5);
+    f64 y0 = ceil((f64)y - 0.5);
+    f64 x1 = ceil((f64)x + (f64)width * scale_x - 0.5);
+    f64 y1 = ceil((f64)y + (f64)height * scale_y - 0.5);
+    x0 = fmin(fmax(x0, -limit), limit);
+    y0 = fmin(fmax(y0, -limit), limit);
+    x1 = fmin(fmax(x1, -limit), limit);
+    y1 = fmin(fmax(y1, -limit), limit);
+    if ((x0 >= x1) || (y0 >= y1)) return false;
+
+    rect->x0 = (s32)x0;
+    rect->y0 = (s32)y0;
+    rect->x1 = (s32)x1;
+    rect->y1 = (s32)y1;
+    return true;
+}
+
+void
+ScaleRaster_Blit(void *memory, u32 pitch, const RenderRect *clip, const Texture *texture,
+    f32 x, f32 y, u32 src_x, u32 src_y, u32 width, u32 height, f32 scale_x, f32 scale_y,
+    TextureFilter filter, BlendMode blend)
+{
+    RenderRect rect;
+    if (!ScaleRaster_GetRect(x, y, width, height, scale_x, scale_y, &rect)) return;
+    if (rect.x0 < clip->x0) rect.x0 = clip->x0;
+    if (rect.y0 < clip->y0) rect.y0 = clip->y0;
+    if (rect.x1 > clip->x1) rect.x1 = clip->x1;
+    if (rect.y1 > clip->y1) rect.y1 = clip->y1;
+    if ((rect.x0 >= rect.x1) || (rect.y0 >= rect.y1)) return;
+
+    /* Tables of the columns and the rows are followed by the rows of the samples. Usual
+    sprites are small enough for the tables on the stack. */
+    u32 columns_num = (u32)(rect.x1 - rect.x0);
+    u32 rows_num = (u32)(rect.y1 - rect.y0);
+    size_t words_num = (filter == TF_BILINEAR) ?
+        (6 * (size_t)columns_num + 3 * (size_t)rows_num) :
+        (2 * (size_t)columns_num + (size_t)rows_num);
+    u32 stack_words[SCALE_RASTER_STACK_WORDS];
+    u32 *words = stack_words;
+    if (words_num > SCALE_RASTER_STACK_WORDS)
+        words = (u32 *)HelperFcn_MemAllocate(words_num * sizeof(u32));
+
+    u32 *columns = words;
+    if (filter == TF_BILINEAR)
+    {
+        u32 *rows = columns + 3 * columns_num;
+        SetupBilinearTable(x, scale_x, rect.x0, columns_num, src_x, width,
+            texture->column_offsets, columns, columns + columns_num,
+            columns + 2 * columns_num);
+        SetupBilinearTable(y, scale_y, rect.y0, rows_num, src_y, height,
+            texture->row_offsets, rows, rows + rows_num, rows + 2 * rows_num);
+        u32 *filtered = rows + 3 * rows_num;
+        BlitBilinear(memory, pitch, &rect, texture, columns, rows, filtered,
+            filtered + 2 * columns_num, blend);
+    }
+    else
+    {
+        u32 *rows = columns + columns_num;
+        SetupNearestTable(x, scale_x, rect.x0, columns_num, src_x, width,
+            texture->column_offsets, columns);
+        SetupNearestTable(y, scale_y, rect.y0, rows_num, src_y, height,
+            texture->row_offsets, rows);
+        BlitNearest(memory, pitch, &rect, texture, columns, rows, rows + rows_num, blend);
+    }
+
+    if (words != stack_words) HelperFcn_MemFree(words);
+}
+
+static void
+SetupNearestTable(f64 origin, f64 scale, s32 begin, u32 count, u32 first, u32 size,
+    const u32 *offsets, u32 *table)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        /* Texel under the pixel center (found from the pixel position only). */
+        f64 t = floor(((f64)(begin + (s32)i) + 0.5 - origin) / scale);
+        t = fmin(fmax(t, 0.0), (f64)(size - 1));
+        table[i] = offsets[first + (u32)t];
+    }
+}
+
+static void
+SetupBilinearTable(f64 origin, f64 scale, s32 begin, u32 count, u32 first, u32 size,
+    const u32 *offsets, u32 *table0, u32 *table1, u32 *weights)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        /* Position relative to the texel centers with 8 fractional bits. */
+        f64 t = (((f64)(begin + (s32)i) + 0.5 - origin) / scale - 0.5) * 256.0;
+        t = fmin(fmax(floor(t), -256.0), (f64)size * 256.0);
+        s64 fixed = (s64)t;
+        s64 t0 = fixed >> 8;
+        s64 t1 = t0 + 1;
+        u32 weight = (u32)(fixed & 0xff);
+
+        /* Texels outside of the region are clamped to its edges. */
+        s64 t_max = (s64)size - 1;
+        t0 = (t0 < 0) ? 0 : ((t0 > t_max) ? t_max : t0);
+        t1 = (t1 < 0) ? 0 : ((t1 > t_max) ? t_max : t1);
+        table0[i] = offsets[first + (u32)t0];
+        table1[i] = offsets[first + (u32)t1];
+        weights[i] = (t0 == t1) ? 0 : weight;
+    }
+}
+
+static void
+BlitNearest(void *memory, u32 pitch, const RenderRect *rect, const Texture *texture,
+    const u32 *columns, const u32 *rows, u32 *samples, BlendMode blend)
+{
+    /* Opaque texels replace the destination, so they are copied right into it. */
+    b32 is_direct = texture->is_opaque && ((blend == BM_NONE) || (blend == BM_ALPHA));
+    if (blend == BM_NONE) blend = BM_ALPHA;
+
+    u32 count = (u32)(rect->x1 - rect->x0);
+    u32 rows_num = (u32)(rect->y1 - rect->y0);
+    for (u32 j = 0; j < rows_num; ++j)
+    {
+        u32 *dst = (u32 *)((u8 *)memory + (size_t)pitch * (u32)(rect->y0 + (s32)j)) +
+            rect->x0;
+        if (is_direct) RENDER_STATS_COUNT_ROW(dst, count);
+
+        /* Rows of the same texel row are identical, unless they are blended. */
+        b32 is_repeated = (j > 0) && (rows[j] == rows[j - 1]);
+        if (is_repeated && is_direct)
+        {
+            memcpy(dst, (u8 *)dst - pitch, count * sizeof(u32));
+            continue;
+        }
+        if (!is_repeated)
+        {
+            const u32 *texels = texture->texels + rows[j];
+            u32 *row = is_direct ? dst : samples;
+            for (u32 i = 0; i < count; ++i)
+            {
+                row[i] = texels[columns[i]];
+            }
+        }
+        if (!is_direct) Blend_Row(dst, samples, count, blend);
+    }
+}
+
+static void
+BlitBilinear(void *memory, u32 pitch, const RenderRect *rect, const Texture *texture,
+    const u32 *columns, const u32 *rows, u32 *filtered, u32 *samples, BlendMode blend)
+{
+    /* Interpolated opaque texels stay opaque. */
+    b32 is_direct = texture->is_opaque && ((blend == BM_NONE) || (blend == BM_ALPHA));
+    if (blend == BM_NONE) blend = BM_ALPHA;
+
+    u32 count = (u32)(rect->x1 - rect->x0);
+    u32 rows_num = (u32)(rect->y1 - rect->y0);
+    const u32 *rows0 = rows;
+    const u32 *rows1 = rows + rows_num;
+    const u32 *weights = rows + 2 * rows_num;
+
+    ScaleRowCache cache;
+    cache.rows[0] = filtered;
+    cache.rows[1] = filtered + count;
+    cache.is_valid[0] = false;
+    cache.is_valid[1] = false;
+    const u32 *row_samples = NULL;
+
+    for (u32 j = 0; j < rows_num; ++j)
+    {
+        u32 *dst = (u32 *)((u8 *)memory + (size_t)pitch * (u32)(rect->y0 + (s32)j)) +
+            rect->x0;
+        if (is_direct) RENDER_STATS_COUNT_ROW(dst, count);
+
+        /* Rows with the same texel rows and weight are identical, unless blended. */
+        b32 is_repeated = (j > 0) && (rows0[j] == rows0[j - 1]) &&
+            (rows1[j] == rows1[j - 1]) && (weights[j] == weights[j - 1]);
+        if (is_repeated && is_direct)
+        {
+            memcpy(dst, (u8 *)dst - pitch, count * sizeof(u32));
+            continue;
+        }
+        if (!is_repeated)
+        {
+            /* Filtered rows are shared by the neighbour destination rows. */
+            const u32 *lower = GetFilteredRow(&cache, texture, rows0[j], rows1[j], columns,
+                count);
+            row_samples = lower;
+            if (weights[j] != 0)
+            {
+                const u32 *upper = GetFilteredRow(&cache, texture, rows1[j], rows0[j],
+                    columns, count);
+                u32 *row = is_direct ? dst : samples;
+                u32 weight = weights[j];
+                for (u32 i = 0; i < count; ++i)
+                {
+                    row[i] = LerpColor(lower[i], upper[i], weight);
+                }
+                row_samples = row;
+            }
+        }
+        if (!is_direct)
+            Blend_Row(dst, row_samples, count, blend);
+        else if (row_samples != dst)
+            memcpy(dst, row_samples, count * sizeof(u32));
+    }
+}
+
+static const u32*
+GetFilteredRow(ScaleRowCache *cache, const Texture *texture, u32 row_offset,
+    u32 kept_row_offset, const u32 *columns, u32 count)
+{
+    for (u32 k = 0; k < 2; ++k)
+    {
+        if (cache->is_valid[k] && (cache->row_offsets[k] == row_offset))
+            return cache->rows[k];
+    }
+
+    u32 k = (cache->is_valid[0] && (cache->row_offsets[0] == kept_row_offset)) ? 1 : 0;
+    const u32 *texels = texture->texels + row_offset;
+    const u32 *columns0 = columns;
+    const u32 *columns1 = columns + count;
+    const u32 *weights = columns + 2 * count;
+    u32 *row = cache->rows[k];
+    for (u32 i = 0; i < count; ++i)
+    {
+        row[i] = LerpColor(texels[columns0[i]], texels[columns1[i]], weights[i]);
+    }
+    cache->row_offsets[k] = row_offset;
+    cache->is_valid[k] = true;
+    return row;
+}
+
+static u32
+LerpColor(u32 a, u32 b, u32 weight)
+{
+    /* Weights sum up to 256, so every channel stays inside of its 16 bit lane. */
+    u32 weight_a = 256 - weight;
+    u32 rb = ((a & 0x00ff00ff) * weight_a + (b & 0x00ff00ff) * weight) >> 8;
+    u32 ag = ((a >> 8) & 0x00ff00ff) * weight_a + ((b >> 8) & 0x00ff00ff) * weight;
+    return (rb & 0x00ff00ff) | (ag & 0xff00ff00);
+}
@@ -0,0 +1,420 @@
+/**
+ * ================================================================================
+ * @file src_engine/span_fill.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for filling horizontal spans of 32 bit pixels.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/span_fill.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/utils.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SPAN_FILL_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#endif
+
+/* GCC and Clang need the target attribute to compile the intrinsics of an
+instruction set which is not enabled for the whole translation unit. */
+#if defined(SPAN_FILL_X86) && !defined(_MSC_VER)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+/* Blocks bigger than this size (in bytes) are cleared with non-temporal stores. */
+#define SPAN_FILL_STREAM_MIN_BYTES (1024 * 1024)
+
+/* Declare pointer to the row fill kernel. */
+typedef void span_fill_row_t(u32 *dst, u32 count, u32 value);
+
+/**
+ * @brief Filling a span with plain C stores.
+ * @param dst Pointer to the first pixel of the span.
+ * @param count Amount of pixels in the span.
+ * @param value 32 bit value to fill with.
+ */
+static void
+FillRowScalar(u32 *dst, u32 count, u32 value);
+
+#ifdef SPAN_FILL_X86
+/**
+ * @brief Filling a span with aligned 128 bit SSE2 stores.
+ * @param dst Pointer to the first pixel of the span.
+ * @param count Amount of pixels in the span.
+ * @param value 32 bit value to fill with.
+ */
+static void
+FillRowSse2(u32 *dst, u32 count, u32 value);
+
+/**
+ * @brief Filling a span with non-temporal 128 bit SSE2 stores.
+ * @param dst Pointer to the first pixel of the span.
+ * @param count Amount of pixels in the span.
+ * @param value 32 bit value to fill with.
+ */
+static void
+FillRowStreamSse2(u32 *dst, u32 count, u32 value);
+
+/**
+ * @brief Filling a span with aligned 256 bit AVX2 stores.
+ * @param dst Pointer to the first pixel of the span.
+ * @param count Amount of pixels in the span.
+ * @param value 32 bit value to fill with.
+ */
+static void
+FillRowAvx2(u32 *dst, u32 count, u32 value);
+
+/**
+ * @brief Filling a span with non-temporal 256 bit AVX2 stores.
+ * @param dst Pointer to the first pixel of the span.
+ * @param count Amount of pixels in the span.
+ * @param value 32 bit value to fill with.
+ */
+static void
+FillRowStreamAvx2(u32 *dst, u32 count, u32 value);
+
+/**
+ * @brief Determination if the CPU and the OS support the AVX2 instructions.
+ * @return b32 Result of the check.
+ */
+static b32
+IsAvx2Supported(void);
+#endif
+
+static SpanFillIsa current_isa = SFI_SCALAR;  /* Instruction set of the kernels. */
+static span_fill_row_t *fill_row = FillRowScalar;  /* Kernel for regular stores. */
+static span_fill_row_t *fill_row_stream = FillRowScalar;  /* Kernel for NT stores. */
+
+void
+SpanFill_Init(void)
+{
+    /* Select the best of the supported instruction sets. */
+    if (!SpanFill_SetIsa(SFI_AVX2))
+    {
+        if (!SpanFill_SetIsa(SFI_SSE2))
+        {
+            SpanFill_SetIsa(SFI_SCALAR);
+        }
+    }
+}
+
+SpanFillIsa
+SpanFill_GetIsa(void)
+{
+    return current_isa;
+}
+
+b32
+SpanFill_SetIsa(SpanFillIsa isa)
+{
+    switch (isa)
+    {
+    case SFI_SCALAR:
+    {
+        fill_row = FillRowScalar;
+        fill_row_stream = FillRowScalar;
+    } break;
+
+#ifdef SPAN_FILL_X86
+    case SFI_SSE2:
+    {
+        /* SSE2 is a part of the x64 baseline and all the supported x86 CPUs. */
+        fill_row = FillRowSse2;
+        fill_row_stream = FillRowStreamSse2;
+    } break;
+
+    case SFI_AVX2:
+    {
+        if (!IsAvx2Supported()) return false;
+        fill_row = FillRowAvx2;
+        fill_row_stream = FillRowStreamAvx2;
+    } break;
+#endif
+
+    default:
+    {
+        return false;
+    }}
+    current_isa = isa;
+    return true;
+}
+
+const char*
+SpanFill_GetIsaName(SpanFillIsa isa)
+{
+    switch (isa)
+    {
+    case SFI_SCALAR: return "scalar";
+    case SFI_SSE2: return "sse2";
+    case SFI_AVX2: return "avx2";
+    default: return "unknown";
+    }
+}
+
+void
+SpanFill_Row(u32 *dst, u32 count, u32 value)
+{
+    fill_row(dst, count, value);
+    RENDER_STATS_COUNT_ROW(dst, count);
+}
+
+void
+SpanFill_Rect(void *dst, u32 pitch, u32 width, u32 height, u32 value)
+{
+    if ((width == 0) || (height == 0)) return;
+    RENDER_STATS_COUNT_RECT(dst, pitch, width, height);
+
+    /* Rows without gaps are filled as one long span. */
+    if (pitch == width * sizeof(u32))
+    {
+        fill_row((u32 *)dst, width * height, value);
+        return;
+    }
+
+    /* Narrow blocks (vertical lines) are cheaper without the kernel call per row. */
+    u8 *row = (u8 *)dst;
+    if (width < 8)
+    {
+        for (u32 y = 0; y < height; ++y)
+        {
+            FillRowScalar((u32 *)row, width, value);
+            row += pitch;
+        }
+        return;
+    }
+
+    for (u32 y = 0; y < height; ++y)
+    {
+        fill_row((u32 *)row, width, value);
+        row += pitch;
+    }
+}
+
+void
+SpanFill_Clear(void *dst, u32 pitch, u32 width, u32 height, u32 value)
+{
+    if ((size_t)pitch * height < SPAN_FILL_STREAM_MIN_BYTES)
+    {
+        SpanFill_Rect(dst, pitch, width, height, value);
+        return;
+    }
+    RENDER_STATS_COUNT_RECT(dst, pitch, width, height);
+
+    if (pitch == width * sizeof(u32))
+    {
+        fill_row_stream((u32 *)dst, width * height, value);
+    }
+    else
+    {
+        u8 *row = (u8 *)dst;
+        for (u32 y = 0; y < height; ++y)
+        {
+            fill_row_stream((u32 *)row, width, value);
+            row += pitch;
+        }
+    }
+
+#ifdef SPAN_FILL_X86
+    /* Make the non-temporal stores visible before any following regular stores. */
+    _mm_sfence();
+#endif
+}
+
+static void
+FillRowScalar(u32 *dst, u32 count, u32 value)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        dst[i] = value;
+    }
+}
+
+#ifdef SPAN_FILL_X86
+TARGET_SSE2 static void
+FillRowSse2(u32 *dst, u32 count, u32 value)
+{
+    u32 *end = dst + count;
+
+    /* Unaligned head: single pixels until the 16 bytes boundary. */
+    while ((dst < end) && ((uintptr_t)dst & 15))
+    {
+        *dst++ = value;
+    }
+
+    /* Aligned body: 16 pixels per iteration, then 4 pixels per iteration. */
+    __m128i v = _mm_set1_epi32((int)value);
+    while (end - dst >= 16)
+    {
+        _mm_store_si128((__m128i *)(dst + 0), v);
+        _mm_store_si128((__m128i *)(dst + 4), v);
+        _mm_store_si128((__m128i *)(dst + 8), v);
+        _mm_store_si128((__m128i *)(dst + 12), v);
+        dst += 16;
+    }
+    while (end - dst >= 4)
+    {
+        _mm_store_si128((__m128i *)dst, v);
+        dst += 4;
+    }
+
+    /* Unaligned tail. */
+    while (dst < end)
+    {
+        *dst++ = value;
+    }
+}
+
+TARGET_SSE2 static void
+FillRowStreamSse2(u32 *dst, u32 count, u32 value)
+{
+    u32 *end = dst + count;
+
+    while ((dst < end) && ((uintptr_t)dst & 15))
+    {
+        *dst++ = value;
+    }
+
+    __m128i v = _mm_set1_epi32((int)value);
+    while (end - dst >= 16)
+    {
+        _mm_stream_si128((__m128i *)(dst + 0), v);
+        _mm_stream_si128((__m128i *)(dst + 4), v);
+        _mm_stream_si128((__m128i *)(dst + 8), v);
+        _mm_stream_si128((__m128i *)(dst + 12), v);
+        dst += 16;
+    }
+    while (end - dst >= 4)
+    {
+        _mm_stream_si128((__m128i *)dst, v);
+        dst += 4;
+    }
+
+    while (dst < end)
+    {
+        *dst++ = value;
+    }
+}
+
+TARGET_AVX2 static void
+FillRowAvx2(u32 *dst, u32 count, u32 value)
+{
+    u32 *end = dst + count;
+
+    /* Unaligned head: single pixels until the 32 bytes boundary. */
+    while ((dst < end) && ((uintptr_t)dst & 31))
+    {
+        *dst++ = value;
+    }
+
+    /* Aligned body: 32 pixels per iteration, then 8 pixels per iteration. */
+    __m256i v = _mm256_set1_epi32((int)value);
+    while (end - dst >= 32)
+    {
+        _mm256_store_si256((__m256i *)(dst + 0), v);
+        _mm256_store_si256((__m256i *)(dst + 8), v);
+        _mm256_store_si256((__m256i *)(dst + 16), v);
+        _mm256_store_si256((__m256i *)(dst + 24), v);
+        dst += 32;
+    }
+    while (end - dst >= 8)
+    {
+        _mm256_store_si256((__m256i *)dst, v);
+        dst += 8;
+    }
+
+    /* Unaligned tail. */
+    while (dst < end)
+    {
+        *dst++ = value;
+    }
+}
+
+TARGET_AVX2 static void
+FillRowStreamAvx2(u32 *dst, u32 count, u32 value)
+{
+    u32 *end = dst + count;
+
+    while ((dst < end) && ((uintptr_t)dst & 31))
+    {
+        *dst++ = value;
+    }
+
+    __m256i v = _mm256_set1_epi32((int)value);
+    while (end - dst >= 32)
+    {
+        _mm256_stream_si256((__m256i *)(dst + 0), v);
+        _mm256_stream_si256((__m256i *)(dst + 8), v);
+        _mm256_stream_si256((__m256i *)(dst + 16), v);
+        _mm256_stream_si256((__m256i *)(dst + 24), v);
+        dst += 32;
+    }
+    while (end - dst >= 8)
+    {
+        _mm256_stream_si256((__m256i *)dst, v);
+        dst += 8;
+    }
+
+    while (dst < end)
+    {
+        *dst++ = value;
+    }
+}
+
+static b32
+IsAvx2Supported(void)
+{
+    u32 max_leaf, ecx_1, ebx_7;
+    u64 xcr0;
+
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0);
+    max_leaf = (u32)regs[0];
+    if (max_leaf < 7) return false;
+    __cpuid(regs, 1);
+    ecx_1 = (u32)regs[2];
+    __cpuidex(regs, 7, 0);
+    ebx_7 = (u32)regs[1];
+#else
+    unsigned int eax, ebx, ecx, edx;
+    max_leaf = __get_cpuid_max(0, NULL);
+    if (max_leaf < 7) return false;
+    __cpuid(1, eax, ebx, ecx, edx);
+    ecx_1 = ecx;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    ebx_7 = ebx;
+#endif
+
+    /* The CPU should support AVX and the OS should save the YMM registers. */
+    b32 is_osxsave = (ecx_1 & (1u << 27)) != 0;
+    b32 is_avx = (ecx_1 & (1u << 28)) != 0;
+    if (!is_osxsave || !is_avx) return false;
+
+#ifdef _MSC_VER
+    xcr0 = (u64)_xgetbv(0);
+#else
+    u32 xcr0_lo, xcr0_hi;
+    __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    xcr0 = ((u64)xcr0_hi << 32) | xcr0_lo;
+#endif
+    if ((xcr0 & 0x6) != 0x6) return false;
+
+    return (ebx_7 & (1u << 5)) != 0;
+}
+#endif
@@ -0,0 +1,111 @@
+/**
+ * ================================================================================
+ * @file src_engine/sprite.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the work with the compiled sprites.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/sprite.h"
+
+#include "include_engine/helper_functions.h"
+#include "include_engine/image.h"
+#include "include_engine/pixel_format.h"
+#include "include_engine/utils.h"
+
+Sprite*
+Sprite_Constructor(void)
+{
+    size_t size = sizeof(Sprite);
+    Sprite *sprite = (Sprite *)HelperFcn_MemAllocate(size);
+    return sprite;
+}
+
+Sprite*
+Sprite_Destructor(Sprite *sprite)
+{
+    if (sprite->spans) HelperFcn_MemFree(sprite->spans);
+    if (sprite->row_spans) HelperFcn_MemFree(sprite->row_spans);
+    if (sprite->pixels) HelperFcn_MemFree(sprite->pixels);
+    HelperFcn_MemFree(sprite);
+    return NULL;
+}
+
+void
+Sprite_InitByImage(Sprite *sprite, const Image *image)
+{
+    sprite->width = image->width;
+    sprite->height = image->height;
+
+    /* Pixels of the image in the render buffer format. */
+    size_t image_size = (size_t)image->width * image->height;
+    u32 *converted = (u32 *)HelperFcn_MemAllocate((image_size ? image_size : 1) *
+        sizeof(u32));
+    u32 pitch = PixelFormat_GetPitch(image->format, image->width);
+    for (u32 i = 0; i < image->height; ++i)
+    {
+        PixelFormat_ConvertRow(converted + (size_t)image->width * i, PF_BGRA_PREMULTIPLIED,
+            (const u8 *)image->data + (size_t)pitch * i, image->format, image->width);
+    }
+
+    /* Count the spans and the visible pixels. Pixel kind: 0 - transparent,
+    1 - translucent, 2 - opaque. */
+    u32 spans_num = 0;
+    u32 pixels_num = 0;
+    const u32 *data = converted;
+    for (u32 i = 0; i < image->height; ++i)
+    {
+        u32 kind = 0;
+        for (u32 j = 0; j < image->width; ++j)
+        {
+            u32 alpha = *data++ >> 24;
+            u32 pixel_kind = (alpha == 0x00) ? 0 : ((alpha == 0xff) ? 2 : 1);
+            if (pixel_kind && (pixel_kind != kind)) spans_num++;
+            if (pixel_kind) pixels_num++;
+            kind = pixel_kind;
+        }
+    }
+
+    sprite->spans_num = spans_num;
+    sprite->pixels_num = pixels_num;
+    sprite->spans = (SpriteSpan *)HelperFcn_MemAllocate((spans_num ? spans_num : 1) *
+        sizeof(SpriteSpan));
+    sprite->row_spans = (u32 *)HelperFcn_MemAllocate((image->height + 1) * sizeof(u32));
+    sprite->pixels = (u32 *)HelperFcn_MemAllocate((pixels_num ? pixels_num : 1) *
+        sizeof(u32));
+
+    /* Record the spans with the converted pixels. */
+    SpriteSpan *span = NULL;
+    u32 span_index = 0;
+    u32 pixel_index = 0;
+    data = converted;
+    for (u32 i = 0; i < image->height; ++i)
+    {
+        sprite->row_spans[i] = span_index;
+        u32 kind = 0;
+        for (u32 j = 0; j < image->width; ++j)
+        {
+            u32 pixel = *data++;
+            u32 alpha = pixel >> 24;
+            u32 pixel_kind = (alpha == 0x00) ? 0 : ((alpha == 0xff) ? 2 : 1);
+            if (pixel_kind)
+            {
+                if (pixel_kind != kind)
+                {
+                    span = &sprite->spans[span_index++];
+                    span->x = j;
+                    span->length = 0;
+                    span->offset = pixel_index;
+                    span->is_opaque = (pixel_kind == 2);
+                }
+                span->length++;
+                sprite->pixels[pixel_index++] = pixel;
+            }
+            kind = pixel_kind;
+        }
+    }
+    sprite->row_spans[image->height] = span_index;
+    HelperFcn_MemFree(converted);
+}
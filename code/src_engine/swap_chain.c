@@ -0,0 +1,156 @@
+/**
+ * ================================================================================
+ * @file src_engine/swap_chain.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the lock-free handoff of the frame
+ * buffers between the producer and the consumer threads.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/swap_chain.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#include "include_engine/atomic.h"
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Giving the rest of the time slice of the thread to other threads.
+ */
+static void
+YieldThread(void);
+
+SwapChain*
+SwapChain_Constructor(void)
+{
+    size_t size = sizeof(SwapChain);
+    SwapChain *swap_chain = (SwapChain *)HelperFcn_MemAllocate(size);
+    return swap_chain;
+}
+
+SwapChain*
+SwapChain_Destructor(SwapChain *swap_chain)
+{
+    HelperFcn_MemFree(swap_chain);
+    return NULL;
+}
+
+void
+SwapChain_Init(SwapChain *swap_chain, u32 buffers_num)
+{
+    dbg_check((buffers_num >= 2) && (buffers_num <= SWAP_CHAIN_BUFFERS_MAX), "%s",
+        "Swap chain should have 2 or 3 buffers!");
+
+    swap_chain->buffers_num = buffers_num;
+    swap_chain->front = 0;
+    swap_chain->back = 1;
+    for (u32 i = 0; i < SWAP_CHAIN_BUFFERS_MAX; ++i)
+    {
+        swap_chain->frames[i] = 0;
+    }
+
+    /* The third buffer waits in the slot as a spare one (nothing to present yet). */
+    Atomic_Store(&swap_chain->slot, (buffers_num == 3) ? 2 : SWAP_CHAIN_NONE);
+    Atomic_Store(&swap_chain->frames_published, 0);
+    Atomic_Store(&swap_chain->frames_presented, 0);
+    Atomic_Store(&swap_chain->frames_dropped, 0);
+    Atomic_Store(&swap_chain->frames_repeated, 0);
+}
+
+s32
+SwapChain_Publish(SwapChain *swap_chain)
+{
+    s32 published = swap_chain->back;
+    dbg_check(published != SWAP_CHAIN_NONE, "%s", "No back buffer to publish!");
+
+    /* Number the frame before the buffer is visible to the consumer. */
+    u32 frame = (u32)Atomic_Increment(&swap_chain->frames_published);
+    swap_chain->frames[published] = frame;
+
+    /* The previous content of the slot becomes the next back buffer. A fresh frame in
+    the slot was never taken by the consumer, so it is dropped. */
+    s32 slot = Atomic_Exchange(&swap_chain->slot, published | SWAP_CHAIN_FRESH);
+    if (slot == SWAP_CHAIN_NONE)
+    {
+        swap_chain->back = SWAP_CHAIN_NONE;
+    }
+    else
+    {
+        if (slot & SWAP_CHAIN_FRESH) Atomic_Increment(&swap_chain->frames_dropped);
+        swap_chain->back = slot & ~SWAP_CHAIN_FRESH;
+    }
+    return published;
+}
+
+s32
+SwapChain_AcquireBack(SwapChain *swap_chain)
+{
+    if (swap_chain->back != SWAP_CHAIN_NONE) return swap_chain->back;
+
+    /* Only a buffer given back by the consumer could be taken from the slot. */
+    s32 slot = Atomic_Load(&swap_chain->slot);
+    if ((slot == SWAP_CHAIN_NONE) || (slot & SWAP_CHAIN_FRESH)) return SWAP_CHAIN_NONE;
+    if (Atomic_CompareExchange(&swap_chain->slot, SWAP_CHAIN_NONE, slot) != slot)
+    {
+        return SWAP_CHAIN_NONE;
+    }
+    swap_chain->back = slot;
+    return slot;
+}
+
+s32
+SwapChain_WaitBack(SwapChain *swap_chain)
+{
+    s32 back = SwapChain_AcquireBack(swap_chain);
+    while (back == SWAP_CHAIN_NONE)
+    {
+        YieldThread();
+        back = SwapChain_AcquireBack(swap_chain);
+    }
+    return back;
+}
+
+b32
+SwapChain_AcquireFront(SwapChain *swap_chain)
+{
+    /* Once the slot holds a fresh frame only the consumer could take it out, the
+    producer could only replace it by a fresher one. */
+    s32 slot = Atomic_Load(&swap_chain->slot);
+    if ((slot == SWAP_CHAIN_NONE) || !(slot & SWAP_CHAIN_FRESH))
+    {
+        Atomic_Increment(&swap_chain->frames_repeated);
+        return false;
+    }
+
+    slot = Atomic_Exchange(&swap_chain->slot, swap_chain->front);
+    swap_chain->front = slot & ~SWAP_CHAIN_FRESH;
+    Atomic_Increment(&swap_chain->frames_presented);
+    return true;
+}
+
+void
+SwapChain_GetStats(SwapChain *swap_chain, SwapChainStats *stats)
+{
+    stats->frames_published = (u32)Atomic_Load(&swap_chain->frames_published);
+    stats->frames_presented = (u32)Atomic_Load(&swap_chain->frames_presented);
+    stats->frames_dropped = (u32)Atomic_Load(&swap_chain->frames_dropped);
+    stats->frames_repeated = (u32)Atomic_Load(&swap_chain->frames_repeated);
+}
+
+static void
+YieldThread(void)
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
@@ -0,0 +1,113 @@
+/**
+ * ================================================================================
+ * @file src_engine/texture.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the work with the textures.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/texture.h"
+
+#include "include_engine/helper_functions.h"
+#include "include_engine/image.h"
+#include "include_engine/pixel_format.h"
+#include "include_engine/utils.h"
+
+/**
+ * @brief Spreading the bits of a coordinate inside of a tile to the even bits, so the
+ * coordinates of the both axes are interleaved into the Morton index.
+ * @param value Coordinate inside of the tile.
+ * @return u32 Value with the bits moved to the even positions.
+ */
+static u32
+SpreadBits(u32 value);
+
+Texture*
+Texture_Constructor(void)
+{
+    size_t size = sizeof(Texture);
+    Texture *texture = (Texture *)HelperFcn_MemAllocate(size);
+    return texture;
+}
+
+Texture*
+Texture_Destructor(Texture *texture)
+{
+    if (texture->texels) HelperFcn_MemFree(texture->texels);
+    if (texture->column_offsets) HelperFcn_MemFree(texture->column_offsets);
+    if (texture->row_offsets) HelperFcn_MemFree(texture->row_offsets);
+    HelperFcn_MemFree(texture);
+    return NULL;
+}
+
+void
+Texture_InitByImage(Texture *texture, const Image *image, TextureLayout layout)
+{
+    u32 width = image->width;
+    u32 height = image->height;
+    texture->width = width;
+    texture->height = height;
+    texture->layout = layout;
+    texture->column_offsets = (u32 *)HelperFcn_MemAllocate((width ? width : 1) *
+        sizeof(u32));
+    texture->row_offsets = (u32 *)HelperFcn_MemAllocate((height ? height : 1) *
+        sizeof(u32));
+
+    /* The tiled layout is padded to the whole tiles (the padding is never sampled). */
+    const u32 tile_size = TEXTURE_TILE_SIZE;
+    size_t texels_num = (size_t)width * height;
+    if (layout == TL_TILED)
+    {
+        u32 tiles_x = (width + tile_size - 1) / tile_size;
+        u32 tiles_y = (height + tile_size - 1) / tile_size;
+        texels_num = (size_t)tiles_x * tiles_y * tile_size * tile_size;
+        for (u32 x = 0; x < width; ++x)
+        {
+            texture->column_offsets[x] = (x / tile_size) * tile_size * tile_size +
+                SpreadBits(x % tile_size);
+        }
+        for (u32 y = 0; y < height; ++y)
+        {
+            texture->row_offsets[y] = (y / tile_size) * tiles_x * tile_size * tile_size +
+                (SpreadBits(y % tile_size) << 1);
+        }
+    }
+    else
+    {
+        for (u32 x = 0; x < width; ++x) texture->column_offsets[x] = x;
+        for (u32 y = 0; y < height; ++y) texture->row_offsets[y] = y * width;
+    }
+    texture->texels = (u32 *)HelperFcn_MemAllocate((texels_num ? texels_num : 1) *
+        sizeof(u32));
+
+    /* Convert the pixels to the render buffer format row by row. */
+    b32 is_opaque = true;
+    u32 *converted = (u32 *)HelperFcn_MemAllocate((width ? width : 1) * sizeof(u32));
+    u32 pitch = PixelFormat_GetPitch(image->format, width);
+    for (u32 y = 0; y < height; ++y)
+    {
+        PixelFormat_ConvertRow(converted, PF_BGRA_PREMULTIPLIED,
+            (const u8 *)image->data + (size_t)pitch * y, image->format, width);
+        u32 *row = texture->texels + texture->row_offsets[y];
+        for (u32 x = 0; x < width; ++x)
+        {
+            if ((converted[x] >> 24) != 0xff) is_opaque = false;
+            row[texture->column_offsets[x]] = converted[x];
+        }
+    }
+    HelperFcn_MemFree(converted);
+    texture->is_opaque = is_opaque;
+}
+
+static u32
+SpreadBits(u32 value)
+{
+    u32 result = 0;
+    for (u32 bit = 0; (value >> bit) != 0; ++bit)
+    {
+        result |= ((value >> bit) & 1) << (2 * bit);
+    }
+    return result;
+}
@@ -0,0 +1,447 @@
+/**
+ * ================================================================================
+ * @file src_engine/texture_raster.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the rasterization of the affine texture mapped
+ * triangles and quads.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/texture_raster.h"
+
+#include <math.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/texture.h"
+#include "include_engine/triangle_raster.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#define TEXTURE_RASTER_CHUNK 256  /* Amount of texels sampled before the blending. */
+
+/* Declare pointer to the function sampling the texels of a span. */
+typedef void sample_row_t(const Texture *texture, s64 u, s64 v, s64 du, s64 dv, u32 count,
+    u32 *dst);
+
+/**
+ * @brief Structure for the affine mapping of the pixels to the texture coordinates
+ * (fixed point with TEXTURE_RASTER_UV_BITS fractional bits).
+ */
+struct TextureMapping_
+{
+    s64 u;  /**< U coordinate at the center of the pixel (0, 0). */
+    s64 v;  /**< V coordinate at the center of the pixel (0, 0). */
+    s64 du_dx;  /**< Increment of the U coordinate for the next pixel in a row. */
+    s64 dv_dx;  /**< Increment of the V coordinate for the next pixel in a row. */
+    s64 du_dy;  /**< Increment of the U coordinate for the next row. */
+    s64 dv_dy;  /**< Increment of the V coordinate for the next row. */
+};
+typedef struct TextureMapping_ TextureMapping;
+
+/**
+ * @brief Structure for an edge function E(x, y) = a * x + b * y + c of the pixel (x, y)
+ * (as in the triangle raster). The pixel is on the inner side when E(x, y) >= 0.
+ */
+struct TextureEdge_
+{
+    s64 a;  /**< Increment of the function for the next pixel in a row. */
+    s64 b;  /**< Increment of the function for the next row. */
+    s64 c;  /**< Value of the function for the pixel (0, 0) with the fill rule bias. */
+};
+typedef struct TextureEdge_ TextureEdge;
+
+/**
+ * @brief Getting the affine mapping of the pixels to the texture by three vertices.
+ * @param vertices Three vertices.
+ * @param uvs Texture coordinates of the vertices.
+ * @param filter Filter of the texture sampling (texel centers are shifted for bilinear).
+ * @param mapping Pointer to the mapping to be set.
+ * @return b32 False if the vertices are degenerate or the mapping is out of range.
+ */
+static b32
+SetupMapping(const Vec2 *vertices, const Vec2 *uvs, TextureFilter filter,
+    TextureMapping *mapping);
+
+/**
+ * @brief Filling a convex polygon with all the vertices inside of the guard band.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param texture Pointer to the texture.
+ * @param vertices Vertices of the polygon.
+ * @param vertices_num Amount of the vertices.
+ * @param mapping Pointer to the mapping of the pixels to the texture.
+ * @param filter Filter of the texture sampling.
+ * @param blend Blend mode.
+ */
+static void
+FillPolygon(void *memory, u32 pitch, const RenderRect *clip, const Texture *texture,
+    const Vec2 *vertices, u32 vertices_num, const TextureMapping *mapping,
+    TextureFilter filter, BlendMode blend);
+
+/**
+ * @brief Clipping a convex polygon by a side of the guard band (Sutherland-Hodgman).
+ * @param src Vertices of the polygon.
+ * @param src_num Amount of the vertices of the polygon.
+ * @param dst Vertices of the clipped polygon (up to one vertex more).
+ * @param axis Axis of the side (0 - Ox, 1 - Oy).
+ * @param limit Coordinate of the side. The sign selects the inner half-plane.
+ * @return u32 Amount of the vertices of the clipped polygon.
+ */
+static u32
+ClipPolygon(const Vec2 *src, u32 src_num, Vec2 *dst, u32 axis, f32 limit);
+
+/**
+ * @brief Division rounded towards the negative infinity.
+ * @param numerator Numerator.
+ * @param denominator Denominator (positive).
+ * @return s64 Quotient.
+ */
+static s64
+FloorDiv(s64 numerator, s64 denominator);
+
+/**
+ * @brief Sampling the nearest texels along a span.
+ * @param texture Pointer to the texture.
+ * @param u U coordinate of the first sample (fixed point).
+ * @param v V coordinate of the first sample (fixed point).
+ * @param du Increment of the U coordinate for the next sample.
+ * @param dv Increment of the V coordinate for the next sample.
+ * @param count Amount of the samples.
+ * @param dst Pointer to the samples.
+ */
+static void
+SampleRowNearest(const Texture *texture, s64 u, s64 v, s64 du, s64 dv, u32 count,
+    u32 *dst);
+
+/**
+ * @brief Sampling the bilinear interpolated texels along a span.
+ * @param texture Pointer to the texture.
+ * @param u U coordinate of the first sample (fixed point, shifted to the texel centers).
+ * @param v V coordinate of the first sample (fixed point, shifted to the texel centers).
+ * @param du Increment of the U coordinate for the next sample.
+ * @param dv Increment of the V coordinate for the next sample.
+ * @param count Amount of the samples.
+ * @param dst Pointer to the samples.
+ */
+static void
+SampleRowBilinear(const Texture *texture, s64 u, s64 v, s64 du, s64 dv, u32 count,
+    u32 *dst);
+
+/**
+ * @brief Linear interpolation of two colors (two channels at once).
+ * @param a First color (ARGB, premultiplied alpha).
+ * @param b Second color (ARGB, premultiplied alpha).
+ * @param weight Weight of the second color from 0 (none) to 255.
+ * @return u32 Interpolated color.
+ */
+static u32
+LerpColor(u32 a, u32 b, u32 weight);
+
+/* Samplers for every filter (TextureFilter order). */
+static sample_row_t *sample_row[TF_FILTERS_NUM] =
+{
+    SampleRowNearest, SampleRowBilinear
+};
+
+void
+TextureRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, const Texture *texture,
+    const Vec2 *vertices, const Vec2 *uvs, u32 vertices_num, TextureFilter filter,
+    BlendMode blend)
+{
+    if ((vertices_num < 3) || (vertices_num > TEXTURE_RASTER_VERTICES_MAX)) return;
+    if ((texture->width == 0) || (texture->height == 0)) return;
+    for (u32 i = 0; i < vertices_num; ++i)
+    {
+        if (!isfinite(vertices[i].x) || !isfinite(vertices[i].y) ||
+            !isfinite(uvs[i].x) || !isfinite(uvs[i].y))
+        {
+            return;
+        }
+    }
+
+    TextureMapping mapping;
+    if (!SetupMapping(vertices, uvs, filter, &mapping)) return;
+
+    /* The mapping does not depend on the vertices, so far away vertices are clipped by
+    the guard band without any change of the texture coordinates. */
+    const f32 guard_band = TRIANGLE_RASTER_GUARD_BAND;
+    Vec2 polygon[2][TEXTURE_RASTER_VERTICES_MAX + 4];
+    b32 is_inside = true;
+    for (u32 i = 0; i < vertices_num; ++i)
+    {
+        polygon[0][i] = vertices[i];
+        if ((fabsf(vertices[i].x) > guard_band) || (fabsf(vertices[i].y) > guard_band))
+            is_inside = false;
+    }
+    if (!is_inside)
+    {
+        vertices_num = ClipPolygon(polygon[0], vertices_num, polygon[1], 0, -guard_band);
+        vertices_num = ClipPolygon(polygon[1], vertices_num, polygon[0], 0, guard_band);
+        vertices_num = ClipPolygon(polygon[0], vertices_num, polygon[1], 1, -guard_band);
+        vertices_num = ClipPolygon(polygon[1], vertices_num, polygon[0], 1, guard_band);
+        if (vertices_num < 3) return;
+    }
+    FillPolygon(memory, pitch, clip, texture, polygon[0], vertices_num, &mapping, filter,
+        blend);
+}
+
+static b32
+SetupMapping(const Vec2 *vertices, const Vec2 *uvs, TextureFilter filter,
+    TextureMapping *mapping)
+{
+    /* Solve u = u0 + du_dx * (x - x0) + du_dy * (y - y0) for the three vertices. */
+    f64 dx1 = (f64)vertices[1].x - vertices[0].x;
+    f64 dy1 = (f64)vertices[1].y - vertices[0].y;
+    f64 dx2 = (f64)vertices[2].x - vertices[0].x;
+    f64 dy2 = (f64)vertices[2].y - vertices[0].y;
+    f64 det = dx1 * dy2 - dx2 * dy1;
+    if (det == 0.0) return false;
+
+    f64 du1 = (f64)uvs[1].x - uvs[0].x;
+    f64 dv1 = (f64)uvs[1].y - uvs[0].y;
+    f64 du2 = (f64)uvs[2].x - uvs[0].x;
+    f64 dv2 = (f64)uvs[2].y - uvs[0].y;
+    f64 du_dx = (du1 * dy2 - du2 * dy1) / det;
+    f64 dv_dx = (dv1 * dy2 - dv2 * dy1) / det;
+    f64 du_dy = (du2 * dx1 - du1 * dx2) / det;
+    f64 dv_dy = (dv2 * dx1 - dv1 * dx2) / det;
+
+    /* Coordinates at the center of the pixel (0, 0). Bilinear filter interpolates
+    between the texel centers. */
+    f64 shift = (filter == TF_BILINEAR) ? 0.5 : 0.0;
+    f64 u = uvs[0].x + du_dx * (0.5 - vertices[0].x) + du_dy * (0.5 - vertices[0].y) - shift;
+    f64 v = uvs[0].y + dv_dx * (0.5 - vertices[0].x) + dv_dy * (0.5 - vertices[0].y) - shift;
+
+    /* Coordinates of any pixel of the guard band have to fit the fixed point. */
+    const f64 one = (f64)((s64)1 << TEXTURE_RASTER_UV_BITS);
+    const f64 gradient_max = 1048576.0;
+    const f64 value_max = 17179869184.0;
+    if (!(fabs(du_dx) < gradient_max) || !(fabs(dv_dx) < gradient_max) ||
+        !(fabs(du_dy) < gradient_max) || !(fabs(dv_dy) < gradient_max) ||
+        !(fabs(u) < value_max) || !(fabs(v) < value_max))
+    {
+        return false;
+    }
+    mapping->u = (s64)floor(u * one + 0.5);
+    mapping->v = (s64)floor(v * one + 0.5);
+    mapping->du_dx = (s64)floor(du_dx * one + 0.5);
+    mapping->dv_dx = (s64)floor(dv_dx * one + 0.5);
+    mapping->du_dy = (s64)floor(du_dy * one + 0.5);
+    mapping->dv_dy = (s64)floor(dv_dy * one + 0.5);
+    return true;
+}
+
+static void
+FillPolygon(void *memory, u32 pitch, const RenderRect *clip, const Texture *texture,
+    const Vec2 *vertices, u32 vertices_num, const TextureMapping *mapping,
+    TextureFilter filter, BlendMode blend)
+{
+    /* Snap the vertices to the grid of the triangle raster. */
+    const f32 snap = (f32)(1 << TRIANGLE_RASTER_SUBPIXEL_BITS);
+    s64 xs[TEXTURE_RASTER_VERTICES_MAX + 4];
+    s64 ys[TEXTURE_RASTER_VERTICES_MAX + 4];
+    s64 area = 0;
+    for (u32 i = 0; i < vertices_num; ++i)
+    {
+        xs[i] = (s64)floorf(vertices[i].x * snap + 0.5f);
+        ys[i] = (s64)floorf(vertices[i].y * snap + 0.5f);
+    }
+    for (u32 i = 0; i < vertices_num; ++i)
+    {
+        u32 j = (i + 1) % vertices_num;
+        area += xs[i] * ys[j] - xs[j] * ys[i];
+    }
+    if (area == 0) return;
+
+    /* Edge functions of the counter-clockwise polygon with the top-left fill rule. */
+    s64 one = (s64)1 << TRIANGLE_RASTER_SUBPIXEL_BITS;
+    s64 half = one / 2;
+    TextureEdge edges[TEXTURE_RASTER_VERTICES_MAX + 4];
+    s64 x_min = xs[0], x_max = xs[0], y_min = ys[0], y_max = ys[0];
+    for (u32 i = 0; i < vertices_num; ++i)
+    {
+        u32 j = (i + 1) % vertices_num;
+        s64 x0 = (area > 0) ? xs[i] : xs[j];
+        s64 y0 = (area > 0) ? ys[i] : ys[j];
+        s64 dx = ((area > 0) ? xs[j] : xs[i]) - x0;
+        s64 dy = ((area > 0) ? ys[j] : ys[i]) - y0;
+        edges[i].a = -dy * one;
+        edges[i].b = dx * one;
+        edges[i].c = dx * (half - y0) - dy * (half - x0);
+        b32 is_top_left = (dy < 0) || ((dy == 0) && (dx < 0));
+        if (!is_top_left) edges[i].c -= 1;
+
+        if (xs[i] < x_min) x_min = xs[i];
+        if (xs[i] > x_max) x_max = xs[i];
+        if (ys[i] < y_min) y_min = ys[i];
+        if (ys[i] > y_max) y_max = ys[i];
+    }
+
+    /* Rows with the pixel centers inside the bounding box of the polygon. */
+    s64 x_begin = (x_min - half + (one - 1)) >> TRIANGLE_RASTER_SUBPIXEL_BITS;
+    s64 x_end = ((x_max - half) >> TRIANGLE_RASTER_SUBPIXEL_BITS) + 1;
+    s64 y_begin = (y_min - half + (one - 1)) >> TRIANGLE_RASTER_SUBPIXEL_BITS;
+    s64 y_end = ((y_max - half) >> TRIANGLE_RASTER_SUBPIXEL_BITS) + 1;
+    if (x_begin < clip->x0) x_begin = clip->x0;
+    if (y_begin < clip->y0) y_begin = clip->y0;
+    if (x_end > clip->x1) x_end = clip->x1;
+    if (y_end > clip->y1) y_end = clip->y1;
+    if ((x_begin >= x_end) || (y_begin >= y_end)) return;
+
+    /* Opaque texels replace the destination, so they are sampled right into it. */
+    sample_row_t *sample = sample_row[filter];
+    b32 is_direct = texture->is_opaque && ((blend == BM_NONE) || (blend == BM_ALPHA));
+    if (blend == BM_NONE) blend = BM_ALPHA;
+    u32 samples[TEXTURE_RASTER_CHUNK];
+
+    for (s64 y = y_begin; y < y_end; ++y)
+    {
+        /* The row of a convex polygon is a single span limited by every edge. */
+        s64 span_begin = x_begin;
+        s64 span_end = x_end;
+        for (u32 i = 0; i < vertices_num; ++i)
+        {
+            const TextureEdge *edge = &edges[i];
+            s64 value = edge->b * y + edge->c;
+            if (edge->a > 0)
+            {
+                s64 x = -FloorDiv(value, edge->a);
+                if (x > span_begin) span_begin = x;
+            }
+            else if (edge->a < 0)
+            {
+                s64 x = FloorDiv(value, -edge->a) + 1;
+                if (x < span_end) span_end = x;
+            }
+            else if (value < 0)
+            {
+                span_end = span_begin;
+            }
+        }
+        if (span_begin >= span_end) continue;
+
+        u32 *dst = (u32 *)((u8 *)memory + (size_t)pitch * (u32)y) + span_begin;
+        u32 count = (u32)(span_end - span_begin);
+        s64 u = mapping->u + span_begin * mapping->du_dx + y * mapping->du_dy;
+        s64 v = mapping->v + span_begin * mapping->dv_dx + y * mapping->dv_dy;
+        if (is_direct)
+        {
+            sample(texture, u, v, mapping->du_dx, mapping->dv_dx, count, dst);
+            RENDER_STATS_COUNT_ROW(dst, count);
+            continue;
+        }
+        while (count > 0)
+        {
+            u32 chunk = (count < TEXTURE_RASTER_CHUNK) ? count : TEXTURE_RASTER_CHUNK;
+            sample(texture, u, v, mapping->du_dx, mapping->dv_dx, chunk, samples);
+            Blend_Row(dst, samples, chunk, blend);
+            u += mapping->du_dx * chunk;
+            v += mapping->dv_dx * chunk;
+            dst += chunk;
+            count -= chunk;
+        }
+    }
+}
+
+static u32
+ClipPolygon(const Vec2 *src, u32 src_num, Vec2 *dst, u32 axis, f32 limit)
+{
+    u32 dst_num = 0;
+    for (u32 i = 0; i < src_num; ++i)
+    {
+        Vec2 a = src[i];
+        Vec2 b = src[(i + 1) % src_num];
+        f32 a_value = (axis == 0) ? a.x : a.y;
+        f32 b_value = (axis == 0) ? b.x : b.y;
+        b32 is_a_inside = (limit < 0.0f) ? (a_value >= limit) : (a_value <= limit);
+        b32 is_b_inside = (limit < 0.0f) ? (b_value >= limit) : (b_value <= limit);
+
+        if (is_a_inside) dst[dst_num++] = a;
+        if (is_a_inside != is_b_inside)
+        {
+            f32 t = (limit - a_value) / (b_value - a_value);
+            Vec2 intersection;
+            intersection.x = (axis == 0) ? limit : a.x + t * (b.x - a.x);
+            intersection.y = (axis == 0) ? a.y + t * (b.y - a.y) : limit;
+            dst[dst_num++] = intersection;
+        }
+    }
+    return dst_num;
+}
+
+static s64
+FloorDiv(s64 numerator, s64 denominator)
+{
+    s64 quotient = numerator / denominator;
+    if ((numerator % denominator != 0) && (numerator < 0)) quotient--;
+    return quotient;
+}
+
+static void
+SampleRowNearest(const Texture *texture, s64 u, s64 v, s64 du, s64 dv, u32 count,
+    u32 *dst)
+{
+    const u32 *texels = texture->texels;
+    const u32 *columns = texture->column_offsets;
+    const u32 *rows = texture->row_offsets;
+    s64 x_max = texture->width - 1;
+    s64 y_max = texture->height - 1;
+    for (u32 i = 0; i < count; ++i)
+    {
+        /* Samples outside of the texture are clamped to its edge texels. */
+        s64 x = u >> TEXTURE_RASTER_UV_BITS;
+        s64 y = v >> TEXTURE_RASTER_UV_BITS;
+        x = (x < 0) ? 0 : ((x > x_max) ? x_max : x);
+        y = (y < 0) ? 0 : ((y > y_max) ? y_max : y);
+        dst[i] = texels[columns[x] + rows[y]];
+        u += du;
+        v += dv;
+    }
+}
+
+static void
+SampleRowBilinear(const Texture *texture, s64 u, s64 v, s64 du, s64 dv, u32 count,
+    u32 *dst)
+{
+    const u32 *texels = texture->texels;
+    const u32 *columns = texture->column_offsets;
+    const u32 *rows = texture->row_offsets;
+    s64 x_max = texture->width - 1;
+    s64 y_max = texture->height - 1;
+    for (u32 i = 0; i < count; ++i)
+    {
+        s64 x0 = u >> TEXTURE_RASTER_UV_BITS;
+        s64 y0 = v >> TEXTURE_RASTER_UV_BITS;
+        u32 fx = (u32)(u >> (TEXTURE_RASTER_UV_BITS - 8)) & 0xff;
+        u32 fy = (u32)(v >> (TEXTURE_RASTER_UV_BITS - 8)) & 0xff;
+        s64 x1 = x0 + 1;
+        s64 y1 = y0 + 1;
+        x0 = (x0 < 0) ? 0 : ((x0 > x_max) ? x_max : x0);
+        x1 = (x1 < 0) ? 0 : ((x1 > x_max) ? x_max : x1);
+        y0 = (y0 < 0) ? 0 : ((y0 > y_max) ? y_max : y0);
+        y1 = (y1 < 0) ? 0 : ((y1 > y_max) ? y_max : y1);
+
+        const u32 *row0 = texels + rows[y0];
+        const u32 *row1 = texels + rows[y1];
+        u32 bottom = LerpColor(row0[columns[x0]], row0[columns[x1]], fx);
+        u32 top = LerpColor(row1[columns[x0]], row1[columns[x1]], fx);
+        dst[i] = LerpColor(bottom, top, fy);
+        u += du;
+        v += dv;
+    }
+}
+
+static u32
+LerpColor(u32 a, u32 b, u32 weight)
+{
+    /* Weights sum up to 256, so every channel stays inside of its 16 bit lane. */
+    u32 weight_a = 256 - weight;
+    u32 rb = ((a & 0x00ff00ff) * weight_a + (b & 0x00ff00ff) * weight) >> 8;
+    u32 ag = ((a >> 8) & 0x00ff00ff) * weight_a + ((b >> 8) & 0x00ff00ff) * weight;
+    return (rb & 0x00ff00ff) | (ag & 0xff00ff00);
+}
@@ -0,0 +1,525 @@
+/**
+ * ================================================================================
+ * @file src_engine/triangle_raster.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions for the rasterization of the filled triangles by
+ * the edge functions.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/triangle_raster.h"
+
+#include <math.h>
+
+#include "include_engine/blend.h"
+#include "include_engine/render.h"
+#include "include_engine/render_stats.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+#include "include_engine/vector2.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRIANGLE_RASTER_X86
+#include <immintrin.h>
+#endif
+
+/* GCC and Clang need the target attribute to compile the intrinsics of an
+instruction set which is not enabled for the whole translation unit. */
+#if defined(TRIANGLE_RASTER_X86) && !defined(_MSC_VER)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+/* Declare pointer to the kernel filling the covered pixels of a block row. */
+typedef void edge_row_t(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color);
+
+/**
+ * @brief Structure for an edge function E(x, y) = a * x + b * y + c of the pixel (x, y).
+ * The pixel is on the inner side of the edge when E(x, y) >= 0.
+ */
+struct TriangleEdge_
+{
+    s64 a;  /**< Increment of the function for the next pixel in a row. */
+    s64 b;  /**< Increment of the function for the next row. */
+    s64 c;  /**< Value of the function for the pixel (0, 0) with the fill rule bias. */
+};
+typedef struct TriangleEdge_ TriangleEdge;
+
+/**
+ * @brief Filling a triangle with all the vertices inside of the guard band.
+ * @param memory Pointer to the pixel (0, 0) of the 32 bit buffer.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param clip Pointer to the rectangle of pixels allowed to be written.
+ * @param v1 First vertex of the triangle.
+ * @param v2 Second vertex of the triangle.
+ * @param v3 Third vertex of the triangle.
+ * @param color 32 bit color (ARGB) of the triangle (premultiplied alpha if blended).
+ * @param blend Blend mode.
+ */
+static void
+FillTriangle(void *memory, u32 pitch, const RenderRect *clip, Vec2 v1, Vec2 v2, Vec2 v3,
+    u32 color, BlendMode blend);
+
+/**
+ * @brief Filling a rectangle of pixels inside the triangle.
+ * @param dst Pointer to the first pixel of the rectangle.
+ * @param pitch Distance between two rows of the buffer in bytes.
+ * @param width Width of the rectangle.
+ * @param height Height of the rectangle.
+ * @param color 32 bit color (ARGB) of the triangle (premultiplied alpha if blended).
+ * @param blend Blend mode.
+ */
+static void
+FillInsideRect(u32 *dst, u32 pitch, u32 width, u32 height, u32 color, BlendMode blend);
+
+/**
+ * @brief Finding the covered pixels of a block row. The covered pixels of a row of the
+ * triangle are adjacent, so they are a single span.
+ * @param count Amount of pixels in the block row (up to the block size).
+ * @param e Values of the three edge functions for the first pixel.
+ * @param a Increments of the three edge functions for the next pixel.
+ * @param begin Pointer to the index of the first covered pixel.
+ * @param end Pointer to the index after the last covered pixel (not greater than the
+ * first one if none is covered).
+ */
+static void
+GetEdgeRowSpan(u32 count, const s32 *e, const s32 *a, u32 *begin, u32 *end);
+
+/**
+ * @brief Blending the covered pixels of a block row as a single span.
+ * @param dst Pointer to the first pixel of the block row.
+ * @param count Amount of pixels in the block row (up to the block size).
+ * @param e Values of the three edge functions for the first pixel.
+ * @param a Increments of the three edge functions for the next pixel.
+ * @param color 32 bit color (ARGB) of the triangle (premultiplied alpha).
+ * @param blend Blend mode (except BM_NONE).
+ */
+static void
+BlendEdgeRow(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color, BlendMode blend);
+
+/**
+ * @brief Clipping a convex polygon by a side of the guard band (Sutherland-Hodgman).
+ * @param src Vertices of the polygon.
+ * @param src_num Amount of the vertices of the polygon.
+ * @param dst Vertices of the clipped polygon (up to one vertex more).
+ * @param axis Axis of the side (0 - Ox, 1 - Oy).
+ * @param limit Coordinate of the side. The sign selects the inner half-plane.
+ * @return u32 Amount of the vertices of the clipped polygon.
+ */
+static u32
+ClipPolygon(const Vec2 *src, u32 src_num, Vec2 *dst, u32 axis, f32 limit);
+
+/**
+ * @brief Snapping the coordinate to the fixed point grid.
+ * @param value Coordinate in pixels.
+ * @return s64 Coordinate in the fixed point units.
+ */
+static s64
+SnapCoordinate(f32 value);
+
+/**
+ * @brief Preparation of the edge function for the edge going from the first vertex to
+ * the second one (the triangle is counter-clockwise).
+ * @param edge Pointer to the edge function to be prepared.
+ * @param x0 X coordinate of the first vertex (fixed point).
+ * @param y0 Y coordinate of the first vertex (fixed point).
+ * @param x1 X coordinate of the second vertex (fixed point).
+ * @param y1 Y coordinate of the second vertex (fixed point).
+ */
+static void
+SetupEdge(TriangleEdge *edge, s64 x0, s64 y0, s64 x1, s64 y1);
+
+/**
+ * @brief Filling the covered pixels of a block row with plain C code.
+ * @param dst Pointer to the first pixel of the block row.
+ * @param count Amount of pixels in the block row (up to the block size).
+ * @param e Values of the three edge functions for the first pixel.
+ * @param a Increments of the three edge functions for the next pixel.
+ * @param color 32 bit color (ARGB) of the triangle.
+ */
+static void
+FillEdgeRowScalar(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color);
+
+#ifdef TRIANGLE_RASTER_X86
+/**
+ * @brief Filling the covered pixels of a block row with 128 bit SSE2 operations.
+ * @param dst Pointer to the first pixel of the block row.
+ * @param count Amount of pixels in the block row (up to the block size).
+ * @param e Values of the three edge functions for the first pixel.
+ * @param a Increments of the three edge functions for the next pixel.
+ * @param color 32 bit color (ARGB) of the triangle.
+ */
+static void
+FillEdgeRowSse2(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color);
+
+/**
+ * @brief Filling the covered pixels of a block row with 256 bit AVX2 masked stores.
+ * @param dst Pointer to the first pixel of the block row.
+ * @param count Amount of pixels in the block row (up to the block size).
+ * @param e Values of the three edge functions for the first pixel.
+ * @param a Increments of the three edge functions for the next pixel.
+ * @param color 32 bit color (ARGB) of the triangle.
+ */
+static void
+FillEdgeRowAvx2(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color);
+#endif
+
+/* Kernels for every instruction set of the span fill (SpanFillIsa order). */
+#ifdef TRIANGLE_RASTER_X86
+static edge_row_t *fill_edge_row[SFI_ISA_NUM] =
+{
+    FillEdgeRowScalar, FillEdgeRowSse2, FillEdgeRowAvx2
+};
+#else
+static edge_row_t *fill_edge_row[SFI_ISA_NUM] =
+{
+    FillEdgeRowScalar, FillEdgeRowScalar, FillEdgeRowScalar
+};
+#endif
+
+void
+TriangleRaster_Fill(void *memory, u32 pitch, const RenderRect *clip, Vec2 v1, Vec2 v2,
+    Vec2 v3, u32 color, BlendMode blend)
+{
+    /* Vertices with infinite or undefined coordinates can not be clipped. */
+    if (!isfinite(v1.x) || !isfinite(v1.y) || !isfinite(v2.x) || !isfinite(v2.y) ||
+        !isfinite(v3.x) || !isfinite(v3.y))
+    {
+        return;
+    }
+
+    if (blend != BM_NONE) color = Blend_Premultiply(color);
+
+    /* Usual triangles are only scissored by the clip rectangle during the traversal. */
+    const f32 guard_band = TRIANGLE_RASTER_GUARD_BAND;
+    if ((fabsf(v1.x) <= guard_band) && (fabsf(v1.y) <= guard_band) &&
+        (fabsf(v2.x) <= guard_band) && (fabsf(v2.y) <= guard_band) &&
+        (fabsf(v3.x) <= guard_band) && (fabsf(v3.y) <= guard_band))
+    {
+        FillTriangle(memory, pitch, clip, v1, v2, v3, color, blend);
+        return;
+    }
+
+    /* Far away vertices would overflow the edge functions, so the triangle is clipped
+    by the guard band and the resulting polygon is drawn as a fan. */
+    Vec2 polygon[2][7];
+    u32 vertices_num = 3;
+    polygon[0][0] = v1;
+    polygon[0][1] = v2;
+    polygon[0][2] = v3;
+    vertices_num = ClipPolygon(polygon[0], vertices_num, polygon[1], 0, -guard_band);
+    vertices_num = ClipPolygon(polygon[1], vertices_num, polygon[0], 0, guard_band);
+    vertices_num = ClipPolygon(polygon[0], vertices_num, polygon[1], 1, -guard_band);
+    vertices_num = ClipPolygon(polygon[1], vertices_num, polygon[0], 1, guard_band);
+    for (u32 i = 2; i < vertices_num; ++i)
+    {
+        FillTriangle(memory, pitch, clip, polygon[0][0], polygon[0][i - 1], polygon[0][i],
+            color, blend);
+    }
+}
+
+static void
+FillTriangle(void *memory, u32 pitch, const RenderRect *clip, Vec2 v1, Vec2 v2, Vec2 v3,
+    u32 color, BlendMode blend)
+{
+    s64 x1 = SnapCoordinate(v1.x), y1 = SnapCoordinate(v1.y);
+    s64 x2 = SnapCoordinate(v2.x), y2 = SnapCoordinate(v2.y);
+    s64 x3 = SnapCoordinate(v3.x), y3 = SnapCoordinate(v3.y);
+
+    /* Make the triangle counter-clockwise. Degenerate triangles cover no pixels. */
+    s64 area = (x2 - x1) * (y3 - y1) - (y2 - y1) * (x3 - x1);
+    if (area == 0) return;
+    if (area < 0)
+    {
+        s64 temp;
+        temp = x2; x2 = x3; x3 = temp;
+        temp = y2; y2 = y3; y3 = temp;
+    }
+
+    TriangleEdge edges[3];
+    SetupEdge(&edges[0], x1, y1, x2, y2);
+    SetupEdge(&edges[1], x2, y2, x3, y3);
+    SetupEdge(&edges[2], x3, y3, x1, y1);
+
+    /* Pixels with the centers inside the bounding box of the triangle. */
+    s64 half = (s64)1 << (TRIANGLE_RASTER_SUBPIXEL_BITS - 1);
+    s64 x_min = (x1 < x2) ? ((x1 < x3) ? x1 : x3) : ((x2 < x3) ? x2 : x3);
+    s64 x_max = (x1 > x2) ? ((x1 > x3) ? x1 : x3) : ((x2 > x3) ? x2 : x3);
+    s64 y_min = (y1 < y2) ? ((y1 < y3) ? y1 : y3) : ((y2 < y3) ? y2 : y3);
+    s64 y_max = (y1 > y2) ? ((y1 > y3) ? y1 : y3) : ((y2 > y3) ? y2 : y3);
+    s64 x_begin = (x_min - half + (2 * half - 1)) >> TRIANGLE_RASTER_SUBPIXEL_BITS;
+    s64 x_end = ((x_max - half) >> TRIANGLE_RASTER_SUBPIXEL_BITS) + 1;
+    s64 y_begin = (y_min - half + (2 * half - 1)) >> TRIANGLE_RASTER_SUBPIXEL_BITS;
+    s64 y_end = ((y_max - half) >> TRIANGLE_RASTER_SUBPIXEL_BITS) + 1;
+    if (x_begin < clip->x0) x_begin = clip->x0;
+    if (y_begin < clip->y0) y_begin = clip->y0;
+    if (x_end > clip->x1) x_end = clip->x1;
+    if (y_end > clip->y1) y_end = clip->y1;
+    if ((x_begin >= x_end) || (y_begin >= y_end)) return;
+
+    edge_row_t *fill_row = fill_edge_row[SpanFill_GetIsa()];
+    const s32 block_size = TRIANGLE_RASTER_BLOCK_SIZE;
+
+    /* Traverse the blocks of the grid aligned to the buffer origin. */
+    for (s32 by = (s32)y_begin & ~(block_size - 1); by < (s32)y_end; by += block_size)
+    {
+        s32 row_begin = (by > (s32)y_begin) ? by : (s32)y_begin;
+        s32 row_end = (by + block_size < (s32)y_end) ? by + block_size : (s32)y_end;
+        u8 *row_memory = (u8 *)memory + (size_t)pitch * (u32)row_begin;
+
+        /* Neighbouring inside blocks are collected into a single rectangle. */
+        s32 run_begin = 0;
+        s32 run_end = 0;
+
+        for (s32 bx = (s32)x_begin & ~(block_size - 1); bx < (s32)x_end; bx += block_size)
+        {
+            s32 col_begin = (bx > (s32)x_begin) ? bx : (s32)x_begin;
+            s32 col_end = (bx + block_size < (s32)x_end) ? bx + block_size : (s32)x_end;
+
+            /* Classify the block by the corners with the minimal and maximal values of
+            every edge function. */
+            b32 is_outside = false;
+            b32 is_active[3];
+            b32 is_inside = true;
+            for (u32 k = 0; k < 3; ++k)
+            {
+                TriangleEdge *edge = &edges[k];
+                s64 x_lo = (edge->a > 0) ? col_begin : col_end - 1;
+                s64 x_hi = (edge->a > 0) ? col_end - 1 : col_begin;
+                s64 y_lo = (edge->b > 0) ? row_begin : row_end - 1;
+                s64 y_hi = (edge->b > 0) ? row_end - 1 : row_begin;
+                s64 e_min = edge->a * x_lo + edge->b * y_lo + edge->c;
+                s64 e_max = edge->a * x_hi + edge->b * y_hi + edge->c;
+                if (e_max < 0) is_outside = true;
+                is_active[k] = (e_min < 0);
+                if (is_active[k]) is_inside = false;
+            }
+
+            if (!is_outside && is_inside)
+            {
+                if (run_begin == run_end) run_begin = col_begin;
+                run_end = col_end;
+                continue;
+            }
+
+            if (run_begin != run_end)
+            {
+                FillInsideRect((u32 *)row_memory + run_begin, pitch,
+                    (u32)(run_end - run_begin), (u32)(row_end - row_begin), color, blend);
+                run_begin = run_end;
+            }
+            if (is_outside) continue;
+
+            /* The block is crossed by an edge, test the pixels. Only the crossing edges
+            are evaluated, their values are small inside the block. */
+            s32 a[3];
+            for (u32 k = 0; k < 3; ++k)
+            {
+                a[k] = is_active[k] ? (s32)edges[k].a : 0;
+            }
+
+            u8 *block_memory = row_memory;
+            for (s32 y = row_begin; y < row_end; ++y)
+            {
+                s32 e[3];
+                for (u32 k = 0; k < 3; ++k)
+                {
+                    TriangleEdge *edge = &edges[k];
+                    e[k] = is_active[k] ? (s32)(edge->a * col_begin + edge->b * y + edge->c) : 0;
+                }
+                u32 *dst = (u32 *)block_memory + col_begin;
+                if (blend == BM_NONE)
+                {
+                    fill_row(dst, (u32)(col_end - col_begin), e, a, color);
+#ifdef RENDER_STATS
+                    /* Kernels store the pixels by the masks, the span is counted. */
+                    u32 begin, end;
+                    GetEdgeRowSpan((u32)(col_end - col_begin), e, a, &begin, &end);
+                    if (begin < end) RENDER_STATS_COUNT_ROW(dst + begin, end - begin);
+#endif
+                }
+                else
+                    BlendEdgeRow(dst, (u32)(col_end - col_begin), e, a, color, blend);
+                block_memory += pitch;
+            }
+        }
+
+        if (run_begin != run_end)
+        {
+            FillInsideRect((u32 *)row_memory + run_begin, pitch, (u32)(run_end - run_begin),
+                (u32)(row_end - row_begin), color, blend);
+        }
+    }
+}
+
+static void
+FillInsideRect(u32 *dst, u32 pitch, u32 width, u32 height, u32 color, BlendMode blend)
+{
+    if (blend == BM_NONE)
+    {
+        SpanFill_Rect(dst, pitch, width, height, color);
+        return;
+    }
+    for (u32 i = 0; i < height; ++i)
+    {
+        Blend_RowColor(dst, width, color, blend);
+        dst = (u32 *)((u8 *)dst + pitch);
+    }
+}
+
+static void
+GetEdgeRowSpan(u32 count, const s32 *e, const s32 *a, u32 *begin, u32 *end)
+{
+    s32 e0 = e[0], e1 = e[1], e2 = e[2];
+    *begin = count;
+    *end = 0;
+    for (u32 i = 0; i < count; ++i)
+    {
+        if ((e0 | e1 | e2) >= 0)
+        {
+            if (*begin == count) *begin = i;
+            *end = i + 1;
+        }
+        e0 += a[0];
+        e1 += a[1];
+        e2 += a[2];
+    }
+}
+
+static void
+BlendEdgeRow(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color, BlendMode blend)
+{
+    u32 begin, end;
+    GetEdgeRowSpan(count, e, a, &begin, &end);
+    if (begin < end) Blend_RowColor(dst + begin, end - begin, color, blend);
+}
+
+static u32
+ClipPolygon(const Vec2 *src, u32 src_num, Vec2 *dst, u32 axis, f32 limit)
+{
+    u32 dst_num = 0;
+    for (u32 i = 0; i < src_num; ++i)
+    {
+        Vec2 a = src[i];
+        Vec2 b = src[(i + 1) % src_num];
+        f32 a_value = (axis == 0) ? a.x : a.y;
+        f32 b_value = (axis == 0) ? b.x : b.y;
+        b32 is_a_inside = (limit < 0.0f) ? (a_value >= limit) : (a_value <= limit);
+        b32 is_b_inside = (limit < 0.0f) ? (b_value >= limit) : (b_value <= limit);
+
+        if (is_a_inside) dst[dst_num++] = a;
+        if (is_a_inside != is_b_inside)
+        {
+            /* The intersection is found from the same end point for the both
+            directions, so the triangles sharing the edge get the same vertex. */
+            Vec2 p = a;
+            Vec2 q = b;
+            if ((q.x < p.x) || ((q.x == p.x) && (q.y < p.y)))
+            {
+                p = b;
+                q = a;
+            }
+            f32 p_value = (axis == 0) ? p.x : p.y;
+            f32 q_value = (axis == 0) ? q.x : q.y;
+            f32 t = (limit - p_value) / (q_value - p_value);
+
+            Vec2 intersection;
+            intersection.x = (axis == 0) ? limit : p.x + t * (q.x - p.x);
+            intersection.y = (axis == 0) ? p.y + t * (q.y - p.y) : limit;
+            dst[dst_num++] = intersection;
+        }
+    }
+    return dst_num;
+}
+
+static s64
+SnapCoordinate(f32 value)
+{
+    return (s64)floorf(value * (f32)(1 << TRIANGLE_RASTER_SUBPIXEL_BITS) + 0.5f);
+}
+
+static void
+SetupEdge(TriangleEdge *edge, s64 x0, s64 y0, s64 x1, s64 y1)
+{
+    /* E(p) = dx * (p.y - y0) - dy * (p.x - x0) at the pixel center p (fixed point). */
+    s64 one = (s64)1 << TRIANGLE_RASTER_SUBPIXEL_BITS;
+    s64 half = one / 2;
+    s64 dx = x1 - x0;
+    s64 dy = y1 - y0;
+    edge->a = -dy * one;
+    edge->b = dx * one;
+    edge->c = dx * (half - y0) - dy * (half - x0);
+
+    /* Top-left fill rule: pixels exactly on the edge belong to the left and top edges
+    only (for the counter-clockwise triangle with Oy axis pointing up). */
+    b32 is_top_left = (dy < 0) || ((dy == 0) && (dx < 0));
+    if (!is_top_left) edge->c -= 1;
+}
+
+static void
+FillEdgeRowScalar(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color)
+{
+    s32 e0 = e[0], e1 = e[1], e2 = e[2];
+    for (u32 i = 0; i < count; ++i)
+    {
+        if ((e0 | e1 | e2) >= 0) dst[i] = color;
+        e0 += a[0];
+        e1 += a[1];
+        e2 += a[2];
+    }
+}
+
+#ifdef TRIANGLE_RASTER_X86
+TARGET_SSE2 static void
+FillEdgeRowSse2(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color)
+{
+    /* The pixels of the block are read and written back, so only the full width blocks
+    are processed (pixels outside of the clip rectangle are never touched). */
+    if (count != 8)
+    {
+        FillEdgeRowScalar(dst, count, e, a, color);
+        return;
+    }
+
+    __m128i e0 = _mm_setr_epi32(e[0], e[0] + a[0], e[0] + 2 * a[0], e[0] + 3 * a[0]);
+    __m128i e1 = _mm_setr_epi32(e[1], e[1] + a[1], e[1] + 2 * a[1], e[1] + 3 * a[1]);
+    __m128i e2 = _mm_setr_epi32(e[2], e[2] + a[2], e[2] + 2 * a[2], e[2] + 3 * a[2]);
+    __m128i value = _mm_set1_epi32((int)color);
+    __m128i minus_one = _mm_set1_epi32(-1);
+
+    for (u32 half = 0; half < 2; ++half)
+    {
+        __m128i mask = _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(e0, e1), e2), minus_one);
+        __m128i pixels = _mm_loadu_si128((__m128i *)(dst + half * 4));
+        pixels = _mm_or_si128(_mm_and_si128(mask, value), _mm_andnot_si128(mask, pixels));
+        _mm_storeu_si128((__m128i *)(dst + half * 4), pixels);
+
+        e0 = _mm_add_epi32(e0, _mm_set1_epi32(4 * a[0]));
+        e1 = _mm_add_epi32(e1, _mm_set1_epi32(4 * a[1]));
+        e2 = _mm_add_epi32(e2, _mm_set1_epi32(4 * a[2]));
+    }
+}
+
+TARGET_AVX2 static void
+FillEdgeRowAvx2(u32 *dst, u32 count, const s32 *e, const s32 *a, u32 color)
+{
+    __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i e0 = _mm256_add_epi32(_mm256_set1_epi32(e[0]),
+        _mm256_mullo_epi32(_mm256_set1_epi32(a[0]), lane));
+    __m256i e1 = _mm256_add_epi32(_mm256_set1_epi32(e[1]),
+        _mm256_mullo_epi32(_mm256_set1_epi32(a[1]), lane));
+    __m256i e2 = _mm256_add_epi32(_mm256_set1_epi32(e[2]),
+        _mm256_mullo_epi32(_mm256_set1_epi32(a[2]), lane));
+
+    /* Masked out lanes are not written at all, so narrow blocks are safe as well. */
+    __m256i mask = _mm256_cmpgt_epi32(_mm256_or_si256(_mm256_or_si256(e0, e1), e2),
+        _mm256_set1_epi32(-1));
+    mask = _mm256_and_si256(mask, _mm256_cmpgt_epi32(_mm256_set1_epi32((int)count), lane));
+    _mm256_maskstore_epi32((int *)dst, mask, _mm256_set1_epi32((int)color));
+}
+#endif
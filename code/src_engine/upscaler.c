@@ -0,0 +1,677 @@
+/**
+ * ================================================================================
+ * @file src_engine/upscaler.c
+ * @author Dmitry Safonov (juvusoft@gmail.com)
+ * @brief Definition of functions necessary for the scaling of the render buffer to
+ * the output resolution.
+ * @version 0.1
+ * @date 2026-10-16
+ * ================================================================================
+ */
+
+#include "include_engine/upscaler.h"
+
+#include <string.h>
+
+#include "include_engine/dbg.h"
+#include "include_engine/helper_functions.h"
+#include "include_engine/job_pool.h"
+#include "include_engine/span_fill.h"
+#include "include_engine/utils.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define UPSCALER_X86
+#include <immintrin.h>
+#endif
+
+/* GCC and Clang need the target attribute to compile the intrinsics of an
+instruction set which is not enabled for the whole translation unit. */
+#if defined(UPSCALER_X86) && !defined(_MSC_VER)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+/* Declare pointer to the kernel taking the source pixels by the column indices. */
+typedef void upscale_gather_t(u32 *dst, const u32 *src, const u32 *cols, u32 count);
+
+/* Declare pointer to the kernel repeating every source pixel factor times. */
+typedef void upscale_replicate_t(u32 *dst, const u32 *src, u32 count, u32 factor);
+
+/* Declare pointer to the kernel interpolating two rows of pixels. The weights pointer
+is advanced by the step after every pixel, so the step 0 uses a single weight. */
+typedef void upscale_lerp_t(u32 *dst, const u32 *a, const u32 *b, const u16 *weights,
+    u32 weights_step, u32 count);
+
+/**
+ * @brief Building the source column (row) table of the nearest filter. Every image
+ * pixel takes the source pixel containing its center.
+ * @param table Table to fill.
+ * @param src_size Amount of the source pixels.
+ * @param dst_size Amount of the image pixels.
+ */
+static void
+BuildNearestTable(u32 *table, u32 src_size, u32 dst_size);
+
+/**
+ * @brief Building the source column (row) table of the bilinear filter. Every image
+ * pixel is interpolated between the source pixel and the next one.
+ * @param table Table of the first source pixels to fill.
+ * @param weights Table of the weights of the next source pixels to fill.
+ * @param src_size Amount of the source pixels (at least two).
+ * @param dst_size Amount of the image pixels.
+ */
+static void
+BuildBilinearTable(u32 *table, u16 *weights, u32 src_size, u32 dst_size);
+
+/**
+ * @brief Scaling a band of the output rows (job procedure).
+ * @param data Pointer to the Upscaler structure.
+ * @param job_index Index of the band.
+ * @param worker_index Index of the executing worker.
+ */
+static void
+UpscaleBand(void *data, u32 job_index, u32 worker_index);
+
+/**
+ * @brief Interpolating a source row horizontally to the width of the image.
+ * @param upscaler Pointer to the Upscaler structure.
+ * @param row Index of the source row.
+ * @param dst Pointer to the interpolated row.
+ * @param temp Pointer to the temporary memory (two image rows).
+ */
+static void
+InterpolateRow(Upscaler *upscaler, u32 row, u32 *dst, u32 *temp);
+
+/**
+ * @brief Taking the source pixels by the column indices with plain C code.
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the source row.
+ * @param cols Source column of every destination pixel.
+ * @param count Amount of the destination pixels.
+ */
+static void
+GatherRowScalar(u32 *dst, const u32 *src, const u32 *cols, u32 count);
+
+/**
+ * @brief Repeating every source pixel with plain C code.
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel.
+ * @param count Amount of the source pixels.
+ * @param factor Amount of the repeats.
+ */
+static void
+ReplicateRowScalar(u32 *dst, const u32 *src, u32 count, u32 factor);
+
+/**
+ * @brief Interpolating two rows of pixels with plain C code.
+ * @param dst Pointer to the first destination pixel.
+ * @param a Pointer to the first pixel of the first row.
+ * @param b Pointer to the first pixel of the second row.
+ * @param weights Weights of the second row (UPSCALER_WEIGHT_ONE - the second row only).
+ * @param weights_step Step of the weights pointer (0 or 1).
+ * @param count Amount of pixels in the row.
+ */
+static void
+LerpRowScalar(u32 *dst, const u32 *a, const u32 *b, const u16 *weights,
+    u32 weights_step, u32 count);
+
+#ifdef UPSCALER_X86
+/**
+ * @brief Repeating every source pixel with 128 bit SSE2 stores.
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel.
+ * @param count Amount of the source pixels.
+ * @param factor Amount of the repeats.
+ */
+static void
+ReplicateRowSse2(u32 *dst, const u32 *src, u32 count, u32 factor);
+
+/**
+ * @brief Interpolating two rows of pixels with SSE2 operations (4 pixels at once).
+ * @param dst Pointer to the first destination pixel.
+ * @param a Pointer to the first pixel of the first row.
+ * @param b Pointer to the first pixel of the second row.
+ * @param weights Weights of the second row (UPSCALER_WEIGHT_ONE - the second row only).
+ * @param weights_step Step of the weights pointer (0 or 1).
+ * @param count Amount of pixels in the row.
+ */
+static void
+LerpRowSse2(u32 *dst, const u32 *a, const u32 *b, const u16 *weights,
+    u32 weights_step, u32 count);
+
+/**
+ * @brief Taking the source pixels by the column indices with AVX2 gathers.
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the source row.
+ * @param cols Source column of every destination pixel.
+ * @param count Amount of the destination pixels.
+ */
+static void
+GatherRowAvx2(u32 *dst, const u32 *src, const u32 *cols, u32 count);
+
+/**
+ * @brief Repeating every source pixel with 256 bit AVX2 stores.
+ * @param dst Pointer to the first destination pixel.
+ * @param src Pointer to the first source pixel.
+ * @param count Amount of the source pixels.
+ * @param factor Amount of the repeats.
+ */
+static void
+ReplicateRowAvx2(u32 *dst, const u32 *src, u32 count, u32 factor);
+
+/**
+ * @brief Interpolating two rows of pixels with AVX2 operations (8 pixels at once).
+ * @param dst Pointer to the first destination pixel.
+ * @param a Pointer to the first pixel of the first row.
+ * @param b Pointer to the first pixel of the second row.
+ * @param weights Weights of the second row (UPSCALER_WEIGHT_ONE - the second row only).
+ * @param weights_step Step of the weights pointer (0 or 1).
+ * @param count Amount of pixels in the row.
+ */
+static void
+LerpRowAvx2(u32 *dst, const u32 *a, const u32 *b, const u16 *weights,
+    u32 weights_step, u32 count);
+#endif
+
+/* Kernels for every instruction set of the span fill (SpanFillIsa order). SSE2 has no
+gather instruction, so its gather kernel is the scalar one. */
+#ifdef UPSCALER_X86
+static upscale_gather_t *gather_row[SFI_ISA_NUM] =
+{
+    GatherRowScalar, GatherRowScalar, GatherRowAvx2
+};
+static upscale_replicate_t *replicate_row[SFI_ISA_NUM] =
+{
+    ReplicateRowScalar, ReplicateRowSse2, ReplicateRowAvx2
+};
+static upscale_lerp_t *lerp_row[SFI_ISA_NUM] =
+{
+    LerpRowScalar, LerpRowSse2, LerpRowAvx2
+};
+#else
+static upscale_gather_t *gather_row[SFI_ISA_NUM] =
+{
+    GatherRowScalar, GatherRowScalar, GatherRowScalar
+};
+static upscale_replicate_t *replicate_row[SFI_ISA_NUM] =
+{
+    ReplicateRowScalar, ReplicateRowScalar, ReplicateRowScalar
+};
+static upscale_lerp_t *lerp_row[SFI_ISA_NUM] =
+{
+    LerpRowScalar, LerpRowScalar, LerpRowScalar
+};
+#endif
+
+Upscaler*
+Upscaler_Constructor(void)
+{
+    size_t size = sizeof(Upscaler);
+    Upscaler *upscaler = (Upscaler *)HelperFcn_MemAllocate(size);
+    return upscaler;
+}
+
+Upscaler*
+Upscaler_Destructor(Upscaler *upscaler)
+{
+    if (upscaler->job_pool) upscaler->job_pool = JobPool_Destructor(upscaler->job_pool);
+    if (upscaler->output)
+    {
+        HelperFcn_MemFree(upscaler->output);
+        HelperFcn_MemFree(upscaler->cols);
+        HelperFcn_MemFree(upscaler->cols_weight);
+        HelperFcn_MemFree(upscaler->rows);
+        HelperFcn_MemFree(upscaler->rows_weight);
+        HelperFcn_MemFree(upscaler->scratch);
+    }
+    HelperFcn_MemFree(upscaler);
+    return NULL;
+}
+
+void
+Upscaler_Init(Upscaler *upscaler, u32 threads_num)
+{
+    upscaler->job_pool = JobPool_Constructor();
+    JobPool_Init(upscaler->job_pool, threads_num);
+}
+
+void
+Upscaler_Configure(Upscaler *upscaler, u32 src_width, u32 src_height, u32 dst_width,
+    u32 dst_height, UpscaleFilter filter)
+{
+    dbg_check((src_width > 0) && (src_height > 0) && (dst_width > 0) && (dst_height > 0),
+        "%s", "Upscaler buffers should not be empty!");
+
+    if ((upscaler->src_width == src_width) && (upscaler->src_height == src_height) &&
+        (upscaler->dst_width == dst_width) && (upscaler->dst_height == dst_height) &&
+        (upscaler->filter == filter) && upscaler->output)
+    {
+        return;
+    }
+
+    b32 is_resized = (upscaler->dst_width * upscaler->dst_height !=
+        dst_width * dst_height) || (upscaler->output == NULL);
+    upscaler->filter = filter;
+    upscaler->src_width = src_width;
+    upscaler->src_height = src_height;
+    upscaler->dst_width = dst_width;
+    upscaler->dst_height = dst_height;
+
+    /* Integer factor is used only when the source fits the output at least once. */
+    UpscaleFilter used_filter = filter;
+    u32 factor_x = dst_width / src_width;
+    u32 factor_y = dst_height / src_height;
+    upscaler->factor = (factor_x < factor_y) ? factor_x : factor_y;
+    if ((filter == UF_NEAREST_INTEGER) && (upscaler->factor == 0)) used_filter = UF_NEAREST;
+    if ((filter == UF_BILINEAR) && ((src_width < 2) || (src_height < 2)))
+    {
+        used_filter = UF_NEAREST;
+    }
+    upscaler->used_filter = used_filter;
+
+    if (used_filter == UF_NEAREST_INTEGER)
+    {
+        upscaler->image_width = src_width * upscaler->factor;
+        upscaler->image_height = src_height * upscaler->factor;
+    }
+    else
+    {
+        upscaler->factor = 0;
+        upscaler->image_width = dst_width;
+        upscaler->image_height = dst_height;
+    }
+    upscaler->image_x = (dst_width - upscaler->image_width) / 2;
+    upscaler->image_y = (dst_height - upscaler->image_height) / 2;
+
+    /* Black borders of the integer scaling are filled at every run. */
+    if (is_resized)
+    {
+        if (upscaler->output) HelperFcn_MemFree(upscaler->output);
+        upscaler->output = (u32 *)HelperFcn_MemAllocate(sizeof(u32) * dst_width * dst_height);
+    }
+
+    u32 image_width = upscaler->image_width;
+    u32 image_height = upscaler->image_height;
+    upscaler->cols = (u32 *)HelperFcn_MemReallocate(upscaler->cols,
+        sizeof(u32) * image_width);
+    upscaler->cols_weight = (u16 *)HelperFcn_MemReallocate(upscaler->cols_weight,
+        sizeof(u16) * image_width);
+    upscaler->rows = (u32 *)HelperFcn_MemReallocate(upscaler->rows,
+        sizeof(u32) * image_height);
+    upscaler->rows_weight = (u16 *)HelperFcn_MemReallocate(upscaler->rows_weight,
+        sizeof(u16) * image_height);
+    if (used_filter == UF_BILINEAR)
+    {
+        BuildBilinearTable(upscaler->cols, upscaler->cols_weight, src_width, image_width);
+        BuildBilinearTable(upscaler->rows, upscaler->rows_weight, src_height, image_height);
+    }
+    else
+    {
+        BuildNearestTable(upscaler->cols, src_width, image_width);
+        BuildNearestTable(upscaler->rows, src_height, image_height);
+        memset(upscaler->cols_weight, 0, sizeof(u16) * image_width);
+        memset(upscaler->rows_weight, 0, sizeof(u16) * image_height);
+    }
+
+    /* Every worker interpolates the rows in its own memory. */
+    u32 workers_num = upscaler->job_pool ? JobPool_GetWorkersNum(upscaler->job_pool) : 1;
+    upscaler->scratch = (u32 *)HelperFcn_MemReallocate(upscaler->scratch,
+        sizeof(u32) * image_width * 4 * workers_num);
+}
+
+const u32*
+Upscaler_Run(Upscaler *upscaler, const void *src)
+{
+    upscaler->src = (const u32 *)src;
+    u32 bands_num = (upscaler->dst_height + UPSCALER_BAND_ROWS - 1) / UPSCALER_BAND_ROWS;
+    if (upscaler->job_pool)
+    {
+        JobPool_Run(upscaler->job_pool, UpscaleBand, upscaler, bands_num);
+    }
+    else
+    {
+        for (u32 i = 0; i < bands_num; ++i) UpscaleBand(upscaler, i, 0);
+    }
+    return upscaler->output;
+}
+
+void
+Upscaler_MapPoint(Upscaler *upscaler, s32 x, s32 y, s32 *src_x, s32 *src_y)
+{
+    s64 image_x = (s64)x - upscaler->image_x;
+    s64 image_y = (s64)y - upscaler->image_y;
+    if (image_x < 0) image_x = 0;
+    if (image_y < 0) image_y = 0;
+    if (image_x >= upscaler->image_width) image_x = upscaler->image_width - 1;
+    if (image_y >= upscaler->image_height) image_y = upscaler->image_height - 1;
+    *src_x = (s32)((image_x * upscaler->src_width) / upscaler->image_width);
+    *src_y = (s32)((image_y * upscaler->src_height) / upscaler->image_height);
+}
+
+static void
+BuildNearestTable(u32 *table, u32 src_size, u32 dst_size)
+{
+    for (u32 i = 0; i < dst_size; ++i)
+    {
+        table[i] = (u32)(((2 * (u64)i + 1) * src_size) / (2 * (u64)dst_size));
+    }
+}
+
+static void
+BuildBilinearTable(u32 *table, u16 *weights, u32 src_size, u32 dst_size)
+{
+    /* Source position of the image pixel center: (i + 0.5) * src / dst - 0.5, in the
+    fixed point with the weight precision, rounded to the nearest. */
+    for (u32 i = 0; i < dst_size; ++i)
+    {
+        s64 num = ((2 * (s64)i + 1) * src_size - dst_size) * UPSCALER_WEIGHT_ONE;
+        s64 pos = (num < 0) ? 0 : (num + dst_size) / (2 * (s64)dst_size);
+        u32 index = (u32)(pos / UPSCALER_WEIGHT_ONE);
+        u32 weight = (u32)(pos % UPSCALER_WEIGHT_ONE);
+
+        /* The last source pixel is taken as the next one with the full weight. */
+        if (index >= src_size - 1)
+        {
+            index = src_size - 2;
+            weight = UPSCALER_WEIGHT_ONE;
+        }
+        table[i] = index;
+        weights[i] = (u16)weight;
+    }
+}
+
+static void
+UpscaleBand(void *data, u32 job_index, u32 worker_index)
+{
+    Upscaler *upscaler = (Upscaler *)data;
+    SpanFillIsa isa = SpanFill_GetIsa();
+    u32 dst_width = upscaler->dst_width;
+    u32 image_x = upscaler->image_x;
+    u32 image_y = upscaler->image_y;
+    u32 image_width = upscaler->image_width;
+    u32 image_height = upscaler->image_height;
+    u32 right = dst_width - image_x - image_width;
+    size_t row_size = sizeof(u32) * image_width;
+
+    /* Two interpolated source rows are kept while the output rows go up the band. */
+    u32 *scratch = upscaler->scratch + (size_t)image_width * 4 * worker_index;
+    u32 *cached[2] = {scratch, scratch + image_width};
+    u32 cached_rows[2] = {0xffffffff, 0xffffffff};
+    u32 *temp = scratch + (size_t)image_width * 2;
+
+    u32 y0 = job_index * UPSCALER_BAND_ROWS;
+    u32 y1 = y0 + UPSCALER_BAND_ROWS;
+    if (y1 > upscaler->dst_height) y1 = upscaler->dst_height;
+    for (u32 y = y0; y < y1; ++y)
+    {
+        u32 *dst = upscaler->output + (size_t)dst_width * y;
+        if ((y < image_y) || (y >= image_y + image_height))
+        {
+            SpanFill_Row(dst, dst_width, 0);
+            continue;
+        }
+        if (image_x > 0) SpanFill_Row(dst, image_x, 0);
+        if (right > 0) SpanFill_Row(dst + image_x + image_width, right, 0);
+        dst += image_x;
+
+        /* Output row equal to the previous one (the band owns it) is copied. */
+        u32 iy = y - image_y;
+        u32 row = upscaler->rows[iy];
+        u16 weight = upscaler->rows_weight[iy];
+        if ((y > y0) && (iy > 0) && (row == upscaler->rows[iy - 1]) &&
+            (weight == upscaler->rows_weight[iy - 1]))
+        {
+            memcpy(dst, dst - dst_width, row_size);
+            continue;
+        }
+
+        const u32 *src = upscaler->src + (size_t)upscaler->src_width * row;
+        if (upscaler->used_filter == UF_NEAREST_INTEGER)
+        {
+            replicate_row[isa](dst, src, upscaler->src_width, upscaler->factor);
+        }
+        else if (upscaler->used_filter == UF_NEAREST)
+        {
+            gather_row[isa](dst, src, upscaler->cols, image_width);
+        }
+        else
+        {
+            /* Both source rows are interpolated horizontally first (reusing the rows
+            of the previous output row), then they are interpolated vertically. */
+            u32 slot0 = (cached_rows[1] == row) ? 1 : 0;
+            u32 slot1 = 1 - slot0;
+            if (cached_rows[slot0] != row)
+            {
+                InterpolateRow(upscaler, row, cached[slot0], temp);
+                cached_rows[slot0] = row;
+            }
+            if (weight == 0)
+            {
+                memcpy(dst, cached[slot0], row_size);
+                continue;
+            }
+            if (cached_rows[slot1] != row + 1)
+            {
+                InterpolateRow(upscaler, row + 1, cached[slot1], temp);
+                cached_rows[slot1] = row + 1;
+            }
+            lerp_row[isa](dst, cached[slot0], cached[slot1], &weight, 0, image_width);
+        }
+    }
+}
+
+static void
+InterpolateRow(Upscaler *upscaler, u32 row, u32 *dst, u32 *temp)
+{
+    SpanFillIsa isa = SpanFill_GetIsa();
+    u32 image_width = upscaler->image_width;
+    const u32 *src = upscaler->src + (size_t)upscaler->src_width * row;
+    u32 *first = temp;
+    u32 *next = temp + image_width;
+    gather_row[isa](first, src, upscaler->cols, image_width);
+    gather_row[isa](next, src + 1, upscaler->cols, image_width);
+    lerp_row[isa](dst, first, next, upscaler->cols_weight, 1, image_width);
+}
+
+static void
+GatherRowScalar(u32 *dst, const u32 *src, const u32 *cols, u32 count)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        dst[i] = src[cols[i]];
+    }
+}
+
+static void
+ReplicateRowScalar(u32 *dst, const u32 *src, u32 count, u32 factor)
+{
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 pixel = src[i];
+        for (u32 j = 0; j < factor; ++j) *dst++ = pixel;
+    }
+}
+
+static void
+LerpRowScalar(u32 *dst, const u32 *a, const u32 *b, const u16 *weights,
+    u32 weights_step, u32 count)
+{
+    /* Two channels are interpolated at once: (a * (1 - w) + b * w + 64) >> 7 fits into
+    the 16 bits of every channel. */
+    for (u32 i = 0; i < count; ++i)
+    {
+        u32 w = *weights;
+        u32 v = UPSCALER_WEIGHT_ONE - w;
+        u32 rb = ((a[i] & 0x00ff00ff) * v + (b[i] & 0x00ff00ff) * w + 0x00400040) >> 7;
+        u32 ag = (((a[i] >> 8) & 0x00ff00ff) * v + ((b[i] >> 8) & 0x00ff00ff) * w +
+            0x00400040) >> 7;
+        dst[i] = (rb & 0x00ff00ff) | ((ag & 0x00ff00ff) << 8);
+        weights += weights_step;
+    }
+}
+
+#ifdef UPSCALER_X86
+TARGET_SSE2 static void
+ReplicateRowSse2(u32 *dst, const u32 *src, u32 count, u32 factor)
+{
+    u32 i = 0;
+    if (factor == 1)
+    {
+        memcpy(dst, src, count * sizeof(u32));
+        return;
+    }
+    else if (factor == 2)
+    {
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+            _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi32(v, v));
+            _mm_storeu_si128((__m128i *)(dst + 4), _mm_unpackhi_epi32(v, v));
+            dst += 8;
+        }
+    }
+    else if (factor >= 4)
+    {
+        /* The last store of the pixel overlaps the previous ones. */
+        for (; i < count; ++i)
+        {
+            __m128i v = _mm_set1_epi32((int)src[i]);
+            for (u32 j = 0; j + 4 < factor; j += 4)
+            {
+                _mm_storeu_si128((__m128i *)(dst + j), v);
+            }
+            _mm_storeu_si128((__m128i *)(dst + factor - 4), v);
+            dst += factor;
+        }
+    }
+    ReplicateRowScalar(dst, src + i, count - i, factor);
+}
+
+TARGET_SSE2 static void
+LerpRowSse2(u32 *dst, const u32 *a, const u32 *b, const u16 *weights,
+    u32 weights_step, u32 count)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i half = _mm_set1_epi16(64);
+    __m128i w_lo = _mm_set1_epi16((short)*weights);
+    __m128i w_hi = w_lo;
+
+    /* Channels are widened to 16 bits: a + ((b - a) * w + 64) >> 7. */
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        if (weights_step)
+        {
+            __m128i w = _mm_loadl_epi64((const __m128i *)(weights + i));
+            w = _mm_unpacklo_epi16(w, w);
+            w_lo = _mm_unpacklo_epi32(w, w);
+            w_hi = _mm_unpackhi_epi32(w, w);
+        }
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i a_lo = _mm_unpacklo_epi8(va, zero);
+        __m128i a_hi = _mm_unpackhi_epi8(va, zero);
+        __m128i d_lo = _mm_sub_epi16(_mm_unpacklo_epi8(vb, zero), a_lo);
+        __m128i d_hi = _mm_sub_epi16(_mm_unpackhi_epi8(vb, zero), a_hi);
+        d_lo = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(d_lo, w_lo), half), 7);
+        d_hi = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(d_hi, w_hi), half), 7);
+        __m128i result = _mm_packus_epi16(_mm_add_epi16(a_lo, d_lo),
+            _mm_add_epi16(a_hi, d_hi));
+        _mm_storeu_si128((__m128i *)(dst + i), result);
+    }
+    LerpRowScalar(dst + i, a + i, b + i, weights + i * weights_step, weights_step,
+        count - i);
+}
+
+TARGET_AVX2 static void
+GatherRowAvx2(u32 *dst, const u32 *src, const u32 *cols, u32 count)
+{
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i index = _mm256_loadu_si256((const __m256i *)(cols + i));
+        __m256i v = _mm256_i32gather_epi32((const int *)src, index, 4);
+        _mm256_storeu_si256((__m256i *)(dst + i), v);
+    }
+    GatherRowScalar(dst + i, src, cols + i, count - i);
+}
+
+TARGET_AVX2 static void
+ReplicateRowAvx2(u32 *dst, const u32 *src, u32 count, u32 factor)
+{
+    u32 i = 0;
+    if (factor == 2)
+    {
+        /* Unpacking works inside the 128 bit lanes, the lanes are put in order. */
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+            __m256i lo = _mm256_unpacklo_epi32(v, v);
+            __m256i hi = _mm256_unpackhi_epi32(v, v);
+            _mm256_storeu_si256((__m256i *)dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i *)(dst + 8),
+                _mm256_permute2x128_si256(lo, hi, 0x31));
+            dst += 16;
+        }
+    }
+    else if (factor >= 8)
+    {
+        for (; i < count; ++i)
+        {
+            __m256i v = _mm256_set1_epi32((int)src[i]);
+            for (u32 j = 0; j + 8 < factor; j += 8)
+            {
+                _mm256_storeu_si256((__m256i *)(dst + j), v);
+            }
+            _mm256_storeu_si256((__m256i *)(dst + factor - 8), v);
+            dst += factor;
+        }
+    }
+    ReplicateRowSse2(dst, src + i, count - i, factor);
+}
+
+TARGET_AVX2 static void
+LerpRowAvx2(u32 *dst, const u32 *a, const u32 *b, const u16 *weights,
+    u32 weights_step, u32 count)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i half = _mm256_set1_epi16(64);
+    __m256i w_lo = _mm256_set1_epi16((short)*weights);
+    __m256i w_hi = w_lo;
+
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        if (weights_step)
+        {
+            /* Unpacking works inside the 128 bit lanes: the low halves get the weights
+            of the pixels 0, 1 | 4, 5 and the high halves of the pixels 2, 3 | 6, 7. */
+            __m128i w = _mm_loadu_si128((const __m128i *)(weights + i));
+            __m128i w0 = _mm_unpacklo_epi16(w, w);
+            __m128i w1 = _mm_unpackhi_epi16(w, w);
+            w_lo = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_unpacklo_epi32(w0, w0)),
+                _mm_unpacklo_epi32(w1, w1), 1);
+            w_hi = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_unpackhi_epi32(w0, w0)),
+                _mm_unpackhi_epi32(w1, w1), 1);
+        }
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i a_lo = _mm256_unpacklo_epi8(va, zero);
+        __m256i a_hi = _mm256_unpackhi_epi8(va, zero);
+        __m256i d_lo = _mm256_sub_epi16(_mm256_unpacklo_epi8(vb, zero), a_lo);
+        __m256i d_hi = _mm256_sub_epi16(_mm256_unpackhi_epi8(vb, zero), a_hi);
+        d_lo = _mm256_srai_epi16(_mm256_add_epi16(_mm256_mullo_epi16(d_lo, w_lo), half), 7);
+        d_hi = _mm256_srai_epi16(_mm256_add_epi16(_mm256_mullo_epi16(d_hi, w_hi), half), 7);
+        __m256i result = _mm256_packus_epi16(_mm256_add_epi16(a_lo, d_lo),
+            _mm256_add_epi16(a_hi, d_hi));
+        _mm256_storeu_si256((__m256i *)(dst + i), result);
+    }
+    LerpRowSse2(dst + i, a + i, b + i, weights + i * weights_step, weights_step,
+        count - i);
+}
+#endif
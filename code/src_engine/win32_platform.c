@@ -129,7 +129,22 @@ WindowCallback(HWND window, UINT message, WPARAM w_param, LPARAM l_param)
     {
         /* Initialize game render. */
         Render_Init(win32_platform->render, window);
-        
+
+        /* Keep the initial client size as the internal resolution, the resized window
+        gets the buffer scaled by the upscaler. */
+        RenderBuffer *buffer = win32_platform->render->buffer;
+        Render_SetInternalResolution(win32_platform->render, buffer->width, buffer->height,
+            UF_BILINEAR);
+
+        /* Rasterize the frames in parallel by 64x64 tiles on all the CPU cores. */
+        Render_EnableTiling(win32_platform->render, 64, 0);
+
+        /* Present a frame while the next one is rasterized (triple buffering). */
+        Render_EnableSwapChain(win32_platform->render, 3);
+
+        /* Draw the background, the world and the overlays into separate layers. */
+        Render_EnableLayers(win32_platform->render);
+
         /* Run the game in a separate thread. */
         game_worker = GameWorker_Constructor();
         GameWorker_Init(game_worker, game, win32_platform);  
@@ -142,6 +157,13 @@ WindowCallback(HWND window, UINT message, WPARAM w_param, LPARAM l_param)
         Render_ResizeWindow(win32_platform->render);
     } break;
 
+    /* Repainting of the uncovered window (only the dirty regions are presented). */
+    case WM_PAINT:
+    {
+        Render_InvalidateWindow(win32_platform->render);
+        result = DefWindowProc(window, message, w_param, l_param);
+    } break;
+
     /* Processing messages when keys are pressed and released. */
     case WM_SYSKEYDOWN:
     case WM_SYSKEYUP:
@@ -51,6 +51,7 @@ static Render *render;
 /* Define different game logic variables: */
 static u32 box_x;
 static u32 box_y;
+static b32 is_dconsole_shown;
 
 Game*
 Game_Constructor(void)
@@ -138,6 +139,7 @@ Game_SimulateTick(Game *game, Win32Platform *win32_platform)
         gres->colors[GC_DCONSOLE_BKG]->color = DCONSOLE_BKG_COLOR;
         gres->colors[GC_DCONSOLE_BRD]->color = DCONSOLE_BRD_COLOR;
         gres->colors[GC_BKG_COLOR]->color = BKG_COLOR;
+        gres->colors[GC_TRANSPARENT]->color = 0x00000000;
         
         /* Prepare the font to use in the game. */
         Font_Init(font, (s32)FONT_ROWS_NUM, (s32)FONT_COLS_NUM, (s32)FONT_SYM_WIDTH, 
@@ -145,8 +147,7 @@ Game_SimulateTick(Game *game, Win32Platform *win32_platform)
         
         /* Initialization of the debuf console. */
         DConsole_Init(dconsole, 100, 50, 200, gres->colors[GC_DCONSOLE_BKG], 
-            gres->colors[GC_DCONSOLE_BRD], DCONSOLE_MARGINS, gres->colors[GC_BKG_COLOR],
-            font);
+            gres->colors[GC_DCONSOLE_BRD], DCONSOLE_MARGINS, font);
         DConsole_ClearMessages(dconsole);
 
         /* Initialization of the audio system. */
@@ -173,6 +174,7 @@ Game_SimulateTick(Game *game, Win32Platform *win32_platform)
         /* Initialization of the game logic related variables. */
         box_x = 300;
         box_y = 300;
+        is_dconsole_shown = true;
 
         /* Jump to the next game stage. */
         game->game_state = GST_INIT_RENDER;
@@ -181,8 +183,10 @@ Game_SimulateTick(Game *game, Win32Platform *win32_platform)
     /* State for the initial render procedure. */
     case GST_INIT_RENDER:
     {
-        /* Initial render of the game elements. */
+        /* Initial render of the game elements (the background is drawn only once). */
+        Render_SetLayer(render, RL_BACKGROUND);
         Render_ClearScreen(render, gres->colors[GC_BKG_COLOR]);
+        Render_SetLayer(render, RL_WORLD);
         Render_DrawRect(render, box_x, box_y, 100, 100, gres->colors[GC_WHITE]);
         Render_DrawBitmap(render, 500, 500, gres->images[GI_SMILE_FACE], 3);
         
@@ -202,14 +206,32 @@ Game_SimulateTick(Game *game, Win32Platform *win32_platform)
         
         if (Keyboard_IsKeyPressedDiscretely(keyboard, KEY_RIGHT))
         {
-            Render_DrawRect(render, box_x, box_y, 100, 100, gres->colors[GC_BKG_COLOR]);
+            Render_DrawRect(render, box_x, box_y, 100, 100, gres->colors[GC_TRANSPARENT]);
             box_x += 5;
             Render_DrawRect(render, box_x, box_y, 100, 100, gres->colors[GC_WHITE]);
         }
         
-        DConsole_AddMessage(dconsole, "Test red string!", gres->colors[GC_RED]);
-        DConsole_AddMessage(dconsole, "Test blue string!", gres->colors[GC_BLUE]);
-        DConsole_Render(dconsole, render);
+        /* The debug console is toggled by ALT (the render statistics are counted only
+        while it is shown). */
+        if (Keyboard_IsKeyPressedDiscretely(keyboard, KEY_ALT))
+        {
+            is_dconsole_shown = !is_dconsole_shown;
+        }
+        if (is_dconsole_shown)
+        {
+            DConsole_AddMessage(dconsole, "Test red string!", gres->colors[GC_RED]);
+            DConsole_AddMessage(dconsole, "Test blue string!", gres->colors[GC_BLUE]);
+#ifdef RENDER_STATS
+            RenderFrameStats render_stats;
+            Render_GetStats(render, &render_stats);
+            DConsole_AddRenderStats(dconsole, &render_stats, 3, gres->colors[GC_WHITE]);
+#endif
+            DConsole_Render(dconsole, render);
+        }
+        else
+        {
+            DConsole_Hide(dconsole, render);
+        }
         
         /* Calculate the delta time. */
         Game_CalculateDTime(game);
@@ -13,14 +13,33 @@
 #include "include_game/game_worker.h"
 
 #include <windows.h>
+#include <dwmapi.h>
 
+#include "include_engine/atomic.h"
 #include "include_engine/dbg.h"
 #include "include_engine/helper_functions.h"
 #include "include_engine/render.h"
+#include "include_engine/render_cmd_buffer.h"
 #include "include_engine/utils.h"
 #include "include_engine/win32_platform.h"
 #include "include_game/game.h"
 
+/**
+ * @brief Render procedure to be executed in the separate thread. Rasterization of the
+ * recorded frames and presenting them in the window.
+ * @param game_worker Pointer to the GameWorker structure.
+ */
+static DWORD WINAPI
+RenderThreadProc(void *game_worker);
+
+/**
+ * @brief Present procedure to be executed in the separate thread. Presenting the newest
+ * rasterized frame once per composition of the desktop.
+ * @param game_worker Pointer to the GameWorker structure.
+ */
+static DWORD WINAPI
+PresentThreadProc(void *game_worker);
+
 GameWorker*
 GameWorker_Constructor(void)
 {
@@ -32,6 +51,12 @@ GameWorker_Constructor(void)
 GameWorker*
 GameWorker_Destructor(GameWorker *game_worker)
 {
+    for (u32 i = 0; i < 2; ++i)
+    {
+        RenderCmdBuffer_Destructor(game_worker->cmd_buffers[i]);
+    }
+    CloseHandle(game_worker->frame_ready);
+    CloseHandle(game_worker->frame_done);
     HelperFcn_MemFree(game_worker);
     return NULL;
 }
@@ -41,22 +66,116 @@ GameWorker_Init(GameWorker *game_worker, Game *game, Win32Platform *win32_platfo
 {
     game_worker->game = game;
     game_worker->win32_platform = win32_platform;
+
+    /* Frame commands are recorded into one buffer while the other one is rasterized. */
+    for (u32 i = 0; i < 2; ++i)
+    {
+        game_worker->cmd_buffers[i] = RenderCmdBuffer_Constructor();
+        RenderCmdBuffer_Init(game_worker->cmd_buffers[i], 64 * 1024);
+    }
+    game_worker->frame_cmd_buffer = NULL;
+
+    /* No frame is recorded yet and the render thread is ready for the first one. */
+    game_worker->frame_ready = CreateSemaphore(NULL, 0, 1, NULL);
+    game_worker->frame_done = CreateSemaphore(NULL, 1, 1, NULL);
+    if ((game_worker->frame_ready == NULL) || (game_worker->frame_done == NULL))
+    {
+        dbg_error("%s", "Frame semaphores were not created!");
+    }
 }
 
 DWORD WINAPI 
 GameWorker_ThreadProc(void *game_worker)
 {
-    Game *game;  /* Pointer to the Game structure. */
-    Win32Platform *win32_platform;  /* Pointer to the Win32Platform structure. */
-    
-    game = ((GameWorker *)game_worker)->game;
-    win32_platform = ((GameWorker *)game_worker)->win32_platform;
-    
+    GameWorker *worker = (GameWorker *)game_worker;
+    Game *game = worker->game;  /* Pointer to the Game structure. */
+    Win32Platform *win32_platform = worker->win32_platform;  /* Pointer to the platform. */
+    Render *render = win32_platform->render;  /* Pointer to the Render structure. */
+
+    HANDLE render_thread = CreateThread(0, 0, RenderThreadProc, worker, 0, 0);
+    if (render_thread == NULL)
+    {
+        dbg_error("%s", "Render thread was not created!");
+    }
+
+    /* Frames of the swap chain are presented while the next ones are rasterized. */
+    HANDLE present_thread = NULL;
+    if (render->swap_chain)
+    {
+        Atomic_Store(&worker->is_presenting, true);
+        present_thread = CreateThread(0, 0, PresentThreadProc, worker, 0, 0);
+        if (present_thread == NULL)
+        {
+            dbg_error("%s", "Present thread was not created!");
+        }
+    }
+
+    u32 frame_index = 0;  /* Index of the command buffer to record. */
     while (game->is_running)
     {
+        /* Simulate the tick while recording its drawing. */
+        RenderCmdBuffer *cmd_buffer = worker->cmd_buffers[frame_index];
+        RenderCmdBuffer_Reset(cmd_buffer);
+        Render_BeginRecording(render, cmd_buffer);
         Game_SimulateTick(game, win32_platform);
-        Render_UpdateWindow(win32_platform->render);
+        Render_EndRecording(render);
+
+        /* Hand the frame over as soon as the previous one is rasterized. */
+        WaitForSingleObject(worker->frame_done, INFINITE);
+        worker->frame_cmd_buffer = cmd_buffer;
+        ReleaseSemaphore(worker->frame_ready, 1, NULL);
+        frame_index ^= 1;
         Sleep(1);
     }
+
+    /* Stop the render thread after the last frame. */
+    WaitForSingleObject(worker->frame_done, INFINITE);
+    worker->frame_cmd_buffer = NULL;
+    ReleaseSemaphore(worker->frame_ready, 1, NULL);
+    WaitForSingleObject(render_thread, INFINITE);
+    CloseHandle(render_thread);
+
+    /* Stop the present thread after the last frame. */
+    if (present_thread)
+    {
+        Atomic_Store(&worker->is_presenting, false);
+        WaitForSingleObject(present_thread, INFINITE);
+        CloseHandle(present_thread);
+    }
+    return(0);
+}
+
+static DWORD WINAPI
+RenderThreadProc(void *game_worker)
+{
+    GameWorker *worker = (GameWorker *)game_worker;
+    Render *render = worker->win32_platform->render;
+
+    while (true)
+    {
+        WaitForSingleObject(worker->frame_ready, INFINITE);
+        RenderCmdBuffer *cmd_buffer = worker->frame_cmd_buffer;
+        if (cmd_buffer == NULL) break;
+
+        RenderCmdBuffer_Execute(cmd_buffer, render);
+        Render_UpdateWindow(render);
+        ReleaseSemaphore(worker->frame_done, 1, NULL);
+    }
+    return(0);
+}
+
+static DWORD WINAPI
+PresentThreadProc(void *game_worker)
+{
+    GameWorker *worker = (GameWorker *)game_worker;
+    Render *render = worker->win32_platform->render;
+
+    while (Atomic_Load(&worker->is_presenting))
+    {
+        Render_PresentFrame(render);
+
+        /* Wait for the next vertical blank (about 60 Hz without the desktop composition). */
+        if (FAILED(DwmFlush())) Sleep(16);
+    }
     return(0);
 }
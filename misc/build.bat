@@ -14,27 +14,57 @@ pushd ..\build
 :: /wd Disable warnings.
 ::      C4201 - Unnamed structures and enumerators.
 ::      C4189 - Unused local variable.
+:: The debug build ("build.bat debug") adds:
+:: -DRENDER_STATS Compile the render statistics in.
+set DEBUG_FLAGS=
+if "%1"=="debug" set DEBUG_FLAGS=-DRENDER_STATS
 
-cl -FC -Zi -W4 -WX ^
+cl -FC -Zi -W4 -WX %DEBUG_FLAGS% ^
     /Fe: Game ^
     /wd4201 /wd4189 ^
     /I ..\code ^
+    ..\code\src_engine\atlas.c ^
     ..\code\src_engine\audio_worker.c ^
     ..\code\src_engine\audio.c ^
+    ..\code\src_engine\batch_raster.c ^
+    ..\code\src_engine\blend.c ^
     ..\code\src_engine\color.c ^
     ..\code\src_engine\debug_console.c ^
+    ..\code\src_engine\dirty_rects.c ^
+    ..\code\src_engine\ellipse_raster.c ^
     ..\code\src_engine\font.c ^
+    ..\code\src_engine\frame_capture.c ^
+    ..\code\src_engine\glyph_cache.c ^
     ..\code\src_engine\helper_functions.c ^
     ..\code\src_engine\image.c ^
+    ..\code\src_engine\job_pool.c ^
     ..\code\src_engine\keyboard.c ^
+    ..\code\src_engine\line_raster.c ^
     ..\code\src_engine\math_functions.c ^
     ..\code\src_engine\matrix22.c ^
     ..\code\src_engine\matrix33.c ^
     ..\code\src_engine\memory_object.c ^
     ..\code\src_engine\mouse.c ^
+    ..\code\src_engine\pixel_format.c ^
+    ..\code\src_engine\png_writer.c ^
+    ..\code\src_engine\polygon_raster.c ^
     ..\code\src_engine\random.c ^
     ..\code\src_engine\render.c ^
+    ..\code\src_engine\render_cmd_buffer.c ^
+    ..\code\src_engine\render_layers.c ^
+    ..\code\src_engine\render_occlusion.c ^
+    ..\code\src_engine\render_stats.c ^
+    ..\code\src_engine\render_target.c ^
+    ..\code\src_engine\render_tiler.c ^
+    ..\code\src_engine\scale_raster.c ^
     ..\code\src_engine\sound.c ^
+    ..\code\src_engine\span_fill.c ^
+    ..\code\src_engine\sprite.c ^
+    ..\code\src_engine\swap_chain.c ^
+    ..\code\src_engine\texture.c ^
+    ..\code\src_engine\texture_raster.c ^
+    ..\code\src_engine\triangle_raster.c ^
+    ..\code\src_engine\upscaler.c ^
     ..\code\src_engine\vector2.c ^
     ..\code\src_engine\vector3.c ^
     ..\code\src_engine\wav_decoder.c ^
@@ -42,7 +72,7 @@ cl -FC -Zi -W4 -WX ^
     ..\code\src_game\game_resourses.c ^
     ..\code\src_game\game_worker.c ^
     ..\code\src_game\game.c ^
-    user32.lib gdi32.lib
+    user32.lib gdi32.lib dwmapi.lib
 
 :: pop the directory 
 popd
@@ -0,0 +1,146 @@
+#!/bin/sh
+
+# Build the headless benchmarks (Linux, GCC or Clang). Run from the misc directory.
+# -O2 Optimize the code.
+# -g Add debug information.
+# -std=gnu11 Anonymous structures and GNU variadic macros are used by the engine.
+# -Wno-unused-function Static functions of dbg.h are not used everywhere.
+
+CC=${CC:-cc}
+CFLAGS="-O2 -g -std=gnu11 -Wall -Wextra -Wno-unused-function -I ../code"
+
+# check if the directory "build" is created, if not then create it
+mkdir -p ../build
+
+# Span fill kernels benchmark.
+$CC $CFLAGS -o ../build/span_fill_bench \
+    ../code/src_bench/span_fill_bench.c \
+    ../code/src_engine/span_fill.c || exit 1
+
+# Swap chain handoff benchmark (producer and fake consumer threads).
+$CC $CFLAGS -o ../build/swap_chain_bench \
+    ../code/src_bench/swap_chain_bench.c \
+    ../code/src_engine/helper_functions.c \
+    ../code/src_engine/swap_chain.c -lpthread -lm || exit 1
+
+# Upscaler benchmark (all the filters, single thread and all the CPU cores).
+$CC $CFLAGS -o ../build/upscaler_bench \
+    ../code/src_bench/upscaler_bench.c \
+    ../code/src_engine/helper_functions.c \
+    ../code/src_engine/job_pool.c \
+    ../code/src_engine/span_fill.c \
+    ../code/src_engine/upscaler.c -lpthread -lm || exit 1
+
+# Render primitives benchmark (headless render, golden images in data/golden).
+$CC $CFLAGS -o ../build/render_bench \
+    ../code/src_bench/render_bench.c \
+    ../code/src_engine/atlas.c \
+    ../code/src_engine/batch_raster.c \
+    ../code/src_engine/blend.c \
+    ../code/src_engine/color.c \
+    ../code/src_engine/dirty_rects.c \
+    ../code/src_engine/ellipse_raster.c \
+    ../code/src_engine/font.c \
+    ../code/src_engine/frame_capture.c \
+    ../code/src_engine/glyph_cache.c \
+    ../code/src_engine/helper_functions.c \
+    ../code/src_engine/image.c \
+    ../code/src_engine/job_pool.c \
+    ../code/src_engine/line_raster.c \
+    ../code/src_engine/math_functions.c \
+    ../code/src_engine/memory_object.c \
+    ../code/src_engine/pixel_format.c \
+    ../code/src_engine/png_writer.c \
+    ../code/src_engine/polygon_raster.c \
+    ../code/src_engine/render.c \
+    ../code/src_engine/render_cmd_buffer.c \
+    ../code/src_engine/render_layers.c \
+    ../code/src_engine/render_occlusion.c \
+    ../code/src_engine/render_stats.c \
+    ../code/src_engine/render_target.c \
+    ../code/src_engine/render_tiler.c \
+    ../code/src_engine/scale_raster.c \
+    ../code/src_engine/span_fill.c \
+    ../code/src_engine/sprite.c \
+    ../code/src_engine/swap_chain.c \
+    ../code/src_engine/texture.c \
+    ../code/src_engine/texture_raster.c \
+    ../code/src_engine/triangle_raster.c \
+    ../code/src_engine/upscaler.c \
+    ../code/src_engine/vector2.c -lpthread -lm || exit 1
+
+# Render primitives benchmark with the render statistics compiled in (overdraw checks).
+$CC $CFLAGS -DRENDER_STATS -o ../build/render_bench_stats \
+    ../code/src_bench/render_bench.c \
+    ../code/src_engine/atlas.c \
+    ../code/src_engine/batch_raster.c \
+    ../code/src_engine/blend.c \
+    ../code/src_engine/color.c \
+    ../code/src_engine/dirty_rects.c \
+    ../code/src_engine/ellipse_raster.c \
+    ../code/src_engine/font.c \
+    ../code/src_engine/frame_capture.c \
+    ../code/src_engine/glyph_cache.c \
+    ../code/src_engine/helper_functions.c \
+    ../code/src_engine/image.c \
+    ../code/src_engine/job_pool.c \
+    ../code/src_engine/line_raster.c \
+    ../code/src_engine/math_functions.c \
+    ../code/src_engine/memory_object.c \
+    ../code/src_engine/pixel_format.c \
+    ../code/src_engine/png_writer.c \
+    ../code/src_engine/polygon_raster.c \
+    ../code/src_engine/render.c \
+    ../code/src_engine/render_cmd_buffer.c \
+    ../code/src_engine/render_layers.c \
+    ../code/src_engine/render_occlusion.c \
+    ../code/src_engine/render_stats.c \
+    ../code/src_engine/render_target.c \
+    ../code/src_engine/render_tiler.c \
+    ../code/src_engine/scale_raster.c \
+    ../code/src_engine/span_fill.c \
+    ../code/src_engine/sprite.c \
+    ../code/src_engine/swap_chain.c \
+    ../code/src_engine/texture.c \
+    ../code/src_engine/texture_raster.c \
+    ../code/src_engine/triangle_raster.c \
+    ../code/src_engine/upscaler.c \
+    ../code/src_engine/vector2.c -lpthread -lm || exit 1
+
+# Frame capture benchmark (headless render, outputs are written into build).
+$CC $CFLAGS -o ../build/capture_bench \
+    ../code/src_bench/capture_bench.c \
+    ../code/src_engine/atlas.c \
+    ../code/src_engine/batch_raster.c \
+    ../code/src_engine/blend.c \
+    ../code/src_engine/color.c \
+    ../code/src_engine/dirty_rects.c \
+    ../code/src_engine/ellipse_raster.c \
+    ../code/src_engine/font.c \
+    ../code/src_engine/frame_capture.c \
+    ../code/src_engine/glyph_cache.c \
+    ../code/src_engine/helper_functions.c \
+    ../code/src_engine/image.c \
+    ../code/src_engine/job_pool.c \
+    ../code/src_engine/line_raster.c \
+    ../code/src_engine/math_functions.c \
+    ../code/src_engine/memory_object.c \
+    ../code/src_engine/pixel_format.c \
+    ../code/src_engine/png_writer.c \
+    ../code/src_engine/polygon_raster.c \
+    ../code/src_engine/render.c \
+    ../code/src_engine/render_cmd_buffer.c \
+    ../code/src_engine/render_layers.c \
+    ../code/src_engine/render_occlusion.c \
+    ../code/src_engine/render_stats.c \
+    ../code/src_engine/render_target.c \
+    ../code/src_engine/render_tiler.c \
+    ../code/src_engine/scale_raster.c \
+    ../code/src_engine/span_fill.c \
+    ../code/src_engine/sprite.c \
+    ../code/src_engine/swap_chain.c \
+    ../code/src_engine/texture.c \
+    ../code/src_engine/texture_raster.c \
+    ../code/src_engine/triangle_raster.c \
+    ../code/src_engine/upscaler.c \
+    ../code/src_engine/vector2.c -lpthread -lm || exit 1